@@ -64,10 +64,22 @@ void Node::setGraph(std::shared_ptr<NodeGraph> graph) {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Node::sendMessageToJS(nlohmann::json const& message) const {
-  mSocket->sendEvent(CommunicationChannel::Event{
+  mSocket->queueEvent(CommunicationChannel::Event{
       CommunicationChannel::Event::Type::eNodeMessage, {{"toNode", mID}, {"message", message}}});
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void Node::sendLatestMessageToJS(nlohmann::json const& message, std::string const& key) const {
+  mSocket->queueLatestNodeMessage(mID, key, message);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Node::sendArrayToJS(std::vector<float> values) const {
+  mSocket->queueNodeArray(mID, std::move(values));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace csl::nodeeditor
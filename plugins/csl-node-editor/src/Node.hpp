@@ -45,9 +45,28 @@ class CSL_NODE_EDITOR_EXPORT Node {
   ///   node.onMessageFromCPP = (message) => {
   ///     console.log(message);
   ///   };
+  /// Messages are not sent immediately but collected and sent together with the messages of all
+  /// other nodes at the end of the frame. They are received in the order they were sent.
   /// @param message A custom JSON object.
   void sendMessageToJS(nlohmann::json const& message) const;
 
+  /// Like sendMessageToJS(), but if this node sends another message with the same key before the
+  /// end of the frame, only the latest one will be received. Use this for messages which are sent
+  /// frequently and only represent the current state of the node, like a displayed value.
+  /// @param message A custom JSON object.
+  /// @param key     Only messages with the same key replace each other.
+  void sendLatestMessageToJS(nlohmann::json const& message, std::string const& key = "") const;
+
+  /// Sends an array of numbers to the JavaScript counterpart of this node. The values are sent as
+  /// binary data which is much more compact than JSON for large arrays. Only the latest array sent
+  /// during a frame will be received. It can be received in the frontend with the onArrayFromCPP
+  /// method of the node:
+  ///   node.onArrayFromCPP = (values) => {
+  ///     console.log(values); // This is a Float32Array.
+  ///   };
+  /// @param values The numbers to send. They will be received with single precision.
+  void sendArrayToJS(std::vector<float> values) const;
+
   /// Called whenever the JavaScript counterpart of this node has sent a message via the global
   /// sendMessageToCPP() method:
   ///   CosmoScout.sendMessageToCPP(message, this.parent.id);
@@ -59,6 +78,30 @@ class CSL_NODE_EDITOR_EXPORT Node {
   /// a reprocessing because a new web client connected.
   virtual void process() = 0;
 
+  /// Determines where process() is called. See getExecutionMode().
+  enum class ExecutionMode {
+    /// process() is called on the main thread. This is the default.
+    eMainThread,
+
+    /// process() may be called on a worker thread, in parallel to other nodes which do not depend
+    /// on each other. The node graph waits for it to finish before the frame continues.
+    eParallel,
+
+    /// process() is called on a worker thread and may take several frames. Nodes which depend on
+    /// the outputs of this node do not wait for it, they are processed again once it has written
+    /// new output values. In the meantime, other methods like onMessageFromJS() or getData() may be
+    /// called on the main thread, so the node has to protect its members accordingly.
+    eAsync
+  };
+
+  /// Override this if process() does expensive computations. Nodes which are not processed on the
+  /// main thread must only use readInput(), writeOutput(), the send...ToJS() methods, and their own
+  /// members in process().
+  /// @return The default implementation returns ExecutionMode::eMainThread.
+  virtual ExecutionMode getExecutionMode() const {
+    return ExecutionMode::eMainThread;
+  }
+
   /// Each node must override this. It simply returns the static sName.
   virtual std::string const& getName() const = 0;
 
@@ -119,6 +162,7 @@ class CSL_NODE_EDITOR_EXPORT Node {
   ///                only written if changed.
   template <typename T>
   void writeOutput(std::string const& socket, T const& value) {
+    auto lock        = mGraph->lockConnections();
     auto connections = mGraph->getOutputConnections(mID, socket);
 
     for (auto& c : connections) {
@@ -137,6 +181,7 @@ class CSL_NODE_EDITOR_EXPORT Node {
   /// @param defaultValue  If there is no input connection, this value will be returned.
   template <typename T>
   T readInput(std::string const& socket, T defaultValue) {
+    auto        lock       = mGraph->lockConnections();
     auto const* connection = mGraph->getInputConnection(mID, socket);
 
     if (connection && connection->mData.has_value()) {
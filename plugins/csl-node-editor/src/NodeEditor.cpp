@@ -223,6 +223,10 @@ void NodeEditor::update() {
   } catch (std::exception const& e) {
     logger().error("Failed to process node graph: {}", e.what());
   }
+
+  // All messages which the nodes sent to their JavaScript counterparts during this frame are sent
+  // together.
+  mSocket->flush();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
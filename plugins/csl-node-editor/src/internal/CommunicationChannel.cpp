@@ -9,6 +9,7 @@
 
 #include "../logger.hpp"
 
+#include <cstring>
 #include <optional>
 
 namespace csl::nodeeditor {
@@ -58,6 +59,91 @@ void CommunicationChannel::sendEvent(CommunicationChannel::Event const& event) c
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void CommunicationChannel::queueEvent(Event event) {
+  std::unique_lock<std::mutex> lock(mOutgoingMutex);
+  mOutgoingEvents.push_back(std::move(event));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CommunicationChannel::queueLatestNodeMessage(
+    uint32_t toNode, std::string const& key, nlohmann::json message) {
+
+  std::unique_lock<std::mutex> lock(mOutgoingMutex);
+
+  auto it = mLatestNodeMessages.find({toNode, key});
+
+  if (it != mLatestNodeMessages.end()) {
+    mOutgoingEvents[it->second].mData["message"] = std::move(message);
+  } else {
+    mLatestNodeMessages.emplace(std::make_pair(toNode, key), mOutgoingEvents.size());
+    mOutgoingEvents.push_back(
+        {Event::Type::eNodeMessage, {{"toNode", toNode}, {"message", std::move(message)}}});
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CommunicationChannel::queueNodeArray(uint32_t toNode, std::vector<float> values) {
+  std::unique_lock<std::mutex> lock(mOutgoingMutex);
+  mOutgoingArrays[toNode] = std::move(values);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CommunicationChannel::flush() {
+  std::vector<Event>                               events;
+  std::unordered_map<uint32_t, std::vector<float>> arrays;
+
+  {
+    std::unique_lock<std::mutex> lock(mOutgoingMutex);
+    events.swap(mOutgoingEvents);
+    arrays.swap(mOutgoingArrays);
+    mLatestNodeMessages.clear();
+  }
+
+  if (!isConnected()) {
+    return;
+  }
+
+  if (!events.empty()) {
+    auto data = nlohmann::json::array();
+
+    for (auto& event : events) {
+      data.push_back({{"type", event.mType}, {"data", std::move(event.mData)}});
+    }
+
+    nlohmann::json json   = {{"type", "batch"}, {"data", std::move(data)}};
+    auto           string = json.dump();
+
+    mg_websocket_write(mConnection, MG_WEBSOCKET_OPCODE_TEXT, string.c_str(), string.size());
+  }
+
+  if (!arrays.empty()) {
+    size_t size = 0;
+    for (auto const& [toNode, values] : arrays) {
+      size += 2 * sizeof(uint32_t) + values.size() * sizeof(float);
+    }
+
+    std::vector<char> buffer(size);
+    char*             data = buffer.data();
+
+    for (auto const& [toNode, values] : arrays) {
+      auto count = static_cast<uint32_t>(values.size());
+
+      std::memcpy(data, &toNode, sizeof(uint32_t));
+      std::memcpy(data + sizeof(uint32_t), &count, sizeof(uint32_t));
+      std::memcpy(data + 2 * sizeof(uint32_t), values.data(), values.size() * sizeof(float));
+
+      data += 2 * sizeof(uint32_t) + values.size() * sizeof(float);
+    }
+
+    mg_websocket_write(mConnection, MG_WEBSOCKET_OPCODE_BINARY, buffer.data(), buffer.size());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 bool CommunicationChannel::isConnected() const {
   return mConnection != nullptr;
 }
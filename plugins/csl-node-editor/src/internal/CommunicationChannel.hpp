@@ -9,10 +9,13 @@
 #define CSL_NODE_EDITOR_COMMUNICATION_CHANNEL_HPP
 
 #include <CivetServer.h>
+#include <map>
 #include <mutex>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 namespace csl::nodeeditor {
 
@@ -20,6 +23,13 @@ namespace csl::nodeeditor {
 /// a web socket. There is a set of predefined event types which make up the whole communication.
 /// This class is instantiated by the node editor. As a user of this library, you should not have to
 /// use this class directly.
+///
+/// Events can either be sent immediately or be queued. All queued events are sent together once per
+/// frame when the node editor calls flush(). They are sent as a single text message of the form
+/// {"type": "batch", "data": [<event>, <event>, ...]}. Additionally, nodes can send arrays of
+/// numbers. These are sent as a single binary message which contains, for each array, the target
+/// node ID and the number of values as uint32 followed by the values as float32. All numbers are
+/// stored in native byte order, which is little-endian on all supported platforms.
 class CommunicationChannel : public CivetWebSocketHandler {
 
  public:
@@ -126,6 +136,28 @@ class CommunicationChannel : public CivetWebSocketHandler {
   ///              described above.
   void sendEvent(Event const& event) const;
 
+  /// Queues an event which will be sent during the next call to flush(). This is thread-safe.
+  /// @param event The event to send. The data object must contain the type-dependent fields as
+  ///              described above.
+  void queueEvent(Event event);
+
+  /// Queues an eNodeMessage event. If there is already a message for the same node with the same
+  /// key in the queue, it will be replaced. This is thread-safe.
+  /// @param toNode  The ID of the target node.
+  /// @param key     Messages of one node with the same key replace each other.
+  /// @param message The custom message.
+  void queueLatestNodeMessage(uint32_t toNode, std::string const& key, nlohmann::json message);
+
+  /// Queues an array of numbers for the given node. If there is already an array for this node in
+  /// the queue, it will be replaced. This is thread-safe.
+  /// @param toNode The ID of the target node.
+  /// @param values The numbers to send.
+  void queueNodeArray(uint32_t toNode, std::vector<float> values);
+
+  /// Sends all queued events and arrays to the connected client. If no client is connected, they
+  /// are discarded. This is called once per frame by the node editor.
+  void flush();
+
   /// Get whether there is a client connected currently.
   /// @return True if there is a client connected.
   bool isConnected() const;
@@ -140,6 +172,13 @@ class CommunicationChannel : public CivetWebSocketHandler {
   std::queue<Event> mEventQueue;
   std::mutex        mEventQueueMutex;
 
+  // These store the outgoing events and arrays until the next call to flush(). mLatestNodeMessages
+  // stores the index in mOutgoingEvents of the latest message for each node and key.
+  std::vector<Event>                                 mOutgoingEvents;
+  std::map<std::pair<uint32_t, std::string>, size_t> mLatestNodeMessages;
+  std::unordered_map<uint32_t, std::vector<float>>   mOutgoingArrays;
+  std::mutex                                         mOutgoingMutex;
+
   mg_connection* mConnection = nullptr;
 };
 
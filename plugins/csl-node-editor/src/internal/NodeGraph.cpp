@@ -8,19 +8,71 @@
 #include "NodeGraph.hpp"
 
 #include "../Node.hpp"
+#include "../logger.hpp"
+
+#include "../../../../src/cs-utils/FrameStats.hpp"
+#include "../../../../src/cs-utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 namespace csl::nodeeditor {
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns a timestamp in nanoseconds as used by the FrameStats.
+int64_t getTimestamp() {
+  return std::chrono::high_resolution_clock::now().time_since_epoch().count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string getTimerName(uint32_t id, Node const& node) {
+  return node.getName() + " (" + std::to_string(id) + ")";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Removes the given connection from the connections of the given node.
+void removeFromIndex(
+    std::unordered_map<uint32_t, std::vector<NodeConnection const*>>& connectionsByNode,
+    uint32_t node, NodeConnection const* connection) {
+
+  auto it = connectionsByNode.find(node);
+
+  if (it != connectionsByNode.end()) {
+    auto& connections = it->second;
+    connections.erase(
+        std::remove(connections.begin(), connections.end(), connection), connections.end());
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// These need to be declared explicitly as the default versions would be defined inline in the
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NodeGraph::NodeGraph() {
+  // We leave one core for the main thread.
+  uint32_t cores = std::thread::hardware_concurrency();
+  mThreadCount   = cores > 1 ? cores - 1 : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This needs to be declared explicitly as the default version would be defined inline in the
 // header which makes it impossible to use a forward declaration of Node.
-NodeGraph::NodeGraph()  = default;
 NodeGraph::~NodeGraph() = default;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void NodeGraph::queueProcess() {
+  std::unique_lock<std::mutex> lock(mMutex);
+
   for (auto const& [id, node] : mNodes) {
     mDirtyNodes.insert(id);
   }
@@ -29,6 +81,7 @@ void NodeGraph::queueProcess() {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void NodeGraph::queueProcess(uint32_t node) {
+  std::unique_lock<std::mutex> lock(mMutex);
   mDirtyNodes.insert(node);
 }
 
@@ -62,21 +115,38 @@ nlohmann::json NodeGraph::toJSON() const {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void NodeGraph::clear() {
+
+  // Nodes which are still running on a worker thread are kept alive by their task. They will simply
+  // not find any connections anymore.
   mNodes.clear();
-  mDirtyNodes.clear();
-  mConnections.clear();
+
+  {
+    auto lock = lockConnections();
+    mConnections.clear();
+    mInputConnections.clear();
+    mOutputConnections.clear();
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDirtyNodes.clear();
+  }
+
+  mTopologyDirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void NodeGraph::addNode(uint32_t id, std::unique_ptr<Node> node) {
   mNodes.emplace(id, std::move(node));
+  mTopologyDirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void NodeGraph::removeNode(uint32_t id) {
   mNodes.erase(id);
+  mTopologyDirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -104,9 +174,13 @@ void NodeGraph::setNodeCollapsed(uint32_t id, bool collapsed) const {
 void NodeGraph::addConnection(
     uint32_t fromNode, std::string fromSocket, uint32_t toNode, std::string toSocket) {
 
-  mDirtyNodes.insert(fromNode);
+  queueProcess(fromNode);
 
+  auto lock = lockConnections();
   mConnections.emplace_back(fromNode, std::move(fromSocket), toNode, std::move(toSocket));
+  mOutputConnections[fromNode].push_back(&mConnections.back());
+  mInputConnections[toNode].push_back(&mConnections.back());
+  mTopologyDirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -114,12 +188,28 @@ void NodeGraph::addConnection(
 void NodeGraph::removeConnection(uint32_t fromNode, std::string const& fromSocket, uint32_t toNode,
     std::string const& toSocket) {
 
-  mDirtyNodes.insert(toNode);
+  queueProcess(toNode);
 
-  mConnections.remove_if([&](NodeConnection const& c) {
-    return c.mFromNode == fromNode && c.mFromSocket == fromSocket && c.mToNode == toNode &&
-           c.mToSocket == toSocket;
-  });
+  auto lock = lockConnections();
+
+  for (auto it = mConnections.begin(); it != mConnections.end();) {
+    if (it->mFromNode == fromNode && it->mFromSocket == fromSocket && it->mToNode == toNode &&
+        it->mToSocket == toSocket) {
+      removeFromIndex(mOutputConnections, fromNode, &(*it));
+      removeFromIndex(mInputConnections, toNode, &(*it));
+      it = mConnections.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  mTopologyDirty = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::unique_lock<std::mutex> NodeGraph::lockConnections() const {
+  return std::unique_lock<std::mutex>(mConnectionsMutex);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -127,29 +217,30 @@ void NodeGraph::removeConnection(uint32_t fromNode, std::string const& fromSocke
 NodeConnection const* NodeGraph::getInputConnection(
     uint32_t toNode, std::string const& toSocket) const {
 
-  auto it = std::find_if(mConnections.begin(), mConnections.end(),
-      [&](NodeConnection const& c) { return c.mToNode == toNode && c.mToSocket == toSocket; });
+  auto it = mInputConnections.find(toNode);
 
-  if (it == mConnections.end()) {
-    return nullptr;
+  if (it != mInputConnections.end()) {
+    for (auto const* c : it->second) {
+      if (c->mToSocket == toSocket) {
+        return c;
+      }
+    }
   }
 
-  return &(*it);
+  return nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 std::vector<NodeConnection const*> NodeGraph::getInputConnections(uint32_t toNode) const {
 
-  std::vector<NodeConnection const*> result;
+  auto it = mInputConnections.find(toNode);
 
-  for (auto const& c : mConnections) {
-    if (c.mToNode == toNode) {
-      result.push_back(&c);
-    }
+  if (it == mInputConnections.end()) {
+    return {};
   }
 
-  return result;
+  return it->second;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -159,9 +250,13 @@ std::vector<NodeConnection const*> NodeGraph::getOutputConnections(
 
   std::vector<NodeConnection const*> result;
 
-  for (auto const& c : mConnections) {
-    if (c.mFromNode == fromNode && c.mFromSocket == fromSocket) {
-      result.push_back(&c);
+  auto it = mOutputConnections.find(fromNode);
+
+  if (it != mOutputConnections.end()) {
+    for (auto const* c : it->second) {
+      if (c->mFromSocket == fromSocket) {
+        result.push_back(c);
+      }
     }
   }
 
@@ -172,81 +267,174 @@ std::vector<NodeConnection const*> NodeGraph::getOutputConnections(
 
 std::vector<NodeConnection const*> NodeGraph::getOutputConnections(uint32_t fromNode) const {
 
-  std::vector<NodeConnection const*> result;
+  auto it = mOutputConnections.find(fromNode);
 
-  for (auto const& c : mConnections) {
-    if (c.mFromNode == fromNode) {
-      result.push_back(&c);
-    }
+  if (it == mOutputConnections.end()) {
+    return {};
   }
 
-  return result;
+  return it->second;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void NodeGraph::process() {
 
+  cs::utils::FrameStats::ScopedTimer timer(
+      "Process Node Graph", cs::utils::FrameStats::TimerMode::eCPU);
+
+  // First, we collect all asynchronous nodes which finished since the last call. If they wrote new
+  // output values, the connected nodes have already been added to mDirtyNodes.
+  {
+    std::vector<FinishedNode> finishedNodes;
+
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      finishedNodes.swap(mFinishedAsyncNodes);
+    }
+
+    for (auto const& node : finishedNodes) {
+      mRunningNodes.erase(node.mID);
+      recordTiming(node);
+    }
+  }
+
+  if (mTopologyDirty) {
+    updateTopology();
+  }
+
   // A naive implementation of this method would simply pop nodes from mDirtyNodes and process them
   // until mDirtyNodes is empty. This would work as new nodes are added to mDirtyNodes if a node
   // produces a new output value during its process() method.
   // However, this approach would lead to too many calls to process(). In the worst case, the
   // process() method of a node would be called once for each connected input. To prevent this, we
-  // first collect all nodes which may need to be processed. Then, we process them one by one,
-  // always choosing a node for which all input nodes have already been processed.
+  // first collect all nodes which may need to be processed. Then, we process them in topological
+  // order, always choosing a node for which all input nodes have already been processed.
+
+  mSchedule.assign(mSortedNodes.size(), ScheduleEntry());
+  mReadyNodes.clear();
 
   // All dirty nodes will need to be processed.
-  auto processNodes = mDirtyNodes;
-
-  // Processing them will most likely result in changed output values, so we will process all
-  // connected output nodes as well. This could lead to nodes being processed for which the input
-  // actually did not change. However, once a node produces a new output, all connected nodes will
-  // be put into mDirtyNodes automatically. So we can check if mDirtyNodes contains a specific node
-  // before calling process() on it. This way, we can ensure that process() is only called for nodes
-  // which have changed input values.
-
-  // Recursively traverse the graph starting from all dirty nodes and push all visited nodes into
-  // processNodes. We abort after too many iterations - in this case there must be a cycle in the
-  // graph!
-  auto     heap       = processNodes;
-  uint32_t iterations = 0;
-
-  while (!heap.empty()) {
-    auto nodes = getOutputNodes(*heap.begin());
-    heap.erase(heap.begin());
-
-    processNodes.insert(nodes.begin(), nodes.end());
-    heap.insert(nodes.begin(), nodes.end());
-
-    if (++iterations > mNodes.size() * mNodes.size()) {
-      throw std::runtime_error("Cycle detected!");
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    for (auto it = mDirtyNodes.begin(); it != mDirtyNodes.end();) {
+      auto index = mNodeIndices.find(*it);
+
+      // The node may have been removed in the meantime.
+      if (index == mNodeIndices.end()) {
+        it = mDirtyNodes.erase(it);
+      } else {
+        mSchedule[index->second].mAffected = true;
+        ++it;
+      }
     }
   }
-  // Now that we have all nodes which should be processed, we process them one by one. We always
-  // choose a node which does not receive input from a node which is still pending to be processed.
-  while (!processNodes.empty()) {
-    auto it = std::find_if(processNodes.begin(), processNodes.end(), [&](uint32_t node) {
-      for (uint32_t inputNode : getInputNodes(node)) {
-        if (processNodes.find(inputNode) != processNodes.end()) {
-          return false;
-        }
+
+  // Processing the dirty nodes will most likely result in changed output values, so we will process
+  // all connected output nodes as well. This could lead to nodes being processed for which the
+  // input actually did not change. However, once a node produces a new output, all connected nodes
+  // will be put into mDirtyNodes automatically. So we can check if mDirtyNodes contains a specific
+  // node before calling process() on it. This way, we can ensure that process() is only called for
+  // nodes which have changed input values.
+  // As the nodes are sorted topologically, a single pass is sufficient to propagate this to all
+  // output nodes. At the same time, we count the inputs each node has to wait for.
+  for (uint32_t i = 0; i < mSortedNodes.size(); ++i) {
+    ScheduleEntry const& entry = mSchedule[i];
+
+    if (!entry.mAffected) {
+      continue;
+    }
+
+    if (entry.mPendingInputs == 0) {
+      mReadyNodes.push_back(i);
+    }
+
+    for (uint32_t output : mOutputIndices[i]) {
+      mSchedule[output].mAffected = true;
+      ++mSchedule[output].mPendingInputs;
+    }
+  }
+
+  // Now we process all nodes whose inputs are ready. Parallel nodes are run on the thread pool
+  // while the main thread continues with other ready nodes. Once there are no more ready nodes, we
+  // wait for the parallel nodes to finish, which will make their output nodes ready.
+  uint32_t tasksInFlight = 0;
+
+  while (!mReadyNodes.empty() || tasksInFlight > 0) {
+    while (!mReadyNodes.empty()) {
+      uint32_t index = mReadyNodes.back();
+      uint32_t id    = mSortedNodes[index];
+      mReadyNodes.pop_back();
+
+      // Asynchronous nodes which are still running are not started again. If they are dirty, they
+      // stay so and will be started again once they have finished.
+      if (mRunningNodes.find(id) != mRunningNodes.end()) {
+        releaseOutputs(index);
+        continue;
       }
-      return true;
-    });
 
-    // Only call process() on nodes which were marked as being dirty.
-    if (mDirtyNodes.find(*it) != mDirtyNodes.end()) {
-      auto node = mNodes.find(*it);
+      bool isDirty = false;
+
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        isDirty = mDirtyNodes.erase(id) > 0;
+      }
 
-      if (node != mNodes.end()) {
-        node->second->process();
+      // Only call process() on nodes which were marked as being dirty.
+      if (!isDirty) {
+        releaseOutputs(index);
+        continue;
+      }
+
+      auto const& node = mNodes.at(id);
+      auto        mode = node->getExecutionMode();
+
+      // The output nodes of an asynchronous node do not wait for it. They will be processed again
+      // once it has finished and written new output values.
+      if (mode == Node::ExecutionMode::eAsync) {
+        mRunningNodes.insert(id);
+        enqueueNode(index, true);
+        releaseOutputs(index);
+
+        // If all workers are busy with asynchronous nodes, we rather process parallel nodes on the
+        // main thread than waiting for a worker to become available.
+      } else if (mode == Node::ExecutionMode::eParallel && mRunningNodes.size() < mThreadCount) {
+        ++tasksInFlight;
+        enqueueNode(index, false);
+
+      } else {
+        auto&   frameStats = cs::utils::FrameStats::get();
+        int32_t timerID    = -1;
+
+        if (frameStats.pEnableMeasurements.get()) {
+          timerID = frameStats.startTimerQuery(
+              getTimerName(id, *node), cs::utils::FrameStats::TimerMode::eCPU);
+        }
+
+        runNode(id, *node);
+
+        frameStats.endTimerQuery(timerID);
+        releaseOutputs(index);
       }
     }
 
-    processNodes.erase(it);
-  }
+    if (tasksInFlight > 0) {
+      std::vector<FinishedNode> finishedNodes;
+
+      {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return !mFinishedParallelNodes.empty(); });
+        finishedNodes.swap(mFinishedParallelNodes);
+      }
 
-  mDirtyNodes.clear();
+      for (auto const& node : finishedNodes) {
+        --tasksInFlight;
+        recordTiming(node);
+        releaseOutputs(mNodeIndices.at(node.mID));
+      }
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -257,30 +445,141 @@ void NodeGraph::handleNodeMessage(uint32_t toNode, nlohmann::json const& message
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::vector<uint32_t> NodeGraph::getOutputNodes(uint32_t node) const {
-  std::vector<uint32_t> result;
+void NodeGraph::updateTopology() {
+
+  // We use Kahn's algorithm for the topological sorting: First, we add all nodes without inputs.
+  // Then, we add each node once all of its input nodes have been added. For this, the nodes are
+  // first referred to by their index in this temporary list.
+  std::vector<uint32_t>                  ids;
+  std::unordered_map<uint32_t, uint32_t> indices;
+
+  for (auto const& [id, node] : mNodes) {
+    indices[id] = static_cast<uint32_t>(ids.size());
+    ids.push_back(id);
+  }
+
+  std::vector<std::vector<uint32_t>> outputs(ids.size());
+  std::vector<uint32_t>              inputCounts(ids.size(), 0);
 
   for (auto const& c : mConnections) {
-    if (c.mFromNode == node) {
-      result.push_back(c.mToNode);
+    auto from = indices.find(c.mFromNode);
+    auto to   = indices.find(c.mToNode);
+
+    // Connections to removed nodes are ignored. Multiple connections between the same nodes are
+    // only counted once.
+    if (from == indices.end() || to == indices.end() ||
+        std::find(outputs[from->second].begin(), outputs[from->second].end(), to->second) !=
+            outputs[from->second].end()) {
+      continue;
     }
+
+    outputs[from->second].push_back(to->second);
+    ++inputCounts[to->second];
   }
 
-  return result;
+  std::vector<uint32_t> order;
+  order.reserve(ids.size());
+
+  for (uint32_t i = 0; i < ids.size(); ++i) {
+    if (inputCounts[i] == 0) {
+      order.push_back(i);
+    }
+  }
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    for (uint32_t output : outputs[order[i]]) {
+      if (--inputCounts[output] == 0) {
+        order.push_back(output);
+      }
+    }
+  }
+
+  // If some nodes could not be added, their inputs depend on each other.
+  if (order.size() < ids.size()) {
+    throw std::runtime_error("Cycle detected!");
+  }
+
+  // Now store the sorted node IDs and refer to the output nodes by their sorted index.
+  std::vector<uint32_t> sortedIndices(ids.size());
+  for (uint32_t i = 0; i < order.size(); ++i) {
+    sortedIndices[order[i]] = i;
+  }
+
+  mSortedNodes.resize(ids.size());
+  mOutputIndices.resize(ids.size());
+  mNodeIndices.clear();
+
+  for (uint32_t i = 0; i < order.size(); ++i) {
+    mSortedNodes[i] = ids[order[i]];
+    mNodeIndices[mSortedNodes[i]] = i;
+
+    mOutputIndices[i].clear();
+    for (uint32_t output : outputs[order[i]]) {
+      mOutputIndices[i].push_back(sortedIndices[output]);
+    }
+  }
+
+  mTopologyDirty = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::vector<uint32_t> NodeGraph::getInputNodes(uint32_t node) const {
-  std::vector<uint32_t> result;
+void NodeGraph::runNode(uint32_t id, Node& node) {
+  try {
+    node.process();
+  } catch (std::exception const& e) {
+    logger().error("Failed to process node '{}' ({}): {}", node.getName(), id, e.what());
+  } catch (...) {
+    logger().error("Failed to process node '{}' ({}): Unknown error!", node.getName(), id);
+  }
+}
 
-  for (auto const& c : mConnections) {
-    if (c.mToNode == node) {
-      result.push_back(c.mFromNode);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NodeGraph::enqueueNode(uint32_t index, bool async) {
+  if (!mThreadPool) {
+    mThreadPool = std::make_unique<cs::utils::ThreadPool>(mThreadCount);
+  }
+
+  uint32_t id = mSortedNodes[index];
+
+  // The task keeps a reference to the node, so it stays alive even if it is removed from the graph
+  // while it is running.
+  mThreadPool->enqueue([this, id, async, node = mNodes.at(id)]() {
+    FinishedNode finished{id, getTimestamp(), 0};
+    runNode(id, *node);
+    finished.mEnd = getTimestamp();
+
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      (async ? mFinishedAsyncNodes : mFinishedParallelNodes).push_back(finished);
+    }
+
+    mCondition.notify_one();
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NodeGraph::releaseOutputs(uint32_t index) {
+  for (uint32_t output : mOutputIndices[index]) {
+    ScheduleEntry& entry = mSchedule[output];
+
+    if (--entry.mPendingInputs == 0) {
+      mReadyNodes.push_back(output);
     }
   }
+}
 
-  return result;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void NodeGraph::recordTiming(FinishedNode const& node) const {
+  auto& frameStats = cs::utils::FrameStats::get();
+  auto  it         = mNodes.find(node.mID);
+
+  if (frameStats.pEnableMeasurements.get() && it != mNodes.end()) {
+    frameStats.addCPUTimerRange(getTimerName(node.mID, *it->second), node.mStart, node.mEnd);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
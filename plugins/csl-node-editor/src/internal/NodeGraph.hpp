@@ -12,14 +12,20 @@
 
 #include "NodeConnection.hpp"
 
+#include <condition_variable>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+namespace cs::utils {
+class ThreadPool;
+} // namespace cs::utils
+
 namespace csl::nodeeditor {
 
 class Node;
@@ -27,6 +33,11 @@ class Node;
 /// This class keeps track of the nodes and their connections. It is used by the NodeEditor and the
 /// Node base class. When implementing custom nodes, you usually will not have to work with this
 /// class directly. Use the methods of the Node class instead.
+///
+/// The nodes are processed in topological order. This order is cached and only recomputed when
+/// nodes or connections are added or removed. Nodes which allow it (see Node::getExecutionMode())
+/// are processed on a thread pool, so that independent nodes can run in parallel. If frame timing
+/// measurements are enabled, the processing time of each node is recorded in the FrameStats.
 class CSL_NODE_EDITOR_EXPORT NodeGraph {
  public:
   // These need to be declared explicitly as the default versions would be defined inline which
@@ -39,7 +50,7 @@ class CSL_NODE_EDITOR_EXPORT NodeGraph {
 
   /// This will force the given node to be processed during the next call to process(). There is
   /// usually no need to call this directly, as it is done by the Node base class whenever an output
-  /// is written.
+  /// is written. This can be called from any thread.
   /// @param node The ID of the node which should be processed.
   void queueProcess(uint32_t node);
 
@@ -51,6 +62,11 @@ class CSL_NODE_EDITOR_EXPORT NodeGraph {
   // The methods below are primarily meant to be used by the Node base class. Usually, you should
   // not have to call them directly.
 
+  /// As nodes may be processed on worker threads, the connections and the data stored in them must
+  /// only be accessed while holding this lock.
+  /// @return A lock on the connections of this graph.
+  std::unique_lock<std::mutex> lockConnections() const;
+
   /// Gets a connection which is connected to a given input socket. There can be at most one
   /// connection *to* a socket.
   /// @param toNode   The ID of the node.
@@ -83,7 +99,9 @@ class CSL_NODE_EDITOR_EXPORT NodeGraph {
 
   /// Calls process() on all nodes which need a reprocessing. This could be due to changed input
   /// values, dropped input connections, new output connections, or due to the entire graph needing
-  /// a reprocessing because a new web client connected.
+  /// a reprocessing because a new web client connected. This returns once all nodes have been
+  /// processed, except for asynchronous nodes which may still be running. Once they have finished,
+  /// the nodes depending on them will be processed during a later call.
   void process();
 
   /// Adds a new node to the graph. This is called by the NodeEditor class whenever the user adds a
@@ -137,17 +155,74 @@ class CSL_NODE_EDITOR_EXPORT NodeGraph {
   void clear();
 
  private:
-  // Returns all nodes which are currently connected to an output socket of the given node.
-  std::vector<uint32_t> getOutputNodes(uint32_t node) const;
-
-  // Returns all nodes which are currently connected to an input socket of the given node.
-  std::vector<uint32_t> getInputNodes(uint32_t node) const;
+  /// A node which has been processed on a worker thread. The timestamps are in nanoseconds.
+  struct FinishedNode {
+    uint32_t mID;
+    int64_t  mStart;
+    int64_t  mEnd;
+  };
+
+  /// This is used by process() to keep track of the state of each node. The vector mSchedule has
+  /// one entry for each node in mSortedNodes.
+  struct ScheduleEntry {
+    bool     mAffected      = false; ///< The node or one of its input nodes is dirty.
+    uint32_t mPendingInputs = 0;     ///< The number of input nodes which are yet to be processed.
+  };
+
+  // Sorts all nodes topologically and stores the result in mSortedNodes, mNodeIndices, and
+  // mOutputIndices. Throws a std::runtime_error if the graph contains a cycle.
+  void updateTopology();
+
+  // Calls process() on the given node. Any exceptions are caught and logged. This is thread-safe.
+  static void runNode(uint32_t id, Node& node);
+
+  // Runs the node with the given index in mSortedNodes on the thread pool. Once finished, it is
+  // added to mFinishedParallelNodes or mFinishedAsyncNodes.
+  void enqueueNode(uint32_t index, bool async);
+
+  // Marks the given node as processed for all of its output nodes. Output nodes which have no more
+  // pending inputs are appended to mReadyNodes.
+  void releaseOutputs(uint32_t index);
+
+  // Records the processing time of a node which ran on a worker thread in the FrameStats.
+  void recordTiming(FinishedNode const& node) const;
 
   // Actually, this map should store unique pointers to the nodes. However, for some reason MSVC
   // does not like this...
   std::unordered_map<uint32_t, std::shared_ptr<Node>> mNodes;
-  std::unordered_set<uint32_t>                        mDirtyNodes;
   std::list<NodeConnection>                           mConnections;
+  mutable std::mutex                                  mConnectionsMutex;
+
+  // The connections in mConnections, indexed by the node they lead to and by the node they come
+  // from. These are updated whenever a connection is added or removed.
+  std::unordered_map<uint32_t, std::vector<NodeConnection const*>> mInputConnections;
+  std::unordered_map<uint32_t, std::vector<NodeConnection const*>> mOutputConnections;
+
+  // The cached topological order of all nodes. The other two members refer to the nodes by their
+  // index in mSortedNodes. The cache is invalidated whenever nodes or connections change.
+  std::vector<uint32_t>                  mSortedNodes;
+  std::unordered_map<uint32_t, uint32_t> mNodeIndices;
+  std::vector<std::vector<uint32_t>>     mOutputIndices;
+  bool                                   mTopologyDirty = true;
+
+  // These are only used during process(). They are stored here so that their memory can be reused.
+  std::vector<ScheduleEntry> mSchedule;
+  std::vector<uint32_t>      mReadyNodes;
+
+  // The asynchronous nodes which have been started but not yet collected by process().
+  std::unordered_set<uint32_t> mRunningNodes;
+
+  // These are accessed by the worker threads and are protected by mMutex.
+  std::unordered_set<uint32_t> mDirtyNodes;
+  std::vector<FinishedNode>    mFinishedParallelNodes;
+  std::vector<FinishedNode>    mFinishedAsyncNodes;
+  std::mutex                   mMutex;
+  std::condition_variable      mCondition;
+
+  // The thread pool is created once the first node needs to be run on a worker thread. It has to be
+  // the last member, so that it is destroyed (and waits for all tasks) before all other members.
+  uint32_t                               mThreadCount = 1;
+  std::unique_ptr<cs::utils::ThreadPool> mThreadPool;
 };
 
 } // namespace csl::nodeeditor
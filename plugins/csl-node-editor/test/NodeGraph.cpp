@@ -0,0 +1,268 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "../src/internal/NodeGraph.hpp"
+#include "../../../src/cs-utils/doctest.hpp"
+#include "../src/Node.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace csl::nodeeditor {
+
+namespace {
+
+// Writes a constant value to its output.
+class SourceNode : public Node {
+ public:
+  explicit SourceNode(int value)
+      : mValue(value) {
+  }
+
+  std::string const& getName() const override {
+    return sName;
+  }
+
+  void process() override {
+    writeOutput("out", mValue.load());
+  }
+
+  static inline const std::string sName = "Source";
+
+  std::atomic<int> mValue;
+};
+
+// Writes the sum of its two inputs to its output. Each call to process() takes the given time, so
+// that it can be checked whether several nodes run concurrently.
+class AddNode : public Node {
+ public:
+  AddNode(ExecutionMode mode, std::chrono::milliseconds duration)
+      : mMode(mode)
+      , mDuration(duration) {
+  }
+
+  std::string const& getName() const override {
+    return sName;
+  }
+
+  ExecutionMode getExecutionMode() const override {
+    return mMode;
+  }
+
+  void process() override {
+    int running = ++sRunning;
+    int maximum = sMaxRunning.load();
+    while (running > maximum && !sMaxRunning.compare_exchange_weak(maximum, running)) {
+    }
+
+    std::this_thread::sleep_for(mDuration);
+    ++mCalls;
+    --sRunning;
+
+    writeOutput("out", readInput("a", 0) + readInput("b", 0));
+  }
+
+  static inline const std::string sName = "Add";
+
+  static inline std::atomic<int> sRunning{0};
+  static inline std::atomic<int> sMaxRunning{0};
+
+  ExecutionMode             mMode;
+  std::chrono::milliseconds mDuration;
+  std::atomic<int>          mCalls{0};
+};
+
+// Stores the value of its input. This is always processed on the main thread.
+class SinkNode : public Node {
+ public:
+  std::string const& getName() const override {
+    return sName;
+  }
+
+  void process() override {
+    mValue = readInput("a", -1);
+    ++mCalls;
+  }
+
+  static inline const std::string sName = "Sink";
+
+  int mValue = -1;
+  int mCalls = 0;
+};
+
+// Throws whenever it is processed on a worker thread.
+class ThrowingNode : public Node {
+ public:
+  std::string const& getName() const override {
+    return sName;
+  }
+
+  ExecutionMode getExecutionMode() const override {
+    return ExecutionMode::eParallel;
+  }
+
+  void process() override {
+    throw std::runtime_error("Test exception");
+  }
+
+  static inline const std::string sName = "Throwing";
+};
+
+template <typename T, typename... Args>
+T* addNode(std::shared_ptr<NodeGraph> const& graph, uint32_t id, Args&&... args) {
+  auto node    = std::make_unique<T>(std::forward<Args>(args)...);
+  T*   pointer = node.get();
+  node->setID(id);
+  node->setGraph(graph);
+  graph->addNode(id, std::move(node));
+  return pointer;
+}
+
+// Calls process() once per "frame" until the given condition is met, but for at most two seconds.
+template <typename F>
+bool processUntil(NodeGraph& graph, F const& condition) {
+  auto start = std::chrono::steady_clock::now();
+
+  while (std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+    graph.process();
+    if (condition()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  return false;
+}
+
+} // namespace
+
+TEST_CASE("csl::nodeeditor::NodeGraph") {
+  using namespace std::chrono_literals;
+
+  auto graph = std::make_shared<NodeGraph>();
+
+  SUBCASE("Parallel fan-out") {
+    // Two expensive nodes depend on the same sources, a third one combines their results.
+    addNode<SourceNode>(graph, 1, 1);
+    addNode<SourceNode>(graph, 2, 2);
+    auto* left   = addNode<AddNode>(graph, 3, Node::ExecutionMode::eParallel, 50ms);
+    auto* right  = addNode<AddNode>(graph, 4, Node::ExecutionMode::eParallel, 50ms);
+    auto* result = addNode<AddNode>(graph, 5, Node::ExecutionMode::eMainThread, 0ms);
+    auto* sink   = addNode<SinkNode>(graph, 6);
+
+    graph->addConnection(1, "out", 3, "a");
+    graph->addConnection(2, "out", 3, "b");
+    graph->addConnection(2, "out", 4, "a");
+    graph->addConnection(3, "out", 5, "a");
+    graph->addConnection(4, "out", 5, "b");
+    graph->addConnection(5, "out", 6, "a");
+
+    AddNode::sMaxRunning = 0;
+    graph->queueProcess();
+    graph->process();
+
+    // Parallel nodes are finished once process() returns.
+    CHECK_EQ(sink->mValue, 5);
+    CHECK_EQ(left->mCalls, 1);
+    CHECK_EQ(right->mCalls, 1);
+    CHECK_EQ(result->mCalls, 1);
+    CHECK_EQ(sink->mCalls, 1);
+
+    // The graph leaves one core to the main thread, so there is more than one worker only if
+    // there are at least three cores.
+    if (std::thread::hardware_concurrency() >= 3) {
+      CHECK_EQ(AddNode::sMaxRunning, 2);
+    }
+
+    // Nothing is processed if nothing changed.
+    graph->process();
+    CHECK_EQ(sink->mCalls, 1);
+  }
+
+  SUBCASE("Asynchronous nodes across frames") {
+    auto* source = addNode<SourceNode>(graph, 1, 1);
+    auto* async  = addNode<AddNode>(graph, 2, Node::ExecutionMode::eAsync, 100ms);
+    auto* sink   = addNode<SinkNode>(graph, 3);
+
+    graph->addConnection(1, "out", 2, "a");
+    graph->addConnection(2, "out", 3, "a");
+
+    // The first call starts the asynchronous node, but does not wait for it.
+    graph->process();
+    CHECK_EQ(sink->mCalls, 0);
+
+    // Queuing a running node again does not start it twice.
+    graph->queueProcess(2);
+    graph->process();
+    CHECK(async->mCalls <= 1);
+
+    // The dependent node is processed in a later frame.
+    CHECK(processUntil(*graph, [&]() { return sink->mValue == 1; }));
+
+    // The node has been queued while it was running, so it runs once more afterwards.
+    CHECK(processUntil(*graph, [&]() { return async->mCalls == 2; }));
+
+    // A new input value is propagated as well.
+    source->mValue = 5;
+    graph->queueProcess(1);
+    CHECK(processUntil(*graph, [&]() { return sink->mValue == 5; }));
+  }
+
+  SUBCASE("Removing a running node") {
+    addNode<SourceNode>(graph, 1, 1);
+    addNode<AddNode>(graph, 2, Node::ExecutionMode::eAsync, 100ms);
+    auto* sink = addNode<SinkNode>(graph, 3);
+
+    graph->addConnection(1, "out", 2, "a");
+    graph->addConnection(2, "out", 3, "a");
+
+    graph->process();
+    graph->removeConnection(2, "out", 3, "a");
+    graph->removeConnection(1, "out", 2, "a");
+    graph->removeNode(2);
+
+    // The removed node finishes in the background, its outputs must not reach any other node.
+    std::this_thread::sleep_for(150ms);
+    graph->process();
+    graph->process();
+    CHECK_EQ(sink->mValue, -1);
+  }
+
+  SUBCASE("Exceptions in worker threads") {
+    addNode<SourceNode>(graph, 1, 1);
+    addNode<ThrowingNode>(graph, 2);
+    auto* sink = addNode<SinkNode>(graph, 3);
+
+    graph->addConnection(1, "out", 2, "a");
+    graph->addConnection(1, "out", 3, "a");
+
+    // The exception is logged, the other nodes are processed nevertheless.
+    graph->process();
+    CHECK_EQ(sink->mValue, 1);
+
+    // The failed node does not block later frames.
+    graph->queueProcess(2);
+    graph->process();
+  }
+
+  SUBCASE("Cycles") {
+    addNode<AddNode>(graph, 1, Node::ExecutionMode::eMainThread, 0ms);
+    addNode<AddNode>(graph, 2, Node::ExecutionMode::eMainThread, 0ms);
+
+    graph->addConnection(1, "out", 2, "a");
+    graph->addConnection(2, "out", 1, "a");
+    CHECK_THROWS_AS(graph->process(), std::runtime_error);
+
+    // Once the cycle is removed, the graph can be processed again.
+    graph->removeConnection(2, "out", 1, "a");
+    CHECK_NOTHROW(graph->process());
+  }
+}
+
+} // namespace csl::nodeeditor
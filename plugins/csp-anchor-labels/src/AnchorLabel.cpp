@@ -186,8 +186,11 @@ double AnchorLabel::distanceToCamera() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void AnchorLabel::setSortKey(int key) const {
-  VistaOpenSGMaterialTools::SetSortKeyOnSubtree(mGuiTransform.get(), key);
+void AnchorLabel::setSortKey(int key) {
+  if (key != mSortKey) {
+    VistaOpenSGMaterialTools::SetSortKeyOnSubtree(mGuiTransform.get(), key);
+    mSortKey = key;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -56,7 +56,8 @@ class AnchorLabel {
   double bodySize() const;
   double distanceToCamera() const;
 
-  void setSortKey(int key) const;
+  /// The sort key is only applied to the scene graph if it differs from the previous one.
+  void setSortKey(int key);
 
   void enable() const;
   void disable() const;
@@ -78,6 +79,7 @@ class AnchorLabel {
   std::unique_ptr<VistaTransformNode>         mGuiTransform;
 
   glm::dvec3 mRelativeAnchorPosition{};
+  int        mSortKey          = -1;
   int        mOffsetConnection = -1;
 };
 } // namespace csp::anchorlabels
@@ -15,6 +15,7 @@
 #include "../../../src/cs-utils/utils.hpp"
 #include "logger.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +36,17 @@ namespace csp::anchorlabels {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// Returns false if any component of the given screen-space bounding box is NaN or infinite.
+bool isFinite(glm::dvec4 const& box) {
+  return !glm::any(glm::isnan(box)) && !glm::any(glm::isinf(box));
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void from_json(nlohmann::json const& j, Plugin::Settings& o) {
   cs::core::Settings::deserialize(j, "enabled", o.mEnabled);
   cs::core::Settings::deserialize(j, "enableDepthOverlap", o.mEnableDepthOverlap);
@@ -145,62 +157,45 @@ void Plugin::update() {
       mNeedsResort = false;
     }
 
-    for (auto&& label : mAnchorLabels) {
+    // Gather all visible labels. As mAnchorLabels is sorted by body size, so are the candidates.
+    mCandidates.clear();
+    for (size_t i = 0; i < mAnchorLabels.size(); ++i) {
+      auto const& label = mAnchorLabels[i];
       label->update();
-    }
 
-    std::unordered_set<AnchorLabel*> labelsToDraw;
-    for (auto const& label : mAnchorLabels) {
       if (label->shouldBeHidden()) {
         continue;
       }
 
-      glm::dvec4 A             = label->getScreenSpaceBB();
-      double     distToCameraA = label->distanceToCamera();
-
-      bool canBeAdded = true;
-      for (auto&& drawLabel : labelsToDraw) {
-        if (mPluginSettings->mEnableDepthOverlap.get()) {
-          // Check the distance relative to each other. If they are far apart we can display both.
-          double distToCameraB    = drawLabel->distanceToCamera();
-          double relativeDistance = distToCameraA < distToCameraB ? distToCameraB / distToCameraA
-                                                                  : distToCameraA / distToCameraB;
-          if (relativeDistance > 1 + mPluginSettings->mIgnoreOverlapThreshold.get()) {
-            continue;
-          }
-        }
+      mCandidates.push_back({label.get(), i, label->getScreenSpaceBB(), label->distanceToCamera()});
+    }
 
-        // Check if they are colliding. If they collide the bigger label survives. Since the list
-        // is sorted by body size, it is assured that the bigger label gets displayed.
-        glm::dvec4 B   = drawLabel->getScreenSpaceBB();
-        bool collision = B.x + B.z > A.x && B.y + B.w > A.y && A.x + A.z > B.x && A.y + A.w > B.y;
-        if (collision) {
-          canBeAdded = false;
-          break;
-        }
-      }
+    declutter();
 
-      if (canBeAdded) {
-        labelsToDraw.insert(label.get());
-      }
+    mIsDrawn.assign(mAnchorLabels.size(), false);
+    for (auto const& candidate : mLabelsToDraw) {
+      mIsDrawn[candidate.mIndex] = true;
     }
 
-    for (auto&& label : mAnchorLabels) {
-      if (labelsToDraw.find(label.get()) != labelsToDraw.end()) {
-        label->enable();
+    for (size_t i = 0; i < mAnchorLabels.size(); ++i) {
+      if (mIsDrawn[i]) {
+        mAnchorLabels[i]->enable();
       } else {
-        label->disable();
+        mAnchorLabels[i]->disable();
       }
     }
 
-    std::vector<AnchorLabel*> sortedLabels(labelsToDraw.begin(), labelsToDraw.end());
-    std::sort(sortedLabels.begin(), sortedLabels.end(), [](AnchorLabel* a, AnchorLabel* b) {
-      return a->distanceToCamera() < b->distanceToCamera();
-    });
+    std::sort(mLabelsToDraw.begin(), mLabelsToDraw.end(),
+        [](Candidate const& a, Candidate const& b) { return a.mDistance < b.mDistance; });
+
+    // The labels are drawn from back to front, the closest one with the sort key of the transparent
+    // items. All other keys are between the non-HDR opaque items and the transparent items. If
+    // there are more labels than keys in this range, the most distant ones share the lowest key.
+    int const minKey = static_cast<int>(cs::utils::DrawOrder::eOpaqueNonHDR) + 1;
+    int const maxKey = static_cast<int>(cs::utils::DrawOrder::eTransparentItems);
 
-    for (int i = 0; i < static_cast<int>(sortedLabels.size()); ++i) {
-      // a little bit hacky... It probably breaks, when more than 100 labels are present.
-      sortedLabels[i]->setSortKey(static_cast<int>(cs::utils::DrawOrder::eTransparentItems) - i);
+    for (int i = 0; i < static_cast<int>(mLabelsToDraw.size()); ++i) {
+      mLabelsToDraw[i].mLabel->setSortKey(std::max(maxKey - i, minKey));
     }
   } else {
     for (auto&& label : mAnchorLabels) {
@@ -211,6 +206,78 @@ void Plugin::update() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void Plugin::declutter() {
+  mLabelsToDraw.clear();
+
+  if (mCandidates.empty()) {
+    return;
+  }
+
+  // The grid cells are chosen to be as large as the median label. This way, most labels cover at
+  // most four cells and only a few other labels have to be tested for each candidate. A few very
+  // long labels only cover some more cells, but do not make the cells coarser for all others.
+  glm::dvec2 cellSize(0.0);
+
+  for (int axis = 0; axis < 2; ++axis) {
+    mBoxSizes.clear();
+    for (auto const& candidate : mCandidates) {
+      if (isFinite(candidate.mBox)) {
+        mBoxSizes.push_back(candidate.mBox[2 + axis]);
+      }
+    }
+
+    if (mBoxSizes.empty()) {
+      continue;
+    }
+
+    auto median = mBoxSizes.begin() + static_cast<std::ptrdiff_t>(mBoxSizes.size() / 2);
+    std::nth_element(mBoxSizes.begin(), median, mBoxSizes.end());
+    cellSize[axis] = *median;
+  }
+
+  mGrid.reset(cellSize, mCandidates.size());
+
+  bool   enableDepthOverlap = mPluginSettings->mEnableDepthOverlap.get();
+  double maxRelativeDist    = 1.0 + mPluginSettings->mIgnoreOverlapThreshold.get();
+
+  for (auto const& candidate : mCandidates) {
+    glm::dvec4 const& A = candidate.mBox;
+
+    // Anchors in the camera plane have no valid screen-space position. Their labels never collide
+    // with any other label, so they are drawn but not inserted into the grid.
+    if (!isFinite(A)) {
+      mLabelsToDraw.push_back(candidate);
+      continue;
+    }
+
+    bool collision = mGrid.findAny(A, [&](uint32_t id) {
+      Candidate const& other = mLabelsToDraw[id];
+
+      if (enableDepthOverlap) {
+        // Check the distance relative to each other. If they are far apart we can display both.
+        double relativeDistance = candidate.mDistance < other.mDistance
+                                      ? other.mDistance / candidate.mDistance
+                                      : candidate.mDistance / other.mDistance;
+        if (relativeDistance > maxRelativeDist) {
+          return false;
+        }
+      }
+
+      // Check if they are colliding. If they collide the bigger label survives. Since the
+      // candidates are sorted by body size, it is assured that the bigger label gets displayed.
+      glm::dvec4 const& B = other.mBox;
+      return B.x + B.z > A.x && B.y + B.w > A.y && A.x + A.z > B.x && A.y + A.w > B.y;
+    });
+
+    if (!collision) {
+      mGrid.insert(static_cast<uint32_t>(mLabelsToDraw.size()), A);
+      mLabelsToDraw.push_back(candidate);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void Plugin::deInit() {
   logger().info("Unloading plugin...");
 
@@ -11,6 +11,8 @@
 #include "../../../src/cs-core/PluginBase.hpp"
 #include "../../../src/cs-core/Settings.hpp"
 #include "../../../src/cs-utils/Property.hpp"
+#include "ScreenSpaceGrid.hpp"
+
 #include <memory>
 #include <unordered_set>
 
@@ -58,14 +60,35 @@ class Plugin : public cs::core::PluginBase {
   void update() override;
 
  private:
+  /// A visible label together with the data required for decluttering. This is gathered once per
+  /// frame so that it does not have to be recomputed for each overlap test.
+  struct Candidate {
+    AnchorLabel* mLabel;
+    size_t       mIndex;    ///< The index of the label in mAnchorLabels.
+    glm::dvec4   mBox;      ///< The screen-space bounding box.
+    double       mDistance; ///< The distance to the camera.
+  };
+
   void onLoad();
   void onSave();
 
+  /// Selects the labels which should be drawn this frame. The candidates are processed in order,
+  /// a label is accepted if it does not collide with any previously accepted label. Accepted labels
+  /// are stored in mLabelsToDraw.
+  void declutter();
+
   std::shared_ptr<Settings>                 mPluginSettings = std::make_shared<Settings>();
   std::vector<std::unique_ptr<AnchorLabel>> mAnchorLabels;
 
   bool mNeedsResort = true; ///< When a new label gets added resort the vector
 
+  // These are only used in update() but are stored here in order to reuse their memory.
+  ScreenSpaceGrid        mGrid;
+  std::vector<Candidate> mCandidates;
+  std::vector<Candidate> mLabelsToDraw;
+  std::vector<bool>      mIsDrawn;
+  std::vector<double>    mBoxSizes;
+
   int mAddObjectConnection    = -1;
   int mRemoveObjectConnection = -1;
   int mOnLoadConnection       = -1;
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "ScreenSpaceGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace csp::anchorlabels {
+
+namespace {
+
+// Cell coordinates are clamped to this range, so that they can be safely converted to integers.
+constexpr double MAX_CELL = 1073741824.0;
+
+// Each box touches up to four cells. With this many buckets per box, most buckets contain at most
+// one box.
+constexpr size_t BUCKETS_PER_BOX = 4;
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ScreenSpaceGrid::reset(glm::dvec2 const& cellSize, size_t boxCount) {
+  mCellSize = glm::max(cellSize, glm::dvec2(std::numeric_limits<double>::min()));
+
+  // The bucket count is a power of two, so that the hash can be reduced with a bit mask.
+  mBucketCount = 1;
+  while (mBucketCount < boxCount * BUCKETS_PER_BOX) {
+    mBucketCount *= 2;
+  }
+
+  if (mBuckets.size() < mBucketCount) {
+    mBuckets.resize(mBucketCount);
+  }
+
+  // Only clear the buckets but keep their memory. Buckets which are not needed this frame are kept
+  // as well, they will be required again once there are more labels again.
+  for (auto& bucket : mBuckets) {
+    bucket.clear();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ScreenSpaceGrid::insert(uint32_t id, glm::dvec4 const& box) {
+  forEachBucket(box, [&](size_t bucket) {
+    mBuckets[bucket].push_back(id);
+    return false;
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ScreenSpaceGrid::CellRange ScreenSpaceGrid::getCellRange(glm::dvec4 const& box) const {
+
+  // Clamp in floating point first, casting out-of-range values to an integer would be undefined.
+  auto toCell = [](double value) {
+    return static_cast<int64_t>(std::clamp(std::floor(value), -MAX_CELL, MAX_CELL));
+  };
+
+  return {toCell(box.x / mCellSize.x), toCell(box.y / mCellSize.y),
+      toCell((box.x + box.z) / mCellSize.x), toCell((box.y + box.w) / mCellSize.y)};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t ScreenSpaceGrid::getBucket(int64_t x, int64_t y) const {
+  // The hash function from "Optimized Spatial Hashing for Collision Detection of Deformable
+  // Objects" by Teschner et al.
+  uint64_t hash =
+      (static_cast<uint64_t>(x) * 73856093ULL) ^ (static_cast<uint64_t>(y) * 19349663ULL);
+  return static_cast<size_t>(hash & (mBucketCount - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace csp::anchorlabels
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CSP_ANCHOR_LABELS_SCREEN_SPACE_GRID_HPP
+#define CSP_ANCHOR_LABELS_SCREEN_SPACE_GRID_HPP
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace csp::anchorlabels {
+
+/// A hashed grid which is used to quickly find screen-space bounding boxes which may overlap a
+/// given box. Boxes are given as {x, y, width, height}, like AnchorLabel::getScreenSpaceBB()
+/// returns them. The plane is divided into cells of a fixed size, and each cell is mapped to one of
+/// several buckets with a hash function. Each inserted box is referenced by an ID in the buckets
+/// of all cells it touches; if the cells are at least as large as the box, these are at most four.
+///
+/// As the grid does not have to cover the bounding box of all labels, labels which are far away
+/// from all others (for example because their anchor is almost in the camera plane) do not make
+/// the cells coarser. Coordinates which are not finite are not supported.
+///
+/// The grid is meant to be reset and refilled every frame. The buckets keep their memory in
+/// between, so no allocations happen once the number of labels is stable.
+class ScreenSpaceGrid {
+ public:
+  /// Removes all boxes and sets the size of the cells. The number of buckets is chosen so that
+  /// about boxCount boxes can be inserted without many of them sharing a bucket.
+  void reset(glm::dvec2 const& cellSize, size_t boxCount);
+
+  /// Adds a box with the given ID.
+  void insert(uint32_t id, glm::dvec4 const& box);
+
+  /// Calls the given predicate with the ID of each inserted box which shares a bucket with the
+  /// given box until it returns true. The predicate may be called several times for the same ID
+  /// and also for boxes which are far away, so it has to check the overlap itself. Returns true if
+  /// the predicate returned true for any ID.
+  template <typename F>
+  bool findAny(glm::dvec4 const& box, F const& predicate) const {
+    return forEachBucket(box, [&](size_t bucket) {
+      for (uint32_t id : mBuckets[bucket]) {
+        if (predicate(id)) {
+          return true;
+        }
+      }
+      return false;
+    });
+  }
+
+ private:
+  /// The first and last cell covered by a box.
+  struct CellRange {
+    int64_t mMinX;
+    int64_t mMinY;
+    int64_t mMaxX;
+    int64_t mMaxY;
+  };
+
+  CellRange getCellRange(glm::dvec4 const& box) const;
+
+  size_t getBucket(int64_t x, int64_t y) const;
+
+  /// Calls the given visitor with the index of each bucket the given box touches until it returns
+  /// true. Boxes which touch more cells than there are buckets simply visit all buckets once.
+  template <typename F>
+  bool forEachBucket(glm::dvec4 const& box, F const& visitor) const {
+    CellRange range = getCellRange(box);
+
+    if ((range.mMaxX - range.mMinX + 1) * (range.mMaxY - range.mMinY + 1) >=
+        static_cast<int64_t>(mBucketCount)) {
+      for (size_t bucket = 0; bucket < mBucketCount; ++bucket) {
+        if (visitor(bucket)) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    for (int64_t y = range.mMinY; y <= range.mMaxY; ++y) {
+      for (int64_t x = range.mMinX; x <= range.mMaxX; ++x) {
+        if (visitor(getBucket(x, y))) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  std::vector<std::vector<uint32_t>> mBuckets{1};
+  size_t                             mBucketCount = 1;
+  glm::dvec2                         mCellSize{1.0, 1.0};
+};
+
+} // namespace csp::anchorlabels
+
+#endif // CSP_ANCHOR_LABELS_SCREEN_SPACE_GRID_HPP
@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "../src/ScreenSpaceGrid.hpp"
+#include "../../../src/cs-utils/doctest.hpp"
+
+namespace csp::anchorlabels {
+
+namespace {
+
+bool overlap(glm::dvec4 const& a, glm::dvec4 const& b) {
+  return b.x + b.z > a.x && b.y + b.w > a.y && a.x + a.z > b.x && a.y + a.w > b.y;
+}
+
+// Inserts all boxes which do not overlap any previously inserted box, just like
+// Plugin::declutter() does. Returns the accepted boxes and the number of overlap tests.
+std::vector<glm::dvec4> declutter(
+    ScreenSpaceGrid& grid, std::vector<glm::dvec4> const& boxes, size_t& tests) {
+  std::vector<glm::dvec4> accepted;
+
+  for (auto const& box : boxes) {
+    bool collision = grid.findAny(box, [&](uint32_t id) {
+      ++tests;
+      return overlap(box, accepted[id]);
+    });
+
+    if (!collision) {
+      grid.insert(static_cast<uint32_t>(accepted.size()), box);
+      accepted.push_back(box);
+    }
+  }
+
+  return accepted;
+}
+
+// Creates a regular layout of non-overlapping labels with the given size and a few labels whose
+// anchors are almost in the camera plane and hence have huge screen-space coordinates.
+std::vector<glm::dvec4> createLabels(size_t count, glm::dvec2 const& size) {
+  std::vector<glm::dvec4> boxes;
+
+  for (size_t i = 0; i < count; ++i) {
+    boxes.emplace_back(static_cast<double>(i % 100) * 2.0 * size.x,
+        static_cast<double>(i / 100) * 2.0 * size.y, size.x, size.y);
+  }
+
+  boxes.emplace_back(1e12, -1e15, size.x, size.y);
+  boxes.emplace_back(-1e300, 1e300, size.x, size.y);
+
+  return boxes;
+}
+
+} // namespace
+
+TEST_CASE("csp::anchorlabels::ScreenSpaceGrid") {
+  ScreenSpaceGrid grid;
+  grid.reset(glm::dvec2(0.1, 0.05), 1000);
+
+  SUBCASE("Overlapping boxes") {
+    glm::dvec4 a(0.0, 0.0, 0.1, 0.05);
+    glm::dvec4 b(0.05, 0.02, 0.1, 0.05);
+    glm::dvec4 c(0.3, 0.0, 0.1, 0.05);
+
+    grid.insert(0, a);
+
+    auto isA = [&](uint32_t id) { return id == 0; };
+    CHECK(grid.findAny(b, isA));
+    CHECK_FALSE(grid.findAny(c, [&](uint32_t /*id*/) { return overlap(c, a); }));
+  }
+
+  SUBCASE("Boxes larger than the cells") {
+    glm::dvec4 small(1.0, 1.0, 0.1, 0.05);
+    glm::dvec4 large(-100.0, -100.0, 200.0, 200.0);
+
+    grid.insert(0, large);
+    CHECK(grid.findAny(small, [](uint32_t id) { return id == 0; }));
+
+    grid.reset(glm::dvec2(0.1, 0.05), 1000);
+    grid.insert(0, small);
+    CHECK(grid.findAny(large, [](uint32_t id) { return id == 0; }));
+  }
+
+  SUBCASE("Labels far away from all others") {
+    auto   boxes = createLabels(1000, glm::dvec2(0.1, 0.05));
+    size_t tests = 0;
+
+    auto accepted = declutter(grid, boxes, tests);
+    CHECK_EQ(accepted.size(), boxes.size());
+
+    // If the far away labels made the grid collapse to a few cells, each label would be tested
+    // against almost all others.
+    CHECK(tests < 4 * boxes.size());
+  }
+}
+
+} // namespace csp::anchorlabels
@@ -18,7 +18,6 @@
 #include "../../../src/cs-utils/FrameStats.hpp"
 #include "../../../src/cs-utils/filesystem.hpp"
 
-#include <VistaKernel/DisplayManager/VistaDisplayManager.h>
 #include <VistaKernel/GraphicsManager/VistaGroupNode.h>
 #include <VistaKernel/GraphicsManager/VistaOpenGLNode.h>
 #include <VistaKernel/GraphicsManager/VistaSceneGraph.h>
@@ -40,6 +39,7 @@ Atmosphere::Atmosphere(std::shared_ptr<Plugin::Settings> pluginSettings,
     , mAllSettings(std::move(allSettings))
     , mSolarSystem(std::move(solarSystem))
     , mGraphicsEngine(std::move(graphicsEngine))
+    , mSceneSnapshot(mGraphicsEngine->getSceneSnapshot())
     , mObjectName(std::move(objectName))
     , mEclipseShadowReceiver(
           std::make_shared<cs::core::EclipseShadowReceiver>(mAllSettings, mSolarSystem, false)) {
@@ -61,30 +61,6 @@ Atmosphere::Atmosphere(std::shared_ptr<Plugin::Settings> pluginSettings,
   mAtmosphereNode->SetIsEnabled(false);
   VistaOpenSGMaterialTools::SetSortKeyOnSubtree(
       mAtmosphereNode.get(), static_cast<int>(cs::utils::DrawOrder::eAtmospheres));
-
-  // Create depth and color buffer textures for each viewport. We need these to read the current
-  // values from the framebuffer.
-  for (auto const& viewport : GetVistaSystem()->GetDisplayManager()->GetViewports()) {
-    GBufferData bufferData;
-
-    bufferData.mDepthBuffer = std::make_unique<VistaTexture>(GL_TEXTURE_2D);
-    bufferData.mDepthBuffer->Bind();
-    bufferData.mDepthBuffer->SetWrapS(GL_CLAMP);
-    bufferData.mDepthBuffer->SetWrapT(GL_CLAMP);
-    bufferData.mDepthBuffer->SetMinFilter(GL_NEAREST);
-    bufferData.mDepthBuffer->SetMagFilter(GL_NEAREST);
-    bufferData.mDepthBuffer->Unbind();
-
-    bufferData.mColorBuffer = std::make_unique<VistaTexture>(GL_TEXTURE_2D);
-    bufferData.mColorBuffer->Bind();
-    bufferData.mColorBuffer->SetWrapS(GL_CLAMP);
-    bufferData.mColorBuffer->SetWrapT(GL_CLAMP);
-    bufferData.mColorBuffer->SetMinFilter(GL_NEAREST);
-    bufferData.mColorBuffer->SetMagFilter(GL_NEAREST);
-    bufferData.mColorBuffer->Unbind();
-
-    mGBufferData.emplace(viewport.second, std::move(bufferData));
-  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -197,7 +173,7 @@ void Atmosphere::updateShader() {
 
   // We bind the eclipse shadow map to texture unit 3. The color and depth buffer are bound to 0 and
   // 1, 2 is used for the cloud map.
-  mEclipseShadowReceiver->init(&mAtmoShader, 3);
+  mEclipseShadowReceiver->init(mAtmoShader.GetProgram(), 3);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -205,7 +181,11 @@ void Atmosphere::updateShader() {
 void Atmosphere::update(double time) {
   auto object = mSolarSystem->getObject(mObjectName);
 
-  if (object && object->getIsBodyVisible() && mPluginSettings->mEnable.get()) {
+  // Some models perform their pre-processing over several frames. The atmosphere is not drawn
+  // before they are done.
+  bool modelReady = mModel->update();
+
+  if (modelReady && object && object->getIsBodyVisible() && mPluginSettings->mEnable.get()) {
     mTime           = time;
     mSunIlluminance = mSolarSystem->getSunIlluminance(object->getObserverRelativePosition());
     mSunLuminance   = mSolarSystem->getSunLuminance();
@@ -265,22 +245,6 @@ bool Atmosphere::Do() {
   glEnable(GL_TEXTURE_2D);
   glDepthMask(GL_FALSE);
 
-  // copy depth buffer -------------------------------------------------------
-  if (!mHDRBuffer) {
-    std::array<GLint, 4> iViewport{};
-    glGetIntegerv(GL_VIEWPORT, iViewport.data());
-
-    auto* viewport   = GetVistaSystem()->GetDisplayManager()->GetCurrentRenderInfo()->m_pViewport;
-    auto const& data = mGBufferData[viewport];
-
-    data.mDepthBuffer->Bind();
-    glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, iViewport.at(0), iViewport.at(1),
-        iViewport.at(2), iViewport.at(3), 0);
-    data.mColorBuffer->Bind();
-    glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, iViewport.at(0), iViewport.at(1), iViewport.at(2),
-        iViewport.at(3), 0);
-  }
-
   // get matrices and related values -----------------------------------------
 
   std::array<GLfloat, 16> glMatV{};
@@ -323,18 +287,18 @@ bool Atmosphere::Do() {
   // The noise shader does not like huge numbers. So we rather loop the time.
   mAtmoShader.SetUniform(mUniforms.time, static_cast<float>(std::fmod(mTime, 1.0e4)));
 
+  // In HDR mode, we read from one ping-pong target and write to the other. Else, the depth and
+  // color are read from a copy of the framebuffer which is shared with all other atmospheres.
   if (mHDRBuffer) {
     mHDRBuffer->doPingPong();
     mHDRBuffer->bind();
-    mHDRBuffer->getDepthAttachment()->Bind(GL_TEXTURE0);
-    mHDRBuffer->getCurrentReadAttachment()->Bind(GL_TEXTURE1);
-  } else {
-    auto* viewport   = GetVistaSystem()->GetDisplayManager()->GetCurrentRenderInfo()->m_pViewport;
-    auto const& data = mGBufferData[viewport];
-    data.mDepthBuffer->Bind(GL_TEXTURE0);
-    data.mColorBuffer->Bind(GL_TEXTURE1);
   }
 
+  VistaTexture* depthBuffer = mSceneSnapshot->getDepth();
+  VistaTexture* colorBuffer = mSceneSnapshot->getColor();
+  depthBuffer->Bind(GL_TEXTURE0);
+  colorBuffer->Bind(GL_TEXTURE1);
+
   mAtmoShader.SetUniform(mUniforms.depthBuffer, 0);
   mAtmoShader.SetUniform(mUniforms.colorBuffer, 1);
 
@@ -368,15 +332,12 @@ bool Atmosphere::Do() {
   // Reset eclipse shadow-related texture units.
   mEclipseShadowReceiver->postRender();
 
-  if (mHDRBuffer) {
-    mHDRBuffer->getDepthAttachment()->Unbind(GL_TEXTURE0);
-    mHDRBuffer->getCurrentReadAttachment()->Unbind(GL_TEXTURE1);
-  } else {
-    auto* viewport   = GetVistaSystem()->GetDisplayManager()->GetCurrentRenderInfo()->m_pViewport;
-    auto const& data = mGBufferData[viewport];
-    data.mDepthBuffer->Unbind(GL_TEXTURE0);
-    data.mColorBuffer->Unbind(GL_TEXTURE1);
-  }
+  depthBuffer->Unbind(GL_TEXTURE0);
+  colorBuffer->Unbind(GL_TEXTURE1);
+
+  // Without HDR rendering, the next atmosphere has to read a fresh copy of the framebuffer which
+  // includes this atmosphere.
+  mSceneSnapshot->invalidateColor();
 
   if (mSettings.mEnableClouds.get() && mCloudTexture) {
     mCloudTexture->Unbind(GL_TEXTURE3);
@@ -21,6 +21,7 @@ class EclipseShadowReceiver;
 
 namespace cs::graphics {
 class HDRBuffer;
+class SceneSnapshot;
 } // namespace cs::graphics
 
 namespace csp::atmospheres {
@@ -56,6 +57,7 @@ class Atmosphere : public IVistaOpenGLDraw {
   std::shared_ptr<cs::core::Settings>              mAllSettings;
   std::shared_ptr<cs::core::SolarSystem>           mSolarSystem;
   std::shared_ptr<cs::core::GraphicsEngine>        mGraphicsEngine;
+  std::shared_ptr<cs::graphics::SceneSnapshot>     mSceneSnapshot;
   std::string                                      mObjectName;
   std::unique_ptr<VistaOpenGLNode>                 mAtmosphereNode;
   std::shared_ptr<cs::graphics::HDRBuffer>         mHDRBuffer;
@@ -71,13 +73,6 @@ class Atmosphere : public IVistaOpenGLDraw {
 
   VistaGLSLShader mAtmoShader;
 
-  struct GBufferData {
-    std::unique_ptr<VistaTexture> mDepthBuffer;
-    std::unique_ptr<VistaTexture> mColorBuffer;
-  };
-
-  std::unordered_map<VistaViewport*, GBufferData> mGBufferData;
-
   bool       mShaderDirty    = true;
   double     mSunIlluminance = 1.0;
   double     mSunLuminance   = 1.0;
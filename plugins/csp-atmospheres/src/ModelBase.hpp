@@ -56,6 +56,13 @@ class ModelBase {
   virtual bool init(
       nlohmann::json const& modelSettings, double planetRadius, double atmosphereRadius) = 0;
 
+  /// This will be called once each frame. Models which spread their pre-processing over several
+  /// frames can use this to continue their work. The atmosphere will only be drawn once this
+  /// returned true. The default implementation does nothing and returns true.
+  virtual bool update() {
+    return true;
+  }
+
   /// Returns the fragment shader created during the last call to init(). See the class description
   /// above for more details.
   virtual GLuint getShader() const = 0;
@@ -8,8 +8,10 @@
 
 #include "Model.hpp"
 
+#include "../../../../src/cs-utils/filesystem.hpp"
 #include "../../logger.hpp"
 
+#include <boost/filesystem.hpp>
 #include <glm/gtc/constants.hpp>
 
 namespace csp::atmospheres::models::bruneton {
@@ -67,6 +69,13 @@ constexpr std::array<double, 48> OZONE_CROSS_SECTION = {1.18e-27, 2.182e-28, 2.8
 // From https://en.wikipedia.org/wiki/Dobson_unit, in molecules.m^-2.
 constexpr double DOBSON_UNIT = 2.687e20;
 
+// The precomputed textures are stored in this directory.
+constexpr const char* CACHE_DIRECTORY = "cache/atmospheres";
+
+// If the precomputed textures are not found in the cache, this many rendering passes of the
+// precomputation are performed each frame. Most passes compute a single layer of a 3D texture.
+constexpr unsigned int PRECOMPUTATION_STEPS_PER_FRAME = 8;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void from_json(nlohmann::json const& j, Model::Settings& o) {
@@ -156,9 +165,43 @@ bool Model::init(
       groundAlbedo, maxSunZenithAngle, 1.0, LUMINANCE_MODE == PRECOMPUTED ? 15 : 3,
       COMBINED_TEXTURES, HALF_PRECISION));
 
-  glDisable(GL_CULL_FACE);
-  mModel->Init();
-  glEnable(GL_CULL_FACE);
+  mCacheKey    = mModel->GetCacheKey();
+  mCacheFile   = std::string(CACHE_DIRECTORY) + "/bruneton-" + mCacheKey + ".bin";
+  mPrecomputed = mModel->LoadTextures(mCacheFile, mCacheKey);
+
+  if (mPrecomputed) {
+    logger().debug("Loaded precomputed atmosphere textures from '{}'.", mCacheFile);
+  } else {
+    logger().info("Precomputing atmosphere textures. This may take a few seconds.");
+    mModel->BeginInit();
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Model::update() {
+  if (mPrecomputed) {
+    return true;
+  }
+
+  if (!mModel->ContinueInit(PRECOMPUTATION_STEPS_PER_FRAME)) {
+    return false;
+  }
+
+  mPrecomputed = true;
+
+  try {
+    cs::utils::filesystem::createDirectoryRecursively(
+        boost::filesystem::system_complete(CACHE_DIRECTORY));
+
+    if (!mModel->SaveTextures(mCacheFile, mCacheKey)) {
+      logger().warn("Failed to write precomputed atmosphere textures to '{}'.", mCacheFile);
+    }
+  } catch (std::exception const& e) {
+    logger().warn("Failed to create cache directory '{}': {}", CACHE_DIRECTORY, e.what());
+  }
 
   return true;
 }
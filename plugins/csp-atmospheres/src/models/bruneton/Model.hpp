@@ -18,6 +18,9 @@ namespace csp::atmospheres::models::bruneton {
 /// information can be found in the repo
 /// https://github.com/ebruneton/precomputed_atmospheric_scattering as well as in the paper
 /// "Precomputed Atmospheric Scattering" (https://hal.inria.fr/inria-00288758/en).
+/// The precomputed textures are stored in the directory "cache/atmospheres". The file names contain
+/// a hash of all model parameters, so the textures are only precomputed once for each set of
+/// parameters.
 class Model : public ModelBase {
  public:
   /// Some of the model parameters can be configured via the settings. An example parametrization is
@@ -44,6 +47,11 @@ class Model : public ModelBase {
   bool init(
       nlohmann::json const& modelSettings, double planetRadius, double atmosphereRadius) override;
 
+  /// If the precomputed textures could not be loaded from the cache directory, they are computed
+  /// incrementally in this method, a few rendering passes each frame. Once this is done, the
+  /// textures are written to the cache and this method returns true.
+  bool update() override;
+
   /// Returns a fragment shader which you can link to your shader program. See the ModelBase class
   /// for more details. You have to call init() for accessing the shader.
   GLuint getShader() const override;
@@ -53,6 +61,9 @@ class Model : public ModelBase {
 
  private:
   std::unique_ptr<internal::Model> mModel;
+  std::string                      mCacheKey;
+  std::string                      mCacheFile;
+  bool                             mPrecomputed = false;
 };
 
 } // namespace csp::atmospheres::models::bruneton
@@ -18,6 +18,9 @@
 // the GLSL files are now loaded via cs::utils::filesystem::loadToString().
 // Also, the shadow_length parameter has been removed from the public API as this is currently
 // not supported by CosmoScout VR.
+// Finally, the precomputation has been split into individual steps which can be spread over several
+// frames and the precomputed textures can be stored in and loaded from a cache file. All such
+// changes are marked with "CosmoScout VR" in the comments below.
 
 /*<h2>atmosphere/model.cc</h2>
 
@@ -38,10 +41,14 @@ of the following C++ code.
 #include "constants.hpp"
 
 #include "../../../../src/cs-utils/filesystem.hpp"
+#include "../../../../src/cs-utils/utils.hpp"
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
 
 /*
@@ -477,6 +484,58 @@ void DrawQuad(const std::vector<bool>& enable_blend, GLuint quad_vao) {
   }
 }
 
+/*
+<p>CosmoScout VR: As the precomputation may be spread over several frames, each
+rendering pass has to set up the attachments of the framebuffer object on its
+own. All attachments which are not given are detached:
+*/
+
+void SetupFramebuffer(const std::vector<GLuint>& attachments, int width, int height) {
+  const GLuint kDrawBuffers[4] = {
+      GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3};
+  for (unsigned int i = 0; i < 4; ++i) {
+    glFramebufferTexture(
+        GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, i < attachments.size() ? attachments[i] : 0, 0);
+  }
+  glDrawBuffers(static_cast<GLsizei>(attachments.size()), kDrawBuffers);
+  glViewport(0, 0, width, height);
+  glScissor(0, 0, width, height);
+}
+
+/*
+<p>CosmoScout VR: The precomputed textures can be stored in a cache file. This
+starts with a magic number, a format version and the cache key. Then the number
+of floats and the RGBA float data of each texture follows. The version has to be
+increased whenever the layout of the file or the precomputation changes:
+*/
+
+constexpr std::array<char, 4> kCacheMagic   = {'C', 'S', 'A', 'T'};
+constexpr uint32_t            kCacheVersion = 1;
+
+template <typename T>
+void WriteValue(std::ofstream& stream, const T& value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(std::ifstream& stream, T& value) {
+  stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return static_cast<bool>(stream);
+}
+
+// Returns the number of floats required to read the given texture as RGBA data.
+size_t GetTextureFloatCount(GLenum target, GLuint texture) {
+  GLint width  = 0;
+  GLint height = 0;
+  GLint depth  = 0;
+  glBindTexture(target, texture);
+  glGetTexLevelParameteriv(target, 0, GL_TEXTURE_WIDTH, &width);
+  glGetTexLevelParameteriv(target, 0, GL_TEXTURE_HEIGHT, &height);
+  glGetTexLevelParameteriv(target, 0, GL_TEXTURE_DEPTH, &depth);
+  glBindTexture(target, 0);
+  return static_cast<size_t>(width) * height * depth * 4;
+}
+
 /*
 <p>Finally, we need a utility function to compute the value of the conversion
 constants *<code>_RADIANCE_TO_LUMINANCE</code>, used above to convert the
@@ -561,6 +620,28 @@ void ComputeSpectralRadianceToLuminanceFactors(const std::vector<double>& wavele
 
 } // anonymous namespace
 
+// CosmoScout VR: The temporary resources which are required while the
+// precomputation is running. The rendering passes are stored as a list of
+// steps which are executed one after another by ContinueInit().
+struct Model::Precomputation {
+  ~Precomputation() {
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &delta_scattering_density_texture);
+    glDeleteTextures(1, &delta_mie_scattering_texture);
+    glDeleteTextures(1, &delta_rayleigh_scattering_texture);
+    glDeleteTextures(1, &delta_irradiance_texture);
+  }
+
+  GLuint                             fbo                               = 0;
+  GLuint                             delta_irradiance_texture          = 0;
+  GLuint                             delta_rayleigh_scattering_texture = 0;
+  GLuint                             delta_mie_scattering_texture      = 0;
+  GLuint                             delta_scattering_density_texture  = 0;
+  GLuint                             delta_multiple_scattering_texture = 0;
+  std::vector<std::function<void()>> steps;
+  size_t                             next_step = 0;
+};
+
 /*<h3 id="implementation">Model implementation</h3>
 
 <p>Using the above utility functions and classes, we can now implement the
@@ -798,20 +879,26 @@ want to store precomputed irradiance or illuminance values:
 */
 
 void Model::Init(unsigned int num_scattering_orders) {
+  BeginInit(num_scattering_orders);
+  ContinueInit(std::numeric_limits<unsigned int>::max());
+}
+
+void Model::BeginInit(unsigned int num_scattering_orders) {
   // The precomputations require temporary textures, in particular to store the
   // contribution of one scattering order, which is needed to compute the next
   // order of scattering (the final precomputed textures store the sum of all
-  // the scattering orders). We allocate them here, and destroy them at the end
-  // of this method.
-  GLuint delta_irradiance_texture =
+  // the scattering orders). We allocate them here, and destroy them once all
+  // steps of the precomputation have been performed.
+  precomputation_ = std::make_unique<Precomputation>();
+  precomputation_->delta_irradiance_texture =
       NewTexture2d(IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT);
-  GLuint delta_rayleigh_scattering_texture =
+  precomputation_->delta_rayleigh_scattering_texture =
       NewTexture3d(SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
           rgb_format_supported_ ? GL_RGB : GL_RGBA, half_precision_);
-  GLuint delta_mie_scattering_texture =
+  precomputation_->delta_mie_scattering_texture =
       NewTexture3d(SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
           rgb_format_supported_ ? GL_RGB : GL_RGBA, half_precision_);
-  GLuint delta_scattering_density_texture =
+  precomputation_->delta_scattering_density_texture =
       NewTexture3d(SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT, SCATTERING_TEXTURE_DEPTH,
           rgb_format_supported_ ? GL_RGB : GL_RGBA, half_precision_);
   // delta_multiple_scattering_texture is only needed to compute scattering
@@ -819,32 +906,26 @@ void Model::Init(unsigned int num_scattering_orders) {
   // delta_mie_scattering_texture are only needed to compute double scattering.
   // Therefore, to save memory, we can store delta_rayleigh_scattering_texture
   // and delta_multiple_scattering_texture in the same GPU texture.
-  GLuint delta_multiple_scattering_texture = delta_rayleigh_scattering_texture;
+  precomputation_->delta_multiple_scattering_texture =
+      precomputation_->delta_rayleigh_scattering_texture;
 
-  // The precomputations also require a temporary framebuffer object, created
-  // here (and destroyed at the end of this method).
-  GLuint fbo;
-  glGenFramebuffers(1, &fbo);
-  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  // The precomputations also require a temporary framebuffer object.
+  glGenFramebuffers(1, &precomputation_->fbo);
 
   // The actual precomputations depend on whether we want to store precomputed
   // irradiance or illuminance values.
+  std::vector<vec3> all_lambdas = GetPrecomputedLambdas();
   if (num_precomputed_wavelengths_ <= 3) {
-    vec3 lambdas{kLambdaR, kLambdaG, kLambdaB};
     mat3 luminance_from_radiance{1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
-    Precompute(fbo, delta_irradiance_texture, delta_rayleigh_scattering_texture,
-        delta_mie_scattering_texture, delta_scattering_density_texture,
-        delta_multiple_scattering_texture, lambdas, luminance_from_radiance, false /* blend */,
+    Precompute(*precomputation_, all_lambdas[0], luminance_from_radiance, false /* blend */,
         num_scattering_orders);
   } else {
-    constexpr double kLambdaMin     = 360.0;
-    constexpr double kLambdaMax     = 830.0;
-    int              num_iterations = (num_precomputed_wavelengths_ + 2) / 3;
-    double           dlambda        = (kLambdaMax - kLambdaMin) / (3 * num_iterations);
-    for (int i = 0; i < num_iterations; ++i) {
-      vec3 lambdas{kLambdaMin + (3 * i + 0.5) * dlambda, kLambdaMin + (3 * i + 1.5) * dlambda,
-          kLambdaMin + (3 * i + 2.5) * dlambda};
-      auto coeff = [dlambda](double lambda, int component) {
+    constexpr double kLambdaMin = 360.0;
+    constexpr double kLambdaMax = 830.0;
+    double           dlambda    = (kLambdaMax - kLambdaMin) / (3 * all_lambdas.size());
+    for (size_t i = 0; i < all_lambdas.size(); ++i) {
+      const vec3& lambdas = all_lambdas[i];
+      auto        coeff   = [dlambda](double lambda, int component) {
         // Note that we don't include MAX_LUMINOUS_EFFICACY here, to avoid
         // artefacts due to too large values when using half precision on GPU.
         // We add this term back in kAtmosphereShader, via
@@ -861,9 +942,7 @@ void Model::Init(unsigned int num_scattering_orders) {
       mat3 luminance_from_radiance{coeff(lambdas[0], 0), coeff(lambdas[1], 0), coeff(lambdas[2], 0),
           coeff(lambdas[0], 1), coeff(lambdas[1], 1), coeff(lambdas[2], 1), coeff(lambdas[0], 2),
           coeff(lambdas[1], 2), coeff(lambdas[2], 2)};
-      Precompute(fbo, delta_irradiance_texture, delta_rayleigh_scattering_texture,
-          delta_mie_scattering_texture, delta_scattering_density_texture,
-          delta_multiple_scattering_texture, lambdas, luminance_from_radiance, i > 0 /* blend */,
+      Precompute(*precomputation_, lambdas, luminance_from_radiance, i > 0 /* blend */,
           num_scattering_orders);
     }
 
@@ -871,25 +950,214 @@ void Model::Init(unsigned int num_scattering_orders) {
     // transmittance for the 3 wavelengths used at the last iteration. But we
     // want the transmittance at kLambdaR, kLambdaG, kLambdaB instead, so we
     // must recompute it here for these 3 wavelengths:
-    std::string header = glsl_header_factory_({kLambdaR, kLambdaG, kLambdaB});
-    Program     compute_transmittance(kVertexShader, header + kComputeTransmittanceShader);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, transmittance_texture_, 0);
-    glDrawBuffer(GL_COLOR_ATTACHMENT0);
-    glViewport(0, 0, TRANSMITTANCE_TEXTURE_WIDTH, TRANSMITTANCE_TEXTURE_HEIGHT);
-    glScissor(0, 0, TRANSMITTANCE_TEXTURE_WIDTH, TRANSMITTANCE_TEXTURE_HEIGHT);
-    compute_transmittance.Use();
-    DrawQuad({}, full_screen_quad_vao_);
+    precomputation_->steps.emplace_back([this]() {
+      std::string header = glsl_header_factory_({kLambdaR, kLambdaG, kLambdaB});
+      Program     compute_transmittance(kVertexShader, header + kComputeTransmittanceShader);
+      SetupFramebuffer(
+          {transmittance_texture_}, TRANSMITTANCE_TEXTURE_WIDTH, TRANSMITTANCE_TEXTURE_HEIGHT);
+      compute_transmittance.Use();
+      DrawQuad({}, full_screen_quad_vao_);
+    });
+  }
+}
+
+/*
+<p>CosmoScout VR: <code>ContinueInit</code> performs the next steps of the
+precomputation prepared by <code>BeginInit</code>. As this is usually called
+in the middle of the application's frame, it restores the OpenGL state which
+is modified by the precomputation steps afterwards:
+*/
+
+bool Model::ContinueInit(unsigned int max_steps) {
+  if (!precomputation_) {
+    return true;
+  }
+
+  GLint draw_framebuffer = 0;
+  GLint read_framebuffer = 0;
+  GLint program          = 0;
+  GLint active_texture   = 0;
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw_framebuffer);
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_framebuffer);
+  glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+  glGetIntegerv(GL_ACTIVE_TEXTURE, &active_texture);
+  glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_VIEWPORT_BIT | GL_SCISSOR_BIT);
+
+  glDisable(GL_CULL_FACE);
+  glBindFramebuffer(GL_FRAMEBUFFER, precomputation_->fbo);
+  glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+  glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+
+  auto& steps = precomputation_->steps;
+  for (unsigned int i = 0; i < max_steps && precomputation_->next_step < steps.size(); ++i) {
+    steps[precomputation_->next_step++]();
+  }
+
+  glPopAttrib();
+  glActiveTexture(active_texture);
+  glUseProgram(program);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_framebuffer);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+
+  if (precomputation_->next_step < steps.size()) {
+    return false;
   }
 
-  // Delete the temporary resources allocated at the begining of this method.
-  glUseProgram(0);
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
-  glDeleteFramebuffers(1, &fbo);
-  glDeleteTextures(1, &delta_scattering_density_texture);
-  glDeleteTextures(1, &delta_mie_scattering_texture);
-  glDeleteTextures(1, &delta_rayleigh_scattering_texture);
-  glDeleteTextures(1, &delta_irradiance_texture);
+  // Delete the temporary resources allocated in BeginInit().
+  precomputation_.reset();
   assert(glGetError() == 0);
+  return true;
+}
+
+/*
+<p>CosmoScout VR: The wavelengths for which <code>Precompute</code> is called.
+In precomputed irradiance mode, these are only <code>kLambdaR</code>,
+<code>kLambdaG</code>, <code>kLambdaB</code>. In precomputed illuminance mode,
+the spectrum is sampled with <code>num_precomputed_wavelengths_</code> values:
+*/
+
+std::vector<Model::vec3> Model::GetPrecomputedLambdas() const {
+  if (num_precomputed_wavelengths_ <= 3) {
+    return {{kLambdaR, kLambdaG, kLambdaB}};
+  }
+
+  constexpr double  kLambdaMin     = 360.0;
+  constexpr double  kLambdaMax     = 830.0;
+  int               num_iterations = (num_precomputed_wavelengths_ + 2) / 3;
+  double            dlambda        = (kLambdaMax - kLambdaMin) / (3 * num_iterations);
+  std::vector<vec3> result;
+  for (int i = 0; i < num_iterations; ++i) {
+    result.push_back({kLambdaMin + (3 * i + 0.5) * dlambda, kLambdaMin + (3 * i + 1.5) * dlambda,
+        kLambdaMin + (3 * i + 2.5) * dlambda});
+  }
+  return result;
+}
+
+/*
+<p>CosmoScout VR: The content of the precomputed textures is fully determined by
+the programs used during the precomputation. Their source code is generated by
+<code>glsl_header_factory_</code> which embeds all atmosphere parameters. Hence
+we hash these headers together with the precomputation shaders and the few
+parameters which are not part of the GLSL code:
+*/
+
+std::string Model::GetCacheKey(unsigned int num_scattering_orders) const {
+  std::string data = std::to_string(kCacheVersion) + " " + std::to_string(num_scattering_orders) +
+                     " " + std::to_string(num_precomputed_wavelengths_) + " " +
+                     std::to_string(half_precision_) + " " +
+                     std::to_string(optional_single_mie_scattering_texture_ == 0) + "\n";
+  data += glsl_header_factory_({kLambdaR, kLambdaG, kLambdaB});
+  for (const vec3& lambdas : GetPrecomputedLambdas()) {
+    data += glsl_header_factory_(lambdas);
+  }
+  data += std::string(kVertexShader) + kGeometryShader + kComputeTransmittanceShader +
+          kComputeDirectIrradianceShader + kComputeSingleScatteringShader +
+          kComputeScatteringDensityShader + kComputeIndirectIrradianceShader +
+          kComputeMultipleScatteringShader;
+  return cs::utils::hashString(data);
+}
+
+/*
+<p>CosmoScout VR: The textures which are stored in the cache files, together
+with their texture targets:
+*/
+
+std::vector<std::pair<GLenum, GLuint>> Model::GetPrecomputedTextures() const {
+  std::vector<std::pair<GLenum, GLuint>> textures = {{GL_TEXTURE_2D, transmittance_texture_},
+      {GL_TEXTURE_3D, scattering_texture_}, {GL_TEXTURE_2D, irradiance_texture_}};
+  if (optional_single_mie_scattering_texture_ != 0) {
+    textures.emplace_back(GL_TEXTURE_3D, optional_single_mie_scattering_texture_);
+  }
+  return textures;
+}
+
+bool Model::LoadTextures(const std::string& file_name, const std::string& cache_key) {
+  std::ifstream stream(file_name, std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+
+  std::array<char, 4> magic{};
+  uint32_t            version    = 0;
+  uint32_t            key_length = 0;
+  stream.read(magic.data(), magic.size());
+  if (!stream || magic != kCacheMagic || !ReadValue(stream, version) || version != kCacheVersion ||
+      !ReadValue(stream, key_length) || key_length != cache_key.size()) {
+    return false;
+  }
+
+  std::string key(key_length, ' ');
+  stream.read(key.data(), key_length);
+  if (!stream || key != cache_key) {
+    return false;
+  }
+
+  // We first read all data, so that no texture is modified if the file turns
+  // out to be truncated.
+  auto                            textures = GetPrecomputedTextures();
+  std::vector<std::vector<float>> data(textures.size());
+  for (size_t i = 0; i < textures.size(); ++i) {
+    uint64_t count = 0;
+    if (!ReadValue(stream, count) ||
+        count != GetTextureFloatCount(textures[i].first, textures[i].second)) {
+      return false;
+    }
+    data[i].resize(count);
+    stream.read(reinterpret_cast<char*>(data[i].data()),
+        static_cast<std::streamsize>(count * sizeof(float)));
+    if (!stream) {
+      return false;
+    }
+  }
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  for (size_t i = 0; i < textures.size(); ++i) {
+    GLenum target = textures[i].first;
+    GLint  width  = 0;
+    GLint  height = 0;
+    GLint  depth  = 0;
+    glBindTexture(target, textures[i].second);
+    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_WIDTH, &width);
+    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_HEIGHT, &height);
+    glGetTexLevelParameteriv(target, 0, GL_TEXTURE_DEPTH, &depth);
+    if (target == GL_TEXTURE_3D) {
+      glTexSubImage3D(target, 0, 0, 0, 0, width, height, depth, GL_RGBA, GL_FLOAT, data[i].data());
+    } else {
+      glTexSubImage2D(target, 0, 0, 0, width, height, GL_RGBA, GL_FLOAT, data[i].data());
+    }
+    glBindTexture(target, 0);
+  }
+
+  // A running precomputation would overwrite the loaded textures.
+  precomputation_.reset();
+  return true;
+}
+
+bool Model::SaveTextures(const std::string& file_name, const std::string& cache_key) const {
+  std::ofstream stream(file_name, std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+
+  stream.write(kCacheMagic.data(), kCacheMagic.size());
+  WriteValue(stream, kCacheVersion);
+  WriteValue(stream, static_cast<uint32_t>(cache_key.size()));
+  stream.write(cache_key.data(), static_cast<std::streamsize>(cache_key.size()));
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  for (const auto& [target, texture] : GetPrecomputedTextures()) {
+    std::vector<float> data(GetTextureFloatCount(target, texture));
+    glBindTexture(target, texture);
+    glGetTexImage(target, 0, GL_RGBA, GL_FLOAT, data.data());
+    glBindTexture(target, 0);
+    WriteValue(stream, static_cast<uint64_t>(data.size()));
+    stream.write(reinterpret_cast<const char*>(data.data()),
+        static_cast<std::streamsize>(data.size() * sizeof(float)));
+  }
+
+  return static_cast<bool>(stream);
 }
 
 /*
@@ -955,73 +1223,81 @@ described in Algorithm 4.1 of
 <a href="https://hal.inria.fr/inria-00288758/en">our paper</a>. Each step is
 explained by the inline comments below.
 */
-void Model::Precompute(GLuint fbo, GLuint delta_irradiance_texture,
-    GLuint delta_rayleigh_scattering_texture, GLuint delta_mie_scattering_texture,
-    GLuint delta_scattering_density_texture, GLuint delta_multiple_scattering_texture,
-    const vec3& lambdas, const mat3& luminance_from_radiance, bool blend,
-    unsigned int num_scattering_orders) {
+void Model::Precompute(Precomputation& precomputation, const vec3& lambdas,
+    const mat3& luminance_from_radiance, bool blend, unsigned int num_scattering_orders) {
   // The precomputations require specific GLSL programs, for each precomputation
-  // step. We create and compile them here (they are automatically destroyed
-  // when this method returns, via the Program destructor).
-  std::string header = glsl_header_factory_(lambdas);
-  Program     compute_transmittance(kVertexShader, header + kComputeTransmittanceShader);
-  Program     compute_direct_irradiance(kVertexShader, header + kComputeDirectIrradianceShader);
-  Program     compute_single_scattering(
-      kVertexShader, kGeometryShader, header + kComputeSingleScatteringShader);
-  Program compute_scattering_density(
-      kVertexShader, kGeometryShader, header + kComputeScatteringDensityShader);
-  Program compute_indirect_irradiance(kVertexShader, header + kComputeIndirectIrradianceShader);
-  Program compute_multiple_scattering(
-      kVertexShader, kGeometryShader, header + kComputeMultipleScatteringShader);
-
-  const GLuint kDrawBuffers[4] = {
-      GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3};
-  glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-  glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+  // step. We create and compile them in the first step (they are automatically
+  // destroyed together with the steps, via the Program destructor).
+  struct Programs {
+    std::unique_ptr<Program> compute_transmittance;
+    std::unique_ptr<Program> compute_direct_irradiance;
+    std::unique_ptr<Program> compute_single_scattering;
+    std::unique_ptr<Program> compute_scattering_density;
+    std::unique_ptr<Program> compute_indirect_irradiance;
+    std::unique_ptr<Program> compute_multiple_scattering;
+  };
+  auto  programs = std::make_shared<Programs>();
+  auto  p        = &precomputation;
+  auto& steps    = precomputation.steps;
+
+  steps.emplace_back([this, programs, lambdas]() {
+    std::string header = glsl_header_factory_(lambdas);
+    programs->compute_transmittance =
+        std::make_unique<Program>(kVertexShader, header + kComputeTransmittanceShader);
+    programs->compute_direct_irradiance =
+        std::make_unique<Program>(kVertexShader, header + kComputeDirectIrradianceShader);
+    programs->compute_single_scattering = std::make_unique<Program>(
+        kVertexShader, kGeometryShader, header + kComputeSingleScatteringShader);
+    programs->compute_scattering_density = std::make_unique<Program>(
+        kVertexShader, kGeometryShader, header + kComputeScatteringDensityShader);
+    programs->compute_indirect_irradiance =
+        std::make_unique<Program>(kVertexShader, header + kComputeIndirectIrradianceShader);
+    programs->compute_multiple_scattering = std::make_unique<Program>(
+        kVertexShader, kGeometryShader, header + kComputeMultipleScatteringShader);
+  });
 
   // Compute the transmittance, and store it in transmittance_texture_.
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, transmittance_texture_, 0);
-  glDrawBuffer(GL_COLOR_ATTACHMENT0);
-  glViewport(0, 0, TRANSMITTANCE_TEXTURE_WIDTH, TRANSMITTANCE_TEXTURE_HEIGHT);
-  glScissor(0, 0, TRANSMITTANCE_TEXTURE_WIDTH, TRANSMITTANCE_TEXTURE_HEIGHT);
-  compute_transmittance.Use();
-  DrawQuad({}, full_screen_quad_vao_);
+  steps.emplace_back([this, programs]() {
+    SetupFramebuffer(
+        {transmittance_texture_}, TRANSMITTANCE_TEXTURE_WIDTH, TRANSMITTANCE_TEXTURE_HEIGHT);
+    programs->compute_transmittance->Use();
+    DrawQuad({}, full_screen_quad_vao_);
+  });
 
   // Compute the direct irradiance, store it in delta_irradiance_texture and,
   // depending on 'blend', either initialize irradiance_texture_ with zeros or
   // leave it unchanged (we don't want the direct irradiance in
   // irradiance_texture_, but only the irradiance from the sky).
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, delta_irradiance_texture, 0);
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, irradiance_texture_, 0);
-  glDrawBuffers(2, kDrawBuffers);
-  glViewport(0, 0, IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT);
-  glScissor(0, 0, IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT);
-  compute_direct_irradiance.Use();
-  compute_direct_irradiance.BindTexture2d("transmittance_texture", transmittance_texture_, 0);
-  DrawQuad({false, blend}, full_screen_quad_vao_);
+  steps.emplace_back([this, programs, p, blend]() {
+    SetupFramebuffer({p->delta_irradiance_texture, irradiance_texture_}, IRRADIANCE_TEXTURE_WIDTH,
+        IRRADIANCE_TEXTURE_HEIGHT);
+    programs->compute_direct_irradiance->Use();
+    programs->compute_direct_irradiance->BindTexture2d(
+        "transmittance_texture", transmittance_texture_, 0);
+    DrawQuad({false, blend}, full_screen_quad_vao_);
+  });
 
   // Compute the rayleigh and mie single scattering, store them in
   // delta_rayleigh_scattering_texture and delta_mie_scattering_texture, and
   // either store them or accumulate them in scattering_texture_ and
-  // optional_single_mie_scattering_texture_.
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, delta_rayleigh_scattering_texture, 0);
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, delta_mie_scattering_texture, 0);
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, scattering_texture_, 0);
-  if (optional_single_mie_scattering_texture_ != 0) {
-    glFramebufferTexture(
-        GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, optional_single_mie_scattering_texture_, 0);
-    glDrawBuffers(4, kDrawBuffers);
-  } else {
-    glDrawBuffers(3, kDrawBuffers);
-  }
-  glViewport(0, 0, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT);
-  glScissor(0, 0, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT);
-  compute_single_scattering.Use();
-  compute_single_scattering.BindMat3("luminance_from_radiance", luminance_from_radiance);
-  compute_single_scattering.BindTexture2d("transmittance_texture", transmittance_texture_, 0);
+  // optional_single_mie_scattering_texture_. CosmoScout VR: Each layer is
+  // rendered in a separate step.
   for (unsigned int layer = 0; layer < SCATTERING_TEXTURE_DEPTH; ++layer) {
-    compute_single_scattering.BindInt("layer", layer);
-    DrawQuad({false, false, blend, blend}, full_screen_quad_vao_);
+    steps.emplace_back([this, programs, p, luminance_from_radiance, blend, layer]() {
+      std::vector<GLuint> attachments = {p->delta_rayleigh_scattering_texture,
+          p->delta_mie_scattering_texture, scattering_texture_};
+      if (optional_single_mie_scattering_texture_ != 0) {
+        attachments.push_back(optional_single_mie_scattering_texture_);
+      }
+      SetupFramebuffer(attachments, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT);
+      programs->compute_single_scattering->Use();
+      programs->compute_single_scattering->BindMat3(
+          "luminance_from_radiance", luminance_from_radiance);
+      programs->compute_single_scattering->BindTexture2d(
+          "transmittance_texture", transmittance_texture_, 0);
+      programs->compute_single_scattering->BindInt("layer", layer);
+      DrawQuad({false, false, blend, blend}, full_screen_quad_vao_);
+    });
   }
 
   // Compute the 2nd, 3rd and 4th order of scattering, in sequence.
@@ -1029,68 +1305,64 @@ void Model::Precompute(GLuint fbo, GLuint delta_irradiance_texture,
        ++scattering_order) {
     // Compute the scattering density, and store it in
     // delta_scattering_density_texture.
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, delta_scattering_density_texture, 0);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, 0, 0);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, 0, 0);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, 0, 0);
-    glDrawBuffer(GL_COLOR_ATTACHMENT0);
-    glViewport(0, 0, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT);
-    glScissor(0, 0, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT);
-    compute_scattering_density.Use();
-    compute_scattering_density.BindTexture2d("transmittance_texture", transmittance_texture_, 0);
-    compute_scattering_density.BindTexture3d(
-        "single_rayleigh_scattering_texture", delta_rayleigh_scattering_texture, 1);
-    compute_scattering_density.BindTexture3d(
-        "single_mie_scattering_texture", delta_mie_scattering_texture, 2);
-    compute_scattering_density.BindTexture3d(
-        "multiple_scattering_texture", delta_multiple_scattering_texture, 3);
-    compute_scattering_density.BindTexture2d("irradiance_texture", delta_irradiance_texture, 4);
-    compute_scattering_density.BindInt("scattering_order", scattering_order);
     for (unsigned int layer = 0; layer < SCATTERING_TEXTURE_DEPTH; ++layer) {
-      compute_scattering_density.BindInt("layer", layer);
-      DrawQuad({}, full_screen_quad_vao_);
+      steps.emplace_back([this, programs, p, scattering_order, layer]() {
+        SetupFramebuffer({p->delta_scattering_density_texture}, SCATTERING_TEXTURE_WIDTH,
+            SCATTERING_TEXTURE_HEIGHT);
+        auto& program = programs->compute_scattering_density;
+        program->Use();
+        program->BindTexture2d("transmittance_texture", transmittance_texture_, 0);
+        program->BindTexture3d(
+            "single_rayleigh_scattering_texture", p->delta_rayleigh_scattering_texture, 1);
+        program->BindTexture3d("single_mie_scattering_texture", p->delta_mie_scattering_texture, 2);
+        program->BindTexture3d(
+            "multiple_scattering_texture", p->delta_multiple_scattering_texture, 3);
+        program->BindTexture2d("irradiance_texture", p->delta_irradiance_texture, 4);
+        program->BindInt("scattering_order", scattering_order);
+        program->BindInt("layer", layer);
+        DrawQuad({}, full_screen_quad_vao_);
+      });
     }
 
     // Compute the indirect irradiance, store it in delta_irradiance_texture and
     // accumulate it in irradiance_texture_.
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, delta_irradiance_texture, 0);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, irradiance_texture_, 0);
-    glDrawBuffers(2, kDrawBuffers);
-    glViewport(0, 0, IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT);
-    glScissor(0, 0, IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT);
-    compute_indirect_irradiance.Use();
-    compute_indirect_irradiance.BindMat3("luminance_from_radiance", luminance_from_radiance);
-    compute_indirect_irradiance.BindTexture3d(
-        "single_rayleigh_scattering_texture", delta_rayleigh_scattering_texture, 0);
-    compute_indirect_irradiance.BindTexture3d(
-        "single_mie_scattering_texture", delta_mie_scattering_texture, 1);
-    compute_indirect_irradiance.BindTexture3d(
-        "multiple_scattering_texture", delta_multiple_scattering_texture, 2);
-    compute_indirect_irradiance.BindInt("scattering_order", scattering_order - 1);
-    DrawQuad({false, true}, full_screen_quad_vao_);
+    steps.emplace_back([this, programs, p, luminance_from_radiance, scattering_order]() {
+      SetupFramebuffer({p->delta_irradiance_texture, irradiance_texture_},
+          IRRADIANCE_TEXTURE_WIDTH, IRRADIANCE_TEXTURE_HEIGHT);
+      auto& program = programs->compute_indirect_irradiance;
+      program->Use();
+      program->BindMat3("luminance_from_radiance", luminance_from_radiance);
+      program->BindTexture3d(
+          "single_rayleigh_scattering_texture", p->delta_rayleigh_scattering_texture, 0);
+      program->BindTexture3d("single_mie_scattering_texture", p->delta_mie_scattering_texture, 1);
+      program->BindTexture3d(
+          "multiple_scattering_texture", p->delta_multiple_scattering_texture, 2);
+      program->BindInt("scattering_order", scattering_order - 1);
+      DrawQuad({false, true}, full_screen_quad_vao_);
+    });
 
     // Compute the multiple scattering, store it in
     // delta_multiple_scattering_texture, and accumulate it in
     // scattering_texture_.
-    glFramebufferTexture(
-        GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, delta_multiple_scattering_texture, 0);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, scattering_texture_, 0);
-    glDrawBuffers(2, kDrawBuffers);
-    glViewport(0, 0, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT);
-    glScissor(0, 0, SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT);
-    compute_multiple_scattering.Use();
-    compute_multiple_scattering.BindMat3("luminance_from_radiance", luminance_from_radiance);
-    compute_multiple_scattering.BindTexture2d("transmittance_texture", transmittance_texture_, 0);
-    compute_multiple_scattering.BindTexture3d(
-        "scattering_density_texture", delta_scattering_density_texture, 1);
     for (unsigned int layer = 0; layer < SCATTERING_TEXTURE_DEPTH; ++layer) {
-      compute_multiple_scattering.BindInt("layer", layer);
-      DrawQuad({false, true}, full_screen_quad_vao_);
+      steps.emplace_back([this, programs, p, luminance_from_radiance, layer]() {
+        SetupFramebuffer({p->delta_multiple_scattering_texture, scattering_texture_},
+            SCATTERING_TEXTURE_WIDTH, SCATTERING_TEXTURE_HEIGHT);
+        auto& program = programs->compute_multiple_scattering;
+        program->Use();
+        program->BindMat3("luminance_from_radiance", luminance_from_radiance);
+        program->BindTexture2d("transmittance_texture", transmittance_texture_, 0);
+        program->BindTexture3d(
+            "scattering_density_texture", p->delta_scattering_density_texture, 1);
+        program->BindInt("layer", layer);
+        DrawQuad({false, true}, full_screen_quad_vao_);
+      });
     }
   }
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, 0, 0);
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, 0, 0);
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, 0, 0);
+
+  // The programs are not needed anymore once all of the above steps have been
+  // performed.
+  steps.emplace_back([programs]() { *programs = Programs(); });
 }
 
 } // namespace csp::atmospheres::models::bruneton::internal
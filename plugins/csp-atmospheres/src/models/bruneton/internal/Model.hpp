@@ -18,6 +18,9 @@
 // removed this and adapted the documentation here accordingly.
 // Similarily, the shadow_length parameter has been removed from the public API as this is currently
 // not supported by CosmoScout VR.
+// Furthermore, CosmoScout VR can spread the precomputation over several frames (see BeginInit() and
+// ContinueInit()) and store the precomputed textures on disk (see GetCacheKey(), LoadTextures() and
+// SaveTextures()).
 
 /*<h2>atmosphere/model.h</h2>
 
@@ -140,7 +143,9 @@ parameter):
 #include <GL/glew.h>
 #include <array>
 #include <functional>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace csp::atmospheres::models::bruneton::internal {
@@ -277,6 +282,25 @@ class Model {
 
   void Init(unsigned int num_scattering_orders = 4);
 
+  // CosmoScout VR: Instead of calling Init(), the precomputation can also be spread over several
+  // frames. BeginInit() allocates the temporary resources and prepares all rendering passes. Each
+  // call to ContinueInit() then performs at most 'max_steps' of these passes and restores the
+  // previously bound framebuffer, program and viewport afterwards. It returns true once all
+  // passes have been performed and the temporary resources have been freed.
+  void BeginInit(unsigned int num_scattering_orders = 4);
+  bool ContinueInit(unsigned int max_steps);
+
+  // CosmoScout VR: Returns a hexadecimal hash of everything which influences the content of the
+  // precomputed textures. This includes the GLSL code of the precomputation shaders which in turn
+  // contains all atmosphere parameters.
+  std::string GetCacheKey(unsigned int num_scattering_orders = 4) const;
+
+  // CosmoScout VR: Writes the precomputed textures to a binary file or reads them from such a file.
+  // LoadTextures() returns false if the file does not exist or if it has been written for a
+  // different cache key. SaveTextures() returns false if the file could not be written.
+  bool LoadTextures(const std::string& file_name, const std::string& cache_key);
+  bool SaveTextures(const std::string& file_name, const std::string& cache_key) const;
+
   GLuint shader() const {
     return atmosphere_shader_;
   }
@@ -301,11 +325,21 @@ class Model {
   typedef std::array<double, 3> vec3;
   typedef std::array<float, 9>  mat3;
 
-  void Precompute(GLuint fbo, GLuint delta_irradiance_texture,
-      GLuint delta_rayleigh_scattering_texture, GLuint delta_mie_scattering_texture,
-      GLuint delta_scattering_density_texture, GLuint delta_multiple_scattering_texture,
-      const vec3& lambdas, const mat3& luminance_from_radiance, bool blend,
-      unsigned int num_scattering_orders);
+  // CosmoScout VR: The temporary resources of an ongoing precomputation. This is defined in the
+  // source file.
+  struct Precomputation;
+
+  // CosmoScout VR: Returns the wavelengths for which Precompute() is called during BeginInit().
+  std::vector<vec3> GetPrecomputedLambdas() const;
+
+  // CosmoScout VR: Returns the targets and names of all textures which are stored by
+  // SaveTextures().
+  std::vector<std::pair<GLenum, GLuint>> GetPrecomputedTextures() const;
+
+  // CosmoScout VR: Instead of executing the rendering passes directly, this appends them to the
+  // list of steps of the given precomputation.
+  void Precompute(Precomputation& precomputation, const vec3& lambdas,
+      const mat3& luminance_from_radiance, bool blend, unsigned int num_scattering_orders);
 
   unsigned int                            num_precomputed_wavelengths_;
   bool                                    half_precision_;
@@ -318,6 +352,7 @@ class Model {
   GLuint                                  atmosphere_shader_;
   GLuint                                  full_screen_quad_vao_;
   GLuint                                  full_screen_quad_vbo_;
+  std::unique_ptr<Precomputation>         precomputation_;
 };
 
 } // namespace csp::atmospheres::models::bruneton::internal
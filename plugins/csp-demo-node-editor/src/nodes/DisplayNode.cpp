@@ -39,10 +39,11 @@ std::string const& DisplayNode::getName() const {
 void DisplayNode::process() {
 
   // Whenever this method is called, we send a message to the JavaScript counterpart of this node.
-  // The value is sent as a JSON object
+  // The value is sent as a JSON object. If the input changes several times during one frame, only
+  // the latest value will be received.
   auto json     = nlohmann::json::object();
   json["value"] = readInput<double>("number", 0.0);
-  sendMessageToJS(json);
+  sendLatestMessageToJS(json);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -67,6 +67,12 @@ void MathNode::process() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+csl::nodeeditor::Node::ExecutionMode MathNode::getExecutionMode() const {
+  return ExecutionMode::eParallel;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void MathNode::onMessageFromJS(nlohmann::json const& message) {
 
   // The CosmoScout.sendMessageToCPP() method sends the currently selected math operation.
@@ -41,6 +41,12 @@ class MathNode : public csl::nodeeditor::Node {
   /// client was connected hence needs updated values for all nodes.
   void process() override;
 
+  /// The computation of the MathNode only depends on its inputs and the selected math operation.
+  /// Hence it can be processed on a worker thread, in parallel to other nodes. The operation is
+  /// only changed on the main thread while the node graph is not processed, so no synchronization
+  /// is required.
+  ExecutionMode getExecutionMode() const override;
+
   /// This will be called whenever the CosmoScout.sendMessageToCPP() is called by the JavaScript
   /// client part of this node.
   /// @param message  A JSON object as sent by the JavaScript node. In this case, it is actually
@@ -56,14 +56,14 @@ std::string const& TimeNode::getName() const {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void TimeNode::init() {
-  sendMessageToJS(boost::posix_time::to_simple_string(
+  sendLatestMessageToJS(boost::posix_time::to_simple_string(
       cs::utils::convert::time::toPosix(mTimeControl->pSimulationTime.get())));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void TimeNode::process() {
-  sendMessageToJS(boost::posix_time::to_simple_string(
+  sendLatestMessageToJS(boost::posix_time::to_simple_string(
       cs::utils::convert::time::toPosix(mTimeControl->pSimulationTime.get())));
 
   // The name of the port must match the name given in the JavaScript code above.
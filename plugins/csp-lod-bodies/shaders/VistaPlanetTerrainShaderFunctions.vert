@@ -40,6 +40,7 @@ float VP_getVertexHeight(ivec2 iPosition)
     float pixelSize = 1.0 / VP_getResolutionDEM();
     vec2 texcoords = VP_getTileCoords(iPosition) * (1.0 - pixelSize) + 0.5 * pixelSize;
     float height = texture(VP_texDEM, vec3(texcoords, VP_dataLayers.x)).x;
+    height = mix(VP_heightRange.x, VP_heightRange.y, height);
 
     // Move skirt vertices down by half the maximum elevation difference inside the tile.
     if (any(equal(iPosition, ivec2(0.0))) || any(equal(iPosition, ivec2(VP_getResolutionDEM() + 1)))) {
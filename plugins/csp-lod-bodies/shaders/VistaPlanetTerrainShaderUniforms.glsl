@@ -31,6 +31,9 @@ uniform sampler2DArray VP_texIMG;
 // The second component contains the maximum height difference in the tile.
 uniform vec2 VP_heightInfo;
 
+// Quantized elevation samples are normalized to this range. It is [0, 1] for float samples.
+uniform vec2 VP_heightRange;
+
 // offset (xy) and total number of patches (z) (relative to base patch)
 uniform ivec3 VP_offsetScale;
 
@@ -36,4 +36,16 @@ uint32_t BaseTileData::getResolution() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+glm::vec2 const& BaseTileData::getValueRange() const {
+  return mValueRange;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void BaseTileData::setValueRange(glm::vec2 const& range) {
+  mValueRange = range;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace csp::lodbodies
@@ -47,9 +47,21 @@ class BaseTileData {
   /// Returns pointer to data stored in this tile.
   virtual void* getDataPtr() = 0;
 
+  /// Returns the size of the data stored in this tile in bytes.
+  virtual std::size_t getDataSize() const = 0;
+
+  /// Returns true if the data is stored block-compressed. In this case, it has to be uploaded with
+  /// glCompressedTexSubImage3D().
+  virtual bool isCompressed() const = 0;
+
   /// Returns the resolution given to the tile at construction time.
   uint32_t getResolution() const;
 
+  /// Quantized tiles store their samples normalized to [0, 1] relative to this range. Actual values
+  /// are obtained with glm::mix(range.x, range.y, sample). For all other tiles, this is [0, 1].
+  glm::vec2 const& getValueRange() const;
+  void             setValueRange(glm::vec2 const& range);
+
   /// Once uploaded to the GPU, this will return the layer in the 3D texture array this data is
   /// stored in.
   int  getTexLayer() const;
@@ -59,8 +71,9 @@ class BaseTileData {
   explicit BaseTileData(uint32_t resolution);
 
  private:
-  uint32_t mResolution;
-  int      mTexLayer{-1};
+  uint32_t  mResolution;
+  int       mTexLayer{-1};
+  glm::vec2 mValueRange{0.F, 1.F};
 };
 
 template <typename T>
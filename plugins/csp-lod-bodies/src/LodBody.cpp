@@ -87,6 +87,12 @@ bool LodBody::getIntersection(
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+double LodBody::getBoundingRadius() const {
+  return utils::getBoundingRadius(&mPlanet);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 double LodBody::getHeight(glm::dvec2 lngLat) const {
   return utils::getHeight(&mPlanet, HeightSamplePrecision::eActual, lngLat);
 }
@@ -75,6 +75,7 @@ class LodBody : public cs::scene::CelestialSurface,
 
   bool getIntersection(
       glm::dvec3 const& rayPos, glm::dvec3 const& rayDir, glm::dvec3& pos) const override;
+  double getBoundingRadius() const override;
   double getHeight(glm::dvec2 lngLat) const override;
 
   void update();
@@ -6,136 +6,145 @@
 // SPDX-License-Identifier: MIT
 
 #include "MinMaxPyramid.hpp"
+#include "TileCompression.hpp"
 #include "TileData.hpp"
 
-namespace csp::lodbodies {
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-// DISCLAIMER: The MinMaxPyramid was ported from a version of CosmoScout VR which used a fixed    //
-// tile resolution of 257x257. There is no guarantee that it still works 100%. This should be     //
-// tested before using it agin :)                                                                 //
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
-MinMaxPyramid::MinMaxPyramid(TileData<float>* tile)
-    : mTileResolution(tile->getResolution())
-    , mLevels(static_cast<uint32_t>(std::log2(mTileResolution)) - 1)
-    , mMinPyramid(mLevels)
-    , mMaxPyramid(mLevels) {
-
-  for (uint32_t i(0); i < mLevels; ++i) {
-    uint32_t resolution = mTileResolution / (1 << (i + 1));
-    mMinPyramid[i] = std::vector<float>(resolution * resolution, std::numeric_limits<float>::max());
-    mMaxPyramid[i] =
-        std::vector<float>(resolution * resolution, std::numeric_limits<float>::lowest());
-  }
-
-  // Construct first MinMaxPyramid layer by sampling 2x2 values
-  uint32_t halfSize = static_cast<uint32_t>((mTileResolution - 1) / 2);
-  uint32_t x2       = 0;
-  uint32_t y2       = 0;
-
-  for (uint32_t y = 0; y < mTileResolution; ++y) {
-    x2 = 0;
-    for (uint32_t x = 0; x < mTileResolution; ++x) {
-      float const v = tile->data()[y * mTileResolution + x];
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
 
-      mMinValue = std::min(mMinValue, v);
-      mMaxValue = std::max(mMaxValue, v);
-      mAvgValue += v / (mTileResolution * mTileResolution);
-
-      x2                                 = std::min(x2, halfSize - 1);
-      y2                                 = std::min(y2, halfSize - 1);
-      mMinPyramid[0][y2 * halfSize + x2] = std::min(mMinPyramid[0][y2 * halfSize + x2], v);
-      mMaxPyramid[0][y2 * halfSize + x2] = std::max(mMaxPyramid[0][y2 * halfSize + x2], v);
+namespace csp::lodbodies {
 
-      if (x % 2 == 1) {
-        x2 += 1;
-      }
-    }
+namespace {
 
-    if (y % 2 == 1) {
-      y2 += 1;
-    }
+// Converts a sample value of a tile with samples of type T to a height. Float samples are already
+// stored as actual heights.
+template <typename T>
+float toHeight(double value, glm::vec2 const& range) {
+  if constexpr (std::is_same_v<T, uint16_t>) {
+    return dequantizeElevation(static_cast<float>(value), range);
   }
 
-  // Build remaining MinMaxPyramid layers
-  for (uint32_t i(1); i < mLevels; ++i) {
-    y2 = 0;
-    for (uint32_t y = 0; y < (mTileResolution - 1) * std::pow(0.5, i); ++y) {
-      x2 = 0;
-      for (uint32_t x = 0; x < (mTileResolution - 1) * std::pow(0.5, i); ++x) {
-        mMinPyramid[i][static_cast<uint64_t>(y2 * halfSize * std::pow(0.5, i) + x2)] = std::min(
-            mMinPyramid[i - 1]
-                       [static_cast<uint64_t>(y * (mTileResolution - 1) * std::pow(0.5, i) + x)],
-            mMinPyramid[i][static_cast<uint64_t>(y2 * halfSize * std::pow(0.5, i) + x2)]);
-        mMaxPyramid[i][static_cast<uint64_t>(y2 * halfSize * std::pow(0.5, i) + x2)] = std::max(
-            mMaxPyramid[i - 1]
-                       [static_cast<uint64_t>(y * (mTileResolution - 1) * std::pow(0.5, i) + x)],
-            mMaxPyramid[i][static_cast<uint64_t>(y2 * halfSize * std::pow(0.5, i) + x2)]);
-        if (x % 2 == 1) {
-          x2 += 1;
-        }
-      }
-      if (y % 2 == 1) {
-        y2 += 1;
-      }
-    }
-  }
+  return static_cast<float>(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::vector<std::vector<float>>& MinMaxPyramid::getMinPyramid() {
-  return mMinPyramid;
+// Computes the element-wise minimum and maximum of three rows. These loops operate on contiguous
+// memory and are vectorized by the compiler.
+template <typename T>
+void combineRows(T const* a, T const* b, T const* c, T* outMin, T* outMax, uint32_t count) {
+  for (uint32_t i = 0; i < count; ++i) {
+    outMin[i] = std::min(a[i], std::min(b[i], c[i])); // NOLINT
+    outMax[i] = std::max(a[i], std::max(b[i], c[i])); // NOLINT
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::vector<std::vector<float>>& MinMaxPyramid::getMaxPyramid() {
-  return mMaxPyramid;
+// Constructs the first level of the pyramid. First, the minimum and maximum of each three
+// consecutive rows are computed. Then, the resulting rows are reduced horizontally to the cells,
+// whereby the last column of each cell is shared with its neighbour. For quantized data, this is
+// done on the integer samples, only the resulting bounds are converted to heights. This is valid as
+// the conversion is monotonic.
+template <typename T>
+void computeFirstLevel(std::vector<T> const& data, uint32_t resolution, glm::vec2 const& range,
+    uint32_t levelSize, MinMaxPyramid::Bounds* cells) {
+  uint32_t       last = resolution - 1;
+  std::vector<T> rowMin(resolution);
+  std::vector<T> rowMax(resolution);
+
+  for (uint32_t y = 0; y < levelSize; ++y) {
+    T const* r0 = data.data() + std::min(2 * y, last) * resolution;     // NOLINT
+    T const* r1 = data.data() + std::min(2 * y + 1, last) * resolution; // NOLINT
+    T const* r2 = data.data() + std::min(2 * y + 2, last) * resolution; // NOLINT
+    combineRows(r0, r1, r2, rowMin.data(), rowMax.data(), resolution);
+
+    for (uint32_t x = 0; x < levelSize; ++x) {
+      uint32_t s0 = std::min(2 * x, last);
+      uint32_t s1 = std::min(2 * x + 1, last);
+      uint32_t s2 = std::min(2 * x + 2, last);
+
+      auto& cell = cells[y * levelSize + x]; // NOLINT
+      cell.mMin  = toHeight<T>(std::min(rowMin[s0], std::min(rowMin[s1], rowMin[s2])), range);
+      cell.mMax  = toHeight<T>(std::max(rowMax[s0], std::max(rowMax[s1], rowMax[s2])), range);
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-float MinMaxPyramid::getMin(std::vector<int> const& quadrants) {
-  return getData(mMinPyramid, quadrants);
+template <typename T>
+float computeAverage(std::vector<T> const& data, glm::vec2 const& range) {
+  double sum = 0.0;
+  for (T v : data) {
+    sum += v;
+  }
+  return toHeight<T>(sum / static_cast<double>(data.size()), range);
 }
 
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-float MinMaxPyramid::getMax(std::vector<int> const& quadrants) {
-  return getData(mMaxPyramid, quadrants);
-}
+MinMaxPyramid::MinMaxPyramid(BaseTileData const* tile) {
+  uint32_t resolution = tile->getResolution();
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+  // Compute the number of cells per edge and the storage offset of each level. Cells of level 0
+  // span two samples.
+  uint32_t size   = std::max(resolution / 2, 1U);
+  uint32_t offset = 0;
 
-float MinMaxPyramid::getData(
-    std::vector<std::vector<float>>& pyramid, std::vector<int> const& quadrants) {
-  // number of pyramid levels:
-  auto qSize = quadrants.size();
-  // particular pyramid layer,
-  // where min max information of the corresponding tile resolution is stored
-  auto layerId = 7 - qSize;
-  // pyramid layer address of searched value
-  int x(0);
-  int y(0);
-  for (size_t i(0); i < qSize; ++i) {
-    int step = int(std::pow(2, qSize - (i + 1)));
-    switch (quadrants[i]) {
-    case 1:
-      x += step;
-      break;
-    case 2:
-      y += step;
-      break;
-    case 3:
-      x += step;
-      y += step;
+  while (true) {
+    mLevelSizes.push_back(size);
+    mLevelOffsets.push_back(offset);
+    offset += size * size;
+
+    if (size == 1) {
       break;
     }
+
+    size = (size + 1) / 2;
   }
 
-  return pyramid[layerId][int(y * std::pow(2, qSize) + x)];
+  mCells.resize(offset);
+
+  auto const& range = tile->getValueRange();
+
+  if (auto const* floatTile = dynamic_cast<TileData<float> const*>(tile)) {
+    mAvgValue = computeAverage(floatTile->data(), range);
+    computeFirstLevel(floatTile->data(), resolution, range, mLevelSizes[0], mCells.data());
+  } else if (auto const* quantizedTile = dynamic_cast<TileData<uint16_t> const*>(tile)) {
+    mAvgValue = computeAverage(quantizedTile->data(), range);
+    computeFirstLevel(quantizedTile->data(), resolution, range, mLevelSizes[0], mCells.data());
+  } else {
+    throw std::invalid_argument("MinMaxPyramid requires an elevation tile!");
+  }
+
+  // Build the remaining levels by combining 2x2 cells of the previous level.
+  for (uint32_t i(1); i < getLevels(); ++i) {
+    uint32_t levelSize = mLevelSizes[i];
+    uint32_t prevSize  = mLevelSizes[i - 1];
+
+    for (uint32_t y = 0; y < levelSize; ++y) {
+      uint32_t y0 = std::min(2 * y, prevSize - 1);
+      uint32_t y1 = std::min(2 * y + 1, prevSize - 1);
+
+      for (uint32_t x = 0; x < levelSize; ++x) {
+        uint32_t x0 = std::min(2 * x, prevSize - 1);
+        uint32_t x1 = std::min(2 * x + 1, prevSize - 1);
+
+        Bounds const& a = getBounds(i - 1, x0, y0);
+        Bounds const& b = getBounds(i - 1, x1, y0);
+        Bounds const& c = getBounds(i - 1, x0, y1);
+        Bounds const& d = getBounds(i - 1, x1, y1);
+
+        auto& cell = mCells[mLevelOffsets[i] + y * levelSize + x];
+        cell.mMin  = std::min(std::min(a.mMin, b.mMin), std::min(c.mMin, d.mMin));
+        cell.mMax  = std::max(std::max(a.mMax, b.mMax), std::max(c.mMax, d.mMax));
+      }
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
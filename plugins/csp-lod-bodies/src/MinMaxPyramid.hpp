@@ -14,15 +14,30 @@
 
 namespace csp::lodbodies {
 
-template <typename T>
-class TileData;
+class BaseTileData;
 
 /// The MinMaxPyramid is a data structure for finding lod data in constant time. It's similar
 /// to a quad tree but it contains precomputed min and max values at each level.
+///
+/// Level 0 is the finest level. Each of its cells covers 3x3 samples of the elevation tile, so that
+/// neighbouring cells share one row or column of samples. This way, the min and max values of a
+/// cell are conservative bounds for the bilinearly interpolated height field within the cell. Each
+/// cell of level l covers 2x2 cells of level l - 1. The last level consists of a single cell.
+///
+/// All levels are stored in one contiguous array, starting with level 0. Within each level, the
+/// cells are stored row by row.
 class MinMaxPyramid {
 
  public:
-  explicit MinMaxPyramid(TileData<float>* tile);
+  /// The minimum and maximum elevation of a cell.
+  struct Bounds {
+    float mMin = std::numeric_limits<float>::max();
+    float mMax = std::numeric_limits<float>::lowest();
+  };
+
+  /// The tile has to contain elevation data, either as float or as quantized 16-bit samples. The
+  /// bounds are always stored as actual heights.
+  explicit MinMaxPyramid(BaseTileData const* tile);
 
   MinMaxPyramid(MinMaxPyramid const& other) = default;
   MinMaxPyramid(MinMaxPyramid&& other)      = default;
@@ -32,38 +47,47 @@ class MinMaxPyramid {
 
   virtual ~MinMaxPyramid() = default;
 
-  std::vector<std::vector<float>>& getMinPyramid();
-  std::vector<std::vector<float>>& getMaxPyramid();
-
-  /// Returns the minimum value in the given quadrant.
-  ///
-  /// Requires a list of quadrant indices {[0..3], [0..3], [0..3], ...}
-  /// The number of given quadrants (q == 3 -> q0: 4x4, q1: 2x2, q2: 1x1)
-  /// determines the MinMaxPyramid level and the address for the data access.
-  /// @code
-  ///  e.g. [1, 1, 1] = 8
-  ///  e.g. [1, 1, 2] = 15
-  ///  e.g. [0, 1, 1] = 4
-  ///  e.g. [0, 1, 2] = 11
-  ///
-  ///  1   2   3  |4|  5   6   7  |8|
-  ///  9  10 |11| 12  13  14 |15| 16
-  /// 17  18  19  20  21  22  23  24
-  /// 25  26  27  28  29  30  31  32
-  /// 33  34  35  36  37  38  39  40
-  /// 41  42  43  44  45  46  47  48
-  /// 49  50  51  52  53  54  55  56
-  /// 57  58  59  60  61  62  63  64
-  /// @endcode
-  float getMin(std::vector<int> const& quadrants);
+  /// Returns the number of levels of the pyramid.
+  uint32_t getLevels() const {
+    return static_cast<uint32_t>(mLevelSizes.size());
+  }
+
+  /// Returns the number of cells along each edge of the given level.
+  uint32_t getLevelSize(uint32_t level) const {
+    return mLevelSizes[level];
+  }
+
+  /// Returns the number of elevation samples along each edge of a cell of the given level, minus
+  /// one. A cell (x, y) of this level covers the samples [x * span, (x + 1) * span].
+  uint32_t getCellSpan(uint32_t level) const {
+    return 2U << level;
+  }
+
+  /// Returns the bounds of the cell (x, y) of the given level. The coordinates must be smaller than
+  /// getLevelSize(level).
+  Bounds const& getBounds(uint32_t level, uint32_t x, uint32_t y) const {
+    return mCells[mLevelOffsets[level] + y * mLevelSizes[level] + x];
+  }
+
+  float getMin(uint32_t level, uint32_t x, uint32_t y) const {
+    return getBounds(level, x, y).mMin;
+  }
+
+  float getMax(uint32_t level, uint32_t x, uint32_t y) const {
+    return getBounds(level, x, y).mMax;
+  }
+
+  /// Returns the bounds of the entire tile.
+  Bounds const& getBounds() const {
+    return mCells.back();
+  }
+
   float getMin() const {
-    return mMinValue;
+    return getBounds().mMin;
   }
 
-  /// Returns the maximum value in the given quadrant.
-  float getMax(std::vector<int> const& quadrants);
   float getMax() const {
-    return mMaxValue;
+    return getBounds().mMax;
   }
 
   /// The average value of the whole pyramid.
@@ -71,18 +95,11 @@ class MinMaxPyramid {
     return mAvgValue;
   }
 
- protected:
-  static float getData(std::vector<std::vector<float>>& pyramid, std::vector<int> const& quadrants);
-
  private:
-  uint32_t mTileResolution{};
-  uint32_t mLevels{};
-
-  std::vector<std::vector<float>> mMinPyramid;
-  std::vector<std::vector<float>> mMaxPyramid;
+  std::vector<Bounds>   mCells;
+  std::vector<uint32_t> mLevelSizes;
+  std::vector<uint32_t> mLevelOffsets;
 
-  float mMinValue = std::numeric_limits<float>::max();
-  float mMaxValue = std::numeric_limits<float>::lowest();
   float mAvgValue = 0.F;
 };
 
@@ -14,7 +14,6 @@
 #include "../../../src/cs-utils/filesystem.hpp"
 #include "../../../src/cs-utils/utils.hpp"
 
-#include <VistaOGLExt/VistaGLSLShader.h>
 #include <VistaOGLExt/VistaOGLUtils.h>
 #include <VistaOGLExt/VistaShaderRegistry.h>
 
@@ -196,7 +195,7 @@ void PlanetShader::compile() {
 
   TerrainShader::compile();
 
-  mEclipseShadowReceiver->init(&mShader, TEX_UNIT_ECLIPSES);
+  mEclipseShadowReceiver->init(mShader->getProgram(), TEX_UNIT_ECLIPSES);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -210,35 +209,35 @@ void PlanetShader::bind() {
   TerrainShader::bind();
 
   GLint loc = -1;
-  loc       = mShader.GetUniformLocation("heightTex");
-  mShader.SetUniform(loc, TEX_UNIT_LUT);
+  loc       = mShader->getUniformLocation("heightTex");
+  mShader->setUniform(loc, TEX_UNIT_LUT);
 
-  loc = mShader.GetUniformLocation("fontTex");
-  mShader.SetUniform(loc, TEX_UNIT_FONT);
+  loc = mShader->getUniformLocation("fontTex");
+  mShader->setUniform(loc, TEX_UNIT_FONT);
 
-  loc = mShader.GetUniformLocation("heightMin");
-  mShader.SetUniform(loc, mPluginSettings->mHeightRange.get().x * 1000);
+  loc = mShader->getUniformLocation("heightMin");
+  mShader->setUniform(loc, mPluginSettings->mHeightRange.get().x * 1000);
 
-  loc = mShader.GetUniformLocation("heightMax");
-  mShader.SetUniform(loc, mPluginSettings->mHeightRange.get().y * 1000);
+  loc = mShader->getUniformLocation("heightMax");
+  mShader->setUniform(loc, mPluginSettings->mHeightRange.get().y * 1000);
 
-  loc = mShader.GetUniformLocation("slopeMin");
-  mShader.SetUniform(loc, cs::utils::convert::toRadians(mPluginSettings->mSlopeRange.get().x));
+  loc = mShader->getUniformLocation("slopeMin");
+  mShader->setUniform(loc, cs::utils::convert::toRadians(mPluginSettings->mSlopeRange.get().x));
 
-  loc = mShader.GetUniformLocation("slopeMax");
-  mShader.SetUniform(loc, cs::utils::convert::toRadians(mPluginSettings->mSlopeRange.get().y));
+  loc = mShader->getUniformLocation("slopeMax");
+  mShader->setUniform(loc, cs::utils::convert::toRadians(mPluginSettings->mSlopeRange.get().y));
 
-  loc = mShader.GetUniformLocation("ambientBrightness");
-  mShader.SetUniform(loc, mSettings->mGraphics.pAmbientBrightness.get());
+  loc = mShader->getUniformLocation("ambientBrightness");
+  mShader->setUniform(loc, mSettings->mGraphics.pAmbientBrightness.get());
 
-  loc = mShader.GetUniformLocation("ambientOcclusion");
-  mShader.SetUniform(loc, mSettings->mGraphics.pAmbientOcclusion.get());
+  loc = mShader->getUniformLocation("ambientOcclusion");
+  mShader->setUniform(loc, mSettings->mGraphics.pAmbientOcclusion.get());
 
-  loc = mShader.GetUniformLocation("texGamma");
-  mShader.SetUniform(loc, mPluginSettings->mTextureGamma.get());
+  loc = mShader->getUniformLocation("texGamma");
+  mShader->setUniform(loc, mPluginSettings->mTextureGamma.get());
 
-  loc = mShader.GetUniformLocation("uSunDirIlluminance");
-  mShader.SetUniform(loc, mSunDirection.x, mSunDirection.y, mSunDirection.z, mSunIlluminance);
+  loc = mShader->getUniformLocation("uSunDirIlluminance");
+  mShader->setUniform(loc, mSunDirection.x, mSunDirection.y, mSunDirection.z, mSunIlluminance);
 
   if (mPluginSettings->mEnableLatLongGrid.get()) {
     mFontTexture->Bind(GL_TEXTURE0 + TEX_UNIT_FONT);
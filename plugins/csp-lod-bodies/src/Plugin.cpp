@@ -10,6 +10,7 @@
 #include "LodBody.hpp"
 #include "logger.hpp"
 
+#include "../../../src/cs-core/GraphicsEngine.hpp"
 #include "../../../src/cs-core/GuiManager.hpp"
 #include "../../../src/cs-core/InputManager.hpp"
 #include "../../../src/cs-core/SolarSystem.hpp"
@@ -37,6 +38,7 @@ namespace csp::lodbodies {
 
 void from_json(nlohmann::json const& j, Plugin::Settings::Dataset& o) {
   cs::core::Settings::deserialize(j, "copyright", o.mCopyright);
+  cs::core::Settings::deserialize(j, "file", o.mFile);
   cs::core::Settings::deserialize(j, "layers", o.mLayers);
   cs::core::Settings::deserialize(j, "maxLevel", o.mMaxLevel);
   cs::core::Settings::deserialize(j, "url", o.mURL);
@@ -44,6 +46,7 @@ void from_json(nlohmann::json const& j, Plugin::Settings::Dataset& o) {
 
 void to_json(nlohmann::json& j, Plugin::Settings::Dataset const& o) {
   cs::core::Settings::serialize(j, "copyright", o.mCopyright);
+  cs::core::Settings::serialize(j, "file", o.mFile);
   cs::core::Settings::serialize(j, "layers", o.mLayers);
   cs::core::Settings::serialize(j, "maxLevel", o.mMaxLevel);
   cs::core::Settings::serialize(j, "url", o.mURL);
@@ -106,6 +109,8 @@ void from_json(nlohmann::json const& j, Plugin::Settings& o) {
   cs::core::Settings::deserialize(j, "maxGPUTilesDEM", o.mMaxGPUTilesDEM);
   cs::core::Settings::deserialize(j, "tileResolutionDEM", o.mTileResolutionDEM);
   cs::core::Settings::deserialize(j, "tileResolutionIMG", o.mTileResolutionIMG);
+  cs::core::Settings::deserialize(j, "quantizeElevationTiles", o.mQuantizeElevationTiles);
+  cs::core::Settings::deserialize(j, "compressColorTiles", o.mCompressColorTiles);
   cs::core::Settings::deserialize(j, "mapCache", o.mMapCache);
   cs::core::Settings::deserialize(j, "bodies", o.mBodies);
 }
@@ -131,6 +136,8 @@ void to_json(nlohmann::json& j, Plugin::Settings const& o) {
   cs::core::Settings::serialize(j, "maxGPUTilesDEM", o.mMaxGPUTilesDEM);
   cs::core::Settings::serialize(j, "tileResolutionDEM", o.mTileResolutionDEM);
   cs::core::Settings::serialize(j, "tileResolutionIMG", o.mTileResolutionIMG);
+  cs::core::Settings::serialize(j, "quantizeElevationTiles", o.mQuantizeElevationTiles);
+  cs::core::Settings::serialize(j, "compressColorTiles", o.mCompressColorTiles);
   cs::core::Settings::serialize(j, "mapCache", o.mMapCache);
   cs::core::Settings::serialize(j, "bodies", o.mBodies);
 }
@@ -141,7 +148,19 @@ void Plugin::init() {
 
   logger().info("Loading plugin...");
 
-  mOnLoadConnection = mAllSettings->onLoad().connect([this]() { onLoad(); });
+  // Reconfiguring the bodies recreates their tile sources and thereby drops all loaded tiles. So we
+  // skip this if neither the settings of this plugin changed nor any of the bodies was detached
+  // from its CelestialObject because the object was redefined.
+  mOnLoadConnection = mAllSettings->onLoad().connect([this]() {
+    bool bodiesAttached = std::all_of(mLodBodies.begin(), mLodBodies.end(), [this](auto const& b) {
+      auto object = mSolarSystem->getObject(b.first);
+      return object && object->getSurface() == b.second;
+    });
+
+    if (!bodiesAttached || mAllSettings->hasPluginSettingsChanged("csp-lod-bodies")) {
+      onLoad();
+    }
+  });
   mOnSaveConnection = mAllSettings->onSave().connect([this]() { onSave(); });
 
   mGuiManager->addPluginTabToSideBarFromHTML(
@@ -391,6 +410,21 @@ void Plugin::init() {
     }
   });
 
+  // Report the number of tiles which are currently requested from the tile sources. This allows
+  // other components (e.g. csp-recorder) to wait until the terrain is fully loaded.
+  mPendingRequestsCallback = mGraphicsEngine->registerPendingRequestsCallback([this]() {
+    uint32_t pending = 0;
+    for (auto const& [name, body] : mLodBodies) {
+      if (body->getDEMtileSource()) {
+        pending += static_cast<uint32_t>(body->getDEMtileSource()->getPendingRequests());
+      }
+      if (body->getIMGtileSource()) {
+        pending += static_cast<uint32_t>(body->getIMGtileSource()->getPendingRequests());
+      }
+    }
+    return pending;
+  });
+
   onLoad();
 
   logger().info("Loading done.");
@@ -405,6 +439,7 @@ void Plugin::deInit() {
   onSave();
 
   mSolarSystem->pActiveObject.disconnect(mActiveObjectConnection);
+  mGraphicsEngine->unregisterPendingRequestsCallback(mPendingRequestsCallback);
 
   for (auto const& [name, body] : mLodBodies) {
     unregisterBody(name);
@@ -487,9 +522,18 @@ void Plugin::onLoad() {
 
   // For now, we cannot re-create the GLResources.
   if (!mGLResources) {
+    bool compressColor = mPluginSettings->mCompressColorTiles.get();
+
+    if (compressColor && !GLEW_EXT_texture_compression_s3tc) {
+      logger().warn("Compressed color tiles are not supported by your graphics driver. Falling "
+                    "back to uncompressed color tiles.");
+      compressColor = false;
+    }
+
     mGLResources = std::make_shared<csp::lodbodies::GLResources>(
         mPluginSettings->mMaxGPUTilesDEM.get(), mPluginSettings->mMaxGPUTilesColor.get(),
-        mPluginSettings->mTileResolutionDEM.get(), mPluginSettings->mTileResolutionIMG.get());
+        mPluginSettings->mTileResolutionDEM.get(), mPluginSettings->mTileResolutionIMG.get(),
+        mPluginSettings->mQuantizeElevationTiles.get(), compressColor);
 
     mPluginSettings->mMaxGPUTilesColor.connect([](uint32_t /*val*/) {
       logger().warn("Changing the maximum number of allocated color tiles at run-time is not "
@@ -510,6 +554,16 @@ void Plugin::onLoad() {
       logger().warn("Changing the tile resolution at run-time is not supported. Please restart "
                     "CosmoScout VR!");
     });
+
+    mPluginSettings->mCompressColorTiles.connect([](bool /*val*/) {
+      logger().warn("Changing the color tile compression at run-time is not supported. Please "
+                    "restart CosmoScout VR!");
+    });
+
+    mPluginSettings->mQuantizeElevationTiles.connect([](bool /*val*/) {
+      logger().warn("Changing the elevation tile quantization at run-time is not supported. Please "
+                    "restart CosmoScout VR!");
+    });
   }
 
   // First try to re-configure existing lodBodies. We assume that they are similar if they have
@@ -600,14 +654,25 @@ void Plugin::setImageSource(std::shared_ptr<LodBody> const& body, std::string co
 
     settings.mActiveImgDataset = dataset->first;
 
-    auto source =
-        std::make_shared<TileSourceWebMapService>(mPluginSettings->mTileResolutionIMG.get());
-    source->setCacheDirectory(mPluginSettings->mMapCache.get());
-    source->setLayers(dataset->second.mLayers);
-    source->setUrl(dataset->second.mURL);
-    source->setDataType(TileDataType::eColor);
+    // This has to match the format of the texture array, which cannot be changed at run-time.
+    bool compress   = mGLResources->get(TileDataType::eColor)->isCompact();
+    auto resolution = mPluginSettings->mTileResolutionIMG.get();
 
-    body->setIMGtileSource(source, dataset->second.mMaxLevel);
+    if (dataset->second.mFile) {
+      auto source = std::make_shared<TileSourceGeoTiff>(resolution);
+      source->setFile(*dataset->second.mFile);
+      source->setDataType(TileDataType::eColor);
+      source->setCompressColor(compress);
+      body->setIMGtileSource(source, dataset->second.mMaxLevel);
+    } else {
+      auto source = std::make_shared<TileSourceWebMapService>(resolution);
+      source->setCacheDirectory(mPluginSettings->mMapCache.get());
+      source->setLayers(dataset->second.mLayers);
+      source->setUrl(dataset->second.mURL);
+      source->setDataType(TileDataType::eColor);
+      source->setCompressColor(compress);
+      body->setIMGtileSource(source, dataset->second.mMaxLevel);
+    }
 
     mGuiManager->getGui()->callJavascript(
         "CosmoScout.lodBodies.setMapDataCopyright", dataset->second.mCopyright);
@@ -630,14 +695,25 @@ void Plugin::setElevationSource(
 
   settings.mActiveDemDataset = dataset->first;
 
-  auto source =
-      std::make_shared<TileSourceWebMapService>(mPluginSettings->mTileResolutionDEM.get());
-  source->setCacheDirectory(mPluginSettings->mMapCache.get());
-  source->setLayers(dataset->second.mLayers);
-  source->setUrl(dataset->second.mURL);
-  source->setDataType(TileDataType::eElevation);
+  // This has to match the format of the texture array, which cannot be changed at run-time.
+  bool quantize   = mGLResources->get(TileDataType::eElevation)->isCompact();
+  auto resolution = mPluginSettings->mTileResolutionDEM.get();
 
-  body->setDEMtileSource(source, dataset->second.mMaxLevel);
+  if (dataset->second.mFile) {
+    auto source = std::make_shared<TileSourceGeoTiff>(resolution);
+    source->setFile(*dataset->second.mFile);
+    source->setDataType(TileDataType::eElevation);
+    source->setQuantizeElevation(quantize);
+    body->setDEMtileSource(source, dataset->second.mMaxLevel);
+  } else {
+    auto source = std::make_shared<TileSourceWebMapService>(resolution);
+    source->setCacheDirectory(mPluginSettings->mMapCache.get());
+    source->setLayers(dataset->second.mLayers);
+    source->setUrl(dataset->second.mURL);
+    source->setDataType(TileDataType::eElevation);
+    source->setQuantizeElevation(quantize);
+    body->setDEMtileSource(source, dataset->second.mMaxLevel);
+  }
 
   mGuiManager->getGui()->callJavascript(
       "CosmoScout.lodBodies.setElevationDataCopyright", dataset->second.mCopyright);
@@ -12,9 +12,11 @@
 #include "../../../src/cs-utils/DefaultProperty.hpp"
 
 #include "TileDataType.hpp"
+#include "TileSourceGeoTiff.hpp"
 #include "TileSourceWebMapService.hpp"
 
 #include <glm/gtc/constants.hpp>
+#include <optional>
 #include <vector>
 
 class VistaOpenGLNode;
@@ -105,6 +107,16 @@ class Plugin : public cs::core::PluginBase {
     /// The image channel resolution used for the tile textures.
     cs::utils::DefaultProperty<uint32_t> mTileResolutionIMG{512};
 
+    /// If enabled, elevation tiles are quantized to 16 bit relative to the height range of each
+    /// tile. This halves their memory requirements in the map cache, in RAM and on the GPU. The
+    /// resulting error is at most the height range of a tile divided by 131070.
+    cs::utils::DefaultProperty<bool> mQuantizeElevationTiles{false};
+
+    /// If enabled, color tiles are BC1-compressed on the loading threads. They then need an eighth
+    /// of the GPU memory, so mMaxGPUTilesColor can be increased accordingly. The encoded tiles are
+    /// stored in the map cache.
+    cs::utils::DefaultProperty<bool> mCompressColorTiles{false};
+
     /// Path to the map cache folder, can be absolute or relative to the cosmoscout executable.
     cs::utils::DefaultProperty<std::string> mMapCache{"map-cache"};
 
@@ -127,6 +139,9 @@ class Plugin : public cs::core::PluginBase {
       std::string mCopyright;  ///< The copyright holder of the data set (also shown in the UI).
       std::string mLayers;     ///< A comma,seperated list of WMS layers.
       uint32_t    mMaxLevel{}; ///< The maximum quadtree depth to load.
+
+      /// If set, the data is read from this local GeoTIFF file instead of the mapserver.
+      std::optional<std::string> mFile;
     };
 
     /// The startup settings for a planet.
@@ -165,9 +180,10 @@ class Plugin : public cs::core::PluginBase {
   std::map<std::string, std::shared_ptr<LodBody>> mLodBodies;
   float                                           mAutoLod{};
 
-  int mActiveObjectConnection = -1;
-  int mOnLoadConnection       = -1;
-  int mOnSaveConnection       = -1;
+  int mActiveObjectConnection  = -1;
+  int mOnLoadConnection        = -1;
+  int mOnSaveConnection        = -1;
+  int mPendingRequestsCallback = -1;
 };
 
 } // namespace csp::lodbodies
@@ -7,10 +7,10 @@
 
 #include "TerrainShader.hpp"
 
+#include "../../../src/cs-graphics/ShaderCache.hpp"
 #include "../../../src/cs-utils/filesystem.hpp"
 #include "../../../src/cs-utils/utils.hpp"
 
-#include <VistaOGLExt/VistaGLSLShader.h>
 #include <VistaOGLExt/VistaShaderRegistry.h>
 
 #include <utility>
@@ -32,13 +32,13 @@ void TerrainShader::bind() {
     mShaderDirty = false;
   }
 
-  mShader.Bind();
+  mShader->bind();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void TerrainShader::release() {
-  mShader.Release();
+  mShader->release();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -58,10 +58,7 @@ void TerrainShader::compile() {
       cs::utils::filesystem::loadToString(
           "../share/resources/shaders/VistaPlanetTerrainShaderUniforms.glsl"));
 
-  mShader = VistaGLSLShader();
-  mShader.InitVertexShaderFromString(mVertexSource);
-  mShader.InitFragmentShaderFromString(mFragmentSource);
-  mShader.Link();
+  mShader = cs::graphics::ShaderCache::get().getShader(mVertexSource, mFragmentSource);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -8,11 +8,11 @@
 #ifndef CSP_LOD_BODIES_TERRAINSHADER_HPP
 #define CSP_LOD_BODIES_TERRAINSHADER_HPP
 
+#include "../../../src/cs-graphics/ShaderProgram.hpp"
+
 #include <memory>
 #include <string>
 
-#include <VistaOGLExt/VistaGLSLShader.h>
-
 namespace csp::lodbodies {
 
 /// The base class for the PlanetShader. It builds the shader from various sources and links it.
@@ -37,10 +37,10 @@ class TerrainShader {
  protected:
   virtual void compile();
 
-  bool            mShaderDirty = true;
-  std::string     mVertexSource;
-  std::string     mFragmentSource;
-  VistaGLSLShader mShader;
+  bool                                         mShaderDirty = true;
+  std::string                                  mVertexSource;
+  std::string                                  mFragmentSource;
+  std::shared_ptr<cs::graphics::ShaderProgram> mShader;
 };
 
 } // namespace csp::lodbodies
@@ -93,8 +93,9 @@ BoundingBox<double> calcTileBounds(
     TileNode const& tile, glm::dvec3 const& radii, double heightScale) {
 
   if (tile.getMinMaxPyramid()) {
-    return calcTileBounds(tile.getMinMaxPyramid()->getMin(), tile.getMinMaxPyramid()->getMax(),
-        tile.getLevel(), tile.getPatchIdx(), radii, heightScale);
+    auto const& bounds = tile.getMinMaxPyramid()->getBounds();
+    return calcTileBounds(
+        bounds.mMin, bounds.mMax, tile.getLevel(), tile.getPatchIdx(), radii, heightScale);
   }
 
   return BoundingBox<double>();
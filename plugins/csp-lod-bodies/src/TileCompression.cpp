@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "TileCompression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace csp::lodbodies {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint16_t packRGB565(glm::ivec3 const& color) {
+  return static_cast<uint16_t>(((color.r >> 3) << 11) | ((color.g >> 2) << 5) | (color.b >> 3));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Expands an RGB565 color to eight bits per channel the same way the GPU does.
+glm::ivec3 unpackRGB565(uint16_t color) {
+  int r = (color >> 11) & 31;
+  int g = (color >> 5) & 63;
+  int b = color & 31;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The four colors a BC1 block can select from in four-color mode (mColor0 > mColor1).
+std::array<glm::ivec3, 4> getPalette(uint16_t color0, uint16_t color1) {
+  glm::ivec3 c0 = unpackRGB565(color0);
+  glm::ivec3 c1 = unpackRGB565(color1);
+
+  if (color0 > color1) {
+    return {c0, c1, (2 * c0 + c1) / 3, (c0 + 2 * c1) / 3};
+  }
+
+  // Three-color mode, the fourth color would be transparent black. The encoder never uses it.
+  return {c0, c1, (c0 + c1) / 2, glm::ivec3(0)};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BC1Block compressBlock(std::array<glm::ivec3, 16> const& samples) {
+  glm::ivec3 minColor(255);
+  glm::ivec3 maxColor(0);
+
+  for (auto const& s : samples) {
+    minColor = glm::min(minColor, s);
+    maxColor = glm::max(maxColor, s);
+  }
+
+  // Moving the endpoints slightly inwards reduces the error for most blocks since the extreme
+  // samples are then represented by the interpolated colors as well.
+  glm::ivec3 inset = (maxColor - minColor) / 16;
+  minColor         = glm::min(minColor + inset, glm::ivec3(255));
+  maxColor         = glm::max(maxColor - inset, glm::ivec3(0));
+
+  BC1Block block{packRGB565(maxColor), packRGB565(minColor), 0U};
+
+  // Both endpoints are quantized to the same color. Index zero then selects this color for all
+  // samples.
+  if (block.mColor0 == block.mColor1) {
+    return block;
+  }
+
+  if (block.mColor0 < block.mColor1) {
+    std::swap(block.mColor0, block.mColor1);
+  }
+
+  auto palette = getPalette(block.mColor0, block.mColor1);
+
+  for (size_t i = 0; i < samples.size(); ++i) {
+    uint32_t bestIndex    = 0;
+    int      bestDistance = std::numeric_limits<int>::max();
+
+    for (uint32_t p = 0; p < 4; ++p) {
+      glm::ivec3 diff     = samples[i] - palette[p];
+      int        distance = diff.r * diff.r + diff.g * diff.g + diff.b * diff.b;
+
+      if (distance < bestDistance) {
+        bestDistance = distance;
+        bestIndex    = p;
+      }
+    }
+
+    block.mIndices |= bestIndex << (2 * i);
+  }
+
+  return block;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<TileData<BC1Block>> compressBC1(TileData<glm::u8vec4> const& tile) {
+  uint32_t resolution = tile.getResolution();
+  uint32_t blockCount = (resolution + 3) / 4;
+  auto     result     = std::make_shared<TileData<BC1Block>>(resolution);
+
+  auto const&                pixels = tile.data();
+  std::array<glm::ivec3, 16> samples{};
+
+  for (uint32_t by = 0; by < blockCount; ++by) {
+    for (uint32_t bx = 0; bx < blockCount; ++bx) {
+      for (uint32_t i = 0; i < 16; ++i) {
+        uint32_t x = std::min(bx * 4 + i % 4, resolution - 1);
+        uint32_t y = std::min(by * 4 + i / 4, resolution - 1);
+        samples.at(i) = glm::ivec3(pixels[y * resolution + x]);
+      }
+
+      result->data()[by * blockCount + bx] = compressBlock(samples);
+    }
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+glm::u8vec4 decompressBC1(TileData<BC1Block> const& tile, uint32_t x, uint32_t y) {
+  uint32_t    blockCount = (tile.getResolution() + 3) / 4;
+  auto const& block      = tile.data()[(y / 4) * blockCount + x / 4];
+  uint32_t    index      = (block.mIndices >> (2 * ((y % 4) * 4 + x % 4))) & 3U;
+  auto        palette    = getPalette(block.mColor0, block.mColor1);
+
+  return glm::u8vec4(glm::u8vec3(palette.at(index)), 255);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<TileData<uint16_t>> quantizeElevation(
+    TileData<float> const& tile, float* maxError) {
+  auto        result  = std::make_shared<TileData<uint16_t>>(tile.getResolution());
+  auto const& heights = tile.data();
+  auto&       samples = result->data();
+
+  auto [minIt, maxIt] = std::minmax_element(heights.begin(), heights.end());
+  glm::vec2 range(*minIt, *maxIt);
+  result->setValueRange(range);
+
+  // All samples are zero for flat tiles.
+  float scale = range.y > range.x ? 65535.F / (range.y - range.x) : 0.F;
+  float error = 0.F;
+
+  for (size_t i = 0; i < heights.size(); ++i) {
+    long sample = std::lround((heights[i] - range.x) * scale);
+    samples[i]  = static_cast<uint16_t>(std::clamp(sample, 0L, 65535L));
+    error       = std::max(error, std::abs(dequantizeElevation(samples[i], range) - heights[i]));
+  }
+
+  if (maxError) {
+    *maxError = error;
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace csp::lodbodies
@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CSP_LOD_BODIES_TILE_COMPRESSION_HPP
+#define CSP_LOD_BODIES_TILE_COMPRESSION_HPP
+
+#include "TileData.hpp"
+
+#include <memory>
+
+namespace csp::lodbodies {
+
+/// Encodes a color tile to BC1 blocks. This is meant to be called on the tile loading threads, it
+/// uses a fast bounding-box endpoint fit which is good enough for satellite imagery. The alpha
+/// channel of the input is ignored. If the resolution is not a multiple of four, the samples at
+/// the edge are repeated to fill the last blocks.
+std::shared_ptr<TileData<BC1Block>> compressBC1(TileData<glm::u8vec4> const& tile);
+
+/// Decodes a single sample of a BC1-compressed tile. This is only used for testing and debugging,
+/// the GPU decodes the blocks during rendering.
+glm::u8vec4 decompressBC1(TileData<BC1Block> const& tile, uint32_t x, uint32_t y);
+
+/// Quantizes an elevation tile to 16-bit samples which are normalized to the minimum and maximum
+/// height of the tile, see BaseTileData::getValueRange(). The samples are rounded, so the error of
+/// the dequantized heights is at most half of the range divided by 65535. The actual maximum error
+/// is written to maxError if it is not null.
+std::shared_ptr<TileData<uint16_t>> quantizeElevation(
+    TileData<float> const& tile, float* maxError = nullptr);
+
+/// Converts a quantized elevation sample in [0, 65535] to a height. The terrain shader does the
+/// same with the normalized samples of the GL_R16 texture.
+inline float dequantizeElevation(float sample, glm::vec2 const& range) {
+  return glm::mix(range.x, range.y, sample / 65535.F);
+}
+
+} // namespace csp::lodbodies
+
+#endif // CSP_LOD_BODIES_TILE_COMPRESSION_HPP
@@ -10,8 +10,20 @@
 
 #include "BaseTileData.hpp"
 
+#include <vector>
+
 namespace csp::lodbodies {
 
+/// A block of 4x4 color samples compressed with the BC1 scheme (also known as DXT1). The two
+/// endpoint colors are stored as RGB565, each sample selects one of four colors interpolated
+/// between them with a two-bit index. This needs an eighth of the memory of uncompressed RGBA8
+/// samples.
+struct BC1Block {
+  uint16_t mColor0;
+  uint16_t mColor1;
+  uint32_t mIndices;
+};
+
 /// Concrete class storing data samples of the template argument type T.
 template <typename T>
 class TileData : public BaseTileData {
@@ -34,6 +46,8 @@ class TileData : public BaseTileData {
 
   void const* getDataPtr() const override;
   void*       getDataPtr() override;
+  std::size_t getDataSize() const override;
+  bool        isCompressed() const override;
 
   std::vector<T> const& data() const;
   std::vector<T>&       data();
@@ -47,25 +61,59 @@ namespace detail {
 /// DataTypeTrait<T> is used to map from a type T to the corresponding TileDataType enum value.
 /// To support additional data types stored in a TileData add a specialization. Only declare base
 /// template, define explicit specializations for supported types below - this causes a convenient
-/// compile error if an attempt is made to instantiate TileData<T> with an unsupported type T
+/// compile error if an attempt is made to instantiate TileData<T> with an unsupported type T.
+/// The trait also provides the number of elements required for a tile of the given resolution.
 template <typename T>
 struct DataTypeTrait;
 
 template <>
 struct DataTypeTrait<float> {
-  static TileDataType const value = TileDataType::eElevation;
+  static TileDataType const value      = TileDataType::eElevation;
+  static bool const         compressed = false;
+
+  static std::size_t getCount(uint32_t resolution) {
+    return static_cast<std::size_t>(resolution) * resolution;
+  }
+};
+
+// Elevation samples quantized to 16 bit, see BaseTileData::getValueRange().
+template <>
+struct DataTypeTrait<uint16_t> {
+  static TileDataType const value      = TileDataType::eElevation;
+  static bool const         compressed = false;
+
+  static std::size_t getCount(uint32_t resolution) {
+    return static_cast<std::size_t>(resolution) * resolution;
+  }
 };
 
 template <>
 struct DataTypeTrait<glm::u8vec4> {
-  static TileDataType const value = TileDataType::eColor;
+  static TileDataType const value      = TileDataType::eColor;
+  static bool const         compressed = false;
+
+  static std::size_t getCount(uint32_t resolution) {
+    return static_cast<std::size_t>(resolution) * resolution;
+  }
+};
+
+template <>
+struct DataTypeTrait<BC1Block> {
+  static TileDataType const value      = TileDataType::eColor;
+  static bool const         compressed = true;
+
+  // Partial blocks at the right and top edges are padded.
+  static std::size_t getCount(uint32_t resolution) {
+    std::size_t blocks = (resolution + 3) / 4;
+    return blocks * blocks;
+  }
 };
 } // namespace detail
 
 template <typename T>
 TileData<T>::TileData(uint32_t resolution)
     : BaseTileData(resolution)
-    , mData(resolution * resolution) {
+    , mData(detail::DataTypeTrait<T>::getCount(resolution)) {
 }
 
 template <typename T>
@@ -91,6 +139,16 @@ void* TileData<T>::getDataPtr() {
   return static_cast<void*>(mData.data());
 }
 
+template <typename T>
+std::size_t TileData<T>::getDataSize() const {
+  return mData.size() * sizeof(T);
+}
+
+template <typename T>
+bool TileData<T>::isCompressed() const {
+  return detail::DataTypeTrait<T>::compressed;
+}
+
 template <typename T>
 std::vector<T> const& TileData<T>::data() const {
   return mData;
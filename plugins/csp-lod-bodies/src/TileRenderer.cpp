@@ -186,36 +186,36 @@ void TileRenderer::preRenderTiles(cs::graphics::ShadowMap* shadowMap) {
 
   mVaoTerrain->Bind();
   mProgTerrain->bind();
-  VistaGLSLShader& shader = mProgTerrain->mShader;
+  cs::graphics::ShaderProgram& shader = *mProgTerrain->mShader;
 
   // update "frame global" uniforms
-  GLint loc = shader.GetUniformLocation("VP_matProjection");
+  GLint loc = shader.getUniformLocation("VP_matProjection");
   glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(mMatP));
-  loc = shader.GetUniformLocation("VP_matModel");
+  loc = shader.getUniformLocation("VP_matModel");
   glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(glm::mat4(mMatM)));
-  loc = shader.GetUniformLocation("VP_matView");
+  loc = shader.getUniformLocation("VP_matView");
   glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(mMatV));
-  loc = shader.GetUniformLocation("VP_heightScale");
-  shader.SetUniform(loc, static_cast<float>(mParams->mHeightScale));
-  loc = shader.GetUniformLocation("VP_radii");
-  shader.SetUniform(loc, static_cast<float>(mParams->mRadii.x),
+  loc = shader.getUniformLocation("VP_heightScale");
+  shader.setUniform(loc, static_cast<float>(mParams->mHeightScale));
+  loc = shader.getUniformLocation("VP_radii");
+  shader.setUniform(loc, static_cast<float>(mParams->mRadii.x),
       static_cast<float>(mParams->mRadii.y), static_cast<float>(mParams->mRadii.z));
-  loc = shader.GetUniformLocation("VP_texDEM");
-  shader.SetUniform(loc, texUnitDEM);
-  loc = shader.GetUniformLocation("VP_texIMG");
-  shader.SetUniform(loc, texUnitIMG);
-  loc = shader.GetUniformLocation("VP_shadowMapMode");
-  shader.SetUniform(loc, shadowMap == nullptr);
+  loc = shader.getUniformLocation("VP_texDEM");
+  shader.setUniform(loc, texUnitDEM);
+  loc = shader.getUniformLocation("VP_texIMG");
+  shader.setUniform(loc, texUnitIMG);
+  loc = shader.getUniformLocation("VP_shadowMapMode");
+  shader.setUniform(loc, shadowMap == nullptr);
 
   if (shadowMap) {
-    shader.SetUniform(shader.GetUniformLocation("VP_shadowBias"), shadowMap->getBias());
-    shader.SetUniform(shader.GetUniformLocation("VP_shadowCascades"),
+    shader.setUniform(shader.getUniformLocation("VP_shadowBias"), shadowMap->getBias());
+    shader.setUniform(shader.getUniformLocation("VP_shadowCascades"),
         static_cast<int>(shadowMap->getMaps().size()));
 
     for (size_t i = 0; i < shadowMap->getMaps().size(); ++i) {
       GLint locSamplers = glGetUniformLocation(
-          shader.GetProgram(), ("VP_shadowMaps[" + std::to_string(i) + "]").c_str());
-      GLint locMatrices = glGetUniformLocation(shader.GetProgram(),
+          shader.getProgram(), ("VP_shadowMaps[" + std::to_string(i) + "]").c_str());
+      GLint locMatrices = glGetUniformLocation(shader.getProgram(),
           ("VP_shadowProjectionViewMatrices[" + std::to_string(i) + "]").c_str());
 
       shadowMap->getMaps()[i]->Bind(GL_TEXTURE0 + texUnitShadow + static_cast<int>(i));
@@ -230,14 +230,15 @@ void TileRenderer::preRenderTiles(cs::graphics::ShadowMap* shadowMap) {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void TileRenderer::renderTiles(std::vector<TileNode*> const& nodes) {
-  VistaGLSLShader& shader = mProgTerrain->mShader;
+  cs::graphics::ShaderProgram& shader = *mProgTerrain->mShader;
 
   // query uniform locations once and store in locs
   UniformLocs locs{};
-  locs.heightInfo  = shader.GetUniformLocation("VP_heightInfo");
-  locs.offsetScale = shader.GetUniformLocation("VP_offsetScale");
-  locs.f1f2        = shader.GetUniformLocation("VP_f1f2");
-  locs.dataLayers  = shader.GetUniformLocation("VP_dataLayers");
+  locs.heightInfo  = shader.getUniformLocation("VP_heightInfo");
+  locs.heightRange = shader.getUniformLocation("VP_heightRange");
+  locs.offsetScale = shader.getUniformLocation("VP_offsetScale");
+  locs.f1f2        = shader.getUniformLocation("VP_f1f2");
+  locs.dataLayers  = shader.getUniformLocation("VP_dataLayers");
 
   for (auto* node : nodes) {
     renderTile(node, locs);
@@ -255,16 +256,17 @@ void TileRenderer::renderTile(TileNode* node, UniformLocs const& locs) {
     return;
   }
 
-  VistaGLSLShader& shader = mProgTerrain->mShader;
+  cs::graphics::ShaderProgram& shader = *mProgTerrain->mShader;
 
   float averageHeight = node->getMinMaxPyramid()->getAverage();
   float minHeight     = node->getMinMaxPyramid()->getMin();
   float maxHeight     = node->getMinMaxPyramid()->getMax();
 
   // update uniforms
-  shader.SetUniform(locs.heightInfo, averageHeight, maxHeight - minHeight);
-  shader.SetUniform(locs.offsetScale, 3, 1, glm::value_ptr(node->getTileOffsetScale()));
-  shader.SetUniform(locs.f1f2, 2, 1, glm::value_ptr(node->getTileF1F2()));
+  shader.setUniform(locs.heightInfo, averageHeight, maxHeight - minHeight);
+  shader.setUniform(locs.heightRange, dem->getValueRange().x, dem->getValueRange().y);
+  shader.setUniform(locs.offsetScale, 3, 1, glm::value_ptr(node->getTileOffsetScale()));
+  shader.setUniform(locs.f1f2, 2, 1, glm::value_ptr(node->getTileF1F2()));
 
   glUniform2i(locs.dataLayers, dem->getTexLayer(), img ? img->getTexLayer() : 0);
 
@@ -285,9 +287,9 @@ void TileRenderer::renderTile(TileNode* node, UniformLocs const& locs) {
     normalsWorldSpace.at(i) = glm::fvec3(mMatN * glm::dvec4(normals.at(i), 0.0));
   }
 
-  glUniform3fv(glGetUniformLocation(shader.GetProgram(), "VP_corners"), 9,
+  glUniform3fv(glGetUniformLocation(shader.getProgram(), "VP_corners"), 9,
       glm::value_ptr(cornersWorldSpace[0]));
-  glUniform3fv(glGetUniformLocation(shader.GetProgram(), "VP_normals"), 4,
+  glUniform3fv(glGetUniformLocation(shader.getProgram(), "VP_normals"), 4,
       glm::value_ptr(normalsWorldSpace[0]));
 
   // draw tile
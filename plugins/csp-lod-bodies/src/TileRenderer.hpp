@@ -70,6 +70,7 @@ class TileRenderer {
  private:
   struct UniformLocs {
     GLint heightInfo;
+    GLint heightRange;
     GLint offsetScale;
     GLint f1f2;
     GLint dataLayers;
@@ -0,0 +1,676 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "TileSourceGeoTiff.hpp"
+
+#include "HEALPix.hpp"
+#include "TileCompression.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <tiffio.h>
+#include <unordered_map>
+
+namespace csp::lodbodies {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// libtiff does not know the GeoTIFF tags. They are registered with the same properties libtiff
+// would give to anonymous fields, hence reading them always requires a count argument.
+uint32_t const TAG_MODEL_PIXEL_SCALE   = 33550;
+uint32_t const TAG_MODEL_TIEPOINT      = 33922;
+uint32_t const TAG_GEO_KEY_DIRECTORY   = 34735;
+uint32_t const TAG_GEO_DOUBLE_PARAMS   = 34736;
+uint32_t const TAG_GEO_ASCII_PARAMS    = 34737;
+uint32_t const TAG_GDAL_METADATA       = 42112;
+uint32_t const TAG_GDAL_NODATA         = 42113;
+uint16_t const KEY_MODEL_TYPE          = 1024;
+uint16_t const KEY_RASTER_TYPE         = 1025;
+uint16_t const MODEL_TYPE_GEOGRAPHIC   = 2;
+uint16_t const RASTER_TYPE_PIXEL_POINT = 2;
+
+std::array<TIFFFieldInfo, 7> const GEOTIFF_FIELDS = {{
+    {TAG_MODEL_PIXEL_SCALE, TIFF_VARIABLE2, TIFF_VARIABLE2, TIFF_DOUBLE, FIELD_CUSTOM, 1, 1,
+        const_cast<char*>("ModelPixelScaleTag")},
+    {TAG_MODEL_TIEPOINT, TIFF_VARIABLE2, TIFF_VARIABLE2, TIFF_DOUBLE, FIELD_CUSTOM, 1, 1,
+        const_cast<char*>("ModelTiepointTag")},
+    {TAG_GEO_KEY_DIRECTORY, TIFF_VARIABLE2, TIFF_VARIABLE2, TIFF_SHORT, FIELD_CUSTOM, 1, 1,
+        const_cast<char*>("GeoKeyDirectoryTag")},
+    {TAG_GEO_DOUBLE_PARAMS, TIFF_VARIABLE2, TIFF_VARIABLE2, TIFF_DOUBLE, FIELD_CUSTOM, 1, 1,
+        const_cast<char*>("GeoDoubleParamsTag")},
+    {TAG_GEO_ASCII_PARAMS, TIFF_VARIABLE2, TIFF_VARIABLE2, TIFF_ASCII, FIELD_CUSTOM, 1, 1,
+        const_cast<char*>("GeoAsciiParamsTag")},
+    {TAG_GDAL_METADATA, TIFF_VARIABLE2, TIFF_VARIABLE2, TIFF_ASCII, FIELD_CUSTOM, 1, 1,
+        const_cast<char*>("GDALMetadata")},
+    {TAG_GDAL_NODATA, TIFF_VARIABLE2, TIFF_VARIABLE2, TIFF_ASCII, FIELD_CUSTOM, 1, 1,
+        const_cast<char*>("GDALNoDataValue")},
+}};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// libtiff calls the tag extender whenever a file is opened. Other extenders which have been
+// registered before are called as well.
+TIFFExtendProc parentExtender = nullptr;
+
+void extendTags(tiff* handle) {
+  TIFFMergeFieldInfo(handle, GEOTIFF_FIELDS.data(), static_cast<uint32_t>(GEOTIFF_FIELDS.size()));
+
+  if (parentExtender) {
+    parentExtender(handle);
+  }
+}
+
+// Without this, libtiff would print a warning for each of the GeoTIFF tags whenever a directory is
+// read. Only the set of known tags is extended, the warning and error handlers are not touched.
+void registerGeoTiffTags() {
+  static std::once_flag flag;
+  std::call_once(flag, []() { parentExtender = TIFFSetTagExtender(extendTags); });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns the given channel of the pixel starting at the given address.
+double readSample(uint8_t const* pixel, uint16_t bitsPerSample, uint32_t channel) {
+  switch (bitsPerSample) {
+  case 8:
+    return pixel[channel];
+  case 16: {
+    uint16_t value{};
+    std::memcpy(&value, pixel + channel * sizeof(uint16_t), sizeof(uint16_t));
+    return value;
+  }
+  default: {
+    float value{};
+    std::memcpy(&value, pixel + channel * sizeof(float), sizeof(float));
+    return value;
+  }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Reads pixels from one image of a TIFF file. The internal blocks (tiles or strips) of the image
+// are decoded on demand and kept until the reader is destroyed. Hence each block is decoded at
+// most once per loaded tile.
+class BlockReader {
+ public:
+  BlockReader(tiff* handle, uint32_t width, uint32_t height, size_t pixelSize)
+      : mHandle(handle)
+      , mWidth(width)
+      , mHeight(height)
+      , mPixelSize(pixelSize)
+      , mTiled(TIFFIsTiled(handle) != 0) {
+
+    if (mTiled) {
+      TIFFGetField(handle, TIFFTAG_TILEWIDTH, &mBlockWidth);
+      TIFFGetField(handle, TIFFTAG_TILELENGTH, &mBlockHeight);
+      mBlockSize = static_cast<size_t>(TIFFTileSize(handle));
+    } else {
+      TIFFGetFieldDefaulted(handle, TIFFTAG_ROWSPERSTRIP, &mBlockHeight);
+      mBlockWidth  = width;
+      mBlockHeight = std::min(mBlockHeight, height);
+      mBlockSize   = static_cast<size_t>(TIFFStripSize(handle));
+    }
+  }
+
+  // Returns nullptr if the pixel is outside of the image.
+  uint8_t const* getPixel(int64_t x, int64_t y) {
+    if (x < 0 || y < 0 || x >= mWidth || y >= mHeight) {
+      return nullptr;
+    }
+
+    auto px = static_cast<uint32_t>(x);
+    auto py = static_cast<uint32_t>(y);
+
+    uint32_t index = mTiled ? TIFFComputeTile(mHandle, px, py, 0, 0)
+                            : TIFFComputeStrip(mHandle, py, 0);
+
+    auto block = mBlocks.find(index);
+
+    if (block == mBlocks.end()) {
+      std::vector<uint8_t> data(mBlockSize);
+
+      auto     size = static_cast<tmsize_t>(mBlockSize);
+      tmsize_t read = mTiled ? TIFFReadEncodedTile(mHandle, index, data.data(), size)
+                             : TIFFReadEncodedStrip(mHandle, index, data.data(), size);
+
+      if (read < 0) {
+        throw std::runtime_error("Failed to decode block " + std::to_string(index) + "!");
+      }
+
+      block = mBlocks.emplace(index, std::move(data)).first;
+    }
+
+    uint32_t bx = mTiled ? px % mBlockWidth : px;
+    uint32_t by = py % mBlockHeight;
+
+    return block->second.data() + (static_cast<size_t>(by) * mBlockWidth + bx) * mPixelSize;
+  }
+
+ private:
+  tiff*    mHandle;
+  int64_t  mWidth;
+  int64_t  mHeight;
+  size_t   mPixelSize;
+  bool     mTiled;
+  uint32_t mBlockWidth{};
+  uint32_t mBlockHeight{};
+  size_t   mBlockSize{};
+
+  std::unordered_map<uint32_t, std::vector<uint8_t>> mBlocks;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+T toTileSample(std::array<double, 4> const& channels, uint16_t channelCount);
+
+template <>
+float toTileSample<float>(std::array<double, 4> const& channels, uint16_t /*channelCount*/) {
+  return static_cast<float>(channels[0]);
+}
+
+template <>
+glm::u8vec4 toTileSample<glm::u8vec4>(
+    std::array<double, 4> const& channels, uint16_t channelCount) {
+  auto toByte = [](double value) {
+    return static_cast<uint8_t>(std::clamp(std::lround(value), 0L, 255L));
+  };
+
+  // Gray-scale images are expanded to RGB. An alpha channel is ignored, as the tiles are always
+  // opaque.
+  if (channelCount < 3) {
+    uint8_t gray = toByte(channels[0]);
+    return {gray, gray, gray, 255};
+  }
+
+  return {toByte(channels[0]), toByte(channels[1]), toByte(channels[2]), 255};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TileSourceGeoTiff::HandleDeleter::operator()(tiff* handle) const {
+  TIFFClose(handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TileSourceGeoTiff::TileSourceGeoTiff(uint32_t resolution)
+    : mResolution(resolution)
+    , mThreadPool(std::max(std::thread::hardware_concurrency(), 1U)) {
+  registerGeoTiffTags();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TileSourceGeoTiff::~TileSourceGeoTiff() = default;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TileSourceGeoTiff::init() {
+  if (mValid) {
+    return;
+  }
+
+  // The file is opened in read-only mode which memory-maps it by default.
+  Handle handle(TIFFOpen(mFile.c_str(), "r"));
+
+  if (!handle) {
+    logger().error("Failed to open GeoTIFF file '{}'!", mFile);
+    return;
+  }
+
+  try {
+    tiff* h = handle.get();
+
+    uint32_t count    = 0;
+    double*  scale    = nullptr;
+    double*  tiepoint = nullptr;
+
+    if (TIFFGetField(h, TAG_MODEL_PIXEL_SCALE, &count, &scale) == 0 || count < 2) {
+      throw std::runtime_error("The file contains no ModelPixelScaleTag.");
+    }
+
+    mPixelSizeLng = scale[0];
+    mPixelSizeLat = scale[1];
+
+    if (TIFFGetField(h, TAG_MODEL_TIEPOINT, &count, &tiepoint) == 0 || count < 6) {
+      throw std::runtime_error("The file contains no ModelTiepointTag.");
+    }
+
+    // The GeoKeyDirectory starts with a header of four values, followed by four values per key:
+    // The key ID, the tag containing the value (0 for inline values), the count and the value.
+    uint16_t* keys         = nullptr;
+    bool      pixelIsPoint = false;
+
+    if (TIFFGetField(h, TAG_GEO_KEY_DIRECTORY, &count, &keys) != 0) {
+      for (uint32_t i = 4; i + 3 < count; i += 4) {
+        if (keys[i + 1] != 0) {
+          continue;
+        }
+
+        if (keys[i] == KEY_MODEL_TYPE && keys[i + 3] != MODEL_TYPE_GEOGRAPHIC) {
+          throw std::runtime_error("Only geographic coordinate systems are supported.");
+        }
+
+        if (keys[i] == KEY_RASTER_TYPE) {
+          pixelIsPoint = keys[i + 3] == RASTER_TYPE_PIXEL_POINT;
+        }
+      }
+    }
+
+    mOriginLng = tiepoint[3] - tiepoint[0] * mPixelSizeLng;
+    mOriginLat = tiepoint[4] + tiepoint[1] * mPixelSizeLat;
+
+    // In this case the tiepoint refers to the center of the pixel.
+    if (pixelIsPoint) {
+      mOriginLng -= 0.5 * mPixelSizeLng;
+      mOriginLat += 0.5 * mPixelSizeLat;
+    }
+
+    char* noData = nullptr;
+    mNoData.reset();
+    if (TIFFGetField(h, TAG_GDAL_NODATA, &count, &noData) != 0 && noData != nullptr) {
+      mNoData = std::strtod(noData, nullptr);
+    }
+
+    uint16_t planarConfig = PLANARCONFIG_CONTIG;
+    TIFFGetFieldDefaulted(h, TIFFTAG_SAMPLESPERPIXEL, &mChannels);
+    TIFFGetFieldDefaulted(h, TIFFTAG_BITSPERSAMPLE, &mBitsPerSample);
+    TIFFGetFieldDefaulted(h, TIFFTAG_SAMPLEFORMAT, &mSampleFormat);
+    TIFFGetFieldDefaulted(h, TIFFTAG_PLANARCONFIG, &planarConfig);
+
+    if (mChannels > 1 && planarConfig != PLANARCONFIG_CONTIG) {
+      throw std::runtime_error("Only interleaved channels are supported.");
+    }
+
+    if (mFormat == TileDataType::eElevation) {
+      bool isInt16   = mBitsPerSample == 16 && mSampleFormat == SAMPLEFORMAT_INT;
+      bool isFloat32 = mBitsPerSample == 32 && mSampleFormat == SAMPLEFORMAT_IEEEFP;
+
+      if (mChannels != 1 || !(isInt16 || isFloat32)) {
+        throw std::runtime_error("Elevation data must have a single int16 or float32 channel.");
+      }
+    } else {
+      bool isUInt8 = mBitsPerSample == 8 && mSampleFormat == SAMPLEFORMAT_UINT;
+
+      if (mChannels == 2 || mChannels > 4 || !isUInt8) {
+        throw std::runtime_error("Image data must have one, three or four uint8 channels.");
+      }
+    }
+
+    // All full-resolution images but the first one are ignored, as well as masks.
+    mOverviews.clear();
+    tdir_t directories = TIFFNumberOfDirectories(h);
+
+    for (tdir_t d = 0; d < directories; ++d) {
+      if (TIFFSetDirectory(h, d) == 0) {
+        break;
+      }
+
+      uint32_t subfileType = 0;
+      TIFFGetFieldDefaulted(h, TIFFTAG_SUBFILETYPE, &subfileType);
+
+      bool isMask     = (subfileType & FILETYPE_MASK) != 0;
+      bool isOverview = (subfileType & FILETYPE_REDUCEDIMAGE) != 0;
+
+      if (isMask || (d > 0 && !isOverview)) {
+        continue;
+      }
+
+      Overview overview{static_cast<uint16_t>(d), 0, 0};
+      TIFFGetField(h, TIFFTAG_IMAGEWIDTH, &overview.mWidth);
+      TIFFGetField(h, TIFFTAG_IMAGELENGTH, &overview.mHeight);
+      mOverviews.push_back(overview);
+    }
+
+    if (mOverviews.empty()) {
+      throw std::runtime_error("The file contains no image.");
+    }
+
+    std::sort(mOverviews.begin(), mOverviews.end(),
+        [](Overview const& a, Overview const& b) { return a.mWidth > b.mWidth; });
+
+    // Rasters spanning all longitudes wrap around at the date line.
+    mIsGlobal = std::abs(mOverviews.front().mWidth * mPixelSizeLng - 360.0) < mPixelSizeLng;
+
+  } catch (std::exception const& e) {
+    logger().error("Cannot use GeoTIFF file '{}': {}", mFile, e.what());
+    return;
+  }
+
+  logger().debug("Opened GeoTIFF file '{}' with {}x{} pixels and {} overviews.", mFile,
+      mOverviews.front().mWidth, mOverviews.front().mHeight, mOverviews.size() - 1);
+
+  releaseHandle(std::move(handle));
+  mValid = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/* virtual */ std::shared_ptr<BaseTileData> TileSourceGeoTiff::loadTile(TileId const& tileId) {
+  if (!mValid) {
+    return nullptr;
+  }
+
+  auto handle = acquireHandle();
+
+  if (!handle) {
+    return nullptr;
+  }
+
+  std::shared_ptr<BaseTileData> result;
+
+  try {
+    if (mFormat == TileDataType::eElevation) {
+      auto tile = loadImpl<float>(handle.get(), tileId);
+      result    = mQuantizeElevation ? quantizeElevation(*tile)
+                                         : std::shared_ptr<BaseTileData>(tile);
+    } else {
+      auto tile = loadImpl<glm::u8vec4>(handle.get(), tileId);
+      result    = mCompressColor ? compressBC1(*tile) : std::shared_ptr<BaseTileData>(tile);
+    }
+  } catch (std::exception const& e) {
+    // This is not critical, the planet will just not refine any further.
+    logger().debug("Tile loading failed: {}", e.what());
+  }
+
+  releaseHandle(std::move(handle));
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+std::shared_ptr<TileData<T>> TileSourceGeoTiff::loadImpl(
+    tiff* handle, TileId const& tileId) const {
+
+  uint32_t resolution  = mResolution;
+  int      basePatch   = HEALPix::getBasePatch(tileId);
+  auto     offsetScale = HEALPix::getPatchOffsetScale(tileId);
+  double   centerLng   = glm::degrees(HEALPix::getCenterLngLat(tileId).x);
+
+  // First, we compute the position of each tile sample in pixel coordinates of the full-resolution
+  // image. Pixel (i, j) covers the range [i, i + 1) x [j, j + 1).
+  std::vector<glm::dvec2> positions(static_cast<size_t>(resolution) * resolution);
+  glm::dvec2              minPixel(std::numeric_limits<double>::max());
+  glm::dvec2              maxPixel(std::numeric_limits<double>::lowest());
+
+  for (uint32_t row = 0; row < resolution; ++row) {
+    for (uint32_t col = 0; col < resolution; ++col) {
+      glm::dvec2 baseXY = glm::dvec2(offsetScale.x, offsetScale.y) +
+                          glm::dvec2(col, row) / (resolution - 1.0) * offsetScale.z;
+      glm::dvec2 lngLat =
+          glm::degrees(HEALPix::convertBaseXY2LngLat(basePatch, baseXY.x, baseXY.y));
+
+      // Longitudes are unwrapped around the tile center. This way, tiles crossing the date line
+      // map to a contiguous range of pixels.
+      double lng = centerLng + std::remainder(lngLat.x - centerLng, 360.0);
+
+      glm::dvec2 pixel(
+          (lng - mOriginLng) / mPixelSizeLng, (mOriginLat - lngLat.y) / mPixelSizeLat);
+
+      positions[row * resolution + col] = pixel;
+      minPixel                          = glm::min(minPixel, pixel);
+      maxPixel                          = glm::max(maxPixel, pixel);
+    }
+  }
+
+  Overview const& overview = selectOverview(minPixel, maxPixel);
+
+  if (TIFFSetDirectory(handle, overview.mDirectory) == 0) {
+    throw std::runtime_error("Failed to select overview " + std::to_string(overview.mDirectory));
+  }
+
+  // JPEG-compressed COGs usually store YCbCr data. libtiff converts this to RGB for us, but this
+  // has to be requested each time a directory is selected.
+  uint16_t photometric = 0;
+  uint16_t compression = 0;
+  TIFFGetFieldDefaulted(handle, TIFFTAG_PHOTOMETRIC, &photometric);
+  TIFFGetFieldDefaulted(handle, TIFFTAG_COMPRESSION, &compression);
+  if (photometric == PHOTOMETRIC_YCBCR && compression == COMPRESSION_JPEG) {
+    TIFFSetField(handle, TIFFTAG_JPEGCOLORMODE, JPEGCOLORMODE_RGB);
+  }
+
+  size_t      pixelSize = static_cast<size_t>(mChannels) * mBitsPerSample / 8;
+  BlockReader reader(handle, overview.mWidth, overview.mHeight, pixelSize);
+
+  glm::dvec2 factor(static_cast<double>(overview.mWidth) / mOverviews.front().mWidth,
+      static_cast<double>(overview.mHeight) / mOverviews.front().mHeight);
+
+  auto tile = std::make_shared<TileData<T>>(resolution);
+  T*   data = tile->template getTypedPtr<T>();
+
+  for (size_t i = 0; i < positions.size(); ++i) {
+
+    // Bilinear interpolation between the centers of the four closest pixels. Neighbours which are
+    // outside of the image or contain no data are skipped and the weights are renormalized.
+    glm::dvec2 pos  = positions[i] * factor - 0.5;
+    glm::dvec2 base = glm::floor(pos);
+    glm::dvec2 frac = pos - base;
+
+    std::array<double, 4> channels{};
+    double                totalWeight = 0.0;
+
+    for (int dy = 0; dy <= 1; ++dy) {
+      for (int dx = 0; dx <= 1; ++dx) {
+        double weight = (dx == 0 ? 1.0 - frac.x : frac.x) * (dy == 0 ? 1.0 - frac.y : frac.y);
+
+        if (weight <= 0.0) {
+          continue;
+        }
+
+        auto x = static_cast<int64_t>(base.x) + dx;
+        auto y = static_cast<int64_t>(base.y) + dy;
+
+        if (mIsGlobal) {
+          x = ((x % overview.mWidth) + overview.mWidth) % overview.mWidth;
+        }
+
+        uint8_t const* pixel = reader.getPixel(x, y);
+
+        if (pixel == nullptr) {
+          continue;
+        }
+
+        double first = readSample(pixel, mBitsPerSample, 0);
+
+        // int16 elevation data has to be reinterpreted as signed.
+        if (mSampleFormat == SAMPLEFORMAT_INT) {
+          first = static_cast<int16_t>(static_cast<uint16_t>(first));
+        }
+
+        if (mNoData && first == *mNoData) {
+          continue;
+        }
+
+        channels[0] += weight * first;
+        for (uint16_t c = 1; c < std::min<uint16_t>(mChannels, 4); ++c) {
+          channels[c] += weight * readSample(pixel, mBitsPerSample, c);
+        }
+
+        totalWeight += weight;
+      }
+    }
+
+    if (totalWeight > 0.0) {
+      for (auto& c : channels) {
+        c /= totalWeight;
+      }
+    }
+
+    data[i] = toTileSample<T>(channels, mChannels);
+  }
+
+  return tile;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TileSourceGeoTiff::Overview const& TileSourceGeoTiff::selectOverview(
+    glm::dvec2 const& minPixel, glm::dvec2 const& maxPixel) const {
+
+  auto const& full = mOverviews.front();
+
+  // Only the part of the tile which actually overlaps the image is relevant.
+  glm::dvec2 clampedMin = minPixel;
+  glm::dvec2 clampedMax = maxPixel;
+
+  if (!mIsGlobal) {
+    clampedMin.x = std::clamp(clampedMin.x, 0.0, static_cast<double>(full.mWidth));
+    clampedMax.x = std::clamp(clampedMax.x, 0.0, static_cast<double>(full.mWidth));
+  }
+
+  clampedMin.y = std::clamp(clampedMin.y, 0.0, static_cast<double>(full.mHeight));
+  clampedMax.y = std::clamp(clampedMax.y, 0.0, static_cast<double>(full.mHeight));
+
+  // We accept up to twice as many pixels as samples in each direction. This is the same ratio as
+  // the factor between two overviews, so the next coarser overview would already undersample the
+  // tile.
+  double maxPixels = 4.0 * mResolution * mResolution;
+
+  for (auto const& overview : mOverviews) {
+    glm::dvec2 factor(static_cast<double>(overview.mWidth) / full.mWidth,
+        static_cast<double>(overview.mHeight) / full.mHeight);
+    glm::dvec2 extent = (clampedMax - clampedMin) * factor;
+
+    if (extent.x * extent.y <= maxPixels) {
+      return overview;
+    }
+  }
+
+  return mOverviews.back();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TileSourceGeoTiff::Handle TileSourceGeoTiff::acquireHandle() {
+  {
+    std::unique_lock<std::mutex> lock(mHandlesMutex);
+    if (!mHandles.empty()) {
+      auto handle = std::move(mHandles.back());
+      mHandles.pop_back();
+      return handle;
+    }
+  }
+
+  // Each loading thread requires its own handle, as libtiff handles are not thread-safe. As the
+  // file is memory-mapped, additional handles are cheap.
+  Handle handle(TIFFOpen(mFile.c_str(), "r"));
+
+  if (!handle) {
+    logger().error("Failed to open GeoTIFF file '{}'!", mFile);
+  }
+
+  return handle;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TileSourceGeoTiff::releaseHandle(Handle handle) {
+  if (handle) {
+    std::unique_lock<std::mutex> lock(mHandlesMutex);
+    mHandles.push_back(std::move(handle));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/* virtual */ void TileSourceGeoTiff::loadTileAsync(TileId const& tileId, OnLoadCallback cb) {
+  mThreadPool.enqueue([=]() {
+    auto tile = loadTile(tileId);
+    cb(tileId, std::move(tile));
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int TileSourceGeoTiff::getPendingRequests() {
+  return static_cast<int>(mThreadPool.getPendingTaskCount() + mThreadPool.getRunningTaskCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TileSourceGeoTiff::getResolution() const {
+  return mResolution;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TileSourceGeoTiff::setFile(std::string const& file) {
+  mFile  = file;
+  mValid = false;
+
+  // The pooled handles refer to the previous file.
+  std::unique_lock<std::mutex> lock(mHandlesMutex);
+  mHandles.clear();
+}
+
+std::string const& TileSourceGeoTiff::getFile() const {
+  return mFile;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TileSourceGeoTiff::setDataType(TileDataType type) {
+  mFormat = type;
+  mValid  = false;
+}
+
+TileDataType TileSourceGeoTiff::getDataType() const {
+  return mFormat;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TileSourceGeoTiff::setQuantizeElevation(bool enable) {
+  mQuantizeElevation = enable;
+}
+
+bool TileSourceGeoTiff::getQuantizeElevation() const {
+  return mQuantizeElevation;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TileSourceGeoTiff::setCompressColor(bool enable) {
+  mCompressColor = enable;
+}
+
+bool TileSourceGeoTiff::getCompressColor() const {
+  return mCompressColor;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool TileSourceGeoTiff::isSame(TileSource const* other) const {
+  auto const* casted = dynamic_cast<TileSourceGeoTiff const*>(other);
+
+  return casted != nullptr && mFile == casted->mFile && mFormat == casted->mFormat &&
+         mQuantizeElevation == casted->mQuantizeElevation &&
+         mCompressColor == casted->mCompressColor;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace csp::lodbodies
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CSP_LOD_BODIES_TILESOURCEGEOTIFF_HPP
+#define CSP_LOD_BODIES_TILESOURCEGEOTIFF_HPP
+
+#include "../../../src/cs-utils/ThreadPool.hpp"
+#include "TileData.hpp"
+#include "TileSource.hpp"
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct tiff;
+
+namespace csp::lodbodies {
+
+/// The data of the tiles is read from a local GeoTIFF file. This allows streaming terrain data
+/// without a map server, for instance in air-gapped installations.
+///
+/// The file has to be georeferenced in geographic coordinates (longitude and latitude in degrees,
+/// e.g. EPSG:4326). Each tile is reprojected to the HEALPix layout on the loading threads by
+/// bilinearly sampling the image at the geographic position of each tile sample. Cloud-Optimized
+/// GeoTIFFs are read efficiently: For each tile, the overview with the most appropriate
+/// resolution is selected and only the internal blocks (tiles or strips) which are covered by the
+/// tile are read and decoded. libtiff memory-maps the file, so no explicit buffering is required.
+///
+/// Elevation data must consist of a single 16-bit integer or 32-bit float channel, image data of
+/// one, three or four 8-bit channels. Pixels which are outside of the image or which match the
+/// GDAL no-data value are filled with zero elevation or black color.
+class TileSourceGeoTiff : public TileSource {
+ public:
+  explicit TileSourceGeoTiff(uint32_t resolution);
+
+  TileSourceGeoTiff(TileSourceGeoTiff const& other) = delete;
+  TileSourceGeoTiff(TileSourceGeoTiff&& other)      = delete;
+
+  TileSourceGeoTiff& operator=(TileSourceGeoTiff const& other) = delete;
+  TileSourceGeoTiff& operator=(TileSourceGeoTiff&& other) = delete;
+
+  ~TileSourceGeoTiff() override;
+
+  /// Reads the georeference and the overview structure of the file. If the file cannot be used,
+  /// an error is printed and no tiles will be loaded.
+  void init() override;
+
+  void fini() override {
+  }
+
+  std::shared_ptr<BaseTileData> loadTile(TileId const& tileId) override;
+
+  void loadTileAsync(TileId const& tileId, OnLoadCallback cb) override;
+  int  getPendingRequests() override;
+
+  uint32_t getResolution() const;
+
+  /// Changing the file closes all pooled file handles. This must not be done while tiles are
+  /// being loaded. Call init() afterwards to open the new file.
+  void               setFile(std::string const& file);
+  std::string const& getFile() const;
+
+  void         setDataType(TileDataType type);
+  TileDataType getDataType() const override;
+
+  /// If enabled, the tiles are converted to the compact formats of the TileTextureArray on the
+  /// loading threads, see TileSourceWebMapService::setQuantizeElevation() and
+  /// TileSourceWebMapService::setCompressColor(). In contrast to the web map service, the encoded
+  /// tiles are not cached.
+  void setQuantizeElevation(bool enable);
+  bool getQuantizeElevation() const;
+
+  void setCompressColor(bool enable);
+  bool getCompressColor() const;
+
+  bool isSame(TileSource const* other) const override;
+
+ private:
+  /// One image of the file. The first one has the full resolution, the others are overviews with
+  /// decreasing resolution.
+  struct Overview {
+    uint16_t mDirectory;
+    uint32_t mWidth;
+    uint32_t mHeight;
+  };
+
+  struct HandleDeleter {
+    void operator()(tiff* handle) const;
+  };
+
+  using Handle = std::unique_ptr<tiff, HandleDeleter>;
+
+  template <typename T>
+  std::shared_ptr<TileData<T>> loadImpl(tiff* handle, TileId const& tileId) const;
+
+  /// Returns the finest overview in which the given rectangle of full-resolution pixels does not
+  /// contain considerably more pixels than a tile has samples.
+  Overview const& selectOverview(glm::dvec2 const& minPixel, glm::dvec2 const& maxPixel) const;
+
+  Handle acquireHandle();
+  void   releaseHandle(Handle handle);
+
+  std::string  mFile;
+  TileDataType mFormat            = TileDataType::eColor;
+  bool         mQuantizeElevation = false;
+  bool         mCompressColor     = false;
+  uint32_t     mResolution;
+
+  // These are set by init(). The origin is the top left corner of the top left pixel in degrees,
+  // the pixel size is given in degrees as well.
+  bool                  mValid = false;
+  double                mOriginLng{};
+  double                mOriginLat{};
+  double                mPixelSizeLng{};
+  double                mPixelSizeLat{};
+  bool                  mIsGlobal{};
+  uint16_t              mChannels{};
+  uint16_t              mBitsPerSample{};
+  uint16_t              mSampleFormat{};
+  std::optional<double> mNoData;
+  std::vector<Overview> mOverviews;
+
+  std::mutex          mHandlesMutex;
+  std::vector<Handle> mHandles;
+
+  // This has to be destroyed first, so that no tile is loaded while the handles are closed.
+  cs::utils::ThreadPool mThreadPool;
+};
+} // namespace csp::lodbodies
+
+#endif // CSP_LOD_BODIES_TILESOURCEGEOTIFF_HPP
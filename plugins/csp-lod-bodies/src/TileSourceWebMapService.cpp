@@ -8,6 +8,7 @@
 #include "TileSourceWebMapService.hpp"
 
 #include "HEALPix.hpp"
+#include "TileCompression.hpp"
 #include "TileNode.hpp"
 #include "logger.hpp"
 
@@ -222,6 +223,74 @@ std::shared_ptr<BaseTileData> loadImpl(TileSourceWebMapService* source, TileId c
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Loads a tile which is stored in one of the compact formats, see TileTextureArray. The tile is
+// loaded with samples of type T and converted with the given encoder. The encoded tile is stored
+// next to the downloaded image in the map cache, so that it does not need to be encoded again when
+// it is loaded the next time. Encoded elevation tiles also store their value range.
+template <typename T, typename E, typename Encoder>
+std::shared_ptr<BaseTileData> loadEncodedImpl(TileSourceWebMapService* source, TileId const& tileId,
+    std::string const& extension, Encoder const& encode) {
+  auto tile = std::make_shared<TileData<E>>(source->getResolution());
+
+  int x{};
+  int y{};
+  csp::lodbodies::TileSourceWebMapService::getXY(tileId, x, y);
+
+  auto cacheFile = source->getCachePath(tileId, x, y, extension).second;
+  auto size      = static_cast<std::streamsize>(tile->getDataSize());
+  bool hasRange  = tile->getDataType() == TileDataType::eElevation;
+  auto range     = tile->getValueRange();
+
+  // If the tile has been encoded before, the data can be read directly from the map cache.
+  if (boost::filesystem::exists(cacheFile)) {
+    std::ifstream in(cacheFile, std::ifstream::binary);
+
+    if (hasRange) {
+      in.read(reinterpret_cast<char*>(&range), sizeof(range));
+    }
+
+    in.read(reinterpret_cast<char*>(tile->getDataPtr()), size);
+
+    if (in && in.peek() == std::ifstream::traits_type::eof()) {
+      tile->setValueRange(range);
+      return tile;
+    }
+
+    in.close();
+    logger().debug("Tile loading failed: Removing invalid cache file '{}'.", cacheFile);
+    boost::filesystem::remove(cacheFile);
+  }
+
+  auto decoded = loadImpl<T>(source, tileId);
+
+  if (!decoded) {
+    return nullptr;
+  }
+
+  tile  = encode(*std::static_pointer_cast<TileData<T>>(decoded));
+  range = tile->getValueRange();
+
+  // The cache directory has been created when the image was downloaded. If the encoded tile
+  // cannot be written, it will simply be encoded again next time.
+  std::ofstream out(cacheFile, std::ofstream::binary);
+
+  if (hasRange) {
+    out.write(reinterpret_cast<char const*>(&range), sizeof(range));
+  }
+
+  out.write(reinterpret_cast<char const*>(tile->getDataPtr()), size);
+
+  if (!out) {
+    out.close();
+    logger().debug("Failed to write encoded tile to cache file '{}'.", cacheFile);
+    boost::filesystem::remove(cacheFile);
+  }
+
+  return tile;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -240,9 +309,24 @@ TileSourceWebMapService::TileSourceWebMapService(uint32_t resolution)
 /* virtual */ std::shared_ptr<BaseTileData> TileSourceWebMapService::loadTile(
     TileId const& tileId) {
   if (mFormat == TileDataType::eElevation) {
+    if (mQuantizeElevation) {
+      return loadEncodedImpl<float, uint16_t>(this, tileId, "r16", [&](TileData<float> const& in) {
+        float maxError{};
+        auto  result = quantizeElevation(in, &maxError);
+        auto  range  = result->getValueRange();
+        logger().debug("Quantized elevation tile {}/{} with a height range of {} m. The maximum "
+                       "error is {} m.",
+            tileId.level(), tileId.patchIdx(), range.y - range.x, maxError);
+        return result;
+      });
+    }
     return loadImpl<float>(this, tileId);
   }
   if (mFormat == TileDataType::eColor) {
+    if (mCompressColor) {
+      return loadEncodedImpl<glm::u8vec4, BC1Block>(
+          this, tileId, "bc1", [](TileData<glm::u8vec4> const& in) { return compressBC1(in); });
+    }
     return loadImpl<glm::u8vec4>(this, tileId);
   }
 
@@ -291,12 +375,8 @@ std::optional<std::string> TileSourceWebMapService::loadData(TileId const& tileI
     type   = "png";
   }
 
-  // We encode the layers and the tile resolution in the cache file path.
-  std::stringstream cacheDir;
-  cacheDir << mCache << "/" << mLayers << "x" << mResolution << "/" << tileId.level() << "/" << x;
+  auto [cacheDir, cacheFile] = getCachePath(tileId, x, y, type);
 
-  std::stringstream cacheFile(cacheDir.str());
-  cacheFile << cacheDir.str() << "/" << y << "." << type;
   std::stringstream url;
 
   double size = 1.0 / (1 << tileId.level());
@@ -347,12 +427,11 @@ std::optional<std::string> TileSourceWebMapService::loadData(TileId const& tileI
       << "&width=" << mResolution << "&height=" << mResolution
       << "&srs=EPSG:900914&format=" << format;
 
-  auto cacheFilePath(boost::filesystem::path(cacheFile.str()));
+  auto cacheFilePath(boost::filesystem::path(cacheFile));
 
   // The file is already there, we can return it.
-  if (boost::filesystem::exists(cacheFilePath) &&
-      boost::filesystem::file_size(cacheFile.str()) > 0) {
-    return cacheFile.str();
+  if (boost::filesystem::exists(cacheFilePath) && boost::filesystem::file_size(cacheFile) > 0) {
+    return cacheFile;
   }
 
   // The file is not available but the server is marked as 'offline'. In this case we can do nothing
@@ -365,7 +444,7 @@ std::optional<std::string> TileSourceWebMapService::loadData(TileId const& tileI
     std::unique_lock<std::mutex> lock(mFileSystemMutex);
 
     // Try to create the cache directory if necessary.
-    auto cacheDirPath(boost::filesystem::absolute(boost::filesystem::path(cacheDir.str())));
+    auto cacheDirPath(boost::filesystem::absolute(boost::filesystem::path(cacheDir)));
     if (!(boost::filesystem::exists(cacheDirPath))) {
       try {
         cs::utils::filesystem::createDirectoryRecursively(
@@ -377,7 +456,7 @@ std::optional<std::string> TileSourceWebMapService::loadData(TileId const& tileI
 
     // The file is there but obviously corrupt. Remove it.
     if (boost::filesystem::exists(cacheFilePath) &&
-        boost::filesystem::file_size(cacheFile.str()) == 0) {
+        boost::filesystem::file_size(cacheFile) == 0) {
       boost::filesystem::remove(cacheFilePath);
     }
   }
@@ -385,11 +464,11 @@ std::optional<std::string> TileSourceWebMapService::loadData(TileId const& tileI
   bool fail = false;
   {
     std::ofstream out;
-    out.open(cacheFile.str(), std::ofstream::out | std::ofstream::binary);
+    out.open(cacheFile, std::ofstream::out | std::ofstream::binary);
 
     if (!out) {
-      throw std::runtime_error(fmt::format(
-          "Failed to download tile data: Cannot open '{}' for writing!", cacheFile.str()));
+      throw std::runtime_error(
+          fmt::format("Failed to download tile data: Cannot open '{}' for writing!", cacheFile));
     }
 
     curlpp::Easy request;
@@ -406,11 +485,11 @@ std::optional<std::string> TileSourceWebMapService::loadData(TileId const& tileI
   }
 
   if (fail) {
-    std::ifstream     in(cacheFile.str());
+    std::ifstream     in(cacheFile);
     std::stringstream sstr;
     sstr << in.rdbuf();
 
-    std::remove(cacheFile.str().c_str());
+    std::remove(cacheFile.c_str());
     throw std::runtime_error(sstr.str());
   }
 
@@ -420,7 +499,19 @@ std::optional<std::string> TileSourceWebMapService::loadData(TileId const& tileI
       boost::filesystem::perms::others_read | boost::filesystem::perms::others_write;
   boost::filesystem::permissions(cacheFilePath, filePerms);
 
-  return cacheFile.str();
+  return cacheFile;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::pair<std::string, std::string> TileSourceWebMapService::getCachePath(
+    TileId const& tileId, int x, int y, std::string const& extension) const {
+
+  // We encode the layers and the tile resolution in the cache file path.
+  std::stringstream cacheDir;
+  cacheDir << mCache << "/" << mLayers << "x" << mResolution << "/" << tileId.level() << "/" << x;
+
+  return {cacheDir.str(), cacheDir.str() + "/" + std::to_string(y) + "." + extension};
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -486,11 +577,33 @@ TileDataType TileSourceWebMapService::getDataType() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void TileSourceWebMapService::setQuantizeElevation(bool enable) {
+  mQuantizeElevation = enable;
+}
+
+bool TileSourceWebMapService::getQuantizeElevation() const {
+  return mQuantizeElevation;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TileSourceWebMapService::setCompressColor(bool enable) {
+  mCompressColor = enable;
+}
+
+bool TileSourceWebMapService::getCompressColor() const {
+  return mCompressColor;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 bool TileSourceWebMapService::isSame(TileSource const* other) const {
   auto const* casted = dynamic_cast<TileSourceWebMapService const*>(other);
 
   return casted != nullptr && mUrl == casted->mUrl && mCache == casted->mCache &&
-         mLayers == casted->mLayers && mFormat == casted->mFormat;
+         mLayers == casted->mLayers && mFormat == casted->mFormat &&
+         mQuantizeElevation == casted->mQuantizeElevation &&
+         mCompressColor == casted->mCompressColor;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
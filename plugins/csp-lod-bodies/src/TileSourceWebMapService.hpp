@@ -15,6 +15,7 @@
 #include <cstdio>
 #include <optional>
 #include <string>
+#include <utility>
 
 namespace csp::lodbodies {
 
@@ -56,6 +57,17 @@ class TileSourceWebMapService : public TileSource {
   void         setDataType(TileDataType type);
   TileDataType getDataType() const override;
 
+  /// If enabled, elevation tiles are quantized to 16 bit on the loading threads. Like compressed
+  /// color tiles, the quantized tiles are stored in the map cache.
+  void setQuantizeElevation(bool enable);
+  bool getQuantizeElevation() const;
+
+  /// If enabled, color tiles are encoded to BC1 blocks on the loading threads. The encoded tiles
+  /// are stored in the map cache next to the downloaded images so that they do not need to be
+  /// encoded again when they are loaded the next time.
+  void setCompressColor(bool enable);
+  bool getCompressColor() const;
+
   bool isSame(TileSource const* other) const override;
 
   /// These can be used to pre-populate the local cache, returns true if the tile is on the diagonal
@@ -70,6 +82,11 @@ class TileSourceWebMapService : public TileSource {
   // writable) a std::runtime_error is thrown.
   std::optional<std::string> loadData(TileId const& tileId, int x, int y);
 
+  /// Returns the directory and the file name of the tile with the given coordinates in the local
+  /// map cache. The file extension is appended to the file name.
+  std::pair<std::string, std::string> getCachePath(
+      TileId const& tileId, int x, int y, std::string const& extension) const;
+
  private:
   static std::mutex mFileSystemMutex;
 
@@ -77,7 +94,9 @@ class TileSourceWebMapService : public TileSource {
   std::string           mUrl;
   std::string           mCache = "cache/img";
   std::string           mLayers;
-  TileDataType          mFormat = TileDataType::eColor;
+  TileDataType          mFormat            = TileDataType::eColor;
+  bool                  mQuantizeElevation = false;
+  bool                  mCompressColor     = false;
   uint32_t              mResolution;
 };
 } // namespace csp::lodbodies
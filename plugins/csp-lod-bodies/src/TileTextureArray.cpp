@@ -8,6 +8,7 @@
 #include "TileTextureArray.hpp"
 
 #include "BaseTileData.hpp"
+#include "TileData.hpp"
 #include "TreeManager.hpp"
 
 #include <VistaBase/VistaStreamUtils.h>
@@ -20,16 +21,16 @@ namespace {
 
 // functions to obtain texture internal/external format and type
 // from TileDataType value
-GLenum getInternalFormat(TileDataType dataType) {
+GLenum getInternalFormat(TileDataType dataType, bool compact) {
   GLenum result = GL_NONE;
 
   switch (dataType) {
   case TileDataType::eElevation:
-    result = GL_R32F;
+    result = compact ? GL_R16 : GL_R32F;
     break;
 
   case TileDataType::eColor:
-    result = GL_RGBA8;
+    result = compact ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_RGBA8;
     break;
   }
 
@@ -51,10 +52,10 @@ GLenum getFormat(TileDataType dataType) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-GLenum getType(TileDataType dataType) {
+GLenum getType(TileDataType dataType, bool compact) {
   switch (dataType) {
   case TileDataType::eElevation:
-    return GL_FLOAT;
+    return compact ? GL_UNSIGNED_SHORT : GL_FLOAT;
 
   case TileDataType::eColor:
     return GL_UNSIGNED_BYTE;
@@ -65,18 +66,39 @@ GLenum getType(TileDataType dataType) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// The number of bytes of tile data which is uploaded to a single layer.
+std::size_t getLayerSize(TileDataType dataType, bool compact, uint32_t resolution) {
+  switch (dataType) {
+  case TileDataType::eElevation:
+    return compact ? detail::DataTypeTrait<uint16_t>::getCount(resolution) * sizeof(uint16_t)
+                   : detail::DataTypeTrait<float>::getCount(resolution) * sizeof(float);
+
+  case TileDataType::eColor:
+    return compact ? detail::DataTypeTrait<BC1Block>::getCount(resolution) * sizeof(BC1Block)
+                   : detail::DataTypeTrait<glm::u8vec4>::getCount(resolution) * sizeof(glm::u8vec4);
+  }
+
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /* explicit */
-TileTextureArray::TileTextureArray(TileDataType dataType, int maxLayerCount, uint32_t resolution)
+TileTextureArray::TileTextureArray(
+    TileDataType dataType, int maxLayerCount, uint32_t resolution, bool compact)
     : mTexId(0U)
     , mIformat()
     , mFormat()
     , mType()
     , mDataType(dataType)
     , mResolution(resolution)
+    , mCompact(compact)
+    , mLayerSize(getLayerSize(dataType, compact, resolution))
+    , mUnpackAlignment(4)
     , mNumLayers(maxLayerCount) {
 }
 
@@ -94,6 +116,12 @@ TileDataType TileTextureArray::getDataType() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+bool TileTextureArray::isCompact() const {
+  return mCompact;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void TileTextureArray::allocateGPU(std::shared_ptr<BaseTileData> data) {
   assert(rdata->getTexLayer() < 0);
 
@@ -151,8 +179,7 @@ void TileTextureArray::processQueue(int maxItems) {
 
     // data could be NULL if a tile is removed before it is ever
     // uploaded to the GPU, c.f. releaseGPU
-    if (data) {
-      allocateLayer(data);
+    if (data && allocateLayer(data)) {
       ++count;
     }
 
@@ -196,7 +223,8 @@ void TileTextureArray::allocateTexture(TileDataType dataType) {
     return;
   }
 
-  // allocate a 2D array texture for storing tile data of type dataType
+  // allocate a 2D array texture for storing tile data of type dataType, for compressed formats
+  // the storage is allocated by the driver in the same way
 
   glGenTextures(1, &mTexId);
 
@@ -204,9 +232,9 @@ void TileTextureArray::allocateTexture(TileDataType dataType) {
   GLsizei const depth  = mNumLayers;
   GLint const   border = 0;
 
-  mIformat = getInternalFormat(dataType);
+  mIformat = getInternalFormat(dataType, mCompact);
   mFormat  = getFormat(dataType);
-  mType    = getType(dataType);
+  mType    = getType(dataType, mCompact);
 
   glBindTexture(GL_TEXTURE_2D_ARRAY, mTexId);
   glTexImage3D(GL_TEXTURE_2D_ARRAY, level, mIformat, mResolution, mResolution, depth, border,
@@ -244,10 +272,18 @@ void TileTextureArray::releaseTexture() {
 
 // Uploads tile data from the node associated with @a data to the GPU.
 // @note May only be called after a call to @c preUpload.
-void TileTextureArray::allocateLayer(std::shared_ptr<BaseTileData> const& data) {
+bool TileTextureArray::allocateLayer(std::shared_ptr<BaseTileData> const& data) {
   assert(!mFreeLayers.empty());
   assert(data->getTexLayer() < 0);
 
+  // This happens if the tile source was configured differently than the GLResources. The tile is
+  // then simply not shown.
+  if (data->getDataSize() != mLayerSize) {
+    vstr::warnp() << "[TileTextureArray::allocateLayer]"
+                  << " Tile data does not match the texture format!" << std::endl;
+    return false;
+  }
+
   int layer = mFreeLayers.back();
   mFreeLayers.pop_back();
 
@@ -257,10 +293,17 @@ void TileTextureArray::allocateLayer(std::shared_ptr<BaseTileData> const& data)
   GLsizei const depth   = 1;
   GLvoid const* pixels  = data->getDataPtr();
 
-  glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, xoffset, yoffset, layer, mResolution, mResolution,
-      depth, mFormat, mType, pixels);
+  if (data->isCompressed()) {
+    glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, xoffset, yoffset, layer, mResolution,
+        mResolution, depth, mIformat, static_cast<GLsizei>(data->getDataSize()), pixels);
+  } else {
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, xoffset, yoffset, layer, mResolution, mResolution,
+        depth, mFormat, mType, pixels);
+  }
 
   data->setTexLayer(layer);
+
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -279,11 +322,17 @@ void TileTextureArray::releaseLayer(std::shared_ptr<BaseTileData> const& data) {
 void TileTextureArray::preUpload() {
   allocateTexture(mDataType);
   glBindTexture(GL_TEXTURE_2D_ARRAY, mTexId);
+
+  // For instance, R16 tiles with an odd resolution have rows which are not a multiple of four
+  // bytes long.
+  glGetIntegerv(GL_UNPACK_ALIGNMENT, &mUnpackAlignment);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void TileTextureArray::postUpload() {
+  glPixelStorei(GL_UNPACK_ALIGNMENT, mUnpackAlignment);
   glBindTexture(GL_TEXTURE_2D_ARRAY, 0U);
 }
 
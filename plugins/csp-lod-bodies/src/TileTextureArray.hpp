@@ -29,9 +29,15 @@ class TreeManager;
 /// once. If more tiles are needed on the GPU the array texture must be resized (which requires all
 /// tiles to be re-uploaded), this should be avoided to prevent the tile resolution to drop
 /// dramatically while only low resolution tiles are on the GPU.
+///
+/// Tiles can optionally be stored in a compact format: Color tiles are then block-compressed
+/// (BC1) and elevation tiles are quantized to 16 bit relative to the value range of each tile. In
+/// this case, the tile sources have to provide TileData<BC1Block> or TileData<uint16_t> instead of
+/// TileData<glm::u8vec4> or TileData<float>.
 class TileTextureArray {
  public:
-  explicit TileTextureArray(TileDataType dataType, int maxLayerCount, uint32_t resolution);
+  explicit TileTextureArray(
+      TileDataType dataType, int maxLayerCount, uint32_t resolution, bool compact = false);
 
   TileTextureArray(TileTextureArray const& other) = delete;
   TileTextureArray(TileTextureArray&& other)      = delete;
@@ -43,6 +49,9 @@ class TileTextureArray {
 
   TileDataType getDataType() const;
 
+  /// Returns true if the tiles are stored in the compact format on the GPU.
+  bool isCompact() const;
+
   /// Requests that data for the tile associated with data be uploaded to the GPU.
   void allocateGPU(std::shared_ptr<BaseTileData> data);
 
@@ -66,11 +75,14 @@ class TileTextureArray {
   void allocateTexture(TileDataType dataType);
   void releaseTexture();
 
-  void allocateLayer(std::shared_ptr<BaseTileData> const& data);
+  bool allocateLayer(std::shared_ptr<BaseTileData> const& data);
   void releaseLayer(std::shared_ptr<BaseTileData> const& data);
 
-  void        preUpload();
-  static void postUpload();
+  /// These bind the texture and set the pixel unpack alignment to one for the uploads, as the
+  /// rows of the tiles are not necessarily aligned to four bytes. postUpload() restores the
+  /// previous alignment.
+  void preUpload();
+  void postUpload();
 
   GLuint       mTexId;
   GLenum       mIformat;
@@ -78,6 +90,9 @@ class TileTextureArray {
   GLenum       mType;
   TileDataType mDataType;
   uint32_t     mResolution;
+  bool         mCompact;
+  std::size_t  mLayerSize;
+  GLint        mUnpackAlignment;
 
   const GLint        mNumLayers;
   std::vector<GLint> mFreeLayers;
@@ -89,12 +104,12 @@ class TileTextureArray {
 class GLResources : public PerDataType<std::unique_ptr<TileTextureArray>> {
  public:
   GLResources(int maxElevationLayers, int maxColorLayers, uint32_t elevationResolution,
-      uint32_t colorResolution)
+      uint32_t colorResolution, bool quantizeElevation = false, bool compressColor = false)
       : PerDataType<std::unique_ptr<TileTextureArray>>(
-            {std::make_unique<TileTextureArray>(
-                 TileDataType::eElevation, maxElevationLayers, elevationResolution),
+            {std::make_unique<TileTextureArray>(TileDataType::eElevation, maxElevationLayers,
+                 elevationResolution, quantizeElevation),
                 std::make_unique<TileTextureArray>(
-                    TileDataType::eColor, maxColorLayers, colorResolution)}) {
+                    TileDataType::eColor, maxColorLayers, colorResolution, compressColor)}) {
   }
 };
 } // namespace csp::lodbodies
@@ -208,8 +208,7 @@ void TreeManager::onDataLoaded(TileId const& tileId, std::shared_ptr<BaseTileDat
   }
 
   if (tileData->getDataType() == TileDataType::eElevation) {
-    auto demdata = dynamic_cast<TileData<float>*>(tileData.get());
-    node->setMinMaxPyramid(std::make_unique<MinMaxPyramid>(demdata));
+    node->setMinMaxPyramid(std::make_unique<MinMaxPyramid>(tileData.get()));
   }
 
   node->setTileData(std::move(tileData));
@@ -10,6 +10,8 @@
 #include "HEALPix.hpp"
 
 #include "BaseTileData.hpp"
+#include "TileCompression.hpp"
+#include "TileData.hpp"
 #include "VistaPlanet.hpp"
 
 #include "../../../src/cs-utils/convert.hpp"
@@ -18,10 +20,47 @@
 
 #include <glm/gtx/quaternion.hpp>
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
+
 namespace csp::lodbodies::utils {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// Provides read access to the heights of an elevation tile, regardless of whether its samples are
+// stored as float or quantized to 16 bit.
+class ElevationSamples {
+ public:
+  explicit ElevationSamples(BaseTileData const* tile)
+      : mFloat(dynamic_cast<TileData<float> const*>(tile) ? tile->getTypedPtr<float>() : nullptr)
+      , mQuantized(mFloat ? nullptr : tile->getTypedPtr<uint16_t>())
+      , mRange(tile->getValueRange()) {
+  }
+
+  float operator[](size_t i) const {
+    if (mFloat) {
+      return mFloat[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return dequantizeElevation(mQuantized[i], mRange);
+  }
+
+ private:
+  float const*    mFloat;
+  uint16_t const* mQuantized;
+  glm::vec2       mRange;
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 double getHeight(
     VistaPlanet const* planet, HeightSamplePrecision precision, glm::dvec2 const& lngLat) {
 
@@ -135,11 +174,11 @@ double getHeight(
   double hP2{};
   double hPP{};
 
-  const auto* ptr = child->getTileData().get(TileDataType::eElevation)->getTypedPtr<float>();
-  h               = ptr[vB + size * uB]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-  hP1 = ptr[vB + size * (uB + 1)];       // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-  hP2 = ptr[vB + 1 + size * uB];         // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-  hPP = ptr[vB + 1 + size * (uB + 1)];   // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  ElevationSamples samples(child->getTileData().get(TileDataType::eElevation).get());
+  h   = samples[vB + size * uB];
+  hP1 = samples[vB + size * (uB + 1)];
+  hP2 = samples[vB + 1 + size * uB];
+  hPP = samples[vB + 1 + size * (uB + 1)];
 
   double interpol1 = (1.0 - uP) * h + uP * hP1;
   double interpol2 = (1.0 - uP) * hP2 + uP * hPP;
@@ -168,214 +207,335 @@ bool intersectTileBounds(TileNode const* tileNode, VistaPlanet const* planet,
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool intersectPlanet(
-    VistaPlanet const* planet, glm::dvec3 rayOrigin, glm::dvec3 rayDir, glm::dvec3& pos) {
-  // Check if TreeManagerDEM is ok
-  if (planet->getTileRenderer().getTreeManager() == nullptr) {
-    return false;
+namespace {
+
+// The state of the ray during intersectPlanet(). All values are in planet coordinates.
+struct RayState {
+  glm::dvec4 mOrigin{0.0};
+  glm::dvec4 mDirection{0.0};
+  double     mDistance = std::numeric_limits<double>::max(); ///< Of the nearest hit found so far.
+  glm::dvec3 mPosition{0.0};
+};
+
+// A point on a ray, projected onto the elevation grid of a tile.
+struct RaySample {
+  double     mT{};      ///< The distance along the ray.
+  glm::dvec2 mGrid{};   ///< Column and row in the elevation grid. May be outside of the tile.
+  double     mHeight{}; ///< The height above the ellipsoid.
+};
+
+// Provides access to the elevation data of a single leaf tile. All heights returned by this class
+// are already multiplied with the height scale of the planet.
+class LeafSampler {
+ public:
+  LeafSampler(VistaPlanet const* planet, TileNode const* node, BaseTileData const* elevation)
+      : mPlanet(planet)
+      , mPyramid(node->getMinMaxPyramid())
+      , mData(elevation)
+      , mResolution(elevation->getResolution())
+      , mBasePatch(HEALPix::getBasePatch(node->getTileId()))
+      , mOffsetScale(HEALPix::getPatchOffsetScale(node->getTileId()))
+      , mHeightScale(planet->getHeightScale()) {
+
+    // This matches the sampling density of the previous fixed-step ray marching: About two
+    // samples per grid cell along the diagonal of the tile bounds.
+    auto const& bounds = node->getBounds();
+    mStepSize          = glm::length(bounds.getMax() - bounds.getMin()) / (2.0 * mResolution);
+
+    // The smallest radius of curvature of the ellipsoid. It is used to bound how much closer to
+    // the surface a straight ray segment can get than its end points.
+    auto const& radii = planet->getRadii();
+    double      minR  = std::min(radii.x, std::min(radii.y, radii.z));
+    double      maxR  = std::max(radii.x, std::max(radii.y, radii.z));
+    mMinCurvature     = minR * minR / maxR;
   }
 
-  // Check if TreeManagerDEM -> GetTree is ok
-  if (planet->getTileRenderer().getTreeManager()->getTree() == nullptr) {
-    return false;
+  RaySample sample(RayState const& ray, double t) const {
+    glm::dvec3 point(ray.mOrigin + ray.mDirection * t);
+    glm::dvec3 lngLatHeight =
+        cs::utils::convert::cartesianToLngLatHeight(point, mPlanet->getRadii());
+
+    glm::dvec2 xy = HEALPix::convertBaseLngLat2XY(mBasePatch, lngLatHeight.xy());
+    xy            = (xy - glm::dvec2(mOffsetScale.x, mOffsetScale.y)) / mOffsetScale.z;
+
+    return {t, xy * static_cast<double>(mResolution - 1), lngLatHeight.z};
   }
 
-  // Initialize Result to Zero
-  pos = glm::dvec3(0);
+  // Bilinearly interpolates the elevation data. The position is clamped to the tile.
+  double getHeight(glm::dvec2 const& grid) const {
+    double maxCoord = static_cast<double>(mResolution - 1);
+    double x        = glm::clamp(grid.x, 0.0, maxCoord);
+    double y        = glm::clamp(grid.y, 0.0, maxCoord);
+    auto   x0       = std::min(static_cast<uint32_t>(x), mResolution - 2);
+    auto   y0       = std::min(static_cast<uint32_t>(y), mResolution - 2);
+    double fx       = x - x0;
+    double fy       = y - y0;
 
-  // Planet transform -> Inverse -> so we are in planet space
-  glm::dmat4 planet_transform = planet->getWorldTransform();
-  glm::dmat4 planet_transformnv;
-  planet_transformnv = glm::inverse(planet_transform);
+    size_t row0 = static_cast<size_t>(y0) * mResolution;
+    size_t row1 = row0 + mResolution;
 
-  // Transform ray into planet coordinate system
-  glm::dvec4 origin(rayOrigin[0], rayOrigin[1], rayOrigin[2], 1.0);
-  origin = planet_transformnv * origin;
+    double h0 = (1.0 - fx) * mData[row0 + x0] + fx * mData[row0 + x0 + 1];
+    double h1 = (1.0 - fx) * mData[row1 + x0] + fx * mData[row1 + x0 + 1];
 
-  glm::dvec4 direction(rayDir[0], rayDir[1], rayDir[2], 0.0);
-  direction = planet_transformnv * direction;
-  direction = glm::normalize(direction);
+    return ((1.0 - fy) * h0 + fy * h1) * mHeightScale;
+  }
 
-  // Determine intersected root patches
-  std::multimap<double, TileNode*> intersected_tiles;
-  for (int rootIndex = 0; rootIndex < 12; ++rootIndex) {
+  // Returns an upper bound for the elevation within the given rectangle of the elevation grid. The
+  // coarsest pyramid level whose cells are at least as large as the rectangle is used, so at most
+  // 2x2 cells have to be checked.
+  double getMaxHeight(glm::dvec2 const& lower, glm::dvec2 const& upper) const {
+    if (!mPyramid) {
+      return std::numeric_limits<double>::max();
+    }
 
-    TileNode* root_node = planet->getTileRenderer().getTreeManager()->getTree()->getRoot(rootIndex);
+    double   maxCoord = static_cast<double>(mResolution - 1);
+    double   extent   = std::max(upper.x - lower.x, upper.y - lower.y);
+    uint32_t level    = 0;
 
-    if (root_node == nullptr) {
-      return false;
+    while (level + 1 < mPyramid->getLevels() && mPyramid->getCellSpan(level) < extent) {
+      ++level;
     }
 
-    double min_dist{};
-    double max_dist{};
-    bool intersects = intersectTileBounds(root_node, planet, origin, direction, min_dist, max_dist);
-    if (intersects) {
-      intersected_tiles.insert(std::pair<double, TileNode*>(min_dist, root_node));
+    auto       span   = static_cast<double>(mPyramid->getCellSpan(level));
+    uint32_t   last   = mPyramid->getLevelSize(level) - 1;
+    glm::dvec2 first  = glm::clamp(lower, 0.0, maxCoord) / span;
+    glm::dvec2 second = glm::clamp(upper, 0.0, maxCoord) / span;
+    auto       cellX0 = std::min(static_cast<uint32_t>(first.x), last);
+    auto       cellY0 = std::min(static_cast<uint32_t>(first.y), last);
+    auto       cellX1 = std::min(static_cast<uint32_t>(second.x), last);
+    auto       cellY1 = std::min(static_cast<uint32_t>(second.y), last);
+
+    float result = std::numeric_limits<float>::lowest();
+
+    for (uint32_t y = cellY0; y <= cellY1; ++y) {
+      for (uint32_t x = cellX0; x <= cellX1; ++x) {
+        result = std::max(result, mPyramid->getMax(level, x, y));
+      }
     }
+
+    return result * mHeightScale;
   }
 
-  TileNode* parent = nullptr;
-  TileNode* child  = nullptr;
+  bool isInside(glm::dvec2 const& grid, double margin) const {
+    double maxCoord = static_cast<double>(mResolution - 1);
+    return grid.x >= -margin && grid.y >= -margin && grid.x <= maxCoord + margin &&
+           grid.y <= maxCoord + margin;
+  }
 
-  // Process intersected tile patch priority queue:
-  while (!intersected_tiles.empty()) {
-    parent = intersected_tiles.begin()->second;
-    intersected_tiles.erase(intersected_tiles.begin());
+  bool overlaps(glm::dvec2 const& lower, glm::dvec2 const& upper) const {
+    double maxCoord = static_cast<double>(mResolution - 1);
+    return upper.x >= 0.0 && upper.y >= 0.0 && lower.x <= maxCoord && lower.y <= maxCoord;
+  }
 
-    if (parent == nullptr) {
-      return false;
+  double getStepSize() const {
+    return mStepSize;
+  }
+
+  // Returns the sagitta of a chord with the given length on a sphere with the smallest radius of
+  // curvature of the ellipsoid.
+  double getSag(double length) const {
+    double halfLength = 0.5 * length;
+
+    if (halfLength >= mMinCurvature) {
+      return mMinCurvature;
     }
 
-    // Sample height field of cut leaf node
-    if (!parent->childrenAvailable()) {
-      // Get entry and exit point again:
-      double min_dist{};
-      double max_dist{};
-      intersectTileBounds(parent, planet, origin, direction, min_dist, max_dist);
-
-      // Prevent entry being behind the camera:
-      min_dist             = std::max(0.0, min_dist);
-      glm::dvec4 entry     = origin + direction * min_dist;
-      glm::dvec4 exit      = origin + direction * max_dist;
-      auto       sampleDir = (exit - entry).xyz();
-      glm::dvec3 lastSampleCartesian{};
-      glm::dvec3 sampleCartesian{};
-      glm::dvec3 lastSampleLngLatHeight{};
-      glm::dvec3 sampleLngLatHeight{};
-      double     height(0.0);
-      double     lastHeight(0.0);
-      bool       first_sample(true);
-
-      // Estimate number of sampling steps
-      //        -------------------- BboxMax
-      //        |        /\        |
-      //        |   255 /  \       |
-      //        |     /      \     |
-      //        |   /          \   |
-      //        | /     Tile     \ |
-      //        | \               /|
-      //        |   \            / |
-      //        |     \        /   |
-      //        |  255 \      /    |
-      //        |        \   /     |
-      //        |         \/       |
-      // BboxMin--------------------
-      auto const& tile        = parent->getTileData().get(TileDataType::eElevation);
-      auto        tile_bounds = parent->getBounds();
-
-      // Tile sizes
-      int size = tile->getResolution();
-
-      auto max_tile_samplings = std::sqrt((size * size) + (size * size));
-      auto max_bbox_samplings = std::sqrt(
-          (max_tile_samplings * max_tile_samplings) + (max_tile_samplings * max_tile_samplings));
-
-      auto step_factor =
-          glm::length(sampleDir) / glm::length(tile_bounds.getMax() - tile_bounds.getMin());
-      auto step_nr = step_factor * max_bbox_samplings;
-
-      // Sample between entry and exit:
-      for (int step(0); step <= static_cast<int>(step_nr); ++step) {
-        lastSampleCartesian    = sampleCartesian;
-        lastSampleLngLatHeight = sampleLngLatHeight;
-        lastHeight             = height;
-
-        // Sample along ray and then convert to polar:
-        sampleCartesian = glm::dvec3(entry[0], entry[1], entry[2]) +
-                          glm::dvec3((step / step_nr) * sampleDir[0],
-                              (step / step_nr) * sampleDir[1], (step / step_nr) * sampleDir[2]);
-
-        sampleLngLatHeight =
-            cs::utils::convert::cartesianToLngLatHeight(sampleCartesian, planet->getRadii());
-
-        // Calc correct HPix coordinate for child patch in relation to base batch
-        int        base   = HEALPix::getBasePatch(parent->getTileId());
-        auto       scale  = HEALPix::getPatchOffsetScale(parent->getTileId());
-        glm::dvec2 HPixPt = HEALPix::convertBaseLngLat2XY(base, sampleLngLatHeight.xy());
-        HPixPt            = (HPixPt - glm::dvec2(scale[0], scale[1])) / scale[2];
-
-        /* Figure out flip */
-        std::swap(HPixPt.x, HPixPt.y);
-
-        // Calc coords in texture space
-        double u = HPixPt.x * (size - 1);
-        double v = HPixPt.y * (size - 1);
-
-        int uB = static_cast<int>(u);
-        int vB = static_cast<int>(v);
-
-        double uP = u - uB;
-        double vP = v - vB;
-
-        double hP1{};
-        double hP2{};
-        double hPP{};
-        if (uB >= size - 1 || uB < 0) {
-          continue;
-        }
-        if (vB >= size - 1 || vB < 0) {
-          continue;
-        }
+    return mMinCurvature - std::sqrt(mMinCurvature * mMinCurvature - halfLength * halfLength);
+  }
+
+ private:
+  VistaPlanet const*   mPlanet;
+  MinMaxPyramid const* mPyramid;
+  ElevationSamples     mData;
+  uint32_t             mResolution;
+  int                  mBasePatch;
+  glm::dvec3           mOffsetScale;
+  double               mHeightScale;
+  double               mStepSize     = 0.0;
+  double               mMinCurvature = 0.0;
+};
+
+// Finds the first intersection of the given ray with the height field of a leaf tile between the
+// distances tMin and tMax. The ray segment is recursively split in halves. Each half is discarded
+// as soon as the min/max pyramid proves that the terrain below it is lower than the segment. Only
+// segments shorter than the sampling step size are tested against the actual height field. As the
+// near half is always processed first, the first hit is the closest one. The given stack is only
+// passed in so that its memory can be reused for all leaf tiles.
+void intersectLeaf(LeafSampler const& leaf, RayState& ray, double tMin, double tMax,
+    std::vector<std::pair<RaySample, RaySample>>& stack) {
+  stack.clear();
+  stack.emplace_back(leaf.sample(ray, tMin), leaf.sample(ray, tMax));
+
+  while (!stack.empty()) {
+    auto [a, b] = stack.back();
+    stack.pop_back();
+
+    // A closer hit has been found in another tile already.
+    if (a.mT >= ray.mDistance) {
+      continue;
+    }
+
+    // The curved path of the ray segment on the grid may slightly exceed the bounding rectangle of
+    // its end points. Hence we add a margin of one grid cell.
+    glm::dvec2 lower = glm::min(a.mGrid, b.mGrid) - 1.0;
+    glm::dvec2 upper = glm::max(a.mGrid, b.mGrid) + 1.0;
 
-        // Access height data
-        const auto* ptr = parent->getTileData().get(TileDataType::eElevation)->getTypedPtr<float>();
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        height = ptr[vB + size * uB];
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        hP1 = ptr[vB + size * (uB + 1)];
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        hP2 = ptr[vB + 1 + size * uB];
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        hPP = ptr[vB + 1 + size * (uB + 1)];
-
-        double interpol1 = (1.0 - uP) * height + uP * hP1;
-        double interpol2 = (1.0 - uP) * hP2 + uP * hPP;
-        height           = (1.0 - vP) * interpol1 + vP * interpol2;
-        height *= planet->getHeightScale();
-
-        // Detect hit as soon as a sample point below the surface is found
-        if (sampleLngLatHeight.z < height) {
-          // Ignore sampling, which already starts below a patch due to exaggeration
-          if (first_sample) {
-            break;
-          }
-
-          double lastWeight = lastSampleLngLatHeight.z - lastHeight;
-          double curWeight  = height - sampleLngLatHeight.z;
-
-          double sum = lastWeight + curWeight;
-
-          lastWeight /= sum;
-          curWeight /= sum;
-
-          pos = lastSampleCartesian * (1.0 - lastWeight) + sampleCartesian * (1.0 - curWeight);
-
-          // FOUND VALID INTERSECTION!!!
-          return true;
+    // Segments which do not touch this tile are handled by the neighbouring tiles.
+    if (!leaf.overlaps(lower, upper)) {
+      continue;
+    }
+
+    double length = b.mT - a.mT;
+    double lowest = std::min(a.mHeight, b.mHeight) - leaf.getSag(length);
+
+    // Empty-space skipping: The whole segment is above the terrain.
+    if (lowest > leaf.getMaxHeight(lower, upper)) {
+      continue;
+    }
+
+    if (length <= leaf.getStepSize()) {
+      double d0 = a.mHeight - leaf.getHeight(a.mGrid);
+      double d1 = b.mHeight - leaf.getHeight(b.mGrid);
+
+      // Rays which start below the surface (e.g. due to height exaggeration) do not hit it.
+      if (d0 >= 0.0 && d1 < 0.0) {
+        double    t   = a.mT + length * d0 / (d0 - d1);
+        RaySample hit = leaf.sample(ray, t);
+
+        if (leaf.isInside(hit.mGrid, 1e-6)) {
+          ray.mDistance = t;
+          ray.mPosition = glm::dvec3(ray.mOrigin + ray.mDirection * t);
+          return;
         }
-        first_sample = false;
       }
+
+      continue;
     }
-    // Parent is not a leaf in cut -> push intersected children into queue:
-    else {
-      // Check all children for intersection
-      for (int childIndex = 0; childIndex < 4; ++childIndex) {
-        /* Get the new Child */
-        child = parent->getChild(childIndex);
-        if (child == nullptr) {
-          continue;
-        }
 
-        double min_dist{};
-        double max_dist{};
-        bool intersects = intersectTileBounds(child, planet, origin, direction, min_dist, max_dist);
-        if (intersects && max_dist > 0.0) {
-          intersected_tiles.insert(std::pair<double, TileNode*>(min_dist, child));
-        }
+    RaySample mid = leaf.sample(ray, 0.5 * (a.mT + b.mT));
+    stack.emplace_back(mid, b);
+    stack.emplace_back(a, mid);
+  }
+}
+
+// Recursively traverses the given tiles from near to far. Tiles whose bounding box is entered
+// behind the nearest hit found so far are skipped.
+template <size_t N>
+void traverseTiles(VistaPlanet const* planet, std::array<TileNode const*, N> const& nodes,
+    RayState& ray, std::vector<std::pair<RaySample, RaySample>>& stack) {
+
+  struct Candidate {
+    double          mEntry;
+    double          mExit;
+    TileNode const* mNode;
+  };
+
+  std::array<Candidate, N> candidates{};
+  size_t                   candidateCount = 0;
+
+  for (auto const* node : nodes) {
+    double minDist{};
+    double maxDist{};
+
+    if (node && intersectTileBounds(node, planet, ray.mOrigin, ray.mDirection, minDist, maxDist) &&
+        maxDist > 0.0) {
+      candidates.at(candidateCount++) = {std::max(minDist, 0.0), maxDist, node};
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(candidateCount),
+      [](Candidate const& a, Candidate const& b) { return a.mEntry < b.mEntry; });
+
+  for (size_t i = 0; i < candidateCount; ++i) {
+    auto const& candidate = candidates.at(i);
+
+    // As the candidates are sorted, all remaining tiles are behind the nearest hit as well.
+    if (candidate.mEntry >= ray.mDistance) {
+      return;
+    }
+
+    auto const* node = candidate.mNode;
+
+    if (!node->childrenAvailable()) {
+      auto const& elevation = node->getTileData(TileDataType::eElevation);
+
+      if (elevation) {
+        intersectLeaf(LeafSampler(planet, node, elevation.get()), ray, candidate.mEntry,
+            std::min(candidate.mExit, ray.mDistance), stack);
       }
+    } else {
+      std::array<TileNode const*, 4> children{};
+
+      for (int childIndex = 0; childIndex < 4; ++childIndex) {
+        children.at(childIndex) = node->getChild(childIndex);
+      }
+
+      traverseTiles(planet, children, ray, stack);
     }
   }
-  return false;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool intersectPlanet(
+    VistaPlanet const* planet, glm::dvec3 rayOrigin, glm::dvec3 rayDir, glm::dvec3& pos) {
+  auto* treeManager = planet->getTileRenderer().getTreeManager();
+
+  if (treeManager == nullptr || treeManager->getTree() == nullptr) {
+    return false;
+  }
+
+  std::array<TileNode const*, 12> roots{};
+
+  for (int rootIndex = 0; rootIndex < 12; ++rootIndex) {
+    roots.at(rootIndex) = treeManager->getTree()->getRoot(rootIndex);
+
+    if (roots.at(rootIndex) == nullptr) {
+      return false;
+    }
+  }
+
+  // Transform the ray into the planet coordinate system.
+  glm::dmat4 inverseTransform = glm::inverse(planet->getWorldTransform());
+
+  RayState ray;
+  ray.mOrigin    = inverseTransform * glm::dvec4(rayOrigin, 1.0);
+  ray.mDirection = glm::normalize(inverseTransform * glm::dvec4(rayDir, 0.0));
+
+  std::vector<std::pair<RaySample, RaySample>> stack;
+  traverseTiles(planet, roots, ray, stack);
+
+  pos = ray.mPosition;
+  return ray.mDistance < std::numeric_limits<double>::max();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double getBoundingRadius(VistaPlanet const* planet) {
+  auto* treeManager = planet->getTileRenderer().getTreeManager();
+
+  if (treeManager == nullptr || treeManager->getTree() == nullptr) {
+    return 0.0;
+  }
+
+  double radius = 0.0;
+
+  for (int rootIndex = 0; rootIndex < 12; ++rootIndex) {
+    TileNode* rootNode = treeManager->getTree()->getRoot(rootIndex);
+
+    if (rootNode == nullptr) {
+      return 0.0;
+    }
+
+    // The farthest corner of the bounding box is at most this far away from the origin.
+    glm::dvec3 corner = glm::max(
+        glm::abs(rootNode->getBounds().getMin()), glm::abs(rootNode->getBounds().getMax()));
+    radius = std::max(radius, glm::length(corner));
+  }
+
+  return radius;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
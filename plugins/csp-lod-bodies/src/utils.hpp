@@ -39,7 +39,9 @@ double getHeight(
     VistaPlanet const* planet, HeightSamplePrecision precision, glm::dvec2 const& lngLat);
 
 /// Intersects a ray with the height field of a VistaPlanet. The Ray is defined by a position
-/// and orientation.
+/// and orientation. The tile tree is traversed from near to far. Within the loaded leaf tiles, the
+/// ray is marched hierarchically: Using the MinMaxPyramid of each tile, large parts of the ray which
+/// are above the terrain are skipped and only the remaining parts are sampled at full resolution.
 /// @param planet VistaPlanet to be intersected
 /// @param rayPos Ray position in world space
 /// @param rayDir Ray direction in world space
@@ -47,6 +49,12 @@ double getHeight(
 bool intersectPlanet(
     VistaPlanet const* planet, glm::dvec3 rayOrigin, glm::dvec3 rayDir, glm::dvec3& pos);
 
+/// Returns the radius of a sphere around the planet's origin which contains the bounding boxes of
+/// all root tiles. As these boxes include the scaled terrain heights, no point found by
+/// intersectPlanet() can be outside of this sphere. If the tile tree is not yet available, zero is
+/// returned.
+double getBoundingRadius(VistaPlanet const* planet);
+
 /// Retrieve entry and exit distance along a ray on the bbox of a tile node. The ray parameters must
 /// be transformed into the planet coordinate system before!
 bool intersectTileBounds(TileNode const* tileNode, VistaPlanet const* planet,
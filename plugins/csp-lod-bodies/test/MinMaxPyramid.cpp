@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "../src/MinMaxPyramid.hpp"
+#include "../src/TileCompression.hpp"
+#include "../src/TileData.hpp"
+#include "../../../src/cs-utils/doctest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace csp::lodbodies {
+
+namespace {
+// Returns the height of the given sample. Quantized samples are converted the same way as by the
+// terrain shader.
+template <typename T>
+float getHeight(TileData<T> const& tile, uint32_t index) {
+  if constexpr (std::is_same_v<T, uint16_t>) {
+    return dequantizeElevation(static_cast<float>(tile.data()[index]), tile.getValueRange());
+  }
+
+  return static_cast<float>(tile.data()[index]);
+}
+
+// Checks that each cell of each level bounds all samples it covers, including the shared border
+// samples.
+template <typename T>
+void checkPyramid(uint32_t resolution) {
+  TileData<T> tile(resolution);
+
+  for (uint32_t i = 0; i < resolution * resolution; ++i) {
+    float value = std::sin(static_cast<float>(i) * 0.37F);
+
+    if constexpr (std::is_same_v<T, uint16_t>) {
+      tile.data()[i] = static_cast<uint16_t>(std::lround((value * 0.5F + 0.5F) * 65535.F));
+    } else {
+      tile.data()[i] = value * 1000.F;
+    }
+  }
+
+  if constexpr (std::is_same_v<T, uint16_t>) {
+    tile.setValueRange(glm::vec2(-1000.F, 1000.F));
+  }
+
+  MinMaxPyramid pyramid(&tile);
+
+  CHECK_EQ(pyramid.getLevelSize(pyramid.getLevels() - 1), 1);
+  CHECK_EQ(pyramid.getMax(pyramid.getLevels() - 1, 0, 0), pyramid.getMax());
+  CHECK_EQ(pyramid.getMin(pyramid.getLevels() - 1, 0, 0), pyramid.getMin());
+
+  for (uint32_t level = 0; level < pyramid.getLevels(); ++level) {
+    uint32_t span = pyramid.getCellSpan(level);
+
+    for (uint32_t y = 0; y < pyramid.getLevelSize(level); ++y) {
+      for (uint32_t x = 0; x < pyramid.getLevelSize(level); ++x) {
+        float minValue = pyramid.getMin(level, x, y);
+        float maxValue = pyramid.getMax(level, x, y);
+
+        for (uint32_t sy = y * span; sy <= std::min((y + 1) * span, resolution - 1); ++sy) {
+          for (uint32_t sx = x * span; sx <= std::min((x + 1) * span, resolution - 1); ++sx) {
+            float v = getHeight(tile, sy * resolution + sx);
+            REQUIRE(v >= minValue);
+            REQUIRE(v <= maxValue);
+          }
+        }
+      }
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("csp::lodbodies::MinMaxPyramid") {
+  checkPyramid<float>(128);
+  checkPyramid<float>(257);
+  checkPyramid<float>(2);
+}
+
+TEST_CASE("csp::lodbodies::MinMaxPyramid with quantized samples") {
+  checkPyramid<uint16_t>(128);
+  checkPyramid<uint16_t>(257);
+  checkPyramid<uint16_t>(2);
+}
+
+} // namespace csp::lodbodies
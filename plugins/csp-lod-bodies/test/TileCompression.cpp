@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "../src/TileCompression.hpp"
+#include "../src/MinMaxPyramid.hpp"
+#include "../../../src/cs-utils/doctest.hpp"
+
+#include <cmath>
+
+namespace csp::lodbodies {
+
+namespace {
+// Compresses a smooth gradient and checks that each decoded sample is close to the original one.
+// The gradient wraps at block boundaries only.
+void checkGradient(uint32_t resolution) {
+  TileData<glm::u8vec4> tile(resolution);
+
+  for (uint32_t y = 0; y < resolution; ++y) {
+    for (uint32_t x = 0; x < resolution; ++x) {
+      uint32_t r = (x % 64) * 4;
+      uint32_t g = (y % 64) * 4;
+      tile.data()[y * resolution + x] = glm::u8vec4(r, g, 255 - r / 2, 255);
+    }
+  }
+
+  auto compressed = compressBC1(tile);
+
+  uint32_t blocks = (resolution + 3) / 4;
+  CHECK_EQ(compressed->getResolution(), resolution);
+  CHECK_EQ(compressed->getDataSize(), blocks * blocks * 8);
+  CHECK(compressed->isCompressed());
+
+  for (uint32_t y = 0; y < resolution; ++y) {
+    for (uint32_t x = 0; x < resolution; ++x) {
+      glm::ivec3 original(tile.data()[y * resolution + x]);
+      glm::ivec3 decoded(decompressBC1(*compressed, x, y));
+
+      REQUIRE(std::abs(original.r - decoded.r) <= 12);
+      REQUIRE(std::abs(original.g - decoded.g) <= 12);
+      REQUIRE(std::abs(original.b - decoded.b) <= 12);
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("csp::lodbodies::compressBC1") {
+  checkGradient(256);
+  checkGradient(257);
+  checkGradient(3);
+}
+
+TEST_CASE("csp::lodbodies::compressBC1 uniform color") {
+  TileData<glm::u8vec4> tile(16);
+
+  for (auto& sample : tile.data()) {
+    sample = glm::u8vec4(128, 64, 32, 255);
+  }
+
+  auto compressed = compressBC1(tile);
+
+  // The color is quantized to RGB565 and expanded again.
+  CHECK_EQ(decompressBC1(*compressed, 5, 7), glm::u8vec4(132, 65, 33, 255));
+}
+
+TEST_CASE("csp::lodbodies::quantizeElevation") {
+  uint32_t        resolution = 65;
+  TileData<float> tile(resolution);
+
+  for (uint32_t i = 0; i < resolution * resolution; ++i) {
+    tile.data()[i] = -400.F + std::sin(static_cast<float>(i) * 0.37F) * 2500.F;
+  }
+
+  float maxError{};
+  auto  quantized = quantizeElevation(tile, &maxError);
+  auto  range     = quantized->getValueRange();
+
+  CHECK_EQ(quantized->getDataSize(), resolution * resolution * sizeof(uint16_t));
+  CHECK(range.x >= -2900.F);
+  CHECK(range.y <= 2100.F);
+  CHECK(maxError <= (range.y - range.x) / 65535.F);
+
+  for (uint32_t i = 0; i < resolution * resolution; ++i) {
+    float height = dequantizeElevation(quantized->data()[i], range);
+    REQUIRE(std::abs(height - tile.data()[i]) <= maxError);
+  }
+
+  // The bounds of the pyramid are computed from the quantized samples.
+  MinMaxPyramid pyramid(quantized.get());
+  CHECK(std::abs(pyramid.getMin() - range.x) <= maxError);
+  CHECK(std::abs(pyramid.getMax() - range.y) <= maxError);
+}
+
+TEST_CASE("csp::lodbodies::quantizeElevation flat tile") {
+  TileData<float> tile(4);
+
+  for (auto& sample : tile.data()) {
+    sample = 42.F;
+  }
+
+  float maxError{};
+  auto  quantized = quantizeElevation(tile, &maxError);
+
+  CHECK_EQ(maxError, 0.F);
+  CHECK_EQ(dequantizeElevation(quantized->data()[5], quantized->getValueRange()), 42.F);
+}
+
+} // namespace csp::lodbodies
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "../src/TileSourceGeoTiff.hpp"
+#include "../../../src/cs-utils/doctest.hpp"
+
+#include <array>
+#include <boost/filesystem.hpp>
+#include <future>
+#include <tiffio.h>
+#include <vector>
+
+namespace csp::lodbodies {
+
+namespace {
+// Writes a global float32 GeoTIFF with 8x4 pixels of 45 degrees which all have the given
+// elevation. The GeoTIFF tags are known to libtiff once a TileSourceGeoTiff has been created.
+void writeGeoTiff(std::string const& file, float elevation) {
+  uint32_t const width  = 8;
+  uint32_t const height = 4;
+
+  tiff* h = TIFFOpen(file.c_str(), "w");
+  REQUIRE(h != nullptr);
+
+  TIFFSetField(h, TIFFTAG_IMAGEWIDTH, width);
+  TIFFSetField(h, TIFFTAG_IMAGELENGTH, height);
+  TIFFSetField(h, TIFFTAG_SAMPLESPERPIXEL, 1);
+  TIFFSetField(h, TIFFTAG_BITSPERSAMPLE, 32);
+  TIFFSetField(h, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_IEEEFP);
+  TIFFSetField(h, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
+  TIFFSetField(h, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+  TIFFSetField(h, TIFFTAG_ROWSPERSTRIP, height);
+
+  // The top left corner of the top left pixel is at 180°W, 90°N. The model type is geographic.
+  std::array<double, 3>   scale    = {45.0, 45.0, 0.0};
+  std::array<double, 6>   tiepoint = {0.0, 0.0, 0.0, -180.0, 90.0, 0.0};
+  std::array<uint16_t, 8> keys     = {1, 1, 0, 1, 1024, 0, 1, 2};
+
+  TIFFSetField(h, 33550, static_cast<uint32_t>(scale.size()), scale.data());
+  TIFFSetField(h, 33922, static_cast<uint32_t>(tiepoint.size()), tiepoint.data());
+  TIFFSetField(h, 34735, static_cast<uint32_t>(keys.size()), keys.data());
+
+  std::vector<float> row(width, elevation);
+  for (uint32_t y = 0; y < height; ++y) {
+    CHECK(TIFFWriteScanline(h, row.data(), y, 0) == 1);
+  }
+
+  TIFFClose(h);
+}
+
+// Loads all base tiles, half of them on the loading threads, and checks that each sample has the
+// given elevation.
+void checkElevation(TileSourceGeoTiff& source, float elevation) {
+  std::vector<std::future<std::shared_ptr<BaseTileData>>> results;
+
+  for (int patchIdx = 0; patchIdx < 12; ++patchIdx) {
+    if (patchIdx % 2 == 0) {
+      std::promise<std::shared_ptr<BaseTileData>> promise;
+      promise.set_value(source.loadTile(TileId(0, patchIdx)));
+      results.push_back(promise.get_future());
+    } else {
+      auto promise = std::make_shared<std::promise<std::shared_ptr<BaseTileData>>>();
+      results.push_back(promise->get_future());
+      source.loadTileAsync(TileId(0, patchIdx),
+          [promise](TileId /*tileId*/, std::shared_ptr<BaseTileData> tile) {
+            promise->set_value(std::move(tile));
+          });
+    }
+  }
+
+  for (auto& result : results) {
+    auto tile = std::dynamic_pointer_cast<TileData<float>>(result.get());
+    REQUIRE(tile != nullptr);
+
+    for (float sample : tile->data()) {
+      CHECK(sample == doctest::Approx(elevation));
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("csp::lodbodies::TileSourceGeoTiff with pooled handles") {
+  TileSourceGeoTiff source(16);
+  source.setDataType(TileDataType::eElevation);
+
+  auto directory = boost::filesystem::temp_directory_path();
+  auto fileA     = (directory / boost::filesystem::unique_path("%%%%-%%%%-a.tif")).string();
+  auto fileB     = (directory / boost::filesystem::unique_path("%%%%-%%%%-b.tif")).string();
+
+  writeGeoTiff(fileA, 100.F);
+  writeGeoTiff(fileB, 200.F);
+
+  source.setFile(fileA);
+  source.init();
+  checkElevation(source, 100.F);
+
+  // The handles which were returned to the pool must not be used for the new file.
+  source.setFile(fileB);
+  source.init();
+  checkElevation(source, 200.F);
+
+  boost::filesystem::remove(fileA);
+  boost::filesystem::remove(fileB);
+}
+
+} // namespace csp::lodbodies
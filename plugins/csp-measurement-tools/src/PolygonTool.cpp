@@ -28,12 +28,19 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+
 namespace csp::measurementtools {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 const int PolygonTool::NUM_SAMPLES = 256;
 
+const double PolygonTool::MAX_EDGE_ANGLE       = cs::utils::convert::toRadians(1.0);
+const double PolygonTool::MAX_PROJECTION_ANGLE = cs::utils::convert::toRadians(170.0);
+
+const std::chrono::milliseconds PolygonTool::CALCULATION_TIME_BUDGET(2);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 const char* PolygonTool::SHADER_VERT = R"(
@@ -248,310 +255,24 @@ bool PolygonTool::checkPoint(glm::dvec2 const& point) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool PolygonTool::findIntersection(Site const& s1, Site const& s2, Site const& s3, Site const& s4,
-    double& intersectionX, double& intersectionY) {
-  // Avoids division with 0
-  if ((s1.mX == 0) || (s2.mX == 0) || (s3.mX == 0) || (s4.mX == 0) || (s1.mY == 0) ||
-      (s2.mY == 0) || (s3.mY == 0) || (s4.mY == 0)) {
-    return false;
-  }
-
-  // Based on
-  // http://www.softwareandfinance.com/Visual_CPP/VCPP_Intersection_Two_lines_EndPoints.html
-
-  // Safety band - to avoid point duplications - set to 1%
-  double safety = 0.01;
-
-  double m1{};
-  double m2{};
-  double c1{};
-  double c2{};
-
-  // Line 1 (y = m1 * x + c1)
-  m1 = (s2.mY - s1.mY) / (s2.mX - s1.mX);
-  c1 = s1.mY - m1 * s1.mX;
-
-  // Line 2 (y = m2 * x + c2)
-  m2 = (s4.mY - s3.mY) / (s4.mX - s3.mX);
-  c2 = s3.mY - m2 * s3.mX;
-
-  // Edges are not exactly parallel
-  if (m1 != m2) {
-    // Intersection of lines
-    intersectionX = (c2 - c1) / (m1 - m2);
-    intersectionY = m1 * (intersectionX) + c1;
-
-    // Checks if intersection point is on the edges or not (between a bounding box)
-    if (((s1.mX > intersectionX) != (s2.mX > intersectionX)) &&
-        ((s3.mX > intersectionX) != (s4.mX > intersectionX)) &&
-        ((s1.mY > intersectionY) != (s2.mY > intersectionY)) &&
-        ((s3.mY > intersectionY) != (s4.mY > intersectionY))) {
-      // Checks all 4 points: do not return with an intersection point within the safety band
-      if (((std::abs((s1.mX - intersectionX) / s1.mX) > safety) ||
-              (std::abs((s1.mY - intersectionY) / s1.mY) > safety)) &&
-          ((std::abs((s2.mX - intersectionX) / s2.mX) > safety) ||
-              (std::abs((s2.mY - intersectionY) / s2.mY) > safety)) &&
-          ((std::abs((s3.mX - intersectionX) / s3.mX) > safety) ||
-              (std::abs((s3.mY - intersectionY) / s3.mY) > safety)) &&
-          ((std::abs((s4.mX - intersectionX) / s4.mX) > safety) ||
-              (std::abs((s4.mY - intersectionY) / s4.mY) > safety))) {
-        return true;
-      }
-    }
-  }
-  return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 void PolygonTool::createMesh(std::vector<Triangle>& triangles) {
-  bool edgesOK = false;
-  int  it      = 0;
-
-  // Does the triangulaiton of the original polygon
-  // Checks and refines the triangulation until all original edges of the polygon are in the
-  // triangulation Quits after 5 iteration to avoid performance issues and displays error message
-  while (!edgesOK && it < 5) {
-    it++;
-
-    // Performs the Delaunay triangulation
-    VoronoiGenerator voronoi;
-    voronoi.parse(mCorners);
-
-    // Number of the original edges of the polygon
-    size_t countEdges = mCorners.size();
-
-    // Vector of the original edges of the polygon from Delaunay triangulation
-    std::vector<Edge2> voronoiEdges;
-
-    for (auto const& s : voronoi.getTriangulation()) {
-      // Finds original edges based on their addresses
-      if (((std::abs(s.second.mAddr - s.first.mAddr) == 1 ||
-               (std::abs(s.second.mAddr - s.first.mAddr) == mCorners.size() - 1)) &&
-              s.first.mAddr < mCorners.size() && s.second.mAddr < mCorners.size())) {
-        // Counts found edges
-        countEdges--;
-
-        Site site1(0, 0, 0);
-        Site site2(0, 0, 0);
-
-        // Orders addresses of the found edge
-        if (((s.first.mAddr == mCorners.size() - 1) && (s.second.mAddr == 0)) ||
-            ((s.second.mAddr > s.first.mAddr) &&
-                !((s.first.mAddr == 0) && (s.second.mAddr == mCorners.size() - 1)))) {
-          site1 = s.first;
-          site2 = s.second;
-        } else {
-          site1 = s.second;
-          site2 = s.first;
-        }
-        // Saves edges of the triangulation
-        voronoiEdges.emplace_back(site1, site2);
-      }
-    }
-
-    // If some of the polygon edges did not match with a voronoi edge
-    // This means, that some edges are missing, and need to be recovered
-    // Intersection points of the missing edges and voronoi edges need to determined
-    // These points are added to mCorners, and the triangulation hopefully
-    // solves the problem in the next cycle (works for most of the cases)
-    if (countEdges != 0) {
-      // Vector of corners on missing edges - to be added to mCorners
-      std::vector<Site> addCorners;
-
-      // Finds the missing edges: search for every original edge in voronoiEdges
-      // (the original polygon edges have neighbor addresses -> searches for corners)
-      for (size_t i = 0; i < mCorners.size(); i++) {
-        bool       found = false;
-        glm::ivec2 missingAddr;
-
-        // In case of the last line of the polygon
-        if (i == (mCorners.size() - 1)) {
-          for (auto const& v : voronoiEdges) {
-            if ((v.first.mAddr == i) && (v.second.mAddr == 0)) {
-              found = true;
-            }
-          }
+  // The edges of the polygon are inserted as constraints into the Delaunay triangulation, so that
+  // they are part of the mesh even if the polygon is concave.
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  edges.reserve(mCorners.size());
 
-          if (!found) {
-            missingAddr = glm::ivec2(i, 0);
-          }
-        }
-        // Every other line
-        else {
-          for (auto const& v : voronoiEdges) {
-            if ((v.first.mAddr == i) && (v.second.mAddr == i + 1)) {
-              found = true;
-            }
-          }
-          if (!found) {
-            missingAddr = glm::ivec2(i, i + 1);
-          }
-        }
-
-        // If this edge is missing
-        if (!found) {
-          // Points of the missing edge
-          Site              site1(0, 0, 0);
-          Site              site2(0, 0, 0);
-          std::vector<Site> sites;
-
-          // Pairs the known addresses of the missing edge with sites
-          for (auto const& s : voronoi.getTriangulation()) {
-            if (s.first.mAddr == missingAddr.x) {
-              site1 = s.first;
-            }
-            if (s.second.mAddr == missingAddr.x) {
-              site1 = s.second;
-            }
-
-            if (s.first.mAddr == missingAddr.y) {
-              site2 = s.first;
-            }
-            if (s.second.mAddr == missingAddr.y) {
-              site2 = s.second;
-            }
-          }
-
-          // Finds intersecting edges (if a triangulation edge intersects the original polygon edge,
-          // it is wrong)
-          for (auto const& s : voronoi.getTriangulation()) {
-            double intersectionX{};
-            double intersectionY{};
-
-            if (findIntersection(site1, site2, s.first, s.second, intersectionX, intersectionY)) {
-              int addrNew =
-                  site1.mAddr + 1; // = site2.mAddr (except for the last edge, where site2.mAddr=0!
-              Site oldCorner(0, 0, 0);
-              bool done = false;
-
-              // Cycles through addCorners vector and saves current intersection into the right
-              // place
-              for (auto& addCorner : addCorners) {
-                // If current intersection is not saved yet
-                if (!done) {
-                  // Compares addresses of the two intersection
-                  if (addCorner.mAddr < addrNew) {
-                    // Skips first elements of vector
-                  } else if (addCorner.mAddr == addrNew) {
-                    // If edges points to positive x
-                    if (intersectionX > site1.mX) {
-                      // Saves intersection only when it is in front of the
-                      // existing intersection; otherwise it will be handled
-                      // in the next cycle
-                      if (addCorner.mX > intersectionX) {
-                        // Saves existing intersection to oldCorner
-                        // will be placed back to vector in the next cycle
-                        oldCorner = addCorner;
-                        addCorner = Site(intersectionX, intersectionY, addrNew);
-                        done      = true;
-                      }
-                    }
-                    // If edges points to negative x
-                    else if (intersectionX < site1.mX) {
-                      if (addCorner.mX < intersectionX) {
-                        oldCorner = addCorner;
-                        addCorner = Site(intersectionX, intersectionY, addrNew);
-                        done      = true;
-                      }
-                    }
-                    // Handles the very rare case of a vertical edge
-                    // Does the same, as before, just now with y coordinates
-                    else if (intersectionX == site1.mX) {
-                      if (intersectionY > site1.mY) {
-                        if (addCorner.mY > intersectionY) {
-                          oldCorner = addCorner;
-                          addCorner = Site(intersectionX, intersectionY, addrNew);
-                          done      = true;
-                        }
-                      } else if (intersectionY < site1.mY) {
-                        if (addCorner.mY < intersectionY) {
-                          oldCorner = addCorner;
-                          addCorner = Site(intersectionX, intersectionY, addrNew);
-                          done      = true;
-                        }
-                      }
-                    } // if (intersectionX==s.first.mX)
-                  }   // if (addCorners[i].mAddr == addrNew)
-                  // if (addCorners[i].mAddr > addrNew)
-                  else {
-                    oldCorner = addCorner;
-                    addCorner = Site(intersectionX, intersectionY, addrNew);
-                    done      = true;
-                  }
-                } // if (!done)
-                else {
-                  // After the current intersecting point is added to the middle of the vector
-                  // shifts back every other element by one position
-                  Site newCorner = addCorner;
-                  addCorner      = oldCorner;
-                  oldCorner      = newCorner;
-                }
-              } // for (int i = 0; i < addCorners.size(); i++)
-
-              // If the current intersection was placed in the vector
-              if (done) {
-                // Emplaces the last element to the end of the vector
-                addCorners.emplace_back(oldCorner);
-              } else {
-                // Emplaces back current intersection to the end of the vector
-                addCorners.emplace_back(Site(intersectionX, intersectionY, addrNew));
-              }
-
-              // Corners needed to be added -> run the cycle again
-              edgesOK = false;
-            } // if (findIntersection(...))
-          }   // for (auto const& s : triangulation)
-        }     // if (!found)
-      }       // for (int i = 0; i < mCorners.size(); i++)
-
-      // Counts the intersection corners already added to mCorners
-      int cornerCount = 0;
-
-      // Goes through the intersection corners and adds them to the right place of mCorners
-      for (auto const& c : addCorners) {
-        // Address of the intersection if it is the only one in the vector
-        int addr3 = c.mAddr;
-        addr3 += cornerCount;
-
-        // If intersection is not between last and first Site
-        if (addr3 < static_cast<int>(mCorners.size())) {
-          // Saves intersection corner to mCorners and element of mCorners to oldSite
-          Site oldSite    = mCorners[addr3];
-          mCorners[addr3] = Site(c.mX, c.mY, addr3);
-
-          addr3++;
-
-          // Shifts every other corner of mCorners behind by one
-          for (; addr3 < static_cast<int>(mCorners.size()); addr3++) {
-            Site newSite    = mCorners[addr3];
-            mCorners[addr3] = Site(oldSite.mX, oldSite.mY, addr3);
-            oldSite         = newSite;
-          }
-
-          // Emplaces back the last corner
-          mCorners.emplace_back(Site(oldSite.mX, oldSite.mY, addr3));
-        } else {
-          // Emplaces back the intersection corner
-          mCorners.emplace_back(Site(c.mX, c.mY, addr3));
-        }
+  for (size_t i = 0; i < mCorners.size(); i++) {
+    edges.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>((i + 1) % mCorners.size()));
+  }
 
-        cornerCount++;
-      }
-    } // if (countEdges != 0)
-    else {
-      // All of the original edges are in voronoiEdges -> no need for an other cycle
-      edgesOK = true;
-    }
-    // Saves the original triangles
-    triangles = voronoi.getTriangles();
-  } // while (!edgesOK && it < 5)
-
-  // If the voronoi edges are still wrong after 5 cycles of refinement, display the problem
-  if (!edgesOK) {
-    logger().warn("Area calculation can be false: Concave or self-intersecting polygon! Check "
-                  "triangulation mesh.");
+  // This fails only if some of the edges intersect each other.
+  VoronoiGenerator voronoi;
+  if (!voronoi.parse(mCorners, edges)) {
+    logger().warn(
+        "Area calculation can be false: Self-intersecting polygon! Check triangulation mesh.");
   }
+
+  triangles = voronoi.getTriangles();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -644,16 +365,22 @@ bool PolygonTool::checkSleekness(int count) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+glm::dvec3 PolygonTool::toSurface(glm::dvec2 const& point, double mdist, glm::dvec3 const& e,
+    glm::dvec3 const& n, glm::dvec3 const& radii) const {
+  // Inverse stereographic projection from the point opposite to mNormal
+  glm::dvec2 p  = point * mdist;
+  double     r2 = glm::dot(p, p);
+  return (4.0 * p.x * e + 4.0 * p.y * n + (4.0 - r2) * mNormal) / (4.0 + r2) * radii[0];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void PolygonTool::displayMesh(std::shared_ptr<cs::scene::CelestialSurface> const& surface,
     Edge2 const& edge, double mdist, glm::dvec3 const& e, glm::dvec3 const& n,
     glm::dvec3 const& radii, double scale, double& h1, double& h2) {
   // Cartesian coordinates without height
-  glm::dvec3 p1 =
-      glm::normalize(mMiddlePoint + mdist * edge.first.mX * e + mdist * edge.first.mY * n) *
-      radii[0];
-  glm::dvec3 p2 =
-      glm::normalize(mMiddlePoint + mdist * edge.second.mX * e + mdist * edge.second.mY * n) *
-      radii[0];
+  glm::dvec3 p1 = toSurface(glm::dvec2(edge.first.mX, edge.first.mY), mdist, e, n, radii);
+  glm::dvec3 p2 = toSurface(glm::dvec2(edge.second.mX, edge.second.mY), mdist, e, n, radii);
 
   // LongLat coordinates
   glm::dvec2 l1 = cs::utils::convert::cartesianToLngLat(p1, radii);
@@ -668,8 +395,8 @@ void PolygonTool::displayMesh(std::shared_ptr<cs::scene::CelestialSurface> const
   glm::dvec3 r2 = cs::utils::convert::toCartesian(l2, radii, h2 * scale);
 
   // Emplaces back points in Cartesian (on planet surface) for display
-  mTriangulation.emplace_back(r1);
-  mTriangulation.emplace_back(r2);
+  mNextTriangulation.emplace_back(r1);
+  mNextTriangulation.emplace_back(r2);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -682,8 +409,7 @@ void PolygonTool::refineMesh(std::shared_ptr<cs::scene::CelestialSurface> const&
   glm::dvec2 avgPoint2 =
       glm::dvec2((edge.first.mX + edge.second.mX) / 2, (edge.first.mY + edge.second.mY) / 2);
   // Middle point on planet´s surface
-  glm::dvec3 pAvg =
-      glm::normalize(mMiddlePoint + mdist * avgPoint2.x * e + mdist * avgPoint2.y * n) * radii[0];
+  glm::dvec3 pAvg = toSurface(avgPoint2, mdist, e, n, radii);
 
   // Heights of the points over see level
   double hAvg =
@@ -706,9 +432,7 @@ void PolygonTool::refineMesh(std::shared_ptr<cs::scene::CelestialSurface> const&
           glm::dvec2 avgPoint3 = glm::dvec2((i * edge.first.mX + (j - i) * edge.second.mX) / j,
               (i * edge.first.mY + (j - i) * edge.second.mY) / j);
           // Cartesian coordinate of the point
-          glm::dvec3 cAvg3 =
-              glm::normalize(mMiddlePoint + mdist * avgPoint3.x * e + mdist * avgPoint3.y * n) *
-              radii[0];
+          glm::dvec3 cAvg3 = toSurface(avgPoint3, mdist, e, n, radii);
           // Height of the point
           double heAvg3 =
               surface ? surface->getHeight(cs::utils::convert::cartesianToLngLat(cAvg3, radii))
@@ -741,12 +465,9 @@ void PolygonTool::calculateAreaAndVolume(
     std::tie(si1, si2, si3) = triangle;
 
     // Cartesian coordinates without height
-    glm::dvec3 p1 =
-        glm::normalize(mMiddlePoint + mdist * si1.mX * e + mdist * si1.mY * n) * radii[0];
-    glm::dvec3 p2 =
-        glm::normalize(mMiddlePoint + mdist * si2.mX * e + mdist * si2.mY * n) * radii[0];
-    glm::dvec3 p3 =
-        glm::normalize(mMiddlePoint + mdist * si3.mX * e + mdist * si3.mY * n) * radii[0];
+    glm::dvec3 p1 = toSurface(glm::dvec2(si1.mX, si1.mY), mdist, e, n, radii);
+    glm::dvec3 p2 = toSurface(glm::dvec2(si2.mX, si2.mY), mdist, e, n, radii);
+    glm::dvec3 p3 = toSurface(glm::dvec2(si3.mX, si3.mY), mdist, e, n, radii);
 
     // LongLat coordinates
     glm::dvec2 l1 = cs::utils::convert::cartesianToLngLat(p1, radii);
@@ -1069,18 +790,22 @@ void PolygonTool::updateLineVertices() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// Creates a new plane normal to the middle of the polygon and projects the polygon points to
-// this plane and generates a Delaunay-mesh on this plane and calculates the area and volume
-// of the original polygon using this mesh
+// Projects the polygon points stereographically to a plane normal to the middle of the polygon
+// and generates a Delaunay-mesh on this plane. The area and volume of the original
+// polygon are then calculated using this mesh in continueCalculation()
 void PolygonTool::updateCalculation() {
+  // Cancels a running calculation. The previous mesh, area and volume stay visible until the first
+  // refinement pass of the new calculation is finished.
+  mCalculation = {};
+
   // Returns if no triangle can be created
   if (mPoints.size() < 3) {
+    clearMesh();
     return;
   }
 
   mCorners.clear();
   mCornersFine.clear();
-  mTriangulation.clear();
 
   auto       object      = mSolarSystem->getObject(getObjectName());
   auto       surface     = object->getSurface();
@@ -1101,30 +826,8 @@ void PolygonTool::updateCalculation() {
     averagePositionNorm += posNorm / static_cast<double>(mPoints.size());
   }
 
-  // Longest distance to average position
-  double maxDist = 0;
-  for (auto const& mark : mPoints) {
-    double dist = glm::length(mPosition - mark->getPosition());
-    if (dist > maxDist) {
-      maxDist = dist;
-    }
-  }
-
-  // If polygon is to big (disable area calculation and mesh generation)
-  // Voronoi implementation is designed for a maximal area of one hemisphere
-  if (maxDist > radii[0]) {
-    mGuiItem->callJavascript("setArea", 0);
-    mGuiItem->callJavascript("setVolume", 0, 0);
-    pShowMesh = false;
-    return;
-  }
-  // Converts maxDist to Voronoi plane (approx.)
-  // 1.2 is for safety -> makes sure, that the voronoi coordinates are under 1
-  maxDist = 1.2 * maxDist * radii[0] / (std::sqrt(std::pow(radii[0], 2) - std::pow(maxDist, 2)));
-
   // Planes normal is perpendicular to the average position
-  mNormal      = glm::normalize(mPosition);
-  mMiddlePoint = mNormal * radii[0];
+  mNormal = glm::normalize(mPosition);
   // Coordinate system of the plane
   glm::dvec3 east(0.0);
   glm::dvec3 north(0.0);
@@ -1144,6 +847,47 @@ void PolygonTool::updateCalculation() {
 
   east = -glm::cross(mNormal, north);
 
+  // Directions of the polygon corners. The edges of the polygon are great circle arcs, but they
+  // are straight lines in the Delaunay-mesh. Therefore long edges are subdivided.
+  std::vector<glm::dvec3> directions;
+
+  for (auto mark = mPoints.begin(); mark != mPoints.end(); ++mark) {
+    auto       next = std::next(mark) == mPoints.end() ? mPoints.begin() : std::next(mark);
+    glm::dvec3 d0   = glm::normalize((*mark)->getPosition());
+    glm::dvec3 d1   = glm::normalize((*next)->getPosition());
+
+    // Filters out double points
+    if (d0 == d1) {
+      continue;
+    }
+
+    double angle    = std::acos(glm::clamp(glm::dot(d0, d1), -1.0, 1.0));
+    int    segments = std::max(1, static_cast<int>(std::ceil(angle / MAX_EDGE_ANGLE)));
+
+    for (int i = 0; i < segments; i++) {
+      directions.push_back(glm::normalize(d0 + (d1 - d0) * (i / static_cast<double>(segments))));
+    }
+  }
+
+  if (directions.size() < 3) {
+    clearMesh();
+    return;
+  }
+
+  // The polygon is projected stereographically from the point opposite to mNormal. This works for
+  // polygons larger than a hemisphere, only points close to the projection center are excluded.
+  // Disables area calculation and mesh generation if the polygon comes too close to this point.
+  for (auto const& d : directions) {
+    // This also catches NaNs for points on opposite sides of the planet.
+    if (!(glm::dot(d, mNormal) > std::cos(MAX_PROJECTION_ANGLE))) {
+      mGuiItem->callJavascript("setArea", 0);
+      mGuiItem->callJavascript("setVolume", 0, 0);
+      pShowMesh = false;
+      clearMesh();
+      return;
+    }
+  }
+
   // Calculates plane for volume calculation
   // From DipStrikeTool
   // Based on http://stackoverflow.com/questions/1400213/3d-least-squares-plane
@@ -1186,143 +930,166 @@ void PolygonTool::updateCalculation() {
   mOffset       = solution.z;
   mMiddlePoint2 = averagePositionNorm + mNormal2 * radii[0] * mOffset;
 
-  // Projects points to Voronoi plane and calculates their position in the new coordinate system
-  int        addr = 0;
-  glm::dvec3 lastPosition{0};
+  // The least squares plane can only be used for the volume calculation if all points of the
+  // polygon are in front of it.
+  mCalculation.mHasVolume = std::all_of(directions.begin(), directions.end(),
+      [this](glm::dvec3 const& d) { return glm::dot(mNormal2, d) > 0; });
 
-  for (auto const& mark : mPoints) {
-    glm::dvec3 currentPosition = mark->getPosition();
-
-    // Filters out double points
-    if (currentPosition != lastPosition) {
-      // Corrects distance from origin (average point is inside of the sphere)
-      double     k   = glm::dot(mNormal, mMiddlePoint) / glm::dot(mNormal, currentPosition);
-      glm::dvec3 pos = k * currentPosition;
-
-      // Coordinates on the plane
-      double x = glm::dot(east, pos - mMiddlePoint);
-      double y = glm::dot(north, pos - mMiddlePoint);
-
-      // Avoids crashing when moving to the other side of the planet
-      if ((std::isnan(x / maxDist)) || (std::isnan(y / maxDist))) {
-        return;
-      }
+  // Projects points to Voronoi plane and calculates their position in the new coordinate system
+  std::vector<glm::dvec2> projected;
+  projected.reserve(directions.size());
 
-      // Saves coordinates normalized with maxDist
-      mCorners.emplace_back(x / maxDist, y / maxDist, addr);
+  // Longest distance to the center of the plane
+  double maxDist = 0;
 
-      lastPosition = currentPosition;
-      addr++;
-    }
+  for (auto const& d : directions) {
+    double k = 2.0 / (1.0 + glm::dot(mNormal, d));
+    projected.emplace_back(k * glm::dot(east, d), k * glm::dot(north, d));
+    maxDist = std::max(maxDist, glm::length(projected.back()));
   }
 
-  // Vector to save triangles from voronoi generator
-  std::vector<Triangle> triangles;
+  // Saves coordinates normalized with maxDist
+  for (size_t i = 0; i < projected.size(); i++) {
+    mCorners.emplace_back(
+        projected[i].x / maxDist, projected[i].y / maxDist, static_cast<uint16_t>(i));
+  }
 
   // Creates Delaunay-mesh of the original polygon
-  createMesh(triangles);
-
-  bool     fine          = false;
-  uint32_t attempt       = 0;
-  double   area          = 0;
-  double   negVolume     = 0;
-  double   posVolume     = 0;
-  size_t   triangleCount = 0;
-  size_t   pointCount    = 0;
-
-  // Counts points of the original Delaunay-mesh
-  for (auto const& vect : mCornersFine) {
-    pointCount += vect.size();
-  }
+  createMesh(mCalculation.mTriangles);
+
+  mCalculation.mActive      = !mCalculation.mTriangles.empty();
+  mCalculation.mMaxDist     = maxDist;
+  mCalculation.mEast        = east;
+  mCalculation.mNorth       = north;
+  mCalculation.mRadii       = radii;
+  mCalculation.mHeightScale = heightScale;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  // Refines triangulation until it is necessary or mMaxAttempt or mMaxPoints
-  while ((!fine) && (attempt < mMaxAttempt) && (pointCount < mMaxPoints)) {
-    attempt++;
-    fine = true;
+void PolygonTool::continueCalculation() {
+  auto& c = mCalculation;
 
-    area          = 0;
-    negVolume     = 0;
-    posVolume     = 0;
-    triangleCount = 0;
-    pointCount    = 0;
+  auto   startTime = std::chrono::steady_clock::now();
+  auto   surface   = mSolarSystem->getObject(getObjectName())->getSurface();
+  double maxDist   = c.mMaxDist;
 
-    mTriangulation.clear();
+  while (c.mActive) {
+
+    // Starts a new refinement pass if necessary. It refines the triangulation until it is fine
+    // enough or mMaxAttempt or mMaxPoints is reached.
+    if (c.mNextTriangle == 0) {
+      if (c.mFine || c.mAttempt >= mMaxAttempt || c.mPointCount >= mMaxPoints) {
+        c.mActive = false;
+        break;
+      }
+
+      c.mAttempt++;
+      c.mFine = true;
+
+      c.mArea          = 0;
+      c.mNegVolume     = 0;
+      c.mPosVolume     = 0;
+      c.mTriangleCount = 0;
+      c.mPointCount    = 0;
+
+      mNextTriangulation.clear();
+    }
 
     // Goes through every triangle of original Delaunay-mesh separately
-    for (auto const& t : triangles) {
-
-      Site s1(0, 0, 0);
-      Site s2(0, 0, 0);
-      Site s3(0, 0, 0);
-      std::tie(s1, s2, s3) = t;
-
-      // Middle point of the triangle
-      glm::dvec2 avgPoint = glm::dvec2((s1.mX + s2.mX + s3.mX) / 3, (s1.mY + s2.mY + s3.mY) / 3);
-
-      // Checks, if middle point is is the polygon
-      if (checkPoint(avgPoint)) {
-        if (attempt == 1) {
-          // Emplaces back the 3 corners of the triangle
-          std::vector<Site> corners;
-          corners.emplace_back(s1.mX, s1.mY, 0);
-          corners.emplace_back(s2.mX, s2.mY, 1);
-          corners.emplace_back(s3.mX, s3.mY, 2);
-
-          mCornersFine.emplace_back(corners);
-        }
+    auto const& t = c.mTriangles[c.mNextTriangle];
+    c.mNextTriangle++;
+
+    Site s1(0, 0, 0);
+    Site s2(0, 0, 0);
+    Site s3(0, 0, 0);
+    std::tie(s1, s2, s3) = t;
+
+    // Middle point of the triangle
+    glm::dvec2 avgPoint = glm::dvec2((s1.mX + s2.mX + s3.mX) / 3, (s1.mY + s2.mY + s3.mY) / 3);
+
+    // Checks, if middle point is is the polygon
+    if (checkPoint(avgPoint)) {
+      if (c.mAttempt == 1) {
+        // Emplaces back the 3 corners of the triangle
+        std::vector<Site> corners;
+        corners.emplace_back(s1.mX, s1.mY, 0);
+        corners.emplace_back(s2.mX, s2.mY, 1);
+        corners.emplace_back(s3.mX, s3.mY, 2);
+
+        mCornersFine.emplace_back(corners);
+      }
 
-        // Checks sleekness of triangles in Delaunay-mesh and refines them, if necessary
-        bool refine = checkSleekness(static_cast<int32_t>(triangleCount));
+      // Checks sleekness of triangles in Delaunay-mesh and refines them, if necessary
+      bool refine = checkSleekness(static_cast<int32_t>(c.mTriangleCount));
 
-        // Voronoi inside the original triangles - to refine triangle angles
-        VoronoiGenerator voronoiRefine;
-        voronoiRefine.parse(mCornersFine[triangleCount]);
+      // Voronoi inside the original triangles - to refine triangle angles
+      VoronoiGenerator voronoiRefine;
+      voronoiRefine.parse(mCornersFine[c.mTriangleCount]);
 
-        // No need for checkPoint, all of the edges are inside the triangle and the polygon
-        for (auto const& s : voronoiRefine.getTriangulation()) {
-          double h1{};
-          double h2{};
+      // No need for checkPoint, all of the edges are inside the triangle and the polygon
+      for (auto const& s : voronoiRefine.getTriangulation()) {
+        double h1{};
+        double h2{};
 
-          // Calculates mesh coordinates on planet's surface and saves these coordinates for display
-          displayMesh(surface, s, maxDist, east, north, radii, heightScale, h1, h2);
+        // Calculates mesh coordinates on planet's surface and saves these coordinates for display
+        displayMesh(surface, s, maxDist, c.mEast, c.mNorth, c.mRadii, c.mHeightScale, h1, h2);
 
-          // If not too many points are addded in checkSleekness and it is not the the last attempt
-          // than refines the mesh based on edge length and height differences
-          if ((!refine) && (pointCount < mMaxPoints) && (attempt < mMaxAttempt)) {
-            refineMesh(surface, s, maxDist, east, north, radii, static_cast<int32_t>(triangleCount),
-                h1, h2, fine);
-          }
+        // If not too many points are addded in checkSleekness and it is not the the last attempt
+        // than refines the mesh based on edge length and height differences
+        if ((!refine) && (c.mPointCount < mMaxPoints) && (c.mAttempt < mMaxAttempt)) {
+          refineMesh(surface, s, maxDist, c.mEast, c.mNorth, c.mRadii,
+              static_cast<int32_t>(c.mTriangleCount), h1, h2, c.mFine);
         }
+      }
 
-        std::vector<Triangle> trianglesRefined = voronoiRefine.getTriangles();
+      std::vector<Triangle> trianglesRefined = voronoiRefine.getTriangles();
 
-        // Calculates area and volume
-        calculateAreaAndVolume(
-            surface, trianglesRefined, maxDist, east, north, radii, area, posVolume, negVolume);
+      // Calculates area and volume
+      calculateAreaAndVolume(surface, trianglesRefined, maxDist, c.mEast, c.mNorth, c.mRadii,
+          c.mArea, c.mPosVolume, c.mNegVolume);
 
-        pointCount += mCornersFine[triangleCount].size();
-        triangleCount++;
-      } // if (checkPoint(avgPoint))
-    }   // for (auto const& t : triangles)
+      c.mPointCount += mCornersFine[c.mTriangleCount].size();
+      c.mTriangleCount++;
+    }
 
-    // Displays values
-    if (!std::isnan(area)) {
-      mGuiItem->callJavascript("setArea", area);
-    } else {
-      mGuiItem->callJavascript("setArea", 0);
+    // At the end of each refinement pass, the intermediate result is shown.
+    if (c.mNextTriangle == c.mTriangles.size()) {
+      c.mNextTriangle = 0;
+      showCalculationResult();
     }
 
-    if ((!std::isnan(posVolume)) && (!std::isnan(negVolume))) {
-      mGuiItem->callJavascript("setVolume", posVolume, negVolume);
-    } else if (!std::isnan(negVolume)) {
-      mGuiItem->callJavascript("setVolume", 0, negVolume);
-    } else if (!std::isnan(posVolume)) {
-      mGuiItem->callJavascript("setVolume", posVolume, 0);
-    } else {
-      mGuiItem->callJavascript("setVolume", 0, 0);
+    if (std::chrono::steady_clock::now() - startTime > CALCULATION_TIME_BUDGET) {
+      break;
     }
-  } // while ((!fine) && (attempt < mMaxAttempt) && (pointCount < mMaxPoints))
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void PolygonTool::showCalculationResult() {
+  auto const& c = mCalculation;
+
+  // Displays values
+  if (!std::isnan(c.mArea)) {
+    mGuiItem->callJavascript("setArea", c.mArea);
+  } else {
+    mGuiItem->callJavascript("setArea", 0);
+  }
+
+  if (!c.mHasVolume) {
+    mGuiItem->callJavascript("setVolume", 0, 0);
+  } else if ((!std::isnan(c.mPosVolume)) && (!std::isnan(c.mNegVolume))) {
+    mGuiItem->callJavascript("setVolume", c.mPosVolume, c.mNegVolume);
+  } else if (!std::isnan(c.mNegVolume)) {
+    mGuiItem->callJavascript("setVolume", 0, c.mNegVolume);
+  } else if (!std::isnan(c.mPosVolume)) {
+    mGuiItem->callJavascript("setVolume", c.mPosVolume, 0);
+  } else {
+    mGuiItem->callJavascript("setVolume", 0, 0);
+  }
+
+  std::swap(mTriangulation, mNextTriangulation);
   mIndexCount2 = mTriangulation.size();
 
   // Uploads new data
@@ -1336,6 +1103,14 @@ void PolygonTool::updateCalculation() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void PolygonTool::clearMesh() {
+  mTriangulation.clear();
+  mNextTriangulation.clear();
+  mIndexCount2 = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void PolygonTool::update() {
   MultiPointTool::update();
 
@@ -1345,6 +1120,12 @@ void PolygonTool::update() {
     mVerticesDirty = false;
   }
 
+  // The mesh is refined over multiple frames, so that editing large polygons does not freeze the
+  // application.
+  if (mCalculation.mActive) {
+    continueCalculation();
+  }
+
   auto object   = mSolarSystem->getObject(getObjectName());
   auto guiScale = mSolarSystem->getScaleBasedOnObserverDistance(
       object, mPosition, pScaleDistance.get(), mSettings->mGraphics.pWorldUIScale.get());
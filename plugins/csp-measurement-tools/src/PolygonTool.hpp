@@ -13,6 +13,7 @@
 
 #include <VistaKernel/GraphicsManager/VistaOpenGLDraw.h>
 
+#include <chrono>
 #include <glm/glm.hpp>
 #include <vector>
 
@@ -33,6 +34,9 @@ namespace csp::measurementtools {
 
 /// Measures the area and volume of an arbitrary polygon on surface with a Delaunay-mesh. It
 /// displays the bounding box of the selected polygon, which can be copied for cache generator.
+/// The mesh is refined iteratively. As this requires many height samples, each refinement pass is
+/// distributed over multiple frames; the result of each finished pass is shown immediately. If the
+/// polygon is modified, the calculation is restarted.
 class PolygonTool : public IVistaOpenGLDraw, public csl::tools::MultiPointTool {
  public:
   /// This text is shown on the ui and can be edited by the user.
@@ -67,25 +71,34 @@ class PolygonTool : public IVistaOpenGLDraw, public csl::tools::MultiPointTool {
 
  private:
   void updateLineVertices();
+
+  /// Projects the polygon to a plane and creates the initial Delaunay-mesh. This cancels any
+  /// running calculation.
   void updateCalculation();
 
+  /// Refines the mesh and accumulates area and volume until CALCULATION_TIME_BUDGET is used up.
+  void continueCalculation();
+
+  /// Shows area, volume and mesh of the last finished refinement pass.
+  void showCalculationResult();
+  void clearMesh();
+
   /// Returns the interpolated position in cartesian coordinates. The fourth component is
   /// height above the surface
   glm::dvec4 getInterpolatedPosBetweenTwoMarks(
       std::shared_ptr<cs::scene::CelestialSurface> const& surface,
       csl::tools::DeletableMark const& l0, csl::tools::DeletableMark const& l1, double value);
 
-  /// Finds the intersection point between two sites
-  static bool findIntersection(Site const& s1, Site const& s2, Site const& s3, Site const& s4,
-      double& intersectionX, double& intersectionY);
-
-  /// Creates a Delaunay-mesh and corrects it to match the original polygon
+  /// Creates a constrained Delaunay-mesh which contains all edges of the original polygon
   /// (especially for concave polygons)
   void createMesh(std::vector<Triangle>& triangles);
   /// Checks sleekness of a triangle from the original Delaunay-mesh and its subtriangles
   /// If a triangle is too sleek, divides it
   /// Returns true if a lot of new points are added
   bool checkSleekness(int count);
+  /// Maps a point of the Delaunay-mesh back to the planet's surface (without height)
+  glm::dvec3 toSurface(glm::dvec2 const& point, double mdist, glm::dvec3 const& e,
+      glm::dvec3 const& n, glm::dvec3 const& radii) const;
   /// Draws the Delaunay-mesh on the planet's surface
   void displayMesh(std::shared_ptr<cs::scene::CelestialSurface> const& surface, Edge2 const& edge,
       double mdist, glm::dvec3 const& e, glm::dvec3 const& n, glm::dvec3 const& r, double scale,
@@ -140,12 +153,13 @@ class PolygonTool : public IVistaOpenGLDraw, public csl::tools::MultiPointTool {
   // minLng,maxLng,minLat,maxLat
   glm::dvec4 mBoundingBox = glm::dvec4(0.0);
 
-  // For Delaunay-mesh
+  // For Delaunay-mesh. mTriangulation is the mesh which is currently drawn, mNextTriangulation is
+  // filled by the running refinement pass.
   std::vector<Site>              mCorners;
   std::vector<std::vector<Site>> mCornersFine;
   std::vector<glm::dvec3>        mTriangulation;
+  std::vector<glm::dvec3>        mNextTriangulation;
   glm::dvec3                     mNormal      = glm::dvec3(0.0);
-  glm::dvec3                     mMiddlePoint = glm::dvec3(0.0);
   size_t                         mIndexCount2 = 0;
 
   // For triangle fineness
@@ -159,9 +173,34 @@ class PolygonTool : public IVistaOpenGLDraw, public csl::tools::MultiPointTool {
   glm::dvec3 mNormal2      = glm::dvec3(0.0);
   glm::dvec3 mMiddlePoint2 = glm::dvec3(0.0);
 
-  static const int   NUM_SAMPLES;
-  static const char* SHADER_VERT;
-  static const char* SHADER_FRAG;
+  // State of the calculation which is distributed over multiple frames.
+  struct CalculationState {
+    bool                  mActive = false;
+    std::vector<Triangle> mTriangles;
+    size_t                mNextTriangle = 0;
+    uint32_t              mAttempt      = 0;
+    bool                  mFine         = false;
+    bool                  mHasVolume    = false;
+
+    double mArea          = 0;
+    double mPosVolume     = 0;
+    double mNegVolume     = 0;
+    size_t mTriangleCount = 0;
+    size_t mPointCount    = 0;
+
+    double     mMaxDist     = 0;
+    double     mHeightScale = 1;
+    glm::dvec3 mEast        = glm::dvec3(0.0);
+    glm::dvec3 mNorth       = glm::dvec3(0.0);
+    glm::dvec3 mRadii       = glm::dvec3(0.0);
+  } mCalculation;
+
+  static const int                       NUM_SAMPLES;
+  static const double                    MAX_EDGE_ANGLE;
+  static const double                    MAX_PROJECTION_ANGLE;
+  static const std::chrono::milliseconds CALCULATION_TIME_BUDGET;
+  static const char*                     SHADER_VERT;
+  static const char*                     SHADER_FRAG;
 };
 
 } // namespace csp::measurementtools
@@ -0,0 +1,886 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "DelaunayTriangulation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace csp::measurementtools {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The exact arithmetic below represents a number as an expansion: a sum of doubles which do not
+// overlap, ordered by increasing magnitude. The sign of an expansion is the sign of its last
+// component. See Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+// Geometric Predicates", 1997. The expansions are stored in fixed-size arrays, so that no memory
+// is allocated.
+
+// Relative error bounds of the floating-point evaluation of the predicates.
+constexpr double EPSILON        = std::numeric_limits<double>::epsilon() * 0.5;
+constexpr double ORIENT_BOUND   = (3.0 + 16.0 * EPSILON) * EPSILON;
+constexpr double INCIRCLE_BOUND = (10.0 + 96.0 * EPSILON) * EPSILON;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Computes x + y = a + b exactly, x is the rounded sum.
+void twoSum(double a, double b, double& x, double& y) {
+  x         = a + b;
+  double bv = x - a;
+  double av = x - bv;
+  y         = (a - av) + (b - bv);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Stores a - b as an expansion in h and returns its length, which is at most two.
+size_t difference(double a, double b, double* h) {
+  size_t length = 0;
+  double x      = 0.0;
+  double y      = 0.0;
+  twoSum(a, -b, x, y);
+
+  if (y != 0.0) {
+    h[length++] = y;
+  }
+
+  if (x != 0.0) {
+    h[length++] = x;
+  }
+
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Adds b to the expansion h in place. Returns the new length, which is at most length + 1.
+size_t grow(double* h, size_t length, double b) {
+  size_t result = 0;
+
+  for (size_t i = 0; i < length; ++i) {
+    double y = 0.0;
+    twoSum(b, h[i], b, y);
+    if (y != 0.0) {
+      h[result++] = y;
+    }
+  }
+
+  if (b != 0.0) {
+    h[result++] = b;
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Adds the product of the expansions e and f to the expansion h in place. Returns the new length,
+// which is at most length + 2 * eLength * fLength.
+size_t addProduct(
+    double* h, size_t length, double const* e, size_t eLength, double const* f, size_t fLength) {
+  for (size_t i = 0; i < eLength; ++i) {
+    for (size_t j = 0; j < fLength; ++j) {
+      double product = e[i] * f[j];
+      length         = grow(h, length, std::fma(e[i], f[j], -product));
+      length         = grow(h, length, product);
+    }
+  }
+
+  return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns a positive value if a, b and c are in counter-clockwise order, a negative value if they
+// are in clockwise order and zero if they are collinear. Only the sign of the result is exact.
+double orient2d(glm::dvec2 const& a, glm::dvec2 const& b, glm::dvec2 const& c) {
+  double left  = (a.x - c.x) * (b.y - c.y);
+  double right = (a.y - c.y) * (b.x - c.x);
+  double det   = left - right;
+
+  if (std::abs(det) >= ORIENT_BOUND * (std::abs(left) + std::abs(right))) {
+    return det;
+  }
+
+  std::array<double, 2> acx{};
+  std::array<double, 2> acy{};
+  std::array<double, 2> bcy{};
+  std::array<double, 2> cbx{};
+
+  size_t acxLength = difference(a.x, c.x, acx.data());
+  size_t acyLength = difference(a.y, c.y, acy.data());
+  size_t bcyLength = difference(b.y, c.y, bcy.data());
+  size_t cbxLength = difference(c.x, b.x, cbx.data());
+
+  // (a.x - c.x) * (b.y - c.y) + (a.y - c.y) * (c.x - b.x)
+  std::array<double, 16> exact{};
+  size_t length = addProduct(exact.data(), 0, acx.data(), acxLength, bcy.data(), bcyLength);
+  length        = addProduct(exact.data(), length, acy.data(), acyLength, cbx.data(), cbxLength);
+
+  return length == 0 ? 0.0 : exact[length - 1];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns a positive value if d lies inside the circumcircle of the counter-clockwise triangle
+// a, b, c, a negative value if it lies outside and zero if the four points are cocircular. For a
+// clockwise triangle, the sign is reversed. Only the sign of the result is exact.
+double incircle(
+    glm::dvec2 const& a, glm::dvec2 const& b, glm::dvec2 const& c, glm::dvec2 const& d) {
+  glm::dvec2 ad = a - d;
+  glm::dvec2 bd = b - d;
+  glm::dvec2 cd = c - d;
+
+  double bdxcdy = bd.x * cd.y;
+  double cdxbdy = cd.x * bd.y;
+  double cdxady = cd.x * ad.y;
+  double adxcdy = ad.x * cd.y;
+  double adxbdy = ad.x * bd.y;
+  double bdxady = bd.x * ad.y;
+
+  double alift = glm::dot(ad, ad);
+  double blift = glm::dot(bd, bd);
+  double clift = glm::dot(cd, cd);
+
+  double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+  double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+                     (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                     (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+
+  if (std::abs(det) > INCIRCLE_BOUND * permanent) {
+    return det;
+  }
+
+  // The coordinate differences and their negations.
+  std::array<std::array<double, 2>, 3> dx{};
+  std::array<std::array<double, 2>, 3> dy{};
+  std::array<std::array<double, 2>, 3> negDy{};
+  std::array<size_t, 3>                dxLength{};
+  std::array<size_t, 3>                dyLength{};
+  std::array<size_t, 3>                negDyLength{};
+
+  std::array<glm::dvec2 const*, 3> points = {&a, &b, &c};
+  for (size_t i = 0; i < 3; ++i) {
+    dxLength[i]    = difference(points[i]->x, d.x, dx[i].data());
+    dyLength[i]    = difference(points[i]->y, d.y, dy[i].data());
+    negDyLength[i] = difference(d.y, points[i]->y, negDy[i].data());
+  }
+
+  // det = lift(a) * cross(b, c) + lift(b) * cross(c, a) + lift(c) * cross(a, b), where all
+  // coordinates are relative to d.
+  std::array<double, 1536> exact{};
+  size_t                   length = 0;
+
+  for (size_t i = 0; i < 3; ++i) {
+    size_t j = (i + 1) % 3;
+    size_t k = (i + 2) % 3;
+
+    std::array<double, 16> lift{};
+    size_t liftLength = addProduct(lift.data(), 0, dx[i].data(), dxLength[i], dx[i].data(),
+        dxLength[i]);
+    liftLength = addProduct(lift.data(), liftLength, dy[i].data(), dyLength[i], dy[i].data(),
+        dyLength[i]);
+
+    std::array<double, 16> cross{};
+    size_t crossLength = addProduct(cross.data(), 0, dx[j].data(), dxLength[j], dy[k].data(),
+        dyLength[k]);
+    crossLength = addProduct(cross.data(), crossLength, dx[k].data(), dxLength[k],
+        negDy[j].data(), negDyLength[j]);
+
+    length =
+        addProduct(exact.data(), length, lift.data(), liftLength, cross.data(), crossLength);
+  }
+
+  return length == 0 ? 0.0 : exact[length - 1];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns true if p, q and r are in counter-clockwise order.
+bool orient(glm::dvec2 const& p, glm::dvec2 const& q, glm::dvec2 const& r) {
+  return orient2d(p, q, r) > 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns true if p lies inside the circumcircle of the clockwise triangle a, b, c.
+bool inCircle(
+    glm::dvec2 const& a, glm::dvec2 const& b, glm::dvec2 const& c, glm::dvec2 const& p) {
+  return incircle(a, b, c, p) < 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns true if p and q lie strictly on different sides of the line through a and b.
+bool separates(glm::dvec2 const& a, glm::dvec2 const& b, glm::dvec2 const& p, glm::dvec2 const& q) {
+  double op = orient2d(a, b, p);
+  double oq = orient2d(a, b, q);
+  return (op > 0.0 && oq < 0.0) || (op < 0.0 && oq > 0.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns the circumcenter of the triangle a, b, c relative to a.
+glm::dvec2 circumcenterOffset(glm::dvec2 const& a, glm::dvec2 const& b, glm::dvec2 const& c) {
+  glm::dvec2 d = b - a;
+  glm::dvec2 e = c - a;
+
+  double bl = glm::dot(d, d);
+  double cl = glm::dot(e, e);
+  double s  = 0.5 / (d.x * e.y - d.y * e.x);
+
+  return glm::dvec2((e.y * bl - d.y * cl) * s, (d.x * cl - e.x * bl) * s);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double circumradius2(glm::dvec2 const& a, glm::dvec2 const& b, glm::dvec2 const& c) {
+  glm::dvec2 offset = circumcenterOffset(a, b, c);
+  return glm::dot(offset, offset);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Monotonically increases with the real angle, but is much cheaper to compute.
+double pseudoAngle(glm::dvec2 const& d) {
+  if (d.x == 0.0 && d.y == 0.0) {
+    return 0.0;
+  }
+
+  double p = d.x / (std::abs(d.x) + std::abs(d.y));
+  return (d.y > 0.0 ? 3.0 - p : 1.0 + p) / 4.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DelaunayTriangulation::triangulate(std::vector<glm::dvec2> const& points) {
+  mPoints = &points;
+  mTriangles.clear();
+  mHalfedges.clear();
+  mConstrained.clear();
+
+  auto n = static_cast<uint32_t>(points.size());
+
+  if (n < 3) {
+    return;
+  }
+
+  // Find the center of the bounding box.
+  glm::dvec2 minPos(std::numeric_limits<double>::max());
+  glm::dvec2 maxPos(std::numeric_limits<double>::lowest());
+
+  for (auto const& p : points) {
+    minPos = glm::min(minPos, p);
+    maxPos = glm::max(maxPos, p);
+  }
+
+  glm::dvec2 center = (minPos + maxPos) * 0.5;
+
+  // Pick a seed point close to the center.
+  uint32_t i0      = 0;
+  double   minDist = std::numeric_limits<double>::max();
+  for (uint32_t i = 0; i < n; ++i) {
+    double d = glm::distance(center, points[i]);
+    if (d < minDist) {
+      i0      = i;
+      minDist = d;
+    }
+  }
+
+  // Find the point closest to the seed.
+  uint32_t i1 = INVALID_INDEX;
+  minDist     = std::numeric_limits<double>::max();
+  for (uint32_t i = 0; i < n; ++i) {
+    double d = glm::distance(points[i0], points[i]);
+    if (i != i0 && d < minDist && d > 0.0) {
+      i1      = i;
+      minDist = d;
+    }
+  }
+
+  if (i1 == INVALID_INDEX) {
+    return;
+  }
+
+  // Find the third point which forms the smallest circumcircle with the first two.
+  uint32_t i2        = INVALID_INDEX;
+  double   minRadius = std::numeric_limits<double>::max();
+  for (uint32_t i = 0; i < n; ++i) {
+    if (i == i0 || i == i1) {
+      continue;
+    }
+
+    double r = circumradius2(points[i0], points[i1], points[i]);
+    if (r < minRadius) {
+      i2        = i;
+      minRadius = r;
+    }
+  }
+
+  // All points are collinear.
+  if (i2 == INVALID_INDEX) {
+    return;
+  }
+
+  if (orient(points[i0], points[i1], points[i2])) {
+    std::swap(i1, i2);
+  }
+
+  mCenter = points[i0] + circumcenterOffset(points[i0], points[i1], points[i2]);
+
+  // Sort the points by distance from the seed triangle's circumcenter.
+  mIDs.resize(n);
+  mDistances.resize(n);
+  std::iota(mIDs.begin(), mIDs.end(), 0);
+  for (uint32_t i = 0; i < n; ++i) {
+    mDistances[i] = glm::distance(points[i], mCenter);
+  }
+
+  std::sort(mIDs.begin(), mIDs.end(),
+      [this](uint32_t a, uint32_t b) { return mDistances[a] < mDistances[b]; });
+
+  // Initialize the hull with the seed triangle. The hull is stored as a doubly linked list of
+  // point indices; the hash allows finding a visible hull edge for a new point quickly.
+  auto hashSize = static_cast<uint32_t>(std::ceil(std::sqrt(n)));
+  mHullPrev.assign(n, 0);
+  mHullNext.assign(n, 0);
+  mHullTri.assign(n, 0);
+  mHullHash.assign(hashSize, INVALID_INDEX);
+
+  mHullStart    = i0;
+  mHullNext[i0] = mHullPrev[i2] = i1;
+  mHullNext[i1] = mHullPrev[i0] = i2;
+  mHullNext[i2] = mHullPrev[i1] = i0;
+
+  mHullTri[i0] = 0;
+  mHullTri[i1] = 1;
+  mHullTri[i2] = 2;
+
+  mHullHash[hashKey(points[i0])] = i0;
+  mHullHash[hashKey(points[i1])] = i1;
+  mHullHash[hashKey(points[i2])] = i2;
+
+  size_t maxTriangles = 2 * n - 5;
+  mTriangles.reserve(maxTriangles * 3);
+  mHalfedges.reserve(maxTriangles * 3);
+
+  addTriangle(i0, i1, i2, INVALID_INDEX, INVALID_INDEX, INVALID_INDEX);
+
+  glm::dvec2 previous(0.0);
+
+  for (uint32_t k = 0; k < n; ++k) {
+    uint32_t          i = mIDs[k];
+    glm::dvec2 const& p = points[i];
+
+    // Skip near-duplicate points.
+    if (k > 0 && std::abs(p.x - previous.x) <= std::numeric_limits<double>::epsilon() &&
+        std::abs(p.y - previous.y) <= std::numeric_limits<double>::epsilon()) {
+      continue;
+    }
+    previous = p;
+
+    // Skip the seed triangle points.
+    if (i == i0 || i == i1 || i == i2) {
+      continue;
+    }
+
+    // Find a visible edge on the convex hull using the edge hash.
+    uint32_t start = 0;
+    uint32_t key   = hashKey(p);
+    for (uint32_t j = 0; j < hashSize; ++j) {
+      start = mHullHash[(key + j) % hashSize];
+      if (start != INVALID_INDEX && start != mHullNext[start]) {
+        break;
+      }
+    }
+
+    start      = mHullPrev[start];
+    uint32_t e = start;
+    uint32_t q = mHullNext[e];
+
+    while (!orient(p, points[e], points[q])) {
+      e = q;
+      if (e == start) {
+        e = INVALID_INDEX;
+        break;
+      }
+      q = mHullNext[e];
+    }
+
+    // This is likely a near-duplicate point, skip it.
+    if (e == INVALID_INDEX) {
+      continue;
+    }
+
+    // Add the first triangle from the point.
+    uint32_t t = addTriangle(e, i, mHullNext[e], INVALID_INDEX, INVALID_INDEX, mHullTri[e]);
+
+    // Recursively flip triangles from the point until they satisfy the Delaunay condition.
+    mHullTri[i] = legalize(t + 2);
+    mHullTri[e] = t;
+
+    // Walk forward through the hull, adding more triangles and flipping recursively.
+    uint32_t next = mHullNext[e];
+    q             = mHullNext[next];
+    while (orient(p, points[next], points[q])) {
+      t               = addTriangle(next, i, q, mHullTri[i], INVALID_INDEX, mHullTri[next]);
+      mHullTri[i]     = legalize(t + 2);
+      mHullNext[next] = next; // Mark as removed.
+      next            = q;
+      q               = mHullNext[next];
+    }
+
+    // Walk backward from the other side, adding more triangles and flipping.
+    if (e == start) {
+      q = mHullPrev[e];
+      while (orient(p, points[q], points[e])) {
+        t = addTriangle(q, i, e, INVALID_INDEX, mHullTri[e], mHullTri[q]);
+        legalize(t + 2);
+        mHullTri[q]  = t;
+        mHullNext[e] = e; // Mark as removed.
+        e            = q;
+        q            = mHullPrev[e];
+      }
+    }
+
+    // Update the hull indices.
+    mHullStart = mHullPrev[i] = e;
+    mHullNext[e] = mHullPrev[next] = i;
+    mHullNext[i]                   = next;
+
+    // Save the two new edges in the hash table.
+    mHullHash[hashKey(p)]         = i;
+    mHullHash[hashKey(points[e])] = e;
+  }
+
+  mConstrained.assign(mTriangles.size(), false);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool DelaunayTriangulation::constrain(std::vector<std::pair<uint32_t, uint32_t>> const& edges) {
+  if (edges.empty()) {
+    return true;
+  }
+
+  if (mTriangles.empty()) {
+    return false;
+  }
+
+  auto const& points = *mPoints;
+
+  mPointEdges.assign(points.size(), INVALID_INDEX);
+  for (uint32_t e = 0; e < mTriangles.size(); ++e) {
+    mPointEdges[mTriangles[e]] = e;
+  }
+
+  bool success = true;
+  mEdgeStack.clear();
+
+  for (auto [a, b] : edges) {
+    if (a == b) {
+      continue;
+    }
+
+    // Ignored points are not part of any triangle.
+    if (mPointEdges[a] == INVALID_INDEX || mPointEdges[b] == INVALID_INDEX) {
+      success = false;
+      continue;
+    }
+
+    // If the edge passes through other points, it is inserted piece by piece.
+    while (a != b) {
+      a = insertEdge(a, b);
+
+      if (a == INVALID_INDEX) {
+        success = false;
+        break;
+      }
+    }
+  }
+
+  // The flips of insertEdge() may have created edges which do not satisfy the Delaunay condition.
+  // insertEdge() has pushed all edges of the flipped triangles to mEdgeStack. These are flipped
+  // until the triangulation is Delaunay again, except for the constrained edges.
+  mCrossings.clear();
+
+  while (!mEdgeStack.empty()) {
+    uint32_t a = mEdgeStack.back();
+    uint32_t b = mHalfedges[a];
+    mEdgeStack.pop_back();
+
+    if (b == INVALID_INDEX || mConstrained[a]) {
+      continue;
+    }
+
+    uint32_t p0 = mTriangles[prevHalfedge(a)];
+    uint32_t pr = mTriangles[a];
+    uint32_t pl = mTriangles[nextHalfedge(a)];
+    uint32_t p1 = mTriangles[prevHalfedge(b)];
+
+    if (inCircle(points[p0], points[pr], points[pl], points[p1])) {
+      flip(a);
+
+      mEdgeStack.push_back(a);
+      mEdgeStack.push_back(nextHalfedge(a));
+      mEdgeStack.push_back(b);
+      mEdgeStack.push_back(nextHalfedge(b));
+    }
+  }
+
+  return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<uint32_t> const& DelaunayTriangulation::getTriangles() const {
+  return mTriangles;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<uint32_t> const& DelaunayTriangulation::getHalfedges() const {
+  return mHalfedges;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t DelaunayTriangulation::getTriangleCount() const {
+  return mTriangles.size() / 3;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool DelaunayTriangulation::isConstrained(uint32_t e) const {
+  return mConstrained[e];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t DelaunayTriangulation::addTriangle(
+    uint32_t i0, uint32_t i1, uint32_t i2, uint32_t a, uint32_t b, uint32_t c) {
+  auto t = static_cast<uint32_t>(mTriangles.size());
+
+  mTriangles.push_back(i0);
+  mTriangles.push_back(i1);
+  mTriangles.push_back(i2);
+
+  mHalfedges.resize(mHalfedges.size() + 3);
+  link(t, a);
+  link(t + 1, b);
+  link(t + 2, c);
+
+  return t;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DelaunayTriangulation::link(uint32_t a, uint32_t b) {
+  mHalfedges[a] = b;
+  if (b != INVALID_INDEX) {
+    mHalfedges[b] = a;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t DelaunayTriangulation::legalize(uint32_t a) {
+  auto const& points = *mPoints;
+
+  // The recursion is replaced by an explicit stack.
+  mEdgeStack.clear();
+
+  uint32_t ar = 0;
+
+  while (true) {
+    uint32_t b  = mHalfedges[a];
+    uint32_t a0 = a - a % 3;
+    ar          = a0 + (a + 2) % 3;
+
+    // Convex hull edges cannot be flipped.
+    if (b == INVALID_INDEX) {
+      if (mEdgeStack.empty()) {
+        break;
+      }
+      a = mEdgeStack.back();
+      mEdgeStack.pop_back();
+      continue;
+    }
+
+    uint32_t b0 = b - b % 3;
+    uint32_t al = a0 + (a + 1) % 3;
+    uint32_t bl = b0 + (b + 2) % 3;
+
+    uint32_t p0 = mTriangles[ar];
+    uint32_t pr = mTriangles[a];
+    uint32_t pl = mTriangles[al];
+    uint32_t p1 = mTriangles[bl];
+
+    // If the pair of triangles does not satisfy the Delaunay condition (p1 is inside the
+    // circumcircle of [p0, pl, pr]), flip them. Then do the same check for the new pair of
+    // triangles.
+    if (inCircle(points[p0], points[pr], points[pl], points[p1])) {
+      mTriangles[a] = p1;
+      mTriangles[b] = p0;
+
+      uint32_t hbl = mHalfedges[bl];
+
+      // The edge was swapped on the other side of the hull (rare), fix the half-edge reference.
+      if (hbl == INVALID_INDEX) {
+        uint32_t e = mHullStart;
+        do {
+          if (mHullTri[e] == bl) {
+            mHullTri[e] = a;
+            break;
+          }
+          e = mHullPrev[e];
+        } while (e != mHullStart);
+      }
+
+      link(a, hbl);
+      link(b, mHalfedges[ar]);
+      link(ar, bl);
+
+      mEdgeStack.push_back(b0 + (b + 1) % 3);
+    } else {
+      if (mEdgeStack.empty()) {
+        break;
+      }
+      a = mEdgeStack.back();
+      mEdgeStack.pop_back();
+    }
+  }
+
+  return ar;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t DelaunayTriangulation::insertEdge(uint32_t a, uint32_t b) {
+  auto const&       points = *mPoints;
+  glm::dvec2 const& pa     = points[a];
+  glm::dvec2 const& pb     = points[b];
+
+  // Look at all triangles around a. The edge either exists already, runs along another edge or
+  // enters one of these triangles.
+  uint32_t crossing = INVALID_INDEX;
+
+  collectFan(a);
+  for (uint32_t e : mFan) {
+    uint32_t r = mTriangles[nextHalfedge(e)];
+    uint32_t s = mTriangles[prevHalfedge(e)];
+
+    if (r == b) {
+      markConstrained(e);
+      return b;
+    }
+
+    if (s == b) {
+      markConstrained(prevHalfedge(e));
+      return b;
+    }
+
+    double orientR = orient2d(pa, points[r], pb);
+    double orientS = orient2d(pa, points[s], pb);
+
+    if (orientR == 0.0 && glm::dot(points[r] - pa, pb - pa) > 0.0) {
+      markConstrained(e);
+      return r;
+    }
+
+    if (orientS == 0.0 && glm::dot(points[s] - pa, pb - pa) > 0.0) {
+      markConstrained(prevHalfedge(e));
+      return s;
+    }
+
+    // As all triangles are clockwise, the edge enters the triangle if b lies right of a -> r and
+    // left of a -> s.
+    if (orientR < 0.0 && orientS > 0.0) {
+      crossing = nextHalfedge(e);
+      break;
+    }
+  }
+
+  if (crossing == INVALID_INDEX) {
+    return INVALID_INDEX;
+  }
+
+  // Walk through the triangulation towards b and collect all edges which are crossed on the way.
+  // If the walk hits another point, the edge is only inserted up to this point.
+  uint32_t c = b;
+
+  mCrossings.clear();
+  while (true) {
+    if (mConstrained[crossing] || mHalfedges[crossing] == INVALID_INDEX) {
+      return INVALID_INDEX;
+    }
+
+    mCrossings.push_back(crossing);
+
+    uint32_t t = mHalfedges[crossing];
+    uint32_t v = mTriangles[prevHalfedge(t)];
+
+    if (v == b) {
+      break;
+    }
+
+    double orientV = orient2d(pa, pb, points[v]);
+
+    if (orientV == 0.0) {
+      c = v;
+      break;
+    }
+
+    // The walk continues through the edge whose end points are on different sides.
+    double orientT = orient2d(pa, pb, points[mTriangles[t]]);
+    crossing       = ((orientV > 0.0) == (orientT > 0.0)) ? nextHalfedge(t) : prevHalfedge(t);
+  }
+
+  // Flip the crossing edges until none of them crosses the new edge anymore. An edge can only be
+  // flipped if the two adjacent triangles form a convex quadrilateral; else it is retried after
+  // the other edges have been flipped. See Sloan, "A fast algorithm for generating constrained
+  // Delaunay triangulations", 1993.
+  glm::dvec2 const& pc = points[c];
+
+  for (size_t i = 0; i < mCrossings.size(); ++i) {
+    uint32_t e = mCrossings[i];
+
+    uint32_t p0 = mTriangles[prevHalfedge(e)];
+    uint32_t pr = mTriangles[e];
+    uint32_t pl = mTriangles[nextHalfedge(e)];
+    uint32_t p1 = mTriangles[prevHalfedge(mHalfedges[e])];
+
+    if (!separates(points[p0], points[p1], points[pr], points[pl])) {
+      mCrossings.push_back(e);
+      continue;
+    }
+
+    uint32_t f = mHalfedges[e];
+    flip(e);
+
+    // The new diagonal is stored in the previous half-edge of e, all edges of the two new triangles
+    // are checked for the Delaunay condition later on.
+    mEdgeStack.push_back(e);
+    mEdgeStack.push_back(nextHalfedge(e));
+    mEdgeStack.push_back(prevHalfedge(e));
+    mEdgeStack.push_back(f);
+    mEdgeStack.push_back(nextHalfedge(f));
+
+    if (p0 != a && p0 != c && p1 != a && p1 != c && separates(pa, pc, points[p0], points[p1])) {
+      mCrossings.push_back(prevHalfedge(e));
+    }
+  }
+
+  collectFan(a);
+  for (uint32_t e : mFan) {
+    if (mTriangles[nextHalfedge(e)] == c) {
+      markConstrained(e);
+      break;
+    }
+
+    if (mTriangles[prevHalfedge(e)] == c) {
+      markConstrained(prevHalfedge(e));
+      break;
+    }
+  }
+
+  return c;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DelaunayTriangulation::flip(uint32_t a) {
+  uint32_t b  = mHalfedges[a];
+  uint32_t al = nextHalfedge(a);
+  uint32_t ar = prevHalfedge(a);
+  uint32_t br = nextHalfedge(b);
+  uint32_t bl = prevHalfedge(b);
+
+  uint32_t p0 = mTriangles[ar];
+  uint32_t pr = mTriangles[a];
+  uint32_t pl = mTriangles[al];
+  uint32_t p1 = mTriangles[bl];
+
+  mTriangles[a] = p1;
+  mTriangles[b] = p0;
+
+  // The outer edges which have been stored in bl and ar are now stored in a and b.
+  link(a, mHalfedges[bl]);
+  link(b, mHalfedges[ar]);
+  link(ar, bl);
+
+  mConstrained[a]  = mConstrained[bl];
+  mConstrained[b]  = mConstrained[ar];
+  mConstrained[ar] = false;
+  mConstrained[bl] = false;
+
+  // pr and pl have lost the flipped edge.
+  mPointEdges[pr] = br;
+  mPointEdges[pl] = al;
+
+  // Edges which are still queued for flipping may have been moved.
+  for (auto& e : mCrossings) {
+    if (e == bl) {
+      e = a;
+    } else if (e == ar) {
+      e = b;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DelaunayTriangulation::collectFan(uint32_t p) {
+  mFan.clear();
+
+  uint32_t start = mPointEdges[p];
+  uint32_t e     = start;
+
+  // Rotate around p until we are back at the start. If the convex hull is reached before, rotate
+  // into the other direction from the start.
+  do {
+    mFan.push_back(e);
+    e = mHalfedges[prevHalfedge(e)];
+
+    if (e == INVALID_INDEX) {
+      e = start;
+      while (mHalfedges[e] != INVALID_INDEX) {
+        e = nextHalfedge(mHalfedges[e]);
+        mFan.push_back(e);
+      }
+      return;
+    }
+  } while (e != start);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DelaunayTriangulation::markConstrained(uint32_t e) {
+  mConstrained[e] = true;
+  if (mHalfedges[e] != INVALID_INDEX) {
+    mConstrained[mHalfedges[e]] = true;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t DelaunayTriangulation::hashKey(glm::dvec2 const& p) const {
+  auto hashSize = static_cast<uint32_t>(mHullHash.size());
+  auto key      = static_cast<uint32_t>(std::floor(pseudoAngle(p - mCenter) * hashSize));
+  return key % hashSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace csp::measurementtools
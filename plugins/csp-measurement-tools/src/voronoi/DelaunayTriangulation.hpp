@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CSP_MEASUREMENT_TOOLS_DELAUNAY_TRIANGULATION_HPP
+#define CSP_MEASUREMENT_TOOLS_DELAUNAY_TRIANGULATION_HPP
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace csp::measurementtools {
+
+/// Computes the Delaunay triangulation of a set of points in the plane. This uses the sweep-hull
+/// algorithm as implemented by the Delaunator library (https://github.com/mapbox/delaunator): The
+/// points are inserted in the order of their distance to a seed triangle, each new point is
+/// connected to the visible part of the convex hull and non-Delaunay edges are flipped afterwards.
+/// This runs in O(n log n) time.
+///
+/// The result is stored in flat arrays of indices, no nodes are allocated individually. Each
+/// triangle t consists of the three half-edges 3t, 3t + 1 and 3t + 2. getTriangles()[e] is the
+/// index of the point where half-edge e starts, getHalfedges()[e] is the index of the opposite
+/// half-edge in the adjacent triangle, or INVALID_INDEX if e is part of the convex hull.
+///
+/// Afterwards, edges between given points can be enforced with constrain(). The result is the
+/// constrained Delaunay triangulation: It contains all given edges and is as close to the Delaunay
+/// triangulation as possible. This allows triangulating arbitrary (e.g. concave) polygons in one
+/// pass.
+///
+/// All geometric decisions are made with the orientation and in-circle predicates of Jonathan
+/// Shewchuk ("Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates").
+/// They are evaluated with floating-point arithmetic first; only if the result is too close to
+/// zero to be trusted, it is computed exactly. Hence the triangulation is valid even for
+/// (nearly) collinear or cocircular input points.
+///
+/// Points which are (almost) identical to a previously inserted point are ignored. If all points
+/// are collinear, no triangles are created.
+class DelaunayTriangulation {
+ public:
+  static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+  /// Computes the triangulation of the given points. Any previous result is discarded; the
+  /// allocated memory is reused.
+  void triangulate(std::vector<glm::dvec2> const& points);
+
+  /// Inserts the given edges into the triangulation computed by the last call to triangulate().
+  /// The edges are given as pairs of point indices; the points passed to triangulate() must still
+  /// be valid. If an edge passes through another point, it is split at this point. Edges which
+  /// cross a previously inserted edge or which start or end at an ignored point cannot be inserted;
+  /// in this case, false is returned. All other edges are inserted nevertheless.
+  bool constrain(std::vector<std::pair<uint32_t, uint32_t>> const& edges);
+
+  /// Three consecutive entries are the point indices of one triangle. All triangles have the same
+  /// winding order.
+  std::vector<uint32_t> const& getTriangles() const;
+
+  /// For each half-edge, the opposite half-edge or INVALID_INDEX.
+  std::vector<uint32_t> const& getHalfedges() const;
+
+  /// Returns the number of triangles.
+  size_t getTriangleCount() const;
+
+  /// Returns true if the given half-edge is part of an edge which has been inserted with
+  /// constrain().
+  bool isConstrained(uint32_t e) const;
+
+  /// Returns the half-edge which follows the given one in the same triangle.
+  static uint32_t nextHalfedge(uint32_t e) {
+    return (e % 3 == 2) ? e - 2 : e + 1;
+  }
+
+  /// Returns the half-edge which precedes the given one in the same triangle.
+  static uint32_t prevHalfedge(uint32_t e) {
+    return (e % 3 == 0) ? e + 2 : e - 1;
+  }
+
+ private:
+  uint32_t addTriangle(uint32_t i0, uint32_t i1, uint32_t i2, uint32_t a, uint32_t b, uint32_t c);
+  void     link(uint32_t a, uint32_t b);
+  uint32_t legalize(uint32_t a);
+  uint32_t hashKey(glm::dvec2 const& p) const;
+
+  /// Inserts the edge from point a towards point b by flipping all edges which cross it. If the
+  /// edge passes through another point, only the part up to this point is inserted. Returns the
+  /// point where the inserted edge ends or INVALID_INDEX if it crosses a constrained edge.
+  uint32_t insertEdge(uint32_t a, uint32_t b);
+
+  /// Flips the edge of half-edge a, so that it connects the two points opposite to it. Afterwards,
+  /// a and its opposite half-edge b are the outer edges of the new triangles which have previously
+  /// been stored in prevHalfedge(b) and prevHalfedge(a) respectively; the new edge consists of
+  /// prevHalfedge(a) and prevHalfedge(b).
+  void flip(uint32_t a);
+
+  /// Stores all half-edges which start at the given point in mFan.
+  void collectFan(uint32_t p);
+
+  void markConstrained(uint32_t e);
+
+  std::vector<glm::dvec2> const* mPoints = nullptr;
+
+  std::vector<uint32_t> mTriangles;
+  std::vector<uint32_t> mHalfedges;
+  std::vector<bool>     mConstrained;
+
+  // Temporary data which is only used during triangulate(). These are members so that their memory
+  // can be reused.
+  std::vector<uint32_t> mIDs;
+  std::vector<double>   mDistances;
+  std::vector<uint32_t> mHullPrev;
+  std::vector<uint32_t> mHullNext;
+  std::vector<uint32_t> mHullTri;
+  std::vector<uint32_t> mHullHash;
+  std::vector<uint32_t> mEdgeStack;
+
+  // Temporary data which is only used during constrain(). mPointEdges contains one half-edge for
+  // each point which starts at this point, mCrossings the edges which cross the currently inserted
+  // edge.
+  std::vector<uint32_t> mPointEdges;
+  std::vector<uint32_t> mCrossings;
+  std::vector<uint32_t> mFan;
+
+  glm::dvec2 mCenter{};
+  uint32_t   mHullStart = 0;
+};
+
+} // namespace csp::measurementtools
+
+#endif // CSP_MEASUREMENT_TOOLS_DELAUNAY_TRIANGULATION_HPP
@@ -8,57 +8,43 @@
 #ifndef CSP_MEASUREMENT_TOOLS_VORONOI_GENERATOR_HPP
 #define CSP_MEASUREMENT_TOOLS_VORONOI_GENERATOR_HPP
 
-#include "Beachline.hpp"
-#include "Circle.hpp"
+#include "DelaunayTriangulation.hpp"
 #include "Site.hpp"
-#include "Vector2f.hpp"
 
 #include <map>
-#include <queue>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace csp::measurementtools {
 
-using Edge     = std::pair<Vector2f, Vector2f>;
 using Edge2    = std::pair<Site, Site>;
 using Triangle = std::tuple<Site, Site, Site>;
 
+/// Computes the Delaunay triangulation of a set of Sites. The triangulation is computed with the
+/// DelaunayTriangulation, this class converts the result to edges and triangles which reference the
+/// original Sites, including their addresses. Sites at the same position as a previous Site are
+/// ignored.
 class VoronoiGenerator {
  public:
-  VoronoiGenerator();
-
-  void parse(std::vector<Site> const& sites);
-
-  double sweepLine() const;
-
-  double maxY() const;
-  double minY() const;
+  /// Triangulates the given Sites. The optional constraints are pairs of indices into sites; these
+  /// edges will be part of the triangulation. Returns false if some of the constraints could not be
+  /// inserted, for example because they intersect each other.
+  bool parse(std::vector<Site> const&                   sites,
+      std::vector<std::pair<uint32_t, uint32_t>> const& constraints = {});
 
   std::vector<Site> const&                     getSites() const;
-  std::vector<Edge> const&                     getEdges() const;
   std::vector<Edge2> const&                    getTriangulation() const;
   std::vector<Triangle> const&                 getTriangles() const;
   std::map<uint16_t, std::vector<Site>> const& getNeighbors() const;
 
-  void addTriangulationEdge(Site const& site1, Site const& site2);
-  void removeTriangulationEdge(Site const& site1, Site const& site2);
-
  private:
-  void process(Site const& event);
-  void process(Circle* event);
-  void addCircleEvent(Arc* arc);
-  void finishEdges();
-
-  Beachline mBeachline;
-  double    mSweepline{0.0};
-  double    mMaxY{0.0};
-  double    mMinY{0.0};
+  void addTriangulationEdge(Site const& site1, Site const& site2);
 
-  std::priority_queue<Site, std::vector<Site>, SitePosComp>        mSiteEvents;
-  std::priority_queue<Circle*, std::vector<Circle*>, CirclePtrCmp> mCircleEvents;
+  DelaunayTriangulation   mDelaunay;
+  std::vector<glm::dvec2> mPoints;
 
   std::vector<Site>                     mSites;
-  std::vector<Edge>                     mVoronoiEdges;
   std::vector<Edge2>                    mTriangulationEdges;
   std::vector<Triangle>                 mTriangles;
   std::map<uint16_t, std::vector<Site>> mNeighbors;
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "../src/voronoi/DelaunayTriangulation.hpp"
+#include "../../../src/cs-utils/doctest.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <random>
+
+namespace csp::measurementtools {
+
+namespace {
+
+std::vector<glm::dvec2> createRandomPoints(size_t count) {
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+  std::vector<glm::dvec2> points(count);
+  for (auto& p : points) {
+    p = glm::dvec2(distribution(generator), distribution(generator));
+  }
+
+  return points;
+}
+
+// Returns the corners of a star-shaped polygon around the origin. The polygon edges connect
+// consecutive corners.
+std::vector<glm::dvec2> createRandomPolygon(size_t count) {
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+  std::vector<glm::dvec2> points(count);
+  double                  step = 2.0 * glm::pi<double>() / static_cast<double>(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    double angle  = step * (static_cast<double>(i) + 0.8 * distribution(generator));
+    double radius = 0.2 + 0.8 * distribution(generator);
+    points[i]     = radius * glm::dvec2(std::cos(angle), std::sin(angle));
+  }
+
+  return points;
+}
+
+// Checks that the half-edges are consistent and that all triangles are clockwise.
+void checkHalfedges(DelaunayTriangulation const& delaunay, std::vector<glm::dvec2> const& p) {
+  auto const& triangles = delaunay.getTriangles();
+  auto const& halfedges = delaunay.getHalfedges();
+
+  for (uint32_t e = 0; e < halfedges.size(); ++e) {
+    if (halfedges[e] != DelaunayTriangulation::INVALID_INDEX) {
+      CHECK_EQ(halfedges[halfedges[e]], e);
+      CHECK_EQ(triangles[e], triangles[DelaunayTriangulation::nextHalfedge(halfedges[e])]);
+      CHECK_EQ(delaunay.isConstrained(e), delaunay.isConstrained(halfedges[e]));
+    }
+  }
+
+  for (size_t t = 0; t < triangles.size(); t += 3) {
+    glm::dvec2 d = p[triangles[t + 1]] - p[triangles[t]];
+    glm::dvec2 e = p[triangles[t + 2]] - p[triangles[t]];
+    CHECK(d.x * e.y - d.y * e.x < 0.0);
+  }
+}
+
+// Returns true if the triangulation contains a constrained edge between the given points.
+bool hasConstrainedEdge(DelaunayTriangulation const& delaunay, uint32_t a, uint32_t b) {
+  auto const& triangles = delaunay.getTriangles();
+
+  for (uint32_t e = 0; e < triangles.size(); ++e) {
+    uint32_t p = triangles[e];
+    uint32_t q = triangles[DelaunayTriangulation::nextHalfedge(e)];
+    if ((p == a && q == b) || (p == b && q == a)) {
+      return delaunay.isConstrained(e);
+    }
+  }
+
+  return false;
+}
+
+// Checks that the half-edges are consistent and that no point lies inside the circumcircle of any
+// triangle.
+void checkTriangulation(DelaunayTriangulation const& delaunay, std::vector<glm::dvec2> const& p) {
+  auto const& triangles = delaunay.getTriangles();
+
+  checkHalfedges(delaunay, p);
+
+  for (size_t t = 0; t < triangles.size(); t += 3) {
+    glm::dvec2 a = p[triangles[t]];
+    glm::dvec2 b = p[triangles[t + 1]];
+    glm::dvec2 c = p[triangles[t + 2]];
+
+    glm::dvec2 d = b - a;
+    glm::dvec2 e = c - a;
+    double     s = 0.5 / (d.x * e.y - d.y * e.x);
+
+    glm::dvec2 center = a + glm::dvec2((e.y * glm::dot(d, d) - d.y * glm::dot(e, e)) * s,
+                                (d.x * glm::dot(e, e) - e.x * glm::dot(d, d)) * s);
+    double radius = glm::distance(center, a);
+
+    for (auto const& point : p) {
+      CHECK(glm::distance(center, point) > radius - 1e-9);
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("csp::measurementtools::DelaunayTriangulation") {
+  DelaunayTriangulation delaunay;
+
+  SUBCASE("Random points") {
+    auto points = createRandomPoints(500);
+    delaunay.triangulate(points);
+    checkTriangulation(delaunay, points);
+
+    // The convex hull of so many random points has far fewer than 100 vertices.
+    CHECK(delaunay.getTriangleCount() > 2 * points.size() - 100);
+  }
+
+  SUBCASE("Regular grid with duplicates") {
+    std::vector<glm::dvec2> points;
+    for (int i = 0; i < 200; ++i) {
+      points.emplace_back(i % 10, (i % 100) / 10);
+    }
+
+    delaunay.triangulate(points);
+    checkTriangulation(delaunay, points);
+    CHECK_EQ(delaunay.getTriangleCount(), 9 * 9 * 2);
+  }
+
+  SUBCASE("Collinear points") {
+    std::vector<glm::dvec2> points = {{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}};
+    delaunay.triangulate(points);
+    CHECK_EQ(delaunay.getTriangleCount(), 0);
+  }
+
+  SUBCASE("Nearly cocircular points") {
+    // Whether these points are inside each other's circumcircles is decided by the last bits of
+    // their coordinates.
+    std::vector<glm::dvec2> points;
+    for (int i = 0; i < 100; ++i) {
+      double angle = 2.0 * glm::pi<double>() * i / 100.0;
+      points.emplace_back(1e6 + std::cos(angle), 1e6 + std::sin(angle));
+    }
+
+    delaunay.triangulate(points);
+    checkHalfedges(delaunay, points);
+    CHECK_EQ(delaunay.getTriangleCount(), points.size() - 2);
+  }
+
+  SUBCASE("Constrained polygon") {
+    auto points = createRandomPolygon(100);
+
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    for (uint32_t i = 0; i < points.size(); ++i) {
+      edges.emplace_back(i, (i + 1) % points.size());
+    }
+
+    // Some additional points inside and outside of the polygon.
+    auto random = createRandomPoints(200);
+    points.insert(points.end(), random.begin(), random.end());
+
+    delaunay.triangulate(points);
+    CHECK(delaunay.constrain(edges));
+    checkHalfedges(delaunay, points);
+
+    for (auto const& [a, b] : edges) {
+      CHECK(hasConstrainedEdge(delaunay, a, b));
+    }
+  }
+
+  SUBCASE("Constraints through other points") {
+    std::vector<glm::dvec2> points;
+    for (int i = 0; i < 100; ++i) {
+      points.emplace_back(i % 10, i / 10);
+    }
+
+    // The diagonal passes through all points (i, i), so it is split into nine edges.
+    delaunay.triangulate(points);
+    CHECK(delaunay.constrain({{0, 99}}));
+    checkHalfedges(delaunay, points);
+
+    for (uint32_t i = 0; i < 9; ++i) {
+      CHECK(hasConstrainedEdge(delaunay, i * 11, (i + 1) * 11));
+    }
+  }
+
+  SUBCASE("Intersecting constraints") {
+    std::vector<glm::dvec2> points = {{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}};
+
+    // The second diagonal cannot be inserted, but the first one is kept.
+    delaunay.triangulate(points);
+    CHECK_FALSE(delaunay.constrain({{0, 2}, {1, 3}}));
+    checkHalfedges(delaunay, points);
+    CHECK(hasConstrainedEdge(delaunay, 0, 2));
+    CHECK_FALSE(hasConstrainedEdge(delaunay, 1, 3));
+  }
+}
+
+} // namespace csp::measurementtools
@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "OfflineRenderer.hpp"
+
+#include "../../../src/cs-core/GraphicsEngine.hpp"
+#include "../../../src/cs-core/Settings.hpp"
+#include "../../../src/cs-core/SolarSystem.hpp"
+#include "../../../src/cs-core/TimeControl.hpp"
+#include "../../../src/cs-utils/ThreadPool.hpp"
+#include "../../../src/cs-utils/filesystem.hpp"
+#include "logger.hpp"
+
+#include <GL/glew.h>
+#include <VistaKernel/DisplayManager/VistaDisplayManager.h>
+#include <VistaKernel/DisplayManager/VistaWindow.h>
+#include <VistaKernel/VistaSystem.h>
+#include <boost/filesystem.hpp>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace csp::recorder {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OfflineRenderer::OfflineRenderer(std::shared_ptr<cs::core::Settings> settings,
+    std::shared_ptr<cs::core::SolarSystem>                           solarSystem,
+    std::shared_ptr<cs::core::TimeControl>                           timeControl,
+    std::shared_ptr<cs::core::GraphicsEngine>                        graphicsEngine)
+    : mSettings(std::move(settings))
+    , mSolarSystem(std::move(solarSystem))
+    , mTimeControl(std::move(timeControl))
+    , mGraphicsEngine(std::move(graphicsEngine)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OfflineRenderer::~OfflineRenderer() {
+  try {
+    stop();
+  } catch (...) {}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void OfflineRenderer::start(std::string const& recordingFile, Parameters parameters) {
+  stop();
+
+  // This throws if the file cannot be read.
+  mRecording  = Recording::load(recordingFile);
+  mParameters = std::move(parameters);
+
+  if (mRecording->empty()) {
+    mRecording.reset();
+    throw std::runtime_error("The recording '" + recordingFile + "' contains no frames.");
+  }
+
+  if (mParameters.mFrameRate <= 0.0) {
+    mRecording.reset();
+    throw std::runtime_error("The frame rate for offline rendering must be positive.");
+  }
+
+  cs::utils::filesystem::createDirectoryRecursively(
+      boost::filesystem::system_complete(mParameters.mOutputDirectory));
+
+  double duration = mRecording->getDuration();
+  mFrameCount     = static_cast<uint32_t>(std::floor(duration * mParameters.mFrameRate)) + 1;
+  mFrameIndex     = 0;
+  mWaitedFrames   = 0;
+  mSettledFrames  = 0;
+  mEncoder        = std::make_unique<cs::utils::ThreadPool>(
+      std::max(mParameters.mEncoderThreads, static_cast<uint32_t>(1)));
+
+  // The simulation time must not advance on its own and the user interface should not be visible
+  // in the captured images. These settings are restored once rendering is finished.
+  mTimeSpeed           = mSettings->pTimeSpeed.get();
+  mEnableAutoExposure  = mSettings->mGraphics.pEnableAutoExposure.get();
+  mEnableUserInterface = mSettings->pEnableUserInterface.get();
+
+  mSettings->pTimeSpeed           = 0.F;
+  mSettings->pEnableUserInterface = false;
+
+  if (mRecording->mHasExposure) {
+    mSettings->mGraphics.pEnableAutoExposure = false;
+  }
+
+  logger().info("Rendering {} frames of '{}' to '{}'.", mFrameCount, recordingFile,
+      mParameters.mOutputDirectory);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void OfflineRenderer::stop() {
+  if (!isRunning()) {
+    return;
+  }
+
+  mSettings->pTimeSpeed                    = mTimeSpeed;
+  mSettings->mGraphics.pEnableAutoExposure = mEnableAutoExposure;
+  mSettings->pEnableUserInterface          = mEnableUserInterface;
+
+  // Destroying the thread pool blocks until all queued images have been written.
+  mEncoder.reset();
+  mRecording.reset();
+
+  logger().info("Offline rendering finished after {} of {} frames.", mFrameIndex, mFrameCount);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool OfflineRenderer::isRunning() const {
+  return mRecording.has_value();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void OfflineRenderer::update() {
+  if (!isRunning()) {
+    return;
+  }
+
+  // The state of the current output frame has already been rendered at least once. We capture it
+  // as soon as no data has been requested for several consecutive frames.
+  if (mWaitedFrames > 0) {
+    if (mGraphicsEngine->getPendingRequests() == 0) {
+      ++mSettledFrames;
+    } else {
+      mSettledFrames = 0;
+    }
+
+    bool settled = mSettledFrames >= mParameters.mSettleFrames;
+    bool timeout = mWaitedFrames >= mParameters.mMaxWaitFrames;
+
+    // If the encoder threads cannot keep up, we wait here. Else the read-back images would pile up
+    // in memory.
+    bool encoderBusy = mEncoder->getPendingTaskCount() > 2 * mParameters.mEncoderThreads;
+
+    if ((settled || timeout) && !encoderBusy) {
+      if (!settled) {
+        logger().warn("Data requests did not settle within {} frames. Capturing frame {} anyways.",
+            mParameters.mMaxWaitFrames, mFrameIndex);
+      }
+
+      captureFrame(mFrameIndex);
+
+      ++mFrameIndex;
+      mWaitedFrames  = 0;
+      mSettledFrames = 0;
+
+      if (mFrameIndex >= mFrameCount) {
+        stop();
+        return;
+      }
+    }
+  }
+
+  // We apply the state in each frame, even if it did not change. This way, the user cannot
+  // accidentally navigate away while waiting for the data to arrive.
+  applyFrame(mFrameIndex);
+  ++mWaitedFrames;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void OfflineRenderer::applyFrame(uint32_t index) {
+  auto frame = mRecording->sample(index / mParameters.mFrameRate);
+
+  if (mRecording->mHasObserver) {
+    mSolarSystem->flyObserverTo(mRecording->getName(frame.mCenter),
+        mRecording->getName(frame.mFrame), frame.mPosition, frame.mRotation, 0.0);
+  }
+
+  if (mRecording->mHasTime) {
+    mTimeControl->setTime(frame.mSimulationTime);
+  }
+
+  if (mRecording->mHasExposure) {
+    mSettings->mGraphics.pExposure = frame.mExposure;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void OfflineRenderer::captureFrame(uint32_t index) {
+  int   width  = 0;
+  int   height = 0;
+  auto* window = GetVistaSystem()->GetDisplayManager()->GetWindows().begin()->second;
+  window->GetWindowProperties()->GetSize(width, height);
+
+  auto pixels = std::make_shared<std::vector<uint8_t>>(width * height * 3);
+
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels->data());
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+  auto file = mParameters.mOutputDirectory + "/frame_" + std::to_string(index) + ".png";
+
+  // Flipping and encoding is done on the worker threads. We do not use
+  // stbi_flip_vertically_on_write() here, as this modifies global state which is not thread-safe.
+  mEncoder->enqueue([pixels, width, height, file]() {
+    size_t               rowSize = static_cast<size_t>(width) * 3;
+    std::vector<uint8_t> row(rowSize);
+
+    for (int y = 0; y < height / 2; ++y) {
+      uint8_t* top    = pixels->data() + y * rowSize;
+      uint8_t* bottom = pixels->data() + (height - y - 1) * rowSize;
+      std::memcpy(row.data(), top, rowSize);
+      std::memcpy(top, bottom, rowSize);
+      std::memcpy(bottom, row.data(), rowSize);
+    }
+
+    if (stbi_write_png(file.c_str(), width, height, 3, pixels->data(), width * 3) == 0) {
+      logger().error("Failed to write '{}'!", file);
+    }
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace csp::recorder
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CSP_RECORDER_OFFLINE_RENDERER_HPP
+#define CSP_RECORDER_OFFLINE_RENDERER_HPP
+
+#include "Recording.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace cs::core {
+class Settings;
+class SolarSystem;
+class TimeControl;
+class GraphicsEngine;
+} // namespace cs::core
+
+namespace cs::utils {
+class ThreadPool;
+} // namespace cs::utils
+
+namespace csp::recorder {
+
+/// The OfflineRenderer replays a binary Recording inside CosmoScout VR and writes each frame to a
+/// numbered png image. The recording is resampled at a fixed frame rate, so the resulting image
+/// sequence does not depend on the frame rate at which it was recorded nor on the frame rate at
+/// which it is rendered.
+/// For each output frame, the observer, the simulation time and the exposure are applied and then
+/// the renderer waits until no component reports pending data requests anymore (see
+/// GraphicsEngine::getPendingRequests()). Only then the frame is read back from the GPU and handed
+/// to a pool of worker threads which encode the image files in the background.
+class OfflineRenderer {
+ public:
+  /// Configures the replay of a recording.
+  struct Parameters {
+    /// The directory where the frame_<n>.png files are written to. It is created if necessary.
+    std::string mOutputDirectory;
+
+    /// The number of output frames per second of recorded real time.
+    double mFrameRate = 60.0;
+
+    /// A frame is captured only if no data requests have been pending for this many frames.
+    uint32_t mSettleFrames = 3;
+
+    /// If the data requests do not settle within this number of frames, the frame is captured
+    /// anyways and a warning is printed.
+    uint32_t mMaxWaitFrames = 600;
+
+    /// The number of worker threads which encode the images.
+    uint32_t mEncoderThreads = 4;
+  };
+
+  OfflineRenderer(std::shared_ptr<cs::core::Settings> settings,
+      std::shared_ptr<cs::core::SolarSystem>          solarSystem,
+      std::shared_ptr<cs::core::TimeControl>          timeControl,
+      std::shared_ptr<cs::core::GraphicsEngine>       graphicsEngine);
+
+  OfflineRenderer(OfflineRenderer const& other) = delete;
+  OfflineRenderer(OfflineRenderer&& other)      = delete;
+
+  OfflineRenderer& operator=(OfflineRenderer const& other) = delete;
+  OfflineRenderer& operator=(OfflineRenderer&& other) = delete;
+
+  ~OfflineRenderer();
+
+  /// Starts rendering the given recording. Any currently running replay is stopped. Throws a
+  /// std::runtime_error if the recording cannot be loaded.
+  void start(std::string const& recordingFile, Parameters parameters);
+
+  /// Stops the current replay. All frames which have been captured so far will still be written.
+  void stop();
+
+  /// Returns true while a recording is being replayed.
+  bool isRunning() const;
+
+  /// This has to be called once a frame. It applies the state of the current output frame and
+  /// captures the previously rendered image once all data requests have settled.
+  void update();
+
+ private:
+  void applyFrame(uint32_t index);
+  void captureFrame(uint32_t index);
+
+  std::shared_ptr<cs::core::Settings>       mSettings;
+  std::shared_ptr<cs::core::SolarSystem>    mSolarSystem;
+  std::shared_ptr<cs::core::TimeControl>    mTimeControl;
+  std::shared_ptr<cs::core::GraphicsEngine> mGraphicsEngine;
+
+  std::optional<Recording>               mRecording;
+  Parameters                             mParameters;
+  std::unique_ptr<cs::utils::ThreadPool> mEncoder;
+
+  uint32_t mFrameIndex    = 0;
+  uint32_t mFrameCount    = 0;
+  uint32_t mWaitedFrames  = 0;
+  uint32_t mSettledFrames = 0;
+
+  // The values of these settings are restored when rendering is finished.
+  float mTimeSpeed           = 1.F;
+  bool  mEnableAutoExposure  = true;
+  bool  mEnableUserInterface = true;
+};
+
+} // namespace csp::recorder
+
+#endif // CSP_RECORDER_OFFLINE_RENDERER_HPP
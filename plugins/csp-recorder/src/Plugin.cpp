@@ -40,6 +40,11 @@ void from_json(nlohmann::json const& j, Plugin::Settings& o) {
   cs::core::Settings::deserialize(j, "recordObserver", o.mRecordObserver);
   cs::core::Settings::deserialize(j, "recordTime", o.mRecordTime);
   cs::core::Settings::deserialize(j, "recordExposure", o.mRecordExposure);
+  cs::core::Settings::deserialize(j, "outputDirectory", o.mOutputDirectory);
+  cs::core::Settings::deserialize(j, "frameRate", o.mFrameRate);
+  cs::core::Settings::deserialize(j, "settleFrames", o.mSettleFrames);
+  cs::core::Settings::deserialize(j, "maxWaitFrames", o.mMaxWaitFrames);
+  cs::core::Settings::deserialize(j, "encoderThreads", o.mEncoderThreads);
 }
 
 void to_json(nlohmann::json& j, Plugin::Settings const& o) {
@@ -47,6 +52,11 @@ void to_json(nlohmann::json& j, Plugin::Settings const& o) {
   cs::core::Settings::serialize(j, "recordObserver", o.mRecordObserver);
   cs::core::Settings::serialize(j, "recordTime", o.mRecordTime);
   cs::core::Settings::serialize(j, "recordExposure", o.mRecordExposure);
+  cs::core::Settings::serialize(j, "outputDirectory", o.mOutputDirectory);
+  cs::core::Settings::serialize(j, "frameRate", o.mFrameRate);
+  cs::core::Settings::serialize(j, "settleFrames", o.mSettleFrames);
+  cs::core::Settings::serialize(j, "maxWaitFrames", o.mMaxWaitFrames);
+  cs::core::Settings::serialize(j, "encoderThreads", o.mEncoderThreads);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -102,6 +112,32 @@ void Plugin::init() {
   mPluginSettings.mRecordExposure.connectAndTouch(
       [this](bool enable) { mGuiManager->setCheckboxValue("recorder.setRecordExposure", enable); });
 
+  // Add a callback to replay a binary recording in offline mode.
+  mOfflineRenderer = std::make_unique<OfflineRenderer>(
+      mAllSettings, mSolarSystem, mTimeControl, mGraphicsEngine);
+
+  mGuiManager->getGui()->registerCallback("recorder.renderOffline",
+      "Replays the given binary recording file at a fixed frame rate and writes each frame to an "
+      "image in the configured output directory.",
+      std::function([this](std::string&& file) {
+        OfflineRenderer::Parameters parameters;
+        parameters.mOutputDirectory = mPluginSettings.mOutputDirectory.get();
+        parameters.mFrameRate       = mPluginSettings.mFrameRate.get();
+        parameters.mSettleFrames    = mPluginSettings.mSettleFrames.get();
+        parameters.mMaxWaitFrames   = mPluginSettings.mMaxWaitFrames.get();
+        parameters.mEncoderThreads  = mPluginSettings.mEncoderThreads.get();
+
+        try {
+          mOfflineRenderer->start(file, parameters);
+        } catch (std::exception const& e) {
+          logger().error("Failed to start offline rendering: {}", e.what());
+        }
+      }));
+
+  mGuiManager->getGui()->registerCallback("recorder.stopOfflineRendering",
+      "Stops the current offline rendering.",
+      std::function([this]() { mOfflineRenderer->stop(); }));
+
   // Load initial settings.
   onLoad();
 
@@ -131,6 +167,14 @@ void Plugin::update() {
 
       mOutFile.open("recording-" + timeString + ".py");
 
+      // The binary recording is kept in memory and written to disk once recording stops.
+      mBinaryFile                   = "recording-" + timeString + ".csr";
+      mRecordingStart               = std::chrono::steady_clock::now();
+      mBinaryRecording.mHasObserver = mPluginSettings.mRecordObserver.get();
+      mBinaryRecording.mHasTime     = mPluginSettings.mRecordTime.get();
+      mBinaryRecording.mHasExposure = mPluginSettings.mRecordExposure.get();
+      mBinaryRecording.clear();
+
       // Write the header of the file. This contains the functions which are then called for each
       // recorded frame.
       mOutFile << R"(#! python3
@@ -159,9 +203,16 @@ def capture(file):
 )" << std::endl;
     }
 
+    // The binary recording stores each frame together with the elapsed real time.
+    mBinaryRecording.addFrame(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - mRecordingStart).count(),
+        mAllSettings->mObserver.pCenter.get(), mAllSettings->mObserver.pFrame.get(),
+        mAllSettings->mObserver.pPosition.get(), mAllSettings->mObserver.pRotation.get(),
+        mTimeControl->pSimulationTime.get(), mAllSettings->mGraphics.pExposure.get());
+
     // Now that the output file is initialized, we can write the information for each frame. Here we
     // write a call navigation.setBodyFull() setting the current full observer transformation.
-    if (mPluginSettings.mRecordTime.get()) {
+    if (mPluginSettings.mRecordObserver.get()) {
       mOutFile << fmt::format("runJS(\"CosmoScout.callbacks.navigation.setBodyFull('{}', '{}', "
                               "{}, {}, {}, {}, {}, {}, {}, 0);\")",
                       mAllSettings->mObserver.pCenter.get(), mAllSettings->mObserver.pFrame.get(),
@@ -193,11 +244,22 @@ def capture(file):
 
   } else {
 
-    // Recording has stopped last frame, so close the output file.
+    // Recording has stopped last frame, so close the output file and write the binary recording.
     if (mOutFile.is_open()) {
       mOutFile.close();
+
+      try {
+        mBinaryRecording.save(mBinaryFile);
+        logger().info("Saved {} frames to '{}'.", mBinaryRecording.getFrames().size(), mBinaryFile);
+      } catch (std::exception const& e) {
+        logger().error("Failed to save recording: {}", e.what());
+      }
+
+      mBinaryRecording.clear();
     }
   }
+
+  mOfflineRenderer->update();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -208,6 +270,9 @@ void Plugin::deInit() {
   // Save settings as this plugin may get reloaded.
   onSave();
 
+  // This blocks until all frames which have been captured so far are written.
+  mOfflineRenderer.reset();
+
   // Clean up the side-bar.
   mGuiManager->removeSettingsSection("Recorder");
 
@@ -216,6 +281,8 @@ void Plugin::deInit() {
   mGuiManager->getGui()->unregisterCallback("recorder.setRecordObserver");
   mGuiManager->getGui()->unregisterCallback("recorder.setRecordTime");
   mGuiManager->getGui()->unregisterCallback("recorder.setRecordExposure");
+  mGuiManager->getGui()->unregisterCallback("recorder.renderOffline");
+  mGuiManager->getGui()->unregisterCallback("recorder.stopOfflineRendering");
 
   // Remove the record button.
   if (mRecording) {
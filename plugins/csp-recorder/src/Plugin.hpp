@@ -11,7 +11,10 @@
 #include "../../../src/cs-core/PluginBase.hpp"
 #include "../../../src/cs-core/Settings.hpp"
 #include "../../../src/cs-utils/Property.hpp"
+#include "OfflineRenderer.hpp"
+#include "Recording.hpp"
 
+#include <chrono>
 #include <fstream>
 
 namespace csp::recorder {
@@ -24,6 +27,9 @@ namespace csp::recorder {
 /// frame using csp-web-api. This two-step approach has the advantage that recording can be done at
 /// high frame rates (with all settings reduced to the bare minimum) while capturing can be done at
 /// high resolution and high quality.
+/// In addition to the python script, a compact binary recording is written. This can be replayed
+/// directly inside CosmoScout VR with the OfflineRenderer, which does not require csp-web-api and
+/// renders the frames at a fixed frame rate as fast as the machine permits.
 class Plugin : public cs::core::PluginBase {
  public:
   struct Settings {
@@ -34,6 +40,22 @@ class Plugin : public cs::core::PluginBase {
     cs::utils::DefaultProperty<bool> mRecordObserver{true};
     cs::utils::DefaultProperty<bool> mRecordTime{true};
     cs::utils::DefaultProperty<bool> mRecordExposure{false};
+
+    /// The directory to which the frames of offline rendering are written.
+    cs::utils::DefaultProperty<std::string> mOutputDirectory{"recording"};
+
+    /// The number of frames per second of recorded time which are rendered in offline mode.
+    cs::utils::DefaultProperty<double> mFrameRate{60.0};
+
+    /// During offline rendering, a frame is captured once no plugin reported pending data requests
+    /// (e.g. terrain tiles or map overlays) for this many consecutive frames.
+    cs::utils::DefaultProperty<uint32_t> mSettleFrames{3};
+
+    /// If the data requests did not settle after this many frames, the frame is captured anyways.
+    cs::utils::DefaultProperty<uint32_t> mMaxWaitFrames{600};
+
+    /// The number of threads which are used for encoding the images during offline rendering.
+    cs::utils::DefaultProperty<uint32_t> mEncoderThreads{4};
   };
 
   void init() override;
@@ -46,9 +68,14 @@ class Plugin : public cs::core::PluginBase {
 
   Settings mPluginSettings;
 
-  bool          mRecording = false;
-  std::ofstream mOutFile;
-  uint32_t      mFrameCounter = 0;
+  bool                                  mRecording = false;
+  std::ofstream                         mOutFile;
+  std::string                           mBinaryFile;
+  Recording                             mBinaryRecording;
+  std::chrono::steady_clock::time_point mRecordingStart;
+  uint32_t                              mFrameCounter = 0;
+
+  std::unique_ptr<OfflineRenderer> mOfflineRenderer;
 
   int mOnLoadConnection = -1;
   int mOnSaveConnection = -1;
@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "Recording.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+namespace csp::recorder {
+
+namespace {
+
+// The file starts with these four bytes followed by the format version.
+constexpr std::array<char, 4> MAGIC   = {'C', 'S', 'R', 'C'};
+constexpr uint32_t            VERSION = 1;
+
+// Bits of the flags byte in the file header.
+constexpr uint8_t FLAG_OBSERVER = 1U << 0U;
+constexpr uint8_t FLAG_TIME     = 1U << 1U;
+constexpr uint8_t FLAG_EXPOSURE = 1U << 2U;
+
+template <typename T>
+void write(std::ofstream& stream, T const& value) {
+  stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read(std::ifstream& stream) {
+  T value{};
+  stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+  if (!stream) {
+    throw std::runtime_error("Unexpected end of file.");
+  }
+  return value;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Recording::addFrame(double realTime, std::string const& center, std::string const& frame,
+    glm::dvec3 const& position, glm::dquat const& rotation, double simulationTime,
+    float exposure) {
+
+  Frame f;
+  f.mRealTime = realTime;
+
+  if (mHasObserver) {
+    f.mCenter   = getNameIndex(center);
+    f.mFrame    = getNameIndex(frame);
+    f.mPosition = position;
+    f.mRotation = rotation;
+  }
+
+  if (mHasTime) {
+    f.mSimulationTime = simulationTime;
+  }
+
+  if (mHasExposure) {
+    f.mExposure = exposure;
+  }
+
+  mFrames.push_back(f);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Recording::empty() const {
+  return mFrames.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Recording::clear() {
+  mFrames.clear();
+  mNames.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double Recording::getDuration() const {
+  return mFrames.empty() ? 0.0 : mFrames.back().mRealTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<Recording::Frame> const& Recording::getFrames() const {
+  return mFrames;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string const& Recording::getName(uint32_t index) const {
+  return mNames.at(index);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Recording::Frame Recording::sample(double realTime) const {
+  if (mFrames.empty()) {
+    return Frame();
+  }
+
+  // Find the first frame which has been recorded after the given time.
+  auto next = std::upper_bound(mFrames.begin(), mFrames.end(), realTime,
+      [](double time, Frame const& frame) { return time < frame.mRealTime; });
+
+  if (next == mFrames.begin()) {
+    return mFrames.front();
+  }
+
+  if (next == mFrames.end()) {
+    return mFrames.back();
+  }
+
+  auto const& a = *(next - 1);
+  auto const& b = *next;
+
+  // We cannot interpolate between different coordinate systems.
+  if (a.mCenter != b.mCenter || a.mFrame != b.mFrame) {
+    return a;
+  }
+
+  double alpha = (realTime - a.mRealTime) / (b.mRealTime - a.mRealTime);
+
+  Frame result           = a;
+  result.mRealTime       = realTime;
+  result.mSimulationTime = glm::mix(a.mSimulationTime, b.mSimulationTime, alpha);
+  result.mExposure       = glm::mix(a.mExposure, b.mExposure, static_cast<float>(alpha));
+  result.mPosition       = glm::mix(a.mPosition, b.mPosition, alpha);
+  result.mRotation       = glm::slerp(a.mRotation, b.mRotation, alpha);
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Recording::save(std::string const& fileName) const {
+  std::ofstream stream(fileName, std::ios::binary);
+
+  if (!stream) {
+    throw std::runtime_error("Failed to open '" + fileName + "' for writing.");
+  }
+
+  uint8_t flags = 0;
+  flags |= mHasObserver ? FLAG_OBSERVER : 0U;
+  flags |= mHasTime ? FLAG_TIME : 0U;
+  flags |= mHasExposure ? FLAG_EXPOSURE : 0U;
+
+  stream.write(MAGIC.data(), MAGIC.size());
+  write(stream, VERSION);
+  write(stream, flags);
+
+  write(stream, static_cast<uint32_t>(mNames.size()));
+  for (auto const& name : mNames) {
+    write(stream, static_cast<uint32_t>(name.size()));
+    stream.write(name.data(), static_cast<std::streamsize>(name.size()));
+  }
+
+  // Only the recorded parts of each frame are written.
+  write(stream, static_cast<uint64_t>(mFrames.size()));
+  for (auto const& f : mFrames) {
+    write(stream, f.mRealTime);
+
+    if (mHasObserver) {
+      write(stream, f.mCenter);
+      write(stream, f.mFrame);
+      write(stream, f.mPosition);
+      write(stream, f.mRotation);
+    }
+
+    if (mHasTime) {
+      write(stream, f.mSimulationTime);
+    }
+
+    if (mHasExposure) {
+      write(stream, f.mExposure);
+    }
+  }
+
+  if (!stream) {
+    throw std::runtime_error("Failed to write recording to '" + fileName + "'.");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Recording Recording::load(std::string const& fileName) {
+  std::ifstream stream(fileName, std::ios::binary);
+
+  if (!stream) {
+    throw std::runtime_error("Failed to open '" + fileName + "' for reading.");
+  }
+
+  try {
+    std::array<char, 4> magic{};
+    stream.read(magic.data(), magic.size());
+    if (!stream || magic != MAGIC) {
+      throw std::runtime_error("This is not a recording file.");
+    }
+
+    auto version = read<uint32_t>(stream);
+    if (version != VERSION) {
+      throw std::runtime_error("Unsupported version " + std::to_string(version) + ".");
+    }
+
+    Recording recording;
+
+    auto flags             = read<uint8_t>(stream);
+    recording.mHasObserver = flags & FLAG_OBSERVER;
+    recording.mHasTime     = flags & FLAG_TIME;
+    recording.mHasExposure = flags & FLAG_EXPOSURE;
+
+    recording.mNames.resize(read<uint32_t>(stream));
+    for (auto& name : recording.mNames) {
+      name.resize(read<uint32_t>(stream));
+      stream.read(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+
+    recording.mFrames.resize(read<uint64_t>(stream));
+    for (auto& f : recording.mFrames) {
+      f.mRealTime = read<double>(stream);
+
+      if (recording.mHasObserver) {
+        f.mCenter   = read<uint32_t>(stream);
+        f.mFrame    = read<uint32_t>(stream);
+        f.mPosition = read<glm::dvec3>(stream);
+        f.mRotation = read<glm::dquat>(stream);
+
+        if (f.mCenter >= recording.mNames.size() || f.mFrame >= recording.mNames.size()) {
+          throw std::runtime_error("Invalid name index.");
+        }
+      }
+
+      if (recording.mHasTime) {
+        f.mSimulationTime = read<double>(stream);
+      }
+
+      if (recording.mHasExposure) {
+        f.mExposure = read<float>(stream);
+      }
+    }
+
+    return recording;
+
+  } catch (std::exception const& e) {
+    throw std::runtime_error("Failed to load recording '" + fileName + "': " + e.what());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t Recording::getNameIndex(std::string const& name) {
+  auto it = std::find(mNames.begin(), mNames.end(), name);
+
+  if (it != mNames.end()) {
+    return static_cast<uint32_t>(std::distance(mNames.begin(), it));
+  }
+
+  mNames.push_back(name);
+  return static_cast<uint32_t>(mNames.size() - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace csp::recorder
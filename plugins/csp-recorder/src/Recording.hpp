@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CSP_RECORDER_RECORDING_HPP
+#define CSP_RECORDER_RECORDING_HPP
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <string>
+#include <vector>
+
+namespace csp::recorder {
+
+/// A Recording stores the observer transformation, the simulation time and the HDR exposure for a
+/// sequence of frames. Each frame is stamped with the real time (in seconds since the start of the
+/// recording) at which it was recorded. This allows resampling the recording at an arbitrary, fixed
+/// frame rate later on, regardless of the frame rate at which it was recorded.
+/// Recordings can be stored in and loaded from a compact binary file. The names of SPICE centers
+/// and frames are stored only once in this file, each frame only references them by index.
+class Recording {
+ public:
+  /// The state of a single recorded frame.
+  struct Frame {
+    double     mRealTime       = 0.0; ///< Seconds since the start of the recording.
+    double     mSimulationTime = 0.0; ///< The simulation time in TDB.
+    float      mExposure       = 0.F; ///< The HDR exposure in EV.
+    uint32_t   mCenter         = 0;   ///< Index of the SPICE center name, see getName().
+    uint32_t   mFrame          = 0;   ///< Index of the SPICE frame name, see getName().
+    glm::dvec3 mPosition{0.0};
+    glm::dquat mRotation{1.0, 0.0, 0.0, 0.0};
+  };
+
+  /// These define which parts of the frame state have been recorded. All other members of the
+  /// recorded frames will have their default values.
+  bool mHasObserver = true;
+  bool mHasTime     = true;
+  bool mHasExposure = false;
+
+  /// Appends a new frame to the recording. The real time of the frames has to increase
+  /// monotonically.
+  void addFrame(double realTime, std::string const& center, std::string const& frame,
+      glm::dvec3 const& position, glm::dquat const& rotation, double simulationTime,
+      float exposure);
+
+  /// Returns true if no frame has been recorded yet.
+  bool empty() const;
+
+  /// Removes all frames and names.
+  void clear();
+
+  /// Returns the real time of the last recorded frame.
+  double getDuration() const;
+
+  std::vector<Frame> const& getFrames() const;
+
+  /// Returns the SPICE center or frame name for an index stored in a Frame.
+  std::string const& getName(uint32_t index) const;
+
+  /// Returns the interpolated state at the given real time. Position, simulation time and exposure
+  /// are interpolated linearly, the rotation spherically. If the SPICE center or frame changes
+  /// between two recorded frames, the state of the earlier one is returned without interpolation.
+  Frame sample(double realTime) const;
+
+  /// Writes the recording to a binary file. Throws a std::runtime_error if the file cannot be
+  /// written.
+  void save(std::string const& fileName) const;
+
+  /// Reads a recording from a binary file written by save(). Throws a std::runtime_error if the
+  /// file cannot be read or is not a valid recording.
+  static Recording load(std::string const& fileName);
+
+ private:
+  uint32_t getNameIndex(std::string const& name);
+
+  std::vector<std::string> mNames;
+  std::vector<Frame>       mFrames;
+};
+
+} // namespace csp::recorder
+
+#endif // CSP_RECORDER_RECORDING_HPP
@@ -220,7 +220,7 @@ bool Ring::Do() {
     mUniforms.litSideVisible    = mShader.GetUniformLocation("uLitSideVisible");
 
     // We bind the eclipse shadow map to texture unit 1.
-    mEclipseShadowReceiver.init(&mShader, 1);
+    mEclipseShadowReceiver.init(mShader.GetProgram(), 1);
 
     mShaderDirty = false;
   }
@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "Constellation.hpp"
+
+#include "logger.hpp"
+
+#include "../../../src/cs-core/Settings.hpp"
+#include "../../../src/cs-core/SolarSystem.hpp"
+#include "../../../src/cs-graphics/GltfLoader.hpp"
+#include "../../../src/cs-utils/FrameStats.hpp"
+#include "../../../src/cs-utils/ThreadPool.hpp"
+#include "../../../src/cs-utils/utils.hpp"
+
+#include <VistaKernel/GraphicsManager/VistaOpenGLNode.h>
+#include <VistaKernel/GraphicsManager/VistaSceneGraph.h>
+#include <VistaKernel/GraphicsManager/VistaTransformNode.h>
+#include <VistaKernelOpenSGExt/VistaOpenSGMaterialTools.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <array>
+#include <future>
+#include <limits>
+#include <numeric>
+
+namespace csp::satellites {
+
+namespace {
+
+// Constellations with more satellites than this are split into chunks of this size which are
+// propagated in parallel.
+constexpr size_t CHUNK_SIZE = 2048;
+
+std::vector<OrbitalElements> loadElements(std::string const& fileName) {
+  if (cs::utils::endsWith(fileName, ".json")) {
+    return loadOMMs(fileName);
+  }
+
+  return loadTLEs(fileName);
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* Constellation::POINTS_VERT = R"(
+#version 330
+
+layout(location = 0) in vec3 iPosition;
+
+uniform mat4  uMatModelView;
+uniform mat4  uMatProjection;
+uniform float uPointSize;
+
+void main()
+{
+    gl_Position  = uMatProjection * uMatModelView * vec4(iPosition, 1.0);
+    gl_PointSize = uPointSize;
+}
+)";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* Constellation::POINTS_FRAG = R"(
+#version 330
+
+uniform vec3 uColor;
+
+layout(location = 0) out vec4 oColor;
+
+void main()
+{
+    float dist = length(gl_PointCoord * 2.0 - 1.0);
+    float blob = pow(dist, 10.0);
+    oColor     = mix(vec4(uColor, 1.0), vec4(0), blob);
+}
+)";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Constellation::Constellation(Plugin::Settings::Constellation const& config, std::string const& name,
+    VistaSceneGraph* sceneGraph, std::shared_ptr<cs::core::Settings> settings,
+    std::shared_ptr<cs::core::SolarSystem> solarSystem)
+    : mConfig(config)
+    , mSceneGraph(sceneGraph)
+    , mSettings(std::move(settings))
+    , mSolarSystem(std::move(solarSystem))
+    , mPropagator(loadElements(config.mElementsFile)) {
+
+  logger().info("Loaded {} satellites for constellation '{}'.", mPropagator.size(), name);
+
+  mBodyFixed.resize(mPropagator.size());
+  mPositions.resize(mPropagator.size());
+
+  mShader.InitVertexShaderFromString(POINTS_VERT);
+  mShader.InitFragmentShaderFromString(POINTS_FRAG);
+  mShader.Link();
+
+  mUniforms.modelViewMatrix  = mShader.GetUniformLocation("uMatModelView");
+  mUniforms.projectionMatrix = mShader.GetUniformLocation("uMatProjection");
+  mUniforms.color            = mShader.GetUniformLocation("uColor");
+  mUniforms.pointSize        = mShader.GetUniformLocation("uPointSize");
+
+  mVAO.Bind();
+  mVBO.Bind(GL_ARRAY_BUFFER);
+  mVBO.BufferData(mPositions.size() * sizeof(glm::vec3), nullptr, GL_STREAM_DRAW);
+  mVAO.EnableAttributeArray(0);
+  mVAO.SpecifyAttributeArrayFloat(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), 0, &mVBO);
+  mVAO.Release();
+  mVBO.Release();
+
+  // The glTF assets are shared between all loaders of the same file, so loading the same model
+  // several times is cheap.
+  if (mConfig.mModelFile && mConfig.mEnvironmentMap) {
+    size_t modelCount = std::min<size_t>(mConfig.mModelCount.get(), mPropagator.size());
+
+    for (size_t i = 0; i < modelCount; ++i) {
+      Model model;
+      model.mModel =
+          std::make_unique<cs::graphics::GltfLoader>(*mConfig.mModelFile, *mConfig.mEnvironmentMap);
+      model.mModel->setIBLIntensity(1.5);
+      model.mModel->setLightColor(1.0, 1.0, 1.0);
+
+      model.mAnchor.reset(sceneGraph->NewTransformNode(sceneGraph->GetRoot()));
+      model.mModel->attachTo(sceneGraph, model.mAnchor.get());
+      model.mAnchor->SetIsEnabled(false);
+
+      VistaOpenSGMaterialTools::SetSortKeyOnSubtree(
+          model.mAnchor.get(), static_cast<int>(cs::utils::DrawOrder::eOpaqueItems));
+
+      mModels.push_back(std::move(model));
+    }
+  }
+
+  // The points are drawn like the deep space dots of the trajectories plugin.
+  mGLNode.reset(sceneGraph->NewOpenGLNode(sceneGraph->GetRoot(), this));
+  VistaOpenSGMaterialTools::SetSortKeyOnSubtree(
+      mGLNode.get(), static_cast<int>(cs::utils::DrawOrder::eTransparentItems) - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Constellation::~Constellation() {
+  for (auto const& model : mModels) {
+    mSceneGraph->GetRoot()->DisconnectChild(model.mAnchor.get());
+  }
+
+  mSceneGraph->GetRoot()->DisconnectChild(mGLNode.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Constellation::update(double tdb, cs::utils::ThreadPool* threadPool) {
+  auto object = mSolarSystem->getObject(mConfig.mObject.get());
+  mVisible    = object && object->getIsOrbitVisible() && mPropagator.size() > 0;
+
+  if (!mVisible) {
+    for (auto const& model : mModels) {
+      model.mAnchor->SetIsEnabled(false);
+    }
+    return;
+  }
+
+  glm::dmat4 transform = object->getObserverRelativeTransform();
+
+  // Computes the body-fixed and the observer-relative positions of a range of satellites.
+  auto propagate = [this, tdb, &transform](size_t begin, size_t end) {
+    mPropagator.propagate(tdb, begin, end, mBodyFixed.data() + begin);
+
+    for (size_t i = begin; i < end; ++i) {
+      mPositions[i] = glm::vec3(transform * glm::dvec4(mBodyFixed[i], 1.0));
+    }
+  };
+
+  size_t count = mPropagator.size();
+
+  if (threadPool && count > CHUNK_SIZE) {
+    std::vector<std::future<void>> chunks;
+
+    for (size_t begin = 0; begin < count; begin += CHUNK_SIZE) {
+      size_t end = std::min(begin + CHUNK_SIZE, count);
+      chunks.push_back(threadPool->enqueue([&propagate, begin, end]() { propagate(begin, end); }));
+    }
+
+    for (auto& chunk : chunks) {
+      chunk.get();
+    }
+  } else {
+    propagate(0, count);
+  }
+
+  if (mModels.empty()) {
+    return;
+  }
+
+  // Find the satellites closest to the observer. Decayed satellites are placed at the origin of the
+  // body and are never selected.
+  auto distance = [this](uint32_t i) {
+    return mBodyFixed[i] == glm::dvec3(0.0) ? std::numeric_limits<float>::max()
+                                            : glm::dot(mPositions[i], mPositions[i]);
+  };
+
+  mNearest.resize(count);
+  std::iota(mNearest.begin(), mNearest.end(), 0U);
+  std::nth_element(mNearest.begin(), mNearest.begin() + static_cast<ptrdiff_t>(mModels.size() - 1),
+      mNearest.end(), [&distance](uint32_t a, uint32_t b) { return distance(a) < distance(b); });
+
+  for (size_t i = 0; i < mModels.size(); ++i) {
+    auto const& model     = mModels[i];
+    uint32_t    satellite = mNearest[i];
+
+    if (mBodyFixed[satellite] == glm::dvec3(0.0)) {
+      model.mAnchor->SetIsEnabled(false);
+      continue;
+    }
+
+    auto modelTransform = glm::scale(glm::translate(transform, mBodyFixed[satellite]),
+        glm::dvec3(mConfig.mModelScale.get()));
+
+    model.mAnchor->SetIsEnabled(true);
+    model.mAnchor->SetTransform(glm::value_ptr(glm::mat4(modelTransform)), true);
+
+    float sunIlluminance(1.F);
+
+    auto sunDirection = glm::vec3(mSolarSystem->getSunDirection(modelTransform[3]));
+
+    model.mModel->setLightDirection(sunDirection.x, sunDirection.y, sunDirection.z);
+
+    if (mSettings->mGraphics.pEnableHDR.get()) {
+      model.mModel->setEnableHDR(true);
+      sunIlluminance = static_cast<float>(mSolarSystem->getSunIlluminance(modelTransform[3]));
+    }
+    model.mModel->setLightIntensity(sunIlluminance);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Constellation::Do() {
+  if (!mVisible) {
+    return true;
+  }
+
+  cs::utils::FrameStats::ScopedTimer timer("Constellation");
+
+  // The positions have been computed relative to the observer, so we only need the view matrix.
+  std::array<GLfloat, 16> glMatMV{};
+  std::array<GLfloat, 16> glMatP{};
+  glGetFloatv(GL_MODELVIEW_MATRIX, glMatMV.data());
+  glGetFloatv(GL_PROJECTION_MATRIX, glMatP.data());
+
+  // Orphan the previous buffer so that we do not have to wait for pending draw calls.
+  mVBO.Bind(GL_ARRAY_BUFFER);
+  mVBO.BufferData(mPositions.size() * sizeof(glm::vec3), nullptr, GL_STREAM_DRAW);
+  mVBO.BufferSubData(0, mPositions.size() * sizeof(glm::vec3), mPositions.data());
+  mVBO.Release();
+
+  glEnable(GL_BLEND);
+  glEnable(GL_PROGRAM_POINT_SIZE);
+  glDepthMask(GL_FALSE);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  auto const& color = mConfig.mColor.get();
+
+  mShader.Bind();
+  glUniformMatrix4fv(mUniforms.modelViewMatrix, 1, GL_FALSE, glMatMV.data());
+  glUniformMatrix4fv(mUniforms.projectionMatrix, 1, GL_FALSE, glMatP.data());
+  mShader.SetUniform(mUniforms.color, color.r, color.g, color.b);
+  mShader.SetUniform(mUniforms.pointSize, mConfig.mPointSize.get());
+
+  mVAO.Bind();
+  glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(mPositions.size()));
+  mVAO.Release();
+
+  mShader.Release();
+
+  glDisable(GL_BLEND);
+  glDisable(GL_PROGRAM_POINT_SIZE);
+  glDepthMask(GL_TRUE);
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Constellation::GetBoundingBox(VistaBoundingBox& /*bb*/) {
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace csp::satellites
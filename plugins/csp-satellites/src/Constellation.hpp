@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CSP_SATELLITES_CONSTELLATION_HPP
+#define CSP_SATELLITES_CONSTELLATION_HPP
+
+#include "Plugin.hpp"
+#include "SGP4.hpp"
+
+#include <VistaKernel/GraphicsManager/VistaOpenGLDraw.h>
+#include <VistaOGLExt/VistaBufferObject.h>
+#include <VistaOGLExt/VistaGLSLShader.h>
+#include <VistaOGLExt/VistaVertexArrayObject.h>
+
+#include <memory>
+
+namespace cs::core {
+class Settings;
+class SolarSystem;
+} // namespace cs::core
+
+namespace cs::graphics {
+class GltfLoader;
+} // namespace cs::graphics
+
+namespace cs::utils {
+class ThreadPool;
+} // namespace cs::utils
+
+class VistaOpenGLNode;
+class VistaSceneGraph;
+class VistaTransformNode;
+
+namespace csp::satellites {
+
+/// A Constellation is a large group of satellites whose orbits are given by mean orbital elements
+/// in a TLE or OMM file. All satellites are propagated together once per frame using the batched
+/// SGP4 implementation. Large constellations are split into chunks which are propagated on the
+/// given thread pool. Each satellite is drawn as a single point; only the few satellites closest to
+/// the observer are drawn with a full glTF model.
+class Constellation : public IVistaOpenGLDraw {
+ public:
+  /// Throws a std::runtime_error if the element file cannot be loaded.
+  Constellation(Plugin::Settings::Constellation const& config, std::string const& name,
+      VistaSceneGraph* sceneGraph, std::shared_ptr<cs::core::Settings> settings,
+      std::shared_ptr<cs::core::SolarSystem> solarSystem);
+
+  Constellation(Constellation const& other) = delete;
+  Constellation(Constellation&& other)      = delete;
+
+  Constellation& operator=(Constellation const& other) = delete;
+  Constellation& operator=(Constellation&& other) = delete;
+
+  ~Constellation() override;
+
+  /// Propagates all satellites to the given simulation time (in TDB seconds since J2000) and
+  /// updates the models of the nearest satellites. If a thread pool is given, it is used for large
+  /// constellations.
+  void update(double tdb, cs::utils::ThreadPool* threadPool);
+
+  bool Do() override;
+  bool GetBoundingBox(VistaBoundingBox& bb) override;
+
+ private:
+  /// A glTF model which is placed at the position of one of the nearest satellites.
+  struct Model {
+    std::unique_ptr<VistaTransformNode>       mAnchor;
+    std::unique_ptr<cs::graphics::GltfLoader> mModel;
+  };
+
+  Plugin::Settings::Constellation        mConfig;
+  VistaSceneGraph*                       mSceneGraph;
+  std::shared_ptr<cs::core::Settings>    mSettings;
+  std::shared_ptr<cs::core::SolarSystem> mSolarSystem;
+  std::unique_ptr<VistaOpenGLNode>       mGLNode;
+
+  SGP4                    mPropagator;
+  std::vector<glm::dvec3> mBodyFixed; ///< Body-fixed positions of all satellites.
+  std::vector<glm::vec3>  mPositions; ///< Observer-relative positions of all satellites.
+  std::vector<uint32_t>   mNearest;
+  std::vector<Model>      mModels;
+  bool                    mVisible = false;
+
+  VistaGLSLShader        mShader;
+  VistaVertexArrayObject mVAO;
+  VistaBufferObject      mVBO;
+
+  struct {
+    uint32_t modelViewMatrix  = 0;
+    uint32_t projectionMatrix = 0;
+    uint32_t color            = 0;
+    uint32_t pointSize        = 0;
+  } mUniforms;
+
+  static const char* POINTS_VERT;
+  static const char* POINTS_FRAG;
+};
+
+} // namespace csp::satellites
+
+#endif // CSP_SATELLITES_CONSTELLATION_HPP
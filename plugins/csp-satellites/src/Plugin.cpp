@@ -7,12 +7,18 @@
 
 #include "Plugin.hpp"
 
+#include "Constellation.hpp"
 #include "Satellite.hpp"
 #include "logger.hpp"
 
 #include "../../../src/cs-core/SolarSystem.hpp"
+#include "../../../src/cs-core/TimeControl.hpp"
+#include "../../../src/cs-utils/ThreadPool.hpp"
 #include "../../../src/cs-utils/logger.hpp"
 
+#include <algorithm>
+#include <thread>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 EXPORT_FN cs::core::PluginBase* create() {
@@ -43,12 +49,38 @@ void to_json(nlohmann::json& j, Plugin::Settings::Satellite const& o) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void from_json(nlohmann::json const& j, Plugin::Settings::Constellation& o) {
+  cs::core::Settings::deserialize(j, "elementsFile", o.mElementsFile);
+  cs::core::Settings::deserialize(j, "object", o.mObject);
+  cs::core::Settings::deserialize(j, "color", o.mColor);
+  cs::core::Settings::deserialize(j, "pointSize", o.mPointSize);
+  cs::core::Settings::deserialize(j, "modelFile", o.mModelFile);
+  cs::core::Settings::deserialize(j, "environmentMap", o.mEnvironmentMap);
+  cs::core::Settings::deserialize(j, "modelCount", o.mModelCount);
+  cs::core::Settings::deserialize(j, "modelScale", o.mModelScale);
+}
+
+void to_json(nlohmann::json& j, Plugin::Settings::Constellation const& o) {
+  cs::core::Settings::serialize(j, "elementsFile", o.mElementsFile);
+  cs::core::Settings::serialize(j, "object", o.mObject);
+  cs::core::Settings::serialize(j, "color", o.mColor);
+  cs::core::Settings::serialize(j, "pointSize", o.mPointSize);
+  cs::core::Settings::serialize(j, "modelFile", o.mModelFile);
+  cs::core::Settings::serialize(j, "environmentMap", o.mEnvironmentMap);
+  cs::core::Settings::serialize(j, "modelCount", o.mModelCount);
+  cs::core::Settings::serialize(j, "modelScale", o.mModelScale);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void from_json(nlohmann::json const& j, Plugin::Settings& o) {
   cs::core::Settings::deserialize(j, "satellites", o.mSatellites);
+  cs::core::Settings::deserialize(j, "constellations", o.mConstellations);
 }
 
 void to_json(nlohmann::json& j, Plugin::Settings const& o) {
   cs::core::Settings::serialize(j, "satellites", o.mSatellites);
+  cs::core::Settings::serialize(j, "constellations", o.mConstellations);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +89,10 @@ void Plugin::init() {
 
   logger().info("Loading plugin...");
 
+  // Large constellations are propagated in parallel on these threads.
+  mThreadPool = std::make_unique<cs::utils::ThreadPool>(
+      std::max(std::thread::hardware_concurrency() / 2, 1U));
+
   mOnLoadConnection = mAllSettings->onLoad().connect([this]() { onLoad(); });
   mOnSaveConnection = mAllSettings->onSave().connect([this]() { onSave(); });
 
@@ -75,6 +111,8 @@ void Plugin::deInit() {
   onSave();
 
   mSatellites.clear();
+  mConstellations.clear();
+  mThreadPool.reset();
 
   mAllSettings->onLoad().disconnect(mOnLoadConnection);
   mAllSettings->onSave().disconnect(mOnSaveConnection);
@@ -88,6 +126,10 @@ void Plugin::update() {
   for (auto const& satellite : mSatellites) {
     satellite->update();
   }
+
+  for (auto const& constellation : mConstellations) {
+    constellation->update(mTimeControl->pSimulationTime.get(), mThreadPool.get());
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +137,7 @@ void Plugin::update() {
 void Plugin::onLoad() {
 
   mSatellites.clear();
+  mConstellations.clear();
 
   // Read settings from JSON.
   mPluginSettings = mAllSettings->mPlugins.at("csp-satellites");
@@ -103,6 +146,15 @@ void Plugin::onLoad() {
     mSatellites.push_back(std::make_shared<Satellite>(
         settings.second, settings.first, mSceneGraph, mAllSettings, mSolarSystem));
   }
+
+  for (auto const& settings : mPluginSettings.mConstellations) {
+    try {
+      mConstellations.push_back(std::make_shared<Constellation>(
+          settings.second, settings.first, mSceneGraph, mAllSettings, mSolarSystem));
+    } catch (std::exception const& e) {
+      logger().error("Failed to load constellation '{}': {}", settings.first, e.what());
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
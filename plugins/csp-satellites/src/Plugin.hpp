@@ -18,8 +18,13 @@
 #include <string>
 #include <vector>
 
+namespace cs::utils {
+class ThreadPool;
+} // namespace cs::utils
+
 namespace csp::satellites {
 
+class Constellation;
 class Satellite;
 
 /// This plugin enables to place satellites into the Solar System.
@@ -38,7 +43,32 @@ class Plugin : public cs::core::PluginBase {
       std::string mEnvironmentMap;
     };
 
-    std::map<std::string, Satellite> mSatellites;
+    /// The settings for a large group of satellites which are propagated with SGP4.
+    struct Constellation {
+      /// Path to a file with the mean orbital elements of the satellites. Files ending in ".json"
+      /// are read as an array of CCSDS OMM records, all other files as two- or three-line element
+      /// sets.
+      std::string mElementsFile;
+
+      /// The name of the object the satellites are orbiting. This should be the Earth, as SGP4
+      /// only works for Earth-orbiting satellites.
+      cs::utils::DefaultProperty<std::string> mObject{"Earth"};
+
+      /// The color and the size in pixels of the points which are drawn for each satellite.
+      cs::utils::DefaultProperty<glm::vec3> mColor{glm::vec3(1.F, 1.F, 1.F)};
+      cs::utils::DefaultProperty<float>     mPointSize{3.F};
+
+      /// If both are given, this model is drawn for the satellites closest to the observer.
+      std::optional<std::string> mModelFile;
+      std::optional<std::string> mEnvironmentMap;
+
+      /// The number of satellites which are drawn with the model and a scale factor for the model.
+      cs::utils::DefaultProperty<uint32_t> mModelCount{4};
+      cs::utils::DefaultProperty<float>    mModelScale{1.F};
+    };
+
+    std::map<std::string, Satellite>     mSatellites;
+    std::map<std::string, Constellation> mConstellations;
   };
 
   void init() override;
@@ -49,8 +79,10 @@ class Plugin : public cs::core::PluginBase {
   void onLoad();
   void onSave();
 
-  Settings                                mPluginSettings;
-  std::vector<std::shared_ptr<Satellite>> mSatellites;
+  Settings                                    mPluginSettings;
+  std::vector<std::shared_ptr<Satellite>>     mSatellites;
+  std::vector<std::shared_ptr<Constellation>> mConstellations;
+  std::unique_ptr<cs::utils::ThreadPool>      mThreadPool;
 
   int mOnLoadConnection = -1;
   int mOnSaveConnection = -1;
@@ -0,0 +1,589 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "SGP4.hpp"
+
+#include "logger.hpp"
+
+#include "../../../src/cs-utils/convert.hpp"
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <cspice/SpiceUsr.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+namespace csp::satellites {
+
+namespace {
+
+// WGS-72 constants as used by the reference implementation of SGP4. Distances are in earth radii,
+// times in minutes.
+constexpr double EARTH_RADIUS = 6378.135; // km
+constexpr double MU           = 398600.8; // km³/s²
+constexpr double J2           = 0.001082616;
+constexpr double J3           = -0.00000253881;
+constexpr double J4           = -0.00000165597;
+constexpr double J3OJ2        = J3 / J2;
+constexpr double X2O3         = 2.0 / 3.0;
+constexpr double TWO_PI       = 2.0 * M_PI;
+constexpr double INV_TWO_PI   = 1.0 / TWO_PI;
+
+// Satellites with a longer period would require the deep-space model.
+constexpr double DEEP_SPACE_PERIOD = 225.0; // min
+
+// The Kepler equation is solved with a fixed number of Newton iterations. This converges for all
+// practical eccentricities and keeps the loop free of data-dependent exits.
+constexpr int KEPLER_ITERATIONS = 10;
+
+// The number of satellites which are propagated together, see SGP4::propagate().
+constexpr size_t BATCH_SIZE = 64;
+
+double xke() {
+  static const double value = 60.0 / std::sqrt(EARTH_RADIUS * EARTH_RADIUS * EARTH_RADIUS / MU);
+  return value;
+}
+
+// The functions below replace std::floor(), std::sin(), std::cos() and std::atan2() in the
+// propagation loop. They consist of arithmetic and selects only, so that the compiler can inline
+// them and vectorize the loop over the satellites. Without a vector math library, the calls to the
+// standard functions would prevent this. The results are accurate to a few units in the last place
+// for the argument ranges which occur in SGP4.
+
+// Rounds to the nearest integer. Adding and subtracting 1.5 * 2^52 pushes the fractional bits out
+// of the mantissa. This is valid for |x| < 2^51.
+inline double roundNearest(double x) {
+  constexpr double MAGIC = 6755399441055744.0;
+  return (x + MAGIC) - MAGIC;
+}
+
+// Like std::floor().
+inline double floorSelect(double x) {
+  double r = roundNearest(x);
+  return r > x ? r - 1.0 : r;
+}
+
+// Wraps the given angle to [0, 2π). The reference implementation uses std::fmod() which keeps the
+// sign instead. This makes no difference as the angles are only used as arguments to sin() and
+// cos() afterwards.
+inline double wrapAngle(double angle) {
+  return angle - TWO_PI * floorSelect(angle * INV_TWO_PI);
+}
+
+// Computes sine and cosine at once. The argument is reduced to [-π/4, π/4] with a three-part
+// Cody-Waite reduction, which is exact enough for |x| < 2^20. The polynomials are the minimax
+// approximations of fdlibm.
+inline void sinCos(double x, double& s, double& c) {
+  constexpr double PIO2_1 = 1.57079632673412561417e+00;
+  constexpr double PIO2_2 = 6.07710050650619224932e-11;
+  constexpr double PIO2_3 = 2.02226624879595063154e-21;
+
+  double q = roundNearest(x * (2.0 / M_PI));
+  double r = ((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_3;
+  double z = r * r;
+
+  double sr = r + r * z *
+                      (-1.66666666666666324348e-01 +
+                          z * (8.33333333332248946124e-03 +
+                                  z * (-1.98412698298579493134e-04 +
+                                          z * (2.75573137070700676789e-06 +
+                                                  z * (-2.50507602534068634195e-08 +
+                                                          z * 1.58969099521155010221e-10)))));
+  double cr = 1.0 - 0.5 * z +
+              z * z *
+                  (4.16666666666666019037e-02 +
+                      z * (-1.38888888888741095749e-03 +
+                              z * (2.48015872894767294178e-05 +
+                                      z * (-2.75573143513906633035e-07 +
+                                              z * (2.08757232129817482790e-09 +
+                                                      z * -1.13596475577881948265e-11)))));
+
+  // The quadrant of x selects the signs and which of the two polynomials is used.
+  double quadrant = q - 4.0 * floorSelect(q * 0.25);
+  bool   swap     = quadrant == 1.0 || quadrant == 3.0;
+  double ss       = swap ? cr : sr;
+  double cc       = swap ? sr : cr;
+  s               = quadrant >= 2.0 ? -ss : ss;
+  c               = quadrant == 1.0 || quadrant == 2.0 ? -cc : cc;
+}
+
+// The rational approximation of atan() on [-0.66, 0.66] of the Cephes library. Larger ratios are
+// mapped to this range using atan(t) = π/4 + atan((t - 1) / (t + 1)) and
+// atan(t) = π/2 - atan(1 / t).
+inline double atan2Select(double y, double x) {
+  constexpr double MOREBITS = 6.123233995736765886130e-17;
+
+  double ax    = std::abs(x);
+  double ay    = std::abs(y);
+  double large = std::max(ax, ay);
+  double small = std::min(ax, ay);
+  double t     = large > 0.0 ? small / large : 0.0;
+
+  bool   reduce = t > 0.66;
+  double base   = reduce ? M_PI / 4.0 : 0.0;
+  double extra  = reduce ? 0.5 * MOREBITS : 0.0;
+  t             = reduce ? (t - 1.0) / (t + 1.0) : t;
+
+  double z = t * t;
+  double p = (((-8.750608600031904122785e-01 * z - 1.615753718733365076637e+01) * z -
+                  7.500855792314704667340e+01) *
+                     z -
+                 1.228866684490136173410e+02) *
+                 z -
+             6.485021904942025371773e+01;
+  double q = ((((z + 2.485846490142306297962e+01) * z + 1.650270098316988542046e+02) * z +
+                  4.328810604912902668951e+02) *
+                     z +
+                 4.853903996359136964868e+02) *
+                 z +
+             1.945506571482613964425e+02;
+
+  double a = base + (t * z * p / q + extra) + t;
+  a        = ay > ax ? M_PI / 2.0 - a : a;
+  a        = x < 0.0 ? M_PI - a : a;
+  return y < 0.0 ? -a : a;
+}
+
+// Parses a floating point value from the given columns of a TLE line. The TLE format uses
+// one-based column numbers.
+double parseColumns(std::string const& line, size_t first, size_t last) {
+  return std::stod(line.substr(first - 1, last - first + 1));
+}
+
+// Parses a value in the TLE exponential notation with an implied decimal point, like " 12345-3"
+// which means 0.12345e-3.
+double parseExponential(std::string const& line, size_t first, size_t last) {
+  auto   field    = line.substr(first - 1, last - first + 1);
+  double sign     = field[0] == '-' ? -1.0 : 1.0;
+  double mantissa = std::stod("0." + field.substr(1, 5));
+  int    exponent = std::stoi(field.substr(6, 2));
+  return sign * mantissa * std::pow(10.0, exponent);
+}
+
+OrbitalElements parseTLE(std::string const& name, std::string const& line1,
+    std::string const& line2) {
+  OrbitalElements elements;
+  elements.mName = name;
+
+  // The epoch is given as two-digit year and fractional day of the year in UTC.
+  int    year = static_cast<int>(parseColumns(line1, 19, 20));
+  double day  = parseColumns(line1, 21, 32);
+  year += year < 57 ? 2000 : 1900;
+
+  auto epoch = boost::posix_time::ptime(boost::gregorian::date(year, 1, 1)) +
+               boost::posix_time::microseconds(static_cast<int64_t>((day - 1.0) * 86400.0 * 1e6));
+
+  elements.mEpoch        = cs::utils::convert::time::toSpice(epoch);
+  elements.mBStar        = parseExponential(line1, 54, 61);
+  elements.mInclination  = glm::radians(parseColumns(line2, 9, 16));
+  elements.mRAAN         = glm::radians(parseColumns(line2, 18, 25));
+  elements.mEccentricity = std::stod("0." + line2.substr(26, 7));
+  elements.mArgOfPerigee = glm::radians(parseColumns(line2, 35, 42));
+  elements.mMeanAnomaly  = glm::radians(parseColumns(line2, 44, 51));
+  elements.mMeanMotion   = parseColumns(line2, 53, 63) * TWO_PI / 1440.0;
+
+  return elements;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<OrbitalElements> loadTLEs(std::string const& fileName) {
+  std::ifstream stream(fileName);
+
+  if (!stream) {
+    throw std::runtime_error("Failed to open '" + fileName + "' for reading.");
+  }
+
+  std::vector<OrbitalElements> result;
+  std::string                  name;
+  std::string                  line1;
+  std::string                  line;
+
+  while (std::getline(stream, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+
+    if (line.size() >= 69 && line[0] == '1' && line[1] == ' ') {
+      line1 = line;
+    } else if (line.size() >= 69 && line[0] == '2' && line[1] == ' ' && !line1.empty()) {
+      try {
+        result.push_back(parseTLE(name.empty() ? line.substr(2, 5) : name, line1, line));
+      } catch (std::exception const& e) {
+        logger().warn("Skipping invalid TLE '{}' in '{}': {}", name, fileName, e.what());
+      }
+      name.clear();
+      line1.clear();
+    } else if (!line.empty()) {
+      // This is the optional name line of the three-line format.
+      name = line.substr(0, line.find_last_not_of(' ') + 1);
+      line1.clear();
+    }
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<OrbitalElements> loadOMMs(std::string const& fileName) {
+  std::ifstream stream(fileName);
+
+  if (!stream) {
+    throw std::runtime_error("Failed to open '" + fileName + "' for reading.");
+  }
+
+  nlohmann::json json;
+
+  try {
+    stream >> json;
+  } catch (std::exception const& e) {
+    throw std::runtime_error("Failed to parse '" + fileName + "': " + e.what());
+  }
+
+  std::vector<OrbitalElements> result;
+  result.reserve(json.size());
+
+  for (auto const& record : json) {
+    try {
+      OrbitalElements elements;
+      elements.mName         = record.at("OBJECT_NAME").get<std::string>();
+      elements.mEpoch = cs::utils::convert::time::toSpice(record.at("EPOCH").get<std::string>());
+      elements.mMeanMotion   = record.at("MEAN_MOTION").get<double>() * TWO_PI / 1440.0;
+      elements.mEccentricity = record.at("ECCENTRICITY").get<double>();
+      elements.mInclination  = glm::radians(record.at("INCLINATION").get<double>());
+      elements.mRAAN         = glm::radians(record.at("RA_OF_ASC_NODE").get<double>());
+      elements.mArgOfPerigee = glm::radians(record.at("ARG_OF_PERICENTER").get<double>());
+      elements.mMeanAnomaly  = glm::radians(record.at("MEAN_ANOMALY").get<double>());
+      elements.mBStar        = record.at("BSTAR").get<double>();
+      result.push_back(elements);
+    } catch (std::exception const& e) {
+      logger().warn("Skipping invalid OMM record in '{}': {}", fileName, e.what());
+    }
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SGP4::SGP4(std::vector<OrbitalElements> const& elements) {
+  size_t count = elements.size();
+
+  for (auto* v : {&mEpoch, &mNo, &mAo, &mEcco, &mInclo, &mNodeo, &mArgpo, &mMo, &mBStar, &mCc1,
+           &mCc4, &mCc5, &mD2, &mD3, &mD4, &mDelmo, &mEta, &mSinmao, &mArgpdot, &mMdot, &mNodedot,
+           &mNodecf, &mOmgcof, &mXmcof, &mT2cof, &mT3cof, &mT4cof, &mT5cof, &mXlcof, &mAycof,
+           &mCon41, &mX1mth2, &mX7thm1, &mCosio, &mSinio}) {
+    v->resize(count, 0.0);
+  }
+
+  size_t deepSpaceCount = 0;
+
+  // This follows sgp4init() of the reference implementation. The simplified drag model (isimp) is
+  // represented by setting the corresponding higher-order coefficients to zero.
+  for (size_t i = 0; i < count; ++i) {
+    auto const& e = elements[i];
+
+    double ecco  = e.mEccentricity;
+    double inclo = e.mInclination;
+    double argpo = e.mArgOfPerigee;
+    double bstar = e.mBStar;
+
+    // Recover the original mean motion and semi-major axis from the Kozai mean motion.
+    double eccsq   = ecco * ecco;
+    double omeosq  = 1.0 - eccsq;
+    double rteosq  = std::sqrt(omeosq);
+    double cosio   = std::cos(inclo);
+    double cosio2  = cosio * cosio;
+    double ak      = std::pow(xke() / e.mMeanMotion, X2O3);
+    double d1      = 0.75 * J2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+    double del     = d1 / (ak * ak);
+    double adel    = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+    del            = d1 / (adel * adel);
+    double no      = e.mMeanMotion / (1.0 + del);
+    double ao      = std::pow(xke() / no, X2O3);
+    double sinio   = std::sin(inclo);
+    double po      = ao * omeosq;
+    double con42   = 1.0 - 5.0 * cosio2;
+    double con41   = -con42 - cosio2 - cosio2;
+    double posq    = po * po;
+    double rp      = ao * (1.0 - ecco);
+    bool   isimp   = rp < (220.0 / EARTH_RADIUS + 1.0);
+    double sfour   = 78.0 / EARTH_RADIUS + 1.0;
+    double qzms24  = std::pow((120.0 - 78.0) / EARTH_RADIUS, 4.0);
+    double perigee = (rp - 1.0) * EARTH_RADIUS;
+
+    if (TWO_PI / no >= DEEP_SPACE_PERIOD) {
+      ++deepSpaceCount;
+    }
+
+    // For perigees below 156 km, the values of s and qoms2t are altered.
+    if (perigee < 156.0) {
+      sfour  = perigee < 98.0 ? 20.0 : perigee - 78.0;
+      qzms24 = std::pow((120.0 - sfour) / EARTH_RADIUS, 4.0);
+      sfour  = sfour / EARTH_RADIUS + 1.0;
+    }
+
+    double pinvsq = 1.0 / posq;
+    double tsi    = 1.0 / (ao - sfour);
+    double eta    = ao * ecco * tsi;
+    double etasq  = eta * eta;
+    double eeta   = ecco * eta;
+    double psisq  = std::abs(1.0 - etasq);
+    double coef   = qzms24 * std::pow(tsi, 4.0);
+    double coef1  = coef / std::pow(psisq, 3.5);
+    double cc2    = coef1 * no *
+                 (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+                     0.375 * J2 * tsi / psisq * con41 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+    double cc1    = bstar * cc2;
+    double cc3    = ecco > 1.0e-4 ? -2.0 * coef * tsi * J3OJ2 * no * sinio / ecco : 0.0;
+    double x1mth2 = 1.0 - cosio2;
+    double cc4    = 2.0 * no * coef1 * ao * omeosq *
+                 (eta * (2.0 + 0.5 * etasq) + ecco * (0.5 + 2.0 * etasq) -
+                     J2 * tsi / (ao * psisq) *
+                         (-3.0 * con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+                             0.75 * x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) *
+                                 std::cos(2.0 * argpo)));
+    double cc5    = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+    double cosio4 = cosio2 * cosio2;
+    double temp1  = 1.5 * J2 * pinvsq * no;
+    double temp2  = 0.5 * temp1 * J2 * pinvsq;
+    double temp3  = -0.46875 * J4 * pinvsq * pinvsq * no;
+    double xhdot1 = -temp1 * cosio;
+
+    mMdot[i] = no + 0.5 * temp1 * rteosq * con41 +
+               0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+    mArgpdot[i] = -0.5 * temp1 * con42 + 0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) +
+                  temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+    mNodedot[i] =
+        xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2)) * cosio;
+
+    double cosioPlusOne = std::abs(cosio + 1.0) > 1.5e-12 ? cosio + 1.0 : 1.5e-12;
+
+    mEpoch[i]  = e.mEpoch;
+    mNo[i]     = no;
+    mAo[i]     = ao;
+    mEcco[i]   = ecco;
+    mInclo[i]  = inclo;
+    mNodeo[i]  = e.mRAAN;
+    mArgpo[i]  = argpo;
+    mMo[i]     = e.mMeanAnomaly;
+    mBStar[i]  = bstar;
+    mCc1[i]    = cc1;
+    mCc4[i]    = cc4;
+    mEta[i]    = eta;
+    mNodecf[i] = 3.5 * omeosq * xhdot1 * cc1;
+    mT2cof[i]  = 1.5 * cc1;
+    mXlcof[i]  = -0.25 * J3OJ2 * sinio * (3.0 + 5.0 * cosio) / cosioPlusOne;
+    mAycof[i]  = -0.5 * J3OJ2 * sinio;
+    mDelmo[i]  = std::pow(1.0 + eta * std::cos(e.mMeanAnomaly), 3.0);
+    mSinmao[i] = std::sin(e.mMeanAnomaly);
+    mCon41[i]  = con41;
+    mX1mth2[i] = x1mth2;
+    mX7thm1[i] = 7.0 * cosio2 - 1.0;
+    mCosio[i]  = cosio;
+    mSinio[i]  = sinio;
+
+    if (!isimp) {
+      double cc1sq = cc1 * cc1;
+      double d2    = 4.0 * ao * tsi * cc1sq;
+      double temp  = d2 * tsi * cc1 / 3.0;
+      double d3    = (17.0 * ao + sfour) * temp;
+      double d4    = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * cc1;
+
+      mCc5[i]    = cc5;
+      mOmgcof[i] = bstar * cc3 * std::cos(argpo);
+      mXmcof[i]  = ecco > 1.0e-4 ? -X2O3 * coef * bstar / eeta : 0.0;
+      mD2[i]     = d2;
+      mD3[i]     = d3;
+      mD4[i]     = d4;
+      mT3cof[i]  = d2 + 2.0 * cc1sq;
+      mT4cof[i]  = 0.25 * (3.0 * d3 + cc1 * (12.0 * d2 + 10.0 * cc1sq));
+      mT5cof[i]  = 0.2 * (3.0 * d4 + 12.0 * cc1 * d3 + 6.0 * d2 * d2 +
+                            15.0 * cc1sq * (2.0 * d2 + cc1sq));
+    }
+  }
+
+  if (deepSpaceCount > 0) {
+    logger().warn("{} of {} satellites have an orbital period of more than {} minutes. Their "
+                  "positions will be inaccurate as deep-space perturbations are not modelled.",
+        deepSpaceCount, count, DEEP_SPACE_PERIOD);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t SGP4::size() const {
+  return mNo.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SGP4::propagate(double tdb, size_t begin, size_t end, glm::dvec3* positions) const {
+
+  // SGP4 computes positions in the true-equator, mean-equinox (TEME) frame. We rotate them to the
+  // Earth-fixed frame with the Greenwich mean sidereal time (IAU-82 model). The difference between
+  // UT1 and UTC is neglected.
+  double deltaET = 0.0;
+  deltet_c(tdb, "ET", &deltaET);
+  double tut1 = (tdb - deltaET) / 86400.0 / 36525.0;
+  double gmst = -6.2e-6 * tut1 * tut1 * tut1 + 0.093104 * tut1 * tut1 +
+                (876600.0 * 3600.0 + 8640184.812866) * tut1 + 67310.54841;
+  gmst          = std::fmod(glm::radians(gmst / 240.0), TWO_PI);
+  double cosGst = std::cos(gmst);
+  double sinGst = std::sin(gmst);
+
+  double const scale = EARTH_RADIUS * 1000.0;
+  end                = std::min(end, size());
+
+  // This follows sgp4() of the reference implementation. All branches have been replaced by
+  // arithmetic selects and everything which only depends on the elements is computed in the
+  // constructor. The satellites are processed in batches of BATCH_SIZE. For each batch, the
+  // computation is split into several loops over the satellites which pass their intermediate
+  // results on in small arrays. This way, the compiler can vectorize each of these loops.
+  std::array<double, BATCH_SIZE> am{}, em{}, nodem{}, tempa{}, axnl{}, aynl{}, u{};
+  std::array<double, BATCH_SIZE> eo1{}, sineo1{}, coseo1{};
+
+  for (size_t first = begin; first < end; first += BATCH_SIZE) {
+    size_t count = std::min(BATCH_SIZE, end - first);
+
+    // Secular gravity, atmospheric drag and long period periodics.
+    for (size_t j = 0; j < count; ++j) {
+      size_t i  = first + j;
+      double t  = (tdb - mEpoch[i]) / 60.0;
+      double t2 = t * t;
+      double t3 = t2 * t;
+      double t4 = t3 * t;
+
+      double xmdf   = mMo[i] + mMdot[i] * t;
+      double argpdf = mArgpo[i] + mArgpdot[i] * t;
+      double node   = mNodeo[i] + mNodedot[i] * t + mNodecf[i] * t2;
+      double delomg = mOmgcof[i] * t;
+
+      double sinxmdf = 0.0;
+      double cosxmdf = 0.0;
+      sinCos(xmdf, sinxmdf, cosxmdf);
+
+      double delmo = 1.0 + mEta[i] * cosxmdf;
+      double delm  = mXmcof[i] * (delmo * delmo * delmo - mDelmo[i]);
+      double mm    = xmdf + delomg + delm;
+      double argp  = argpdf - delomg - delm;
+      double ta    = 1.0 - mCc1[i] * t - mD2[i] * t2 - mD3[i] * t3 - mD4[i] * t4;
+      double templ = mT2cof[i] * t2 + mT3cof[i] * t3 + t4 * (mT4cof[i] + t * mT5cof[i]);
+
+      double sinmm = 0.0;
+      double cosmm = 0.0;
+      sinCos(mm, sinmm, cosmm);
+
+      double tempe = mBStar[i] * mCc4[i] * t + mBStar[i] * mCc5[i] * (sinmm - mSinmao[i]);
+      double a     = mAo[i] * ta * ta;
+      double e     = std::max(mEcco[i] - tempe, 1.0e-6);
+      mm += mNo[i] * templ;
+
+      double xlm = mm + argp + node;
+      node       = wrapAngle(node);
+      argp       = wrapAngle(argp);
+      xlm        = wrapAngle(xlm);
+      mm         = wrapAngle(xlm - argp - node);
+
+      double sinargp = 0.0;
+      double cosargp = 0.0;
+      sinCos(argp, sinargp, cosargp);
+
+      double ax   = e * cosargp;
+      double temp = 1.0 / (a * (1.0 - e * e));
+      double ay   = e * sinargp + temp * mAycof[i];
+      double xl   = mm + argp + node + temp * mXlcof[i] * ax;
+
+      am[j]    = a;
+      em[j]    = e;
+      nodem[j] = node;
+      tempa[j] = ta;
+      axnl[j]  = ax;
+      aynl[j]  = ay;
+      u[j]     = wrapAngle(xl - node);
+      eo1[j]   = u[j];
+    }
+
+    // Solve Kepler's equation. The sine and cosine of the last iteration's input are used below.
+    for (int k = 0; k < KEPLER_ITERATIONS; ++k) {
+      for (size_t j = 0; j < count; ++j) {
+        sinCos(eo1[j], sineo1[j], coseo1[j]);
+        double step = (u[j] - aynl[j] * coseo1[j] + axnl[j] * sineo1[j] - eo1[j]) /
+                      (1.0 - coseo1[j] * axnl[j] - sineo1[j] * aynl[j]);
+        eo1[j] += std::clamp(step, -0.95, 0.95);
+      }
+    }
+
+    // Short period periodics.
+    for (size_t j = 0; j < count; ++j) {
+      size_t i = first + j;
+
+      double ecose = axnl[j] * coseo1[j] + aynl[j] * sineo1[j];
+      double esine = axnl[j] * sineo1[j] - aynl[j] * coseo1[j];
+      double el2   = axnl[j] * axnl[j] + aynl[j] * aynl[j];
+      double pl    = std::max(am[j] * (1.0 - el2), 1.0e-12);
+      double rl    = am[j] * (1.0 - ecose);
+      double betal = std::sqrt(std::max(1.0 - el2, 0.0));
+      double temp  = esine / (1.0 + betal);
+      double sinu  = am[j] / rl * (sineo1[j] - aynl[j] - axnl[j] * temp);
+      double cosu  = am[j] / rl * (coseo1[j] - axnl[j] + aynl[j] * temp);
+      double su    = atan2Select(sinu, cosu);
+      double sin2u = (cosu + cosu) * sinu;
+      double cos2u = 1.0 - 2.0 * sinu * sinu;
+      temp         = 1.0 / pl;
+      double temp1 = 0.5 * J2 * temp;
+      double temp2 = temp1 * temp;
+
+      double mrt   = rl * (1.0 - 1.5 * temp2 * betal * mCon41[i]) +
+                   0.5 * temp1 * mX1mth2[i] * cos2u;
+      su           = su - 0.25 * temp2 * mX7thm1[i] * sin2u;
+      double xnode = nodem[j] + 1.5 * temp2 * mCosio[i] * sin2u;
+      double xinc  = mInclo[i] + 1.5 * temp2 * mCosio[i] * mSinio[i] * cos2u;
+
+      // Orientation vectors.
+      double sinsu = 0.0;
+      double cossu = 0.0;
+      double snod  = 0.0;
+      double cnod  = 0.0;
+      double sini  = 0.0;
+      double cosi  = 0.0;
+      sinCos(su, sinsu, cossu);
+      sinCos(xnode, snod, cnod);
+      sinCos(xinc, sini, cosi);
+
+      double ux = -snod * cosi * sinsu + cnod * cossu;
+      double uy = cnod * cosi * sinsu + snod * cossu;
+      double uz = sini * sinsu;
+
+      // Satellites which have decayed or whose elements have become invalid are moved to the
+      // origin. The conditions are applied one after another, as the compiler cannot vectorize
+      // the short-circuit evaluation of a combined condition.
+      double r = mrt >= 1.0 ? mrt * scale : 0.0;
+      r        = em[j] < 1.0 ? r : 0.0;
+      r        = am[j] * (1.0 - el2) > 0.0 ? r : 0.0;
+      r        = tempa[j] > 0.0 ? r : 0.0;
+
+      // Rotate from TEME to the Earth-fixed frame and swap the axes to the convention of
+      // CosmoScout VR.
+      double x = r * ux;
+      double y = r * uy;
+
+      positions[i - begin] = glm::dvec3(-sinGst * x + cosGst * y, r * uz, cosGst * x + sinGst * y);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace csp::satellites
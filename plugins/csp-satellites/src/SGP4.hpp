@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CSP_SATELLITES_SGP4_HPP
+#define CSP_SATELLITES_SGP4_HPP
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+namespace csp::satellites {
+
+/// The mean orbital elements of a satellite as given in a TLE or an OMM record. Angles are in
+/// radians, the mean motion is in radians per minute.
+struct OrbitalElements {
+  std::string mName;
+  double      mEpoch        = 0.0; ///< In TDB seconds since J2000.
+  double      mMeanMotion   = 0.0;
+  double      mEccentricity = 0.0;
+  double      mInclination  = 0.0;
+  double      mRAAN         = 0.0;
+  double      mArgOfPerigee = 0.0;
+  double      mMeanAnomaly  = 0.0;
+  double      mBStar        = 0.0;
+};
+
+/// Reads two-line element sets. An optional name line (three-line format) may precede each set.
+/// Lines which cannot be parsed are skipped with a warning. Throws a std::runtime_error if the file
+/// cannot be opened.
+std::vector<OrbitalElements> loadTLEs(std::string const& fileName);
+
+/// Reads a JSON array of CCSDS OMM records, as provided for example by CelesTrak. Throws a
+/// std::runtime_error if the file cannot be opened or parsed.
+std::vector<OrbitalElements> loadOMMs(std::string const& fileName);
+
+/// An implementation of the SGP4 propagator for many satellites at once. All per-satellite
+/// constants are computed once and stored as structure of arrays. The satellites are propagated in
+/// small batches; for each batch, the propagation is split into a few loops without any
+/// per-satellite branches or library calls, which the compiler vectorizes. Additionally, different
+/// ranges of satellites can be propagated concurrently from multiple threads.
+///
+/// This implements the near-Earth part of SGP4 as described in "Revisiting Spacetrack Report #3"
+/// (Vallado et al., 2006) with the WGS-72 constants. The lunar-solar perturbations and resonance
+/// terms of the deep-space model (SDP4) are not included, so satellites with an orbital period of
+/// more than 225 minutes will be less accurate.
+class SGP4 {
+ public:
+  explicit SGP4(std::vector<OrbitalElements> const& elements);
+
+  /// Returns the number of satellites.
+  size_t size() const;
+
+  /// Computes the positions of the satellites in the range [begin, end) at the given time (in TDB
+  /// seconds since J2000). The position of satellite i is written to positions[i - begin]. It is
+  /// given in meters in the Earth-fixed frame (ignoring polar motion), using the axis convention of
+  /// CosmoScout VR (the y-axis points to the north pole). Satellites which have decayed are placed
+  /// at the origin.
+  void propagate(double tdb, size_t begin, size_t end, glm::dvec3* positions) const;
+
+ private:
+  // The elements at epoch.
+  std::vector<double> mEpoch, mNo, mAo, mEcco, mInclo, mNodeo, mArgpo, mMo, mBStar;
+
+  // Derived constants, see sgp4init() in the reference implementation.
+  std::vector<double> mCc1, mCc4, mCc5, mD2, mD3, mD4, mDelmo, mEta, mSinmao;
+  std::vector<double> mArgpdot, mMdot, mNodedot, mNodecf, mOmgcof, mXmcof;
+  std::vector<double> mT2cof, mT3cof, mT4cof, mT5cof, mXlcof, mAycof;
+  std::vector<double> mCon41, mX1mth2, mX7thm1, mCosio, mSinio;
+};
+
+} // namespace csp::satellites
+
+#endif // CSP_SATELLITES_SGP4_HPP
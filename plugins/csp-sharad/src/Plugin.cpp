@@ -7,6 +7,7 @@
 
 #include "Plugin.hpp"
 
+#include "../../../src/cs-core/GraphicsEngine.hpp"
 #include "../../../src/cs-core/GuiManager.hpp"
 #include "../../../src/cs-core/SolarSystem.hpp"
 #include "../../../src/cs-core/TimeControl.hpp"
@@ -18,6 +19,8 @@
 #include <VistaKernelOpenSGExt/VistaOpenSGMaterialTools.h>
 #include <boost/filesystem.hpp>
 
+#include <utility>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 EXPORT_FN cs::core::PluginBase* create() {
@@ -92,8 +95,9 @@ void Plugin::init() {
           if (ext == ".tab") {
             std::string sName = file.substr(0, file.length() - 5);
             auto        sharad =
-                std::make_shared<Sharad>(mAllSettings, mSolarSystem, mPluginSettings.mAnchor,
-                    filePath + sName + "_tiff.tif", filePath + sName + "_geom.tab");
+                std::make_shared<Sharad>(mAllSettings, mSolarSystem, mGraphicsEngine,
+                    mPluginSettings.mAnchor, filePath + sName + "_tiff.tif",
+                    filePath + sName + "_geom.tab");
 
             auto* sharadNode = mSceneGraph->NewOpenGLNode(mSceneGraph->GetRoot(), sharad.get());
             VistaOpenSGMaterialTools::SetSortKeyOnSubtree(
@@ -111,7 +115,14 @@ void Plugin::init() {
     }
   });
 
+  mDepthCallback = std::make_unique<DepthCallback>(mGraphicsEngine->getSceneSnapshot());
+  mDepthCallbackNode.reset(
+      mSceneGraph->NewOpenGLNode(mSceneGraph->GetRoot(), mDepthCallback.get()));
+  VistaOpenSGMaterialTools::SetSortKeyOnSubtree(
+      mDepthCallbackNode.get(), static_cast<int>(cs::utils::DrawOrder::eOpaqueNonHDR) + 1);
+
   mPluginSettings.mEnabled.connectAndTouch([this](bool val) {
+    mDepthCallbackNode->SetIsEnabled(val);
     for (auto const& node : mSharadNodes) {
       node->SetIsEnabled(val);
     }
@@ -143,6 +154,8 @@ void Plugin::deInit() {
     mSceneGraph->GetRoot()->DisconnectChild(node.get());
   }
 
+  mSceneGraph->GetRoot()->DisconnectChild(mDepthCallbackNode.get());
+
   mGuiManager->removePluginTab("SHARAD Profiles");
 
   mSolarSystem->pActiveObject.disconnect(mActiveObjectConnection);
@@ -176,4 +189,23 @@ void Plugin::onSave() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+Plugin::DepthCallback::DepthCallback(std::shared_ptr<cs::graphics::SceneSnapshot> sceneSnapshot)
+    : mSceneSnapshot(std::move(sceneSnapshot)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Plugin::DepthCallback::Do() {
+  mSceneSnapshot->invalidateDepth();
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Plugin::DepthCallback::GetBoundingBox(VistaBoundingBox& /*bb*/) {
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace csp::sharad
@@ -11,8 +11,13 @@
 #include "../../../src/cs-core/PluginBase.hpp"
 #include "Sharad.hpp"
 
+#include <VistaKernel/GraphicsManager/VistaOpenGLDraw.h>
 #include <VistaKernel/GraphicsManager/VistaOpenGLNode.h>
 
+namespace cs::graphics {
+class SceneSnapshot;
+} // namespace cs::graphics
+
 namespace csp::sharad {
 
 /// This plugin allows the display of mars subsurface layers captured by the Mars Reconnaissance
@@ -33,9 +38,26 @@ class Plugin : public cs::core::PluginBase {
   void onLoad();
   void onSave();
 
+  // In LDR mode, the depth snapshot of the scene is taken before the items at
+  // cs::utils::DrawOrder::eOpaqueNonHDR are drawn. This node is drawn after these items and right
+  // before the SHARAD profiles. It marks the depth snapshot as outdated, so that the profiles are
+  // occluded by these items as well.
+  class DepthCallback : public IVistaOpenGLDraw {
+   public:
+    explicit DepthCallback(std::shared_ptr<cs::graphics::SceneSnapshot> sceneSnapshot);
+
+    bool Do() override;
+    bool GetBoundingBox(VistaBoundingBox& bb) override;
+
+   private:
+    std::shared_ptr<cs::graphics::SceneSnapshot> mSceneSnapshot;
+  };
+
   Settings                                      mPluginSettings;
   std::vector<std::shared_ptr<Sharad>>          mSharads;
   std::vector<std::unique_ptr<VistaOpenGLNode>> mSharadNodes;
+  std::unique_ptr<DepthCallback>                mDepthCallback;
+  std::unique_ptr<VistaOpenGLNode>              mDepthCallbackNode;
 
   int mActiveObjectConnection = -1;
   int mOnLoadConnection       = -1;
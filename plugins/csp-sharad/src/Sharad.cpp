@@ -7,6 +7,7 @@
 
 #include "Sharad.hpp"
 
+#include "../../../src/cs-core/GraphicsEngine.hpp"
 #include "../../../src/cs-core/SolarSystem.hpp"
 #include "../../../src/cs-graphics/TextureLoader.hpp"
 #include "../../../src/cs-scene/CelestialObserver.hpp"
@@ -15,10 +16,7 @@
 #include "../../../src/cs-utils/utils.hpp"
 #include "logger.hpp"
 
-#include <VistaKernel/GraphicsManager/VistaGroupNode.h>
-#include <VistaKernel/GraphicsManager/VistaOpenGLNode.h>
-#include <VistaKernel/VistaSystem.h>
-#include <VistaKernelOpenSGExt/VistaOpenSGMaterialTools.h>
+#include <VistaOGLExt/VistaTexture.h>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <cstdio>
@@ -77,8 +75,14 @@ const char* Sharad::FRAG = R"(
 #version 330
 
 uniform mat4 uMatProjection;
-uniform sampler2DRect uDepthBuffer;
 uniform sampler2D uSharadTexture;
+
+#if DEPTH_SAMPLES > 0
+uniform sampler2DMS uDepthBuffer;
+#else
+uniform sampler2D uDepthBuffer;
+#endif
+
 uniform float uAmbientBrightness;
 uniform float uTime;
 uniform float uSceneScale;
@@ -93,6 +97,23 @@ in float vTime;
 // outputs
 layout(location = 0) out vec4 oColor;
 
+// Returns the depth of the scene at the current fragment. For multi-sampled depth buffers, the
+// nearest sample is used.
+float getDepth()
+{
+    ivec2 texel = ivec2(gl_FragCoord.xy - uViewportPos);
+
+#if DEPTH_SAMPLES > 0
+    float depth = 1.0;
+    for (int i = 0; i < DEPTH_SAMPLES; ++i) {
+        depth = min(depth, texelFetch(uDepthBuffer, texel, i).r);
+    }
+    return depth;
+#else
+    return texelFetch(uDepthBuffer, texel, 0).r;
+#endif
+}
+
 void main()
 {
     if (vTime > uTime)
@@ -100,7 +121,7 @@ void main()
         discard;
     }
 
-    float fDepth = texture(uDepthBuffer,  gl_FragCoord.xy - uViewportPos).r;
+    float fDepth = getDepth();
     vec4 surfacePos = inverse(uMatProjection) * vec4(vPositionSS.xy / vPositionSS.w, 2*fDepth-1, 1);
     float surfaceDistance = length(surfacePos.xyz / surfacePos.w);
     float sharadDistance  = length(vPositionVS);
@@ -122,13 +143,6 @@ void main()
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::unique_ptr<VistaTexture>                Sharad::mDepthBuffer     = nullptr;
-std::unique_ptr<Sharad::FramebufferCallback> Sharad::mPreCallback     = nullptr;
-std::unique_ptr<VistaOpenGLNode>             Sharad::mPreCallbackNode = nullptr;
-int                                          Sharad::mInstanceCount   = 0;
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 struct ProfileRadarData {
   unsigned int Number;
   unsigned int Year;
@@ -151,34 +165,15 @@ struct ProfileRadarData {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Sharad::Sharad(std::shared_ptr<cs::core::Settings> settings,
-    std::shared_ptr<cs::core::SolarSystem> solarSystem, std::string objectName,
+    std::shared_ptr<cs::core::SolarSystem>           solarSystem,
+    std::shared_ptr<cs::core::GraphicsEngine>        graphicsEngine, std::string objectName,
     std::string const& sTiffFile, std::string const& sTabFile)
     : mSettings(std::move(settings))
     , mSolarSystem(std::move(solarSystem))
+    , mGraphicsEngine(std::move(graphicsEngine))
     , mTexture(cs::graphics::TextureLoader::loadFromFile(sTiffFile))
     , mObjectName(std::move(objectName)) {
 
-  if (mInstanceCount == 0) {
-    mDepthBuffer = std::make_unique<VistaTexture>(GL_TEXTURE_RECTANGLE);
-    mDepthBuffer->Bind();
-    mDepthBuffer->SetWrapS(GL_CLAMP);
-    mDepthBuffer->SetWrapT(GL_CLAMP);
-    mDepthBuffer->SetMinFilter(GL_NEAREST);
-    mDepthBuffer->SetMagFilter(GL_NEAREST);
-    mDepthBuffer->Unbind();
-
-    mPreCallback = std::make_unique<FramebufferCallback>(mDepthBuffer.get());
-
-    auto* sceneGraph = GetVistaSystem()->GetGraphicsManager()->GetSceneGraph();
-    mPreCallbackNode = std::unique_ptr<VistaOpenGLNode>(
-        sceneGraph->NewOpenGLNode(sceneGraph->GetRoot(), mPreCallback.get()));
-
-    VistaOpenSGMaterialTools::SetSortKeyOnSubtree(
-        mPreCallbackNode.get(), static_cast<int>(cs::utils::DrawOrder::eOpaqueNonHDR) + 1);
-  }
-
-  ++mInstanceCount;
-
   // Disables a warning in MSVC about using fopen_s and fscanf_s, which aren't supported in GCC.
   CS_WARNINGS_PUSH
   CS_DISABLE_MSVC_WARNING(4996)
@@ -261,36 +256,34 @@ Sharad::Sharad(std::shared_ptr<cs::core::Settings> settings,
   mVAO.EnableAttributeArray(2);
   mVAO.SpecifyAttributeArrayFloat(
       2, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), static_cast<GLuint>(offsetof(Vertex, time)), &mVBO);
-
-  // create sphere shader ----------------------------------------------------
-  mShader.InitVertexShaderFromString(VERT);
-  mShader.InitFragmentShaderFromString(FRAG);
-  mShader.Link();
-
-  mUniforms.modelViewMatrix  = mShader.GetUniformLocation("uMatModelView");
-  mUniforms.projectionMatrix = mShader.GetUniformLocation("uMatProjection");
-  mUniforms.viewportPosition = mShader.GetUniformLocation("uViewportPos");
-  mUniforms.sharadTexture    = mShader.GetUniformLocation("uSharadTexture");
-  mUniforms.depthBuffer      = mShader.GetUniformLocation("uDepthBuffer");
-  mUniforms.sceneScale       = mShader.GetUniformLocation("uSceneScale");
-  mUniforms.heightScale      = mShader.GetUniformLocation("uHeightScale");
-  mUniforms.radii            = mShader.GetUniformLocation("uRadii");
-  mUniforms.time             = mShader.GetUniformLocation("uTime");
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Sharad::~Sharad() {
-  --mInstanceCount;
+Sharad::~Sharad() = default;
 
-  if (mInstanceCount == 0) {
-    auto* sceneGraph = GetVistaSystem()->GetGraphicsManager()->GetSceneGraph();
-    sceneGraph->GetRoot()->DisconnectChild(mPreCallbackNode.get());
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    mPreCallback.reset(nullptr);
-    mDepthBuffer.reset(nullptr);
-    mPreCallbackNode.reset(nullptr);
-  }
+void Sharad::createShader(uint32_t depthSamples) {
+  std::string frag(FRAG);
+  cs::utils::replaceString(frag, "DEPTH_SAMPLES", std::to_string(depthSamples));
+
+  mShader = std::make_unique<VistaGLSLShader>();
+  mShader->InitVertexShaderFromString(VERT);
+  mShader->InitFragmentShaderFromString(frag);
+  mShader->Link();
+
+  mUniforms.modelViewMatrix  = mShader->GetUniformLocation("uMatModelView");
+  mUniforms.projectionMatrix = mShader->GetUniformLocation("uMatProjection");
+  mUniforms.viewportPosition = mShader->GetUniformLocation("uViewportPos");
+  mUniforms.sharadTexture    = mShader->GetUniformLocation("uSharadTexture");
+  mUniforms.depthBuffer      = mShader->GetUniformLocation("uDepthBuffer");
+  mUniforms.sceneScale       = mShader->GetUniformLocation("uSceneScale");
+  mUniforms.heightScale      = mShader->GetUniformLocation("uHeightScale");
+  mUniforms.radii            = mShader->GetUniformLocation("uRadii");
+  mUniforms.time             = mShader->GetUniformLocation("uTime");
+
+  mShaderDepthSamples = static_cast<int>(depthSamples);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -314,7 +307,16 @@ bool Sharad::Do() {
   if (object && object->getIsBodyVisible()) {
     cs::utils::FrameStats::ScopedTimer timer("Sharad");
 
-    mShader.Bind();
+    // The depth of the scene is shared with other screen-space effects. In HDR mode, this may be a
+    // multi-sampled texture, so the shader has to be recompiled if the sample count changes.
+    auto          snapshot    = mGraphicsEngine->getSceneSnapshot();
+    VistaTexture* depthBuffer = snapshot->getDepth();
+
+    if (mShaderDepthSamples != static_cast<int>(snapshot->getMultiSamples())) {
+      createShader(snapshot->getMultiSamples());
+    }
+
+    mShader->Bind();
 
     // get modelview and projection matrices
     std::array<GLfloat, 16> glMatMV{};
@@ -328,21 +330,21 @@ bool Sharad::Do() {
 
     std::array<GLint, 4> iViewport{};
     glGetIntegerv(GL_VIEWPORT, iViewport.data());
-    mShader.SetUniform(mUniforms.viewportPosition, static_cast<float>(iViewport.at(0)),
+    mShader->SetUniform(mUniforms.viewportPosition, static_cast<float>(iViewport.at(0)),
         static_cast<float>(iViewport.at(1)));
 
     auto radii = object->getRadii();
 
-    mShader.SetUniform(mUniforms.sharadTexture, 0);
-    mShader.SetUniform(mUniforms.depthBuffer, 1);
-    mShader.SetUniform(mUniforms.sceneScale, static_cast<float>(mSceneScale));
-    mShader.SetUniform(mUniforms.heightScale, mSettings->mGraphics.pHeightScale.get());
-    mShader.SetUniform(mUniforms.radii, static_cast<float>(radii[0]), static_cast<float>(radii[1]),
+    mShader->SetUniform(mUniforms.sharadTexture, 0);
+    mShader->SetUniform(mUniforms.depthBuffer, 1);
+    mShader->SetUniform(mUniforms.sceneScale, static_cast<float>(mSceneScale));
+    mShader->SetUniform(mUniforms.heightScale, mSettings->mGraphics.pHeightScale.get());
+    mShader->SetUniform(mUniforms.radii, static_cast<float>(radii[0]), static_cast<float>(radii[1]),
         static_cast<float>(radii[2]));
-    mShader.SetUniform(mUniforms.time, static_cast<float>(mCurrTime - mStartTime));
+    mShader->SetUniform(mUniforms.time, static_cast<float>(mCurrTime - mStartTime));
 
     mTexture->Bind(GL_TEXTURE0);
-    mDepthBuffer->Bind(GL_TEXTURE1);
+    depthBuffer->Bind(GL_TEXTURE1);
 
     glPushAttrib(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -361,10 +363,11 @@ bool Sharad::Do() {
     // clean up ----------------------------------------------------------------
     glEnable(GL_CULL_FACE);
     mTexture->Unbind(GL_TEXTURE0);
+    depthBuffer->Unbind(GL_TEXTURE1);
 
     glPopAttrib();
 
-    mShader.Release();
+    mShader->Release();
   }
 
   return true;
@@ -378,21 +381,4 @@ bool Sharad::GetBoundingBox(VistaBoundingBox& /*bb*/) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Sharad::FramebufferCallback::FramebufferCallback(VistaTexture* pDepthBuffer)
-    : mDepthBuffer(pDepthBuffer) {
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
-bool Sharad::FramebufferCallback::Do() {
-  std::array<GLint, 4> iViewport{};
-  glGetIntegerv(GL_VIEWPORT, iViewport.data());
-  mDepthBuffer->Bind();
-  glCopyTexImage2D(GL_TEXTURE_RECTANGLE, 0, GL_DEPTH_COMPONENT, iViewport.at(0), iViewport.at(1),
-      iViewport.at(2), iViewport.at(3), 0);
-  return true;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 } // namespace csp::sharad
@@ -21,13 +21,18 @@
 
 class VistaTexture;
 
+namespace cs::core {
+class GraphicsEngine;
+} // namespace cs::core
+
 namespace csp::sharad {
 
 /// Renders a single SHARAD image.
 class Sharad : public IVistaOpenGLDraw {
  public:
   Sharad(std::shared_ptr<cs::core::Settings> settings,
-      std::shared_ptr<cs::core::SolarSystem> solarSystem, std::string objectName,
+      std::shared_ptr<cs::core::SolarSystem>    solarSystem,
+      std::shared_ptr<cs::core::GraphicsEngine> graphicsEngine, std::string objectName,
       std::string const& sTiffFile, std::string const& sTabFile);
 
   Sharad(Sharad const& other) = delete;
@@ -46,34 +51,21 @@ class Sharad : public IVistaOpenGLDraw {
   bool GetBoundingBox(VistaBoundingBox& bb) override;
 
  private:
-  class FramebufferCallback : public IVistaOpenGLDraw {
-   public:
-    explicit FramebufferCallback(VistaTexture* pDepthBuffer);
-
-    bool Do() override;
-    bool GetBoundingBox(VistaBoundingBox& /*bb*/) override {
-      return true;
-    }
-
-   private:
-    VistaTexture* mDepthBuffer;
-  };
-
-  static std::unique_ptr<VistaTexture>        mDepthBuffer;
-  static std::unique_ptr<FramebufferCallback> mPreCallback;
-  static std::unique_ptr<VistaOpenGLNode>     mPreCallbackNode;
-  static int                                  mInstanceCount;
+  // The shader is compiled lazily, as it depends on the number of samples of the depth buffer.
+  void createShader(uint32_t depthSamples);
 
-  std::shared_ptr<cs::core::Settings>    mSettings;
-  std::shared_ptr<cs::core::SolarSystem> mSolarSystem;
-  std::unique_ptr<VistaTexture>          mTexture;
+  std::shared_ptr<cs::core::Settings>       mSettings;
+  std::shared_ptr<cs::core::SolarSystem>    mSolarSystem;
+  std::shared_ptr<cs::core::GraphicsEngine> mGraphicsEngine;
+  std::unique_ptr<VistaTexture>             mTexture;
 
   std::string mObjectName;
   double      mStartTime;
 
-  VistaGLSLShader        mShader;
-  VistaVertexArrayObject mVAO;
-  VistaBufferObject      mVBO;
+  std::unique_ptr<VistaGLSLShader> mShader;
+  int                              mShaderDepthSamples = -1;
+  VistaVertexArrayObject           mVAO;
+  VistaBufferObject                mVBO;
 
   struct {
     uint32_t modelViewMatrix  = 0;
@@ -0,0 +1,747 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "BodyRenderer.hpp"
+
+#include "../../../src/cs-core/Settings.hpp"
+#include "../../../src/cs-core/SolarSystem.hpp"
+#include "../../../src/cs-graphics/ShaderCache.hpp"
+#include "../../../src/cs-graphics/ShaderProgram.hpp"
+#include "../../../src/cs-graphics/TextureLoader.hpp"
+#include "../../../src/cs-utils/FrameStats.hpp"
+#include "../../../src/cs-utils/utils.hpp"
+#include "SimpleBody.hpp"
+
+#include <VistaKernel/GraphicsManager/VistaSceneGraph.h>
+#include <VistaKernel/VistaSystem.h>
+#include <VistaKernelOpenSGExt/VistaOpenSGMaterialTools.h>
+#include <VistaMath/VistaBoundingBox.h>
+
+#include <algorithm>
+#include <array>
+#include <glm/gtc/type_ptr.hpp>
+#include <tuple>
+#include <utility>
+
+namespace csp::simplebodies {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+const uint32_t GRID_RESOLUTION_X = 200;
+const uint32_t GRID_RESOLUTION_Y = 100;
+
+// The eclipse shadow maps of individually drawn bodies are bound to this texture unit and the
+// following ones.
+const uint32_t ECLIPSE_TEXTURE_OFFSET = 2;
+
+// The per-body parameters as they are stored in the shader storage buffer. This has to match the
+// Body struct in the shaders below (std430 layout).
+struct BodyData {
+  glm::mat4 mModelMatrix;
+  glm::vec4 mRadii;  // xyz: The radii of the body, w: The horizontal texture coordinate offset.
+  glm::vec4 mSun;    // xyz: The direction to the Sun in body space, w: The Sun's illuminance.
+  glm::vec4 mParams; // xy: The inner and outer ring radius, z: The ambient brightness.
+};
+
+// Bodies are drawn in this order. Bodies of the first two kinds are drawn in batches.
+enum class DrawMode { ePoint, eBatchedSphere, eSingleSphere };
+
+struct DrawItem {
+  DrawMode      mMode;
+  VistaTexture* mTexture;
+  SimpleBody*   mBody;
+  BodyData      mData;
+};
+
+// The shader code for the body parameters which is shared by the sphere and the point shader. It
+// replaces the BODY_BUFFER_SNIPPET in the vertex shaders below.
+const char* BODY_BUFFER_SNIPPET = R"(
+struct Body {
+  mat4 matModel;
+  vec4 radii;
+  vec4 sun;
+  vec4 params;
+};
+
+layout(std430, binding = 0) readonly buffer BodyBuffer {
+  Body uBodies[];
+};
+
+uniform int  uBaseInstance;
+uniform mat4 uMatView;
+uniform mat4 uMatProjection;
+)";
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* BodyRenderer::SPHERE_VERT = R"(
+BODY_BUFFER_SNIPPET
+
+// inputs
+layout(location = 0) in vec2 iGridPos;
+
+// outputs
+out vec2 vTexCoords;
+out vec3 vNormal;
+out vec3 vPosition;
+out vec3 vCenter;
+out vec3 vNorth;
+out vec2 vLngLat;
+out vec3 vSunDirection;
+
+flat out float vSunIlluminance;
+flat out float vAmbientBrightness;
+flat out vec2  vRingRadii;
+
+const float PI = 3.141592654;
+
+vec3 geodeticSurfaceNormal(vec2 lngLat) {
+  return vec3(cos(lngLat.y) * sin(lngLat.x), sin(lngLat.y),
+      cos(lngLat.y) * cos(lngLat.x));
+}
+
+vec3 toCartesian(vec2 lonLat, vec3 radii) {
+  vec3 n = geodeticSurfaceNormal(lonLat);
+  vec3 k = n * radii * radii;
+  float gamma = sqrt(dot(k, n));
+  return k / gamma;
+}
+
+void main() {
+  Body body = uBodies[uBaseInstance + gl_InstanceID];
+
+  vTexCoords = vec2(iGridPos.x + body.radii.w, 1 - iGridPos.y);
+  vLngLat.x = iGridPos.x * 2.0 * PI - PI;
+  vLngLat.y = iGridPos.y * PI - PI/2;
+  vPosition = toCartesian(vLngLat, body.radii.xyz);
+  vNormal       = (body.matModel * vec4(geodeticSurfaceNormal(vLngLat), 0.0)).xyz;
+  vPosition     = (body.matModel * vec4(vPosition, 1.0)).xyz;
+  vNorth        = (body.matModel * vec4(0.0, 1.0, 0.0, 0.0)).xyz;
+  vSunDirection = (body.matModel * vec4(body.sun.xyz, 0.0)).xyz;
+  vCenter       = (body.matModel * vec4(0.0, 0.0, 0.0, 1.0)).xyz;
+  gl_Position   = uMatProjection * uMatView * vec4(vPosition, 1);
+
+  vSunIlluminance    = body.sun.w;
+  vAmbientBrightness = body.params.z;
+  vRingRadii         = body.params.xy;
+}
+)";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* BodyRenderer::SPHERE_FRAG = R"(
+uniform sampler2D uSurfaceTexture;
+uniform sampler2D uRingTexture;
+
+ECLIPSE_SHADER_SNIPPET
+
+// inputs
+in vec2 vTexCoords;
+in vec3 vNormal;
+in vec3 vPosition;
+in vec3 vCenter;
+in vec3 vNorth;
+in vec2 vLngLat;
+in vec3 vSunDirection;
+
+flat in float vSunIlluminance;
+flat in float vAmbientBrightness;
+flat in vec2  vRingRadii;
+
+// outputs
+layout(location = 0) out vec3 oColor;
+
+const float PI = 3.141592654;
+const float E  = 2.718281828;
+
+vec3 SRGBtoLINEAR(vec3 srgbIn) {
+  vec3 bLess = step(vec3(0.04045),srgbIn);
+  return mix( srgbIn/vec3(12.92), pow((srgbIn+vec3(0.055))/vec3(1.055),vec3(2.4)), bLess );
+}
+
+float orenNayar(vec3 N, vec3 L, vec3 V) {
+  float cos_theta_i = dot(N, L);
+
+  if (cos_theta_i <= 0) {
+    return 0;
+  }
+
+  float theta_i = acos(cos_theta_i);
+  
+  float cos_theta_r = dot(N, V);
+  float theta_r = acos(cos_theta_r);
+  
+  // Project L and V on a plane with N as the normal and get the cosine of the angle between the projections.
+  float cos_diff_phi = dot(normalize(V - cos_theta_r * N), normalize(L - cos_theta_i * N));
+  
+  float alpha = max(theta_i, theta_r);
+  float beta = min(theta_i, theta_r);
+  float beta_1  = 2 * beta / PI;
+  
+  const float sigma = 20;
+
+  float sigma2 = pow(sigma * PI / 180, 2);
+  float sigma_term = sigma2 / (sigma2 + 0.09);
+  
+  float C1 = 1 - 0.5 * (sigma2 / (sigma2 + 0.33));
+  
+  float C2 = 0.45 * sigma_term;
+  if (cos_diff_phi >= 0) {
+    C2 *= sin(alpha);
+  } else {
+    C2 *= sin(alpha) - pow(beta_1, 3);
+  }
+  
+  float C3 = 0.125 * sigma_term * pow(4 * alpha * beta / (PI * PI), 2);
+  
+  float L1 = C1 + cos_diff_phi * C2 * tan(beta) + (1 - abs(cos_diff_phi)) * C3 * tan((alpha + beta) / 2);
+  
+  float L2 = 0.17 * sigma2 / (sigma2 + 0.13) * (1 - cos_diff_phi * pow(beta_1, 2));
+  
+  return max(0, (L1 + L2) * cos_theta_i);
+}
+
+// Calculates the shading by planetary rings. This is done in 3 steps:
+// 1. Calculate the intersection between a ray from the fragment to the Sun and the ring plane.
+// 2. If an intersection exists check if it falls within the ring.
+// 3. If it falls within the ring, we get the brightness from the ring texture.
+//
+//                 o o o                   \ /
+//             o           o             -- O --
+//           o               o             / \
+// -------  o                 o  -------
+//           o               o
+//             o           o
+//                 o o o
+//
+float getRingShadow() {
+  // Bodies without a ring have both radii set to zero.
+  if (vRingRadii.y > 0.0) {
+    // The up direction of the ring plane.
+    vec3 ringNormal = normalize(vNorth);
+
+    // The normalized direction of the sun.
+    vec3 sunNormal = normalize(vSunDirection);
+
+    // If the ray is parallel to the ring, we don't draw a shadow.
+    float sunAngle = dot(ringNormal, sunNormal);
+    if (sunAngle == 0) {
+      return 1.0;
+    }
+
+    // The distance along the ray from the fragment to the intersection.
+    float t = (dot(ringNormal, vCenter) - dot(ringNormal, vPosition)) / dot(ringNormal, sunNormal);
+
+    // If the distance is negative, the ray intersects the ring away from the Sun.
+    if (t < 0.0) {
+      return 1.0;
+    }
+
+    // The exact point of intersection with the ring plane.
+    vec3 intersect = vPosition + (sunNormal * t);
+
+    // The distance from the bodies center. If it is outside the ring radii, we don't have a shadow.
+    float dist = length(vCenter - intersect);
+    if (dist < vRingRadii.x || dist > vRingRadii.y) {
+      return 1.0;
+    }
+
+    // Convert the distance to the texture coordinate.
+    float texPosition = (dist - vRingRadii.x) / (vRingRadii.y - vRingRadii.x);
+    return 1.0 - texture(uRingTexture, vec2(texPosition, 0.5)).a;
+  }
+
+  return 1.0;
+}
+
+void main() {
+    oColor = texture(uSurfaceTexture, vTexCoords).rgb;
+
+    #ifdef ENABLE_HDR
+      // Make the amount of ambient brightness perceptually linear in HDR mode.
+      float ambient = pow(vAmbientBrightness, E);
+      oColor = SRGBtoLINEAR(oColor) * vSunIlluminance / PI;
+    #else
+      float ambient = vAmbientBrightness;
+      oColor = oColor * vSunIlluminance;
+    #endif
+
+    #ifdef ENABLE_LIGHTING
+      vec3 light = getRingShadow() * getEclipseShadow(vPosition) * orenNayar(normalize(vNormal), normalize(vSunDirection), -normalize(vPosition));
+      oColor = mix(oColor * light, oColor, ambient);
+    #endif
+}
+)";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* BodyRenderer::POINT_VERT = R"(
+BODY_BUFFER_SNIPPET
+
+// The number of pixels per unit of projected size at a distance of one.
+uniform float uPixelScale;
+
+// outputs
+flat out float vSunIlluminance;
+flat out float vAmbientBrightness;
+flat out float vPhase;
+flat out float vCoverage;
+
+const float PI = 3.141592654;
+
+void main() {
+  Body body = uBodies[uBaseInstance + gl_InstanceID];
+
+  vec3  center = (body.matModel * vec4(0.0, 0.0, 0.0, 1.0)).xyz;
+  float radius = length((body.matModel * vec4(max(body.radii.x, max(body.radii.y, body.radii.z)),
+                 0.0, 0.0, 0.0)).xyz);
+
+  vec4 viewPos = uMatView * vec4(center, 1.0);
+  gl_Position  = uMatProjection * viewPos;
+
+  // The point covers at least one pixel. The brightness is scaled by the fraction of the point
+  // which would actually be covered by the body.
+  float pixelRadius = radius / max(-viewPos.z, radius) * uPixelScale;
+  gl_PointSize      = max(1.0, ceil(2.0 * pixelRadius));
+  vCoverage         = min(1.0, PI * pixelRadius * pixelRadius / (gl_PointSize * gl_PointSize));
+
+  // The fraction of the visible disc which is illuminated by the Sun.
+  vec3 sunDirection = normalize((body.matModel * vec4(body.sun.xyz, 0.0)).xyz);
+  vPhase            = 0.5 + 0.5 * dot(sunDirection, -normalize(center));
+
+  vSunIlluminance    = body.sun.w;
+  vAmbientBrightness = body.params.z;
+}
+)";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* BodyRenderer::POINT_FRAG = R"(
+uniform sampler2D uSurfaceTexture;
+
+// inputs
+flat in float vSunIlluminance;
+flat in float vAmbientBrightness;
+flat in float vPhase;
+flat in float vCoverage;
+
+// outputs
+layout(location = 0) out vec3 oColor;
+
+const float PI = 3.141592654;
+const float E  = 2.718281828;
+
+vec3 SRGBtoLINEAR(vec3 srgbIn) {
+  vec3 bLess = step(vec3(0.04045),srgbIn);
+  return mix( srgbIn/vec3(12.92), pow((srgbIn+vec3(0.055))/vec3(1.055),vec3(2.4)), bLess );
+}
+
+void main() {
+    // The last mipmap level contains the average color of the surface.
+    oColor = textureLod(uSurfaceTexture, vec2(0.5), 100.0).rgb;
+
+    #ifdef ENABLE_HDR
+      float ambient = pow(vAmbientBrightness, E);
+      oColor = SRGBtoLINEAR(oColor) * vSunIlluminance / PI;
+    #else
+      float ambient = vAmbientBrightness;
+      oColor = oColor * vSunIlluminance;
+    #endif
+
+    #ifdef ENABLE_LIGHTING
+      oColor = mix(oColor * vPhase, oColor, ambient);
+    #endif
+
+    oColor *= vCoverage;
+}
+)";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BodyRenderer::BodyRenderer(std::shared_ptr<cs::core::Settings> settings,
+    std::shared_ptr<cs::core::SolarSystem>                     solarSystem)
+    : mSettings(std::move(settings))
+    , mSolarSystem(std::move(solarSystem))
+    , mEclipseShadowReceiver(mSettings, mSolarSystem, false) {
+
+  // For rendering the sphere, we create a 2D-grid which is warped into a sphere in the vertex
+  // shader. The vertex positions are directly used as texture coordinates.
+  std::vector<float>    vertices(GRID_RESOLUTION_X * GRID_RESOLUTION_Y * 2);
+  std::vector<unsigned> indices((GRID_RESOLUTION_X - 1) * (2 + 2 * GRID_RESOLUTION_Y));
+
+  for (uint32_t x = 0; x < GRID_RESOLUTION_X; ++x) {
+    for (uint32_t y = 0; y < GRID_RESOLUTION_Y; ++y) {
+      vertices[(x * GRID_RESOLUTION_Y + y) * 2 + 0] = 1.F / (GRID_RESOLUTION_X - 1) * x;
+      vertices[(x * GRID_RESOLUTION_Y + y) * 2 + 1] = 1.F / (GRID_RESOLUTION_Y - 1) * y;
+    }
+  }
+
+  uint32_t index = 0;
+
+  for (uint32_t x = 0; x < GRID_RESOLUTION_X - 1; ++x) {
+    indices[index++] = x * GRID_RESOLUTION_Y;
+    for (uint32_t y = 0; y < GRID_RESOLUTION_Y; ++y) {
+      indices[index++] = x * GRID_RESOLUTION_Y + y;
+      indices[index++] = (x + 1) * GRID_RESOLUTION_Y + y;
+    }
+    indices[index] = indices[index - 1];
+    ++index;
+  }
+
+  mSphereVAO.Bind();
+
+  mSphereVBO.Bind(GL_ARRAY_BUFFER);
+  mSphereVBO.BufferData(vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+  mSphereIBO.Bind(GL_ELEMENT_ARRAY_BUFFER);
+  mSphereIBO.BufferData(indices.size() * sizeof(unsigned), indices.data(), GL_STATIC_DRAW);
+
+  mSphereVAO.EnableAttributeArray(0);
+  mSphereVAO.SpecifyAttributeArrayFloat(
+      0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0, &mSphereVBO);
+
+  mSphereVAO.Release();
+  mSphereIBO.Release();
+  mSphereVBO.Release();
+
+  // The per-body parameters are uploaded to this buffer each frame.
+  glGenBuffers(1, &mBodyBuffer);
+
+  // Recreate the shaders if lighting or HDR rendering mode are toggled.
+  mEnableLightingConnection = mSettings->mGraphics.pEnableLighting.connect(
+      [this](bool /*enabled*/) { mShaderDirty = true; });
+  mEnableHDRConnection =
+      mSettings->mGraphics.pEnableHDR.connect([this](bool /*enabled*/) { mShaderDirty = true; });
+
+  // Add to scenegraph.
+  VistaSceneGraph* pSG = GetVistaSystem()->GetGraphicsManager()->GetSceneGraph();
+  mGLNode.reset(pSG->NewOpenGLNode(pSG->GetRoot(), this));
+  VistaOpenSGMaterialTools::SetSortKeyOnSubtree(
+      mGLNode.get(), static_cast<int>(cs::utils::DrawOrder::ePlanets));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BodyRenderer::~BodyRenderer() {
+  mSettings->mGraphics.pEnableLighting.disconnect(mEnableLightingConnection);
+  mSettings->mGraphics.pEnableHDR.disconnect(mEnableHDRConnection);
+
+  VistaSceneGraph* pSG = GetVistaSystem()->GetGraphicsManager()->GetSceneGraph();
+  pSG->GetRoot()->DisconnectChild(mGLNode.get());
+
+  glDeleteBuffers(1, &mBodyBuffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void BodyRenderer::addBody(SimpleBody* body) {
+  mBodies.push_back(body);
+
+  // If the shader has not been created yet, this will be done in createShaders().
+  if (mSphereShader) {
+    body->getEclipseShadowReceiver().init(mSphereShader->getProgram(), ECLIPSE_TEXTURE_OFFSET);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void BodyRenderer::removeBody(SimpleBody* body) {
+  mBodies.erase(std::remove(mBodies.begin(), mBodies.end(), body), mBodies.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<cs::graphics::AsyncTexture> BodyRenderer::getTexture(std::string const& fileName) {
+  auto& cached = mTextures[fileName];
+
+  auto texture = cached.lock();
+  if (!texture) {
+    texture = cs::graphics::TextureLoader::loadFromFileAsync(fileName);
+    cached  = texture;
+  }
+
+  return texture;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void BodyRenderer::setPointSpriteThreshold(float pixels) {
+  mPointSpriteThreshold = pixels;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void BodyRenderer::createShaders() {
+  std::string defines = "#version 430\n";
+
+  if (mSettings->mGraphics.pEnableHDR.get()) {
+    defines += "#define ENABLE_HDR\n";
+  }
+
+  if (mSettings->mGraphics.pEnableLighting.get()) {
+    defines += "#define ENABLE_LIGHTING\n";
+  }
+
+  std::string vert = defines + SPHERE_VERT;
+  std::string frag = defines + SPHERE_FRAG;
+
+  cs::utils::replaceString(vert, "BODY_BUFFER_SNIPPET", BODY_BUFFER_SNIPPET);
+  cs::utils::replaceString(
+      frag, "ECLIPSE_SHADER_SNIPPET", mEclipseShadowReceiver.getShaderSnippet());
+
+  mSphereShader = cs::graphics::ShaderCache::get().getShader(vert, frag);
+
+  mSphereUniforms.baseInstance     = mSphereShader->getUniformLocation("uBaseInstance");
+  mSphereUniforms.viewMatrix       = mSphereShader->getUniformLocation("uMatView");
+  mSphereUniforms.projectionMatrix = mSphereShader->getUniformLocation("uMatProjection");
+  mSphereUniforms.surfaceTexture   = mSphereShader->getUniformLocation("uSurfaceTexture");
+  mSphereUniforms.ringTexture      = mSphereShader->getUniformLocation("uRingTexture");
+  mSphereUniforms.eclipseNumOccluders =
+      mSphereShader->getUniformLocation("uEclipseNumOccluders");
+
+  // All bodies share the same shader. We bind the eclipse shadow maps to texture unit 2 and above.
+  for (auto* body : mBodies) {
+    body->getEclipseShadowReceiver().init(mSphereShader->getProgram(), ECLIPSE_TEXTURE_OFFSET);
+  }
+
+  vert = defines + POINT_VERT;
+  frag = defines + POINT_FRAG;
+
+  cs::utils::replaceString(vert, "BODY_BUFFER_SNIPPET", BODY_BUFFER_SNIPPET);
+
+  mPointShader = cs::graphics::ShaderCache::get().getShader(vert, frag);
+
+  mPointUniforms.baseInstance     = mPointShader->getUniformLocation("uBaseInstance");
+  mPointUniforms.viewMatrix       = mPointShader->getUniformLocation("uMatView");
+  mPointUniforms.projectionMatrix = mPointShader->getUniformLocation("uMatProjection");
+  mPointUniforms.surfaceTexture   = mPointShader->getUniformLocation("uSurfaceTexture");
+  mPointUniforms.pixelScale       = mPointShader->getUniformLocation("uPixelScale");
+
+  mShaderDirty = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool BodyRenderer::Do() {
+  cs::utils::FrameStats::ScopedTimer timer("Draw Simple Bodies");
+
+  if (mShaderDirty || mEclipseShadowReceiver.needsRecompilation()) {
+    createShaders();
+  }
+
+  // Get view and projection matrices.
+  std::array<GLfloat, 16> glMatV{};
+  std::array<GLfloat, 16> glMatP{};
+  glGetFloatv(GL_MODELVIEW_MATRIX, glMatV.data());
+  glGetFloatv(GL_PROJECTION_MATRIX, glMatP.data());
+  auto matP = glm::make_mat4x4(glMatP.data());
+
+  // This converts the ratio of a radius and a distance to a radius in pixels.
+  std::array<GLint, 4> viewport{};
+  glGetIntegerv(GL_VIEWPORT, viewport.data());
+  float pixelScale = 0.5F * static_cast<float>(viewport[3]) * matP[1][1];
+
+  // First, we gather the parameters of all visible bodies.
+  std::vector<DrawItem> items;
+  items.reserve(mBodies.size());
+
+  for (auto* body : mBodies) {
+    auto parent = mSolarSystem->getObject(body->getObjectName());
+
+    if (!parent || !parent->getIsBodyVisible()) {
+      continue;
+    }
+
+    auto const& settings = body->getSettings();
+
+    glm::vec3 sunDirection(1, 0, 0);
+    float     sunIlluminance(1.F);
+    float     ambientBrightness(mSettings->mGraphics.pAmbientBrightness.get());
+    auto      transform = parent->getObserverRelativeTransform();
+
+    if (parent == mSolarSystem->getSun()) {
+      // If the SimpleBody is actually the sun, we have to calculate the lighting differently.
+      if (mSettings->mGraphics.pEnableHDR.get()) {
+
+        // The variable is called illuminance, for the sun it contains actually luminance values.
+        sunIlluminance = static_cast<float>(mSolarSystem->getSunLuminance());
+
+        // For planets, this illuminance is divided by pi, so we have to premultiply it for the sun.
+        sunIlluminance *= glm::pi<float>();
+      }
+
+      ambientBrightness = 1.0F;
+
+    } else {
+      // For all other bodies we can use the utility methods from the SolarSystem.
+      if (mSettings->mGraphics.pEnableHDR.get()) {
+        sunIlluminance = static_cast<float>(mSolarSystem->getSunIlluminance(transform[3]));
+      }
+
+      sunDirection =
+          glm::inverse(transform) * glm::dvec4(mSolarSystem->getSunDirection(transform[3]), 0.0);
+    }
+
+    DrawItem item{};
+    item.mBody              = body;
+    item.mTexture           = body->getTexture()->get();
+    item.mData.mModelMatrix = glm::mat4(transform);
+    item.mData.mRadii       = glm::vec4(parent->getRadii(), 0.F);
+    item.mData.mSun         = glm::vec4(sunDirection, sunIlluminance);
+    item.mData.mParams      = glm::vec4(0.F, 0.F, ambientBrightness, 0.F);
+
+    // Textures where the prime meridian is not in the center are shifted by half a revolution.
+    if (!settings.mPrimeMeridianInCenter.get()) {
+      item.mData.mRadii.w = 0.5F;
+    }
+
+    if (settings.mRing) {
+      double scale         = parent->getScale() / mSolarSystem->getObserver().getScale();
+      item.mData.mParams.x = static_cast<float>(settings.mRing->mInnerRadius * scale);
+      item.mData.mParams.y = static_cast<float>(settings.mRing->mOuterRadius * scale);
+    }
+
+    // Decide how the body should be drawn based on its projected size.
+    auto   radii     = parent->getRadii();
+    double maxRadius = std::max(radii.x, std::max(radii.y, radii.z));
+    double radius    = glm::length(transform * glm::dvec4(maxRadius, 0.0, 0.0, 0.0));
+    double distance  = glm::length(glm::dvec3(transform[3]));
+
+    if (distance > radius && radius / distance * pixelScale < mPointSpriteThreshold) {
+      item.mMode = DrawMode::ePoint;
+    } else if (settings.mRing || body->getEclipseShadowReceiver().hasOccluders()) {
+      item.mMode = DrawMode::eSingleSphere;
+    } else {
+      item.mMode = DrawMode::eBatchedSphere;
+    }
+
+    items.push_back(item);
+  }
+
+  if (items.empty()) {
+    return true;
+  }
+
+  // Then we sort the bodies so that all bodies which can be drawn together are next to each other.
+  std::sort(items.begin(), items.end(), [](DrawItem const& a, DrawItem const& b) {
+    return std::tie(a.mMode, a.mTexture) < std::tie(b.mMode, b.mTexture);
+  });
+
+  std::vector<BodyData> data;
+  data.reserve(items.size());
+  for (auto const& item : items) {
+    data.push_back(item.mData);
+  }
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, mBodyBuffer);
+  glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(data.size() * sizeof(BodyData)),
+      data.data(), GL_STREAM_DRAW);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mBodyBuffer);
+
+  // Now we draw ranges of items which share the same mode and texture. Individually drawn spheres
+  // always form a range of their own.
+  size_t rangeStart = 0;
+  while (rangeStart < items.size()) {
+    auto const& first    = items[rangeStart];
+    size_t      rangeEnd = rangeStart + 1;
+
+    if (first.mMode != DrawMode::eSingleSphere) {
+      while (rangeEnd < items.size() && items[rangeEnd].mMode == first.mMode &&
+             items[rangeEnd].mTexture == first.mTexture) {
+        ++rangeEnd;
+      }
+    }
+
+    auto count = static_cast<GLsizei>(rangeEnd - rangeStart);
+
+    // Set the texture wrapping on the x-axis to repeat, so we can easily deal with textures, where
+    // the prime meridian is not in the center. The textures may be shared with other plugins, so we
+    // restore the previous wrapping mode afterwards.
+    GLint wrapMode{};
+    first.mTexture->Bind(GL_TEXTURE0);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &wrapMode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+
+    if (first.mMode == DrawMode::ePoint) {
+      mPointShader->bind();
+      mPointShader->setUniform(mPointUniforms.baseInstance, static_cast<int>(rangeStart));
+      mPointShader->setUniform(mPointUniforms.surfaceTexture, 0);
+      mPointShader->setUniform(mPointUniforms.pixelScale, pixelScale);
+      glUniformMatrix4fv(mPointUniforms.viewMatrix, 1, GL_FALSE, glMatV.data());
+      glUniformMatrix4fv(mPointUniforms.projectionMatrix, 1, GL_FALSE, glMatP.data());
+
+      glEnable(GL_PROGRAM_POINT_SIZE);
+      mPointVAO.Bind();
+      glDrawArraysInstanced(GL_POINTS, 0, 1, count);
+      mPointVAO.Release();
+      glDisable(GL_PROGRAM_POINT_SIZE);
+
+      mPointShader->release();
+
+    } else {
+      mSphereShader->bind();
+      mSphereShader->setUniform(mSphereUniforms.baseInstance, static_cast<int>(rangeStart));
+      mSphereShader->setUniform(mSphereUniforms.surfaceTexture, 0);
+      mSphereShader->setUniform(mSphereUniforms.ringTexture, 1);
+      glUniformMatrix4fv(mSphereUniforms.viewMatrix, 1, GL_FALSE, glMatV.data());
+      glUniformMatrix4fv(mSphereUniforms.projectionMatrix, 1, GL_FALSE, glMatP.data());
+
+      auto const& ring    = first.mBody->getRingTexture();
+      auto&       eclipse = first.mBody->getEclipseShadowReceiver();
+
+      if (first.mMode == DrawMode::eSingleSphere) {
+        if (ring) {
+          ring->get()->Bind(GL_TEXTURE1);
+        }
+
+        eclipse.preRender();
+      } else {
+        glUniform1i(static_cast<GLint>(mSphereUniforms.eclipseNumOccluders), 0);
+      }
+
+      mSphereVAO.Bind();
+      glDrawElementsInstanced(GL_TRIANGLE_STRIP,
+          (GRID_RESOLUTION_X - 1) * (2 + 2 * GRID_RESOLUTION_Y), GL_UNSIGNED_INT, nullptr, count);
+      mSphereVAO.Release();
+
+      if (first.mMode == DrawMode::eSingleSphere) {
+        eclipse.postRender();
+
+        if (ring) {
+          ring->get()->Unbind(GL_TEXTURE1);
+        }
+      }
+
+      mSphereShader->release();
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
+    first.mTexture->Unbind(GL_TEXTURE0);
+
+    rangeStart = rangeEnd;
+  }
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool BodyRenderer::GetBoundingBox(VistaBoundingBox& /*bb*/) {
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace csp::simplebodies
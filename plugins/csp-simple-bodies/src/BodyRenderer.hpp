@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CSP_SIMPLE_BODIES_BODY_RENDERER_HPP
+#define CSP_SIMPLE_BODIES_BODY_RENDERER_HPP
+
+#include "../../../src/cs-core/EclipseShadowReceiver.hpp"
+
+#include <VistaKernel/GraphicsManager/VistaOpenGLDraw.h>
+#include <VistaKernel/GraphicsManager/VistaOpenGLNode.h>
+#include <VistaOGLExt/VistaBufferObject.h>
+#include <VistaOGLExt/VistaVertexArrayObject.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cs::core {
+class Settings;
+class SolarSystem;
+} // namespace cs::core
+
+namespace cs::graphics {
+class AsyncTexture;
+class ShaderProgram;
+} // namespace cs::graphics
+
+namespace csp::simplebodies {
+
+class SimpleBody;
+
+/// The BodyRenderer draws all SimpleBodies of the plugin. All bodies share a single sphere mesh.
+/// The per-body parameters (transformation, radii, lighting) are written to a shader storage buffer
+/// each frame, so that all bodies which use the same surface texture can be drawn with a single
+/// instanced draw call. Only bodies which have a ring or which are currently affected by an eclipse
+/// are drawn individually.
+/// Bodies which cover less than a configurable number of pixels on screen are drawn as point
+/// sprites instead of spheres. Their color is the average color of their surface texture.
+class BodyRenderer : public IVistaOpenGLDraw {
+ public:
+  BodyRenderer(std::shared_ptr<cs::core::Settings> settings,
+      std::shared_ptr<cs::core::SolarSystem>       solarSystem);
+
+  BodyRenderer(BodyRenderer const& other) = delete;
+  BodyRenderer(BodyRenderer&& other)      = delete;
+
+  BodyRenderer& operator=(BodyRenderer const& other) = delete;
+  BodyRenderer& operator=(BodyRenderer&& other) = delete;
+
+  ~BodyRenderer() override;
+
+  /// SimpleBodies register themselves here upon construction and unregister upon destruction.
+  void addBody(SimpleBody* body);
+  void removeBody(SimpleBody* body);
+
+  /// Bodies which use the same texture file share one texture. This is required for drawing them
+  /// with one instanced draw call.
+  std::shared_ptr<cs::graphics::AsyncTexture> getTexture(std::string const& fileName);
+
+  /// Bodies with a projected radius of less than this number of pixels are drawn as point sprites.
+  void setPointSpriteThreshold(float pixels);
+
+  /// Interface implementation of IVistaOpenGLDraw.
+  bool Do() override;
+  bool GetBoundingBox(VistaBoundingBox& bb) override;
+
+ private:
+  void createShaders();
+
+  std::shared_ptr<cs::core::Settings>    mSettings;
+  std::shared_ptr<cs::core::SolarSystem> mSolarSystem;
+
+  std::unique_ptr<VistaOpenGLNode> mGLNode;
+
+  std::vector<SimpleBody*>                                          mBodies;
+  std::map<std::string, std::weak_ptr<cs::graphics::AsyncTexture>> mTextures;
+
+  VistaVertexArrayObject mSphereVAO;
+  VistaBufferObject      mSphereVBO;
+  VistaBufferObject      mSphereIBO;
+  VistaVertexArrayObject mPointVAO;
+  uint32_t               mBodyBuffer = 0;
+
+  std::shared_ptr<cs::graphics::ShaderProgram> mSphereShader;
+  std::shared_ptr<cs::graphics::ShaderProgram> mPointShader;
+
+  // This is only used for generating the shader snippet. The bodies have their own receivers.
+  cs::core::EclipseShadowReceiver mEclipseShadowReceiver;
+
+  float mPointSpriteThreshold = 2.F;
+  bool  mShaderDirty          = true;
+
+  int mEnableLightingConnection = -1;
+  int mEnableHDRConnection      = -1;
+
+  struct {
+    uint32_t baseInstance        = 0;
+    uint32_t viewMatrix          = 0;
+    uint32_t projectionMatrix    = 0;
+    uint32_t surfaceTexture      = 0;
+    uint32_t ringTexture         = 0;
+    uint32_t eclipseNumOccluders = 0;
+  } mSphereUniforms;
+
+  struct {
+    uint32_t baseInstance     = 0;
+    uint32_t viewMatrix       = 0;
+    uint32_t projectionMatrix = 0;
+    uint32_t surfaceTexture   = 0;
+    uint32_t pixelScale       = 0;
+  } mPointUniforms;
+
+  static const char* SPHERE_VERT;
+  static const char* SPHERE_FRAG;
+  static const char* POINT_VERT;
+  static const char* POINT_FRAG;
+};
+
+} // namespace csp::simplebodies
+
+#endif // CSP_SIMPLE_BODIES_BODY_RENDERER_HPP
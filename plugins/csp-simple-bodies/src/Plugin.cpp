@@ -12,6 +12,7 @@
 #include "../../../src/cs-core/SolarSystem.hpp"
 #include "../../../src/cs-utils/logger.hpp"
 #include "../../../src/cs-utils/utils.hpp"
+#include "BodyRenderer.hpp"
 #include "SimpleBody.hpp"
 #include "logger.hpp"
 
@@ -63,10 +64,12 @@ void to_json(nlohmann::json& j, Plugin::Settings::SimpleBody const& o) {
 
 void from_json(nlohmann::json const& j, Plugin::Settings& o) {
   cs::core::Settings::deserialize(j, "bodies", o.mSimpleBodies);
+  cs::core::Settings::deserialize(j, "pointSpriteThreshold", o.mPointSpriteThreshold);
 }
 
 void to_json(nlohmann::json& j, Plugin::Settings const& o) {
   cs::core::Settings::serialize(j, "bodies", o.mSimpleBodies);
+  cs::core::Settings::serialize(j, "pointSpriteThreshold", o.mPointSpriteThreshold);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -78,6 +81,9 @@ void Plugin::init() {
   mOnLoadConnection = mAllSettings->onLoad().connect([this]() { onLoad(); });
   mOnSaveConnection = mAllSettings->onSave().connect([this]() { onSave(); });
 
+  // All bodies are drawn by one renderer.
+  mRenderer = std::make_shared<BodyRenderer>(mAllSettings, mSolarSystem);
+
   // Load settings.
   onLoad();
 
@@ -96,6 +102,9 @@ void Plugin::deInit() {
     unregisterBody(name);
   }
 
+  mSimpleBodies.clear();
+  mRenderer.reset();
+
   mAllSettings->onLoad().disconnect(mOnLoadConnection);
   mAllSettings->onSave().disconnect(mOnSaveConnection);
 
@@ -116,6 +125,8 @@ void Plugin::onLoad() {
   // Read settings from JSON.
   from_json(mAllSettings->mPlugins.at("csp-simple-bodies"), mPluginSettings);
 
+  mRenderer->setPointSpriteThreshold(mPluginSettings.mPointSpriteThreshold.get());
+
   // First try to re-configure existing simpleBodies. We assume that they are similar if they have
   // the same name in the settings (which means they are attached to an anchor with the same name).
   auto simpleBody = mSimpleBodies.begin();
@@ -140,7 +151,7 @@ void Plugin::onLoad() {
       continue;
     }
 
-    auto simpleBody = std::make_shared<SimpleBody>(mAllSettings, mSolarSystem);
+    auto simpleBody = std::make_shared<SimpleBody>(mAllSettings, mSolarSystem, mRenderer);
     simpleBody->setObjectName(settings.first);
     simpleBody->configure(settings.second);
 
@@ -18,6 +18,7 @@
 namespace csp::simplebodies {
 
 class SimpleBody;
+class BodyRenderer;
 
 /// This plugin provides the rendering of planets as spheres with a texture. Despite its name it
 /// can also render moons :P. It can be configured via the applications config file. See README.md
@@ -44,6 +45,9 @@ class Plugin : public cs::core::PluginBase {
     };
 
     std::map<std::string, SimpleBody> mSimpleBodies;
+
+    /// Bodies whose projected radius is smaller than this number of pixels are drawn as points.
+    cs::utils::DefaultProperty<float> mPointSpriteThreshold{2.F};
   };
 
   void init() override;
@@ -56,6 +60,7 @@ class Plugin : public cs::core::PluginBase {
   void unregisterBody(std::string const& name);
 
   Settings                                           mPluginSettings;
+  std::shared_ptr<BodyRenderer>                      mRenderer;
   std::map<std::string, std::shared_ptr<SimpleBody>> mSimpleBodies;
 
   int mOnLoadConnection = -1;
@@ -77,6 +77,44 @@ void to_json(nlohmann::json& j, Plugin::Settings const& o) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+std::map<Stars::CatalogType, std::string> getCatalogs(Plugin::Settings const& settings) {
+  std::map<Stars::CatalogType, std::string> catalogs;
+
+  if (settings.mHipparcosCatalog) {
+    catalogs[Stars::CatalogType::eHipparcos] = *settings.mHipparcosCatalog;
+  }
+
+  if (settings.mTychoCatalog) {
+    catalogs[Stars::CatalogType::eTycho] = *settings.mTychoCatalog;
+  }
+
+  if (settings.mTycho2Catalog) {
+    catalogs[Stars::CatalogType::eTycho2] = *settings.mTycho2Catalog;
+  }
+
+  return catalogs;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Plugin::prepare() {
+
+  // Parsing the star catalogs is by far the most expensive part of the initialization. As it does
+  // not require OpenGL, it is done here on a worker thread.
+  Settings settings;
+  from_json(mAllSettings->mPlugins.at("csp-stars"), settings);
+
+  mPreparedCatalogs = getCatalogs(settings);
+  mPreparedStars =
+      Stars::loadStars(mPreparedCatalogs, settings.mCacheFile.value_or("star_cache.dat"));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void Plugin::init() {
 
   logger().info("Loading plugin...");
@@ -84,8 +122,12 @@ void Plugin::init() {
   mOnLoadConnection = mAllSettings->onLoad().connect([this]() { onLoad(); });
   mOnSaveConnection = mAllSettings->onSave().connect([this]() { onSave(); });
 
-  // Create the Stars object based on the settings.
+  // Create the Stars object based on the settings. The catalogs have been read in prepare()
+  // already, so onLoad() will not read them again.
   mStars = std::make_unique<Stars>();
+  if (!mPreparedCatalogs.empty()) {
+    mStars->setStars(std::move(mPreparedCatalogs), std::move(mPreparedStars));
+  }
 
   // Add the stars to the scenegraph.
   mStarsTransform.reset(mSceneGraph->NewTransformNode(mSceneGraph->GetRoot()));
@@ -265,21 +307,7 @@ void Plugin::onLoad() {
 
   mStars->setCacheFile(mPluginSettings.mCacheFile.value_or("star_cache.dat"));
 
-  std::map<Stars::CatalogType, std::string> catalogs;
-
-  if (mPluginSettings.mHipparcosCatalog) {
-    catalogs[Stars::CatalogType::eHipparcos] = *mPluginSettings.mHipparcosCatalog;
-  }
-
-  if (mPluginSettings.mTychoCatalog) {
-    catalogs[Stars::CatalogType::eTycho] = *mPluginSettings.mTychoCatalog;
-  }
-
-  if (mPluginSettings.mTycho2Catalog) {
-    catalogs[Stars::CatalogType::eTycho2] = *mPluginSettings.mTycho2Catalog;
-  }
-
-  mStars->setCatalogs(catalogs);
+  mStars->setCatalogs(getCatalogs(mPluginSettings));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,7 @@ class Plugin : public cs::core::PluginBase {
     cs::utils::DefaultProperty<glm::vec2>       mMagnitudeRange{glm::vec2(-5.F, 15.F)};
   };
 
+  void prepare() override;
   void init() override;
   void deInit() override;
 
@@ -56,6 +57,10 @@ class Plugin : public cs::core::PluginBase {
   std::unique_ptr<VistaTransformNode> mStarsTransform;
   std::unique_ptr<VistaOpenGLNode>    mStarsNode;
 
+  // The star catalogs are read in prepare() on a worker thread and handed to mStars in init().
+  std::map<Stars::CatalogType, std::string> mPreparedCatalogs;
+  std::vector<Stars::Star>                  mPreparedStars;
+
   int mEnableHDRConnection = -1;
   int mOnLoadConnection    = -1;
   int mOnSaveConnection    = -1;
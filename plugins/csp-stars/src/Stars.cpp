@@ -9,6 +9,8 @@
 
 #include "logger.hpp"
 
+#include "../../../src/cs-graphics/ShaderCache.hpp"
+#include "../../../src/cs-graphics/ShaderProgram.hpp"
 #include "../../../src/cs-graphics/TextureLoader.hpp"
 #include "../../../src/cs-utils/FrameStats.hpp"
 
@@ -22,7 +24,6 @@
 #include <VistaKernel/GraphicsManager/VistaOpenGLNode.h>
 #include <VistaKernel/GraphicsManager/VistaSceneGraph.h>
 #include <VistaOGLExt/VistaBufferObject.h>
-#include <VistaOGLExt/VistaGLSLShader.h>
 #include <VistaOGLExt/VistaOGLUtils.h>
 #include <VistaOGLExt/VistaTexture.h>
 #include <VistaOGLExt/VistaVertexArrayObject.h>
@@ -86,47 +87,63 @@ const int Stars::cCacheVersion = 3;
 
 void Stars::setCatalogs(std::map<Stars::CatalogType, std::string> catalogs) {
   if (mCatalogs != catalogs) {
+    auto stars = loadStars(catalogs, mCacheFile);
+    setStars(std::move(catalogs), std::move(stars));
+  }
+}
 
-    mCatalogs = std::move(catalogs);
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    // Clear stars first.
-    mStars.clear();
+std::vector<Stars::Star> Stars::loadStars(
+    std::map<CatalogType, std::string> const& catalogs, std::string const& cacheFile) {
 
-    // Read star catalogs.
-    if (!readStarCache(mCacheFile)) {
-      std::map<CatalogType, std::string>::const_iterator it;
+  std::vector<Star> stars;
 
-      it = mCatalogs.find(CatalogType::eHipparcos);
-      if (it != mCatalogs.end()) {
-        readStarsFromCatalog(it->first, it->second);
-      }
+  // Read star catalogs.
+  if (!readStarCache(cacheFile, catalogs, stars)) {
+    stars.clear();
 
-      it = mCatalogs.find(CatalogType::eTycho);
-      if (it != mCatalogs.end()) {
-        readStarsFromCatalog(it->first, it->second);
-      }
+    std::map<CatalogType, std::string>::const_iterator it;
 
-      it = mCatalogs.find(CatalogType::eTycho2);
-      if (it != mCatalogs.end()) {
-        // do not load tycho and tycho 2
-        if (mCatalogs.find(CatalogType::eTycho) == mCatalogs.end()) {
-          readStarsFromCatalog(it->first, it->second);
-        } else {
-          logger().warn("Failed to load Tycho2 catalog: Tycho already loaded!");
-        }
-      }
+    it = catalogs.find(CatalogType::eHipparcos);
+    if (it != catalogs.end()) {
+      readStarsFromCatalog(it->first, it->second, catalogs, stars);
+    }
+
+    it = catalogs.find(CatalogType::eTycho);
+    if (it != catalogs.end()) {
+      readStarsFromCatalog(it->first, it->second, catalogs, stars);
+    }
 
-      if (!mStars.empty()) {
-        writeStarCache(mCacheFile);
+    it = catalogs.find(CatalogType::eTycho2);
+    if (it != catalogs.end()) {
+      // do not load tycho and tycho 2
+      if (catalogs.find(CatalogType::eTycho) == catalogs.end()) {
+        readStarsFromCatalog(it->first, it->second, catalogs, stars);
       } else {
-        logger().warn("Loaded no stars! Stars will not work properly.");
+        logger().warn("Failed to load Tycho2 catalog: Tycho already loaded!");
       }
     }
 
-    // Create buffers,
-    buildStarVAO();
-    buildBackgroundVAO();
+    if (!stars.empty()) {
+      writeStarCache(cacheFile, catalogs, stars);
+    } else {
+      logger().warn("Loaded no stars! Stars will not work properly.");
+    }
   }
+
+  return stars;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Stars::setStars(std::map<CatalogType, std::string> catalogs, std::vector<Star> stars) {
+  mCatalogs = std::move(catalogs);
+  mStars    = std::move(stars);
+
+  // Create buffers,
+  buildStarVAO();
+  buildBackgroundVAO();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -269,7 +286,7 @@ void Stars::setStarTexture(std::string const& filename) {
     if (filename.empty()) {
       mStarTexture.reset();
     } else {
-      mStarTexture = cs::graphics::TextureLoader::loadFromFile(filename);
+      mStarTexture = cs::graphics::TextureLoader::loadFromFileAsync(filename);
     }
   }
 }
@@ -282,7 +299,7 @@ void Stars::setCelestialGridTexture(std::string const& filename) {
     if (filename.empty()) {
       mCelestialGridTexture.reset();
     } else {
-      mCelestialGridTexture = cs::graphics::TextureLoader::loadFromFile(filename);
+      mCelestialGridTexture = cs::graphics::TextureLoader::loadFromFileAsync(filename);
     }
   }
 }
@@ -295,7 +312,7 @@ void Stars::setStarFiguresTexture(std::string const& filename) {
     if (filename.empty()) {
       mStarFiguresTexture.reset();
     } else {
-      mStarFiguresTexture = cs::graphics::TextureLoader::loadFromFile(filename);
+      mStarFiguresTexture = cs::graphics::TextureLoader::loadFromFileAsync(filename);
     }
   }
 }
@@ -352,49 +369,48 @@ bool Stars::Do() {
       defines += "#define DRAWMODE_SPRITE\n";
     }
 
-    mStarShader = VistaGLSLShader();
+    auto& shaderCache = cs::graphics::ShaderCache::get();
+
     if (mDrawMode == DrawMode::ePoint || mDrawMode == DrawMode::eSmoothPoint) {
-      mStarShader.InitVertexShaderFromString(defines + cStarsSnippets + cStarsVertOnePixel);
-      mStarShader.InitFragmentShaderFromString(defines + cStarsSnippets + cStarsFragOnePixel);
+      mStarShader = shaderCache.getShader(defines + cStarsSnippets + cStarsVertOnePixel,
+          defines + cStarsSnippets + cStarsFragOnePixel);
     } else {
-      mStarShader.InitVertexShaderFromString(defines + cStarsSnippets + cStarsVert);
-      mStarShader.InitGeometryShaderFromString(defines + cStarsSnippets + cStarsGeom);
-      mStarShader.InitFragmentShaderFromString(defines + cStarsSnippets + cStarsFrag);
+      mStarShader = shaderCache.getShader(defines + cStarsSnippets + cStarsVert,
+          defines + cStarsSnippets + cStarsFrag, defines + cStarsSnippets + cStarsGeom);
     }
 
-    mStarShader.Link();
+    mBackgroundShader = shaderCache.getShader(defines + cBackgroundVert, defines + cBackgroundFrag);
 
-    mBackgroundShader = VistaGLSLShader();
-    mBackgroundShader.InitVertexShaderFromString(defines + cBackgroundVert);
-    mBackgroundShader.InitFragmentShaderFromString(defines + cBackgroundFrag);
-    mBackgroundShader.Link();
+    mUniforms.bgInverseMVMatrix  = mBackgroundShader->getUniformLocation("uInvMV");
+    mUniforms.bgInverseMVPMatrix = mBackgroundShader->getUniformLocation("uInvMVP");
+    mUniforms.bgTexture          = mBackgroundShader->getUniformLocation("iTexture");
+    mUniforms.bgColor            = mBackgroundShader->getUniformLocation("cColor");
 
-    mUniforms.bgInverseMVMatrix  = mBackgroundShader.GetUniformLocation("uInvMV");
-    mUniforms.bgInverseMVPMatrix = mBackgroundShader.GetUniformLocation("uInvMVP");
-    mUniforms.bgTexture          = mBackgroundShader.GetUniformLocation("iTexture");
-    mUniforms.bgColor            = mBackgroundShader.GetUniformLocation("cColor");
+    mUniforms.starResolution   = mStarShader->getUniformLocation("uResolution");
+    mUniforms.starTexture      = mStarShader->getUniformLocation("uStarTexture");
+    mUniforms.starMinMagnitude = mStarShader->getUniformLocation("uMinMagnitude");
+    mUniforms.starMaxMagnitude = mStarShader->getUniformLocation("uMaxMagnitude");
+    mUniforms.starSolidAngle   = mStarShader->getUniformLocation("uSolidAngle");
+    mUniforms.starLuminanceMul = mStarShader->getUniformLocation("uLuminanceMultiplicator");
 
-    mUniforms.starResolution   = mStarShader.GetUniformLocation("uResolution");
-    mUniforms.starTexture      = mStarShader.GetUniformLocation("uStarTexture");
-    mUniforms.starMinMagnitude = mStarShader.GetUniformLocation("uMinMagnitude");
-    mUniforms.starMaxMagnitude = mStarShader.GetUniformLocation("uMaxMagnitude");
-    mUniforms.starSolidAngle   = mStarShader.GetUniformLocation("uSolidAngle");
-    mUniforms.starLuminanceMul = mStarShader.GetUniformLocation("uLuminanceMultiplicator");
-
-    mUniforms.starMVMatrix        = mStarShader.GetUniformLocation("uMatMV");
-    mUniforms.starPMatrix         = mStarShader.GetUniformLocation("uMatP");
-    mUniforms.starInverseMVMatrix = mStarShader.GetUniformLocation("uInvMV");
-    mUniforms.starInversePMatrix  = mStarShader.GetUniformLocation("uInvP");
+    mUniforms.starMVMatrix        = mStarShader->getUniformLocation("uMatMV");
+    mUniforms.starPMatrix         = mStarShader->getUniformLocation("uMatP");
+    mUniforms.starInverseMVMatrix = mStarShader->getUniformLocation("uInvMV");
+    mUniforms.starInversePMatrix  = mStarShader->getUniformLocation("uInvP");
 
     mShaderDirty = false;
   }
 
-  // draw background
-  if ((mCelestialGridTexture && mBackgroundColor1[3] != 0.F) ||
-      (mStarFiguresTexture && mBackgroundColor2[3] != 0.F)) {
+  // Draw the background. The textures are only drawn once they have been loaded.
+  bool drawCelestialGrid = mCelestialGridTexture && mCelestialGridTexture->isReady() &&
+                           mBackgroundColor1[3] != 0.F;
+  bool drawStarFigures =
+      mStarFiguresTexture && mStarFiguresTexture->isReady() && mBackgroundColor2[3] != 0.F;
+
+  if (drawCelestialGrid || drawStarFigures) {
     mBackgroundVAO.Bind();
-    mBackgroundShader.Bind();
-    mBackgroundShader.SetUniform(mUniforms.bgTexture, 0);
+    mBackgroundShader->bind();
+    mBackgroundShader->setUniform(mUniforms.bgTexture, 0);
 
     float fadeOut =
         mEnableHDR ? 0.001F * mLuminanceMultiplicator : mLuminanceMultiplicator * sceneBrightness;
@@ -413,29 +429,29 @@ bool Stars::Do() {
     glUniformMatrix4fv(mUniforms.bgInverseMVPMatrix, 1, GL_FALSE, matInverseMVP.GetData());
     glUniformMatrix4fv(mUniforms.bgInverseMVMatrix, 1, GL_FALSE, matInverseMV.GetData());
 
-    if (mCelestialGridTexture && mBackgroundColor1[3] != 0.F) {
-      mBackgroundShader.SetUniform(mUniforms.bgColor, mBackgroundColor1[0], mBackgroundColor1[1],
+    if (drawCelestialGrid) {
+      mBackgroundShader->setUniform(mUniforms.bgColor, mBackgroundColor1[0], mBackgroundColor1[1],
           mBackgroundColor1[2], mBackgroundColor1[3] * fadeOut);
-      mCelestialGridTexture->Bind(GL_TEXTURE0);
+      mCelestialGridTexture->get()->Bind(GL_TEXTURE0);
       glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-      mCelestialGridTexture->Unbind(GL_TEXTURE0);
+      mCelestialGridTexture->get()->Unbind(GL_TEXTURE0);
     }
 
-    if (mStarFiguresTexture && mBackgroundColor2[3] != 0.F) {
-      mBackgroundShader.SetUniform(mUniforms.bgColor, mBackgroundColor2[0], mBackgroundColor2[1],
+    if (drawStarFigures) {
+      mBackgroundShader->setUniform(mUniforms.bgColor, mBackgroundColor2[0], mBackgroundColor2[1],
           mBackgroundColor2[2], mBackgroundColor2[3] * fadeOut);
-      mStarFiguresTexture->Bind(GL_TEXTURE0);
+      mStarFiguresTexture->get()->Bind(GL_TEXTURE0);
       glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-      mStarFiguresTexture->Unbind(GL_TEXTURE0);
+      mStarFiguresTexture->get()->Unbind(GL_TEXTURE0);
     }
 
-    mBackgroundShader.Release();
+    mBackgroundShader->release();
     mBackgroundVAO.Release();
   }
 
   // draw stars
   mStarVAO.Bind();
-  mStarShader.Bind();
+  mStarShader->bind();
 
   if (mDrawMode == DrawMode::ePoint || mDrawMode == DrawMode::eSmoothPoint) {
     glPointSize(0.5F);
@@ -452,18 +468,18 @@ bool Stars::Do() {
   std::array<int, 4> viewport{};
   glGetIntegerv(GL_VIEWPORT, viewport.data());
 
-  mStarShader.SetUniform(mUniforms.starResolution, static_cast<float>(viewport.at(2)),
+  mStarShader->setUniform(mUniforms.starResolution, static_cast<float>(viewport.at(2)),
       static_cast<float>(viewport.at(3)));
 
-  mStarTexture->Bind(GL_TEXTURE0);
-  mStarShader.SetUniform(mUniforms.starTexture, 0);
+  mStarTexture->get()->Bind(GL_TEXTURE0);
+  mStarShader->setUniform(mUniforms.starTexture, 0);
 
-  mStarShader.SetUniform(mUniforms.starMinMagnitude, mMinMagnitude);
-  mStarShader.SetUniform(mUniforms.starMaxMagnitude, mMaxMagnitude);
-  mStarShader.SetUniform(mUniforms.starSolidAngle, mSolidAngle);
+  mStarShader->setUniform(mUniforms.starMinMagnitude, mMinMagnitude);
+  mStarShader->setUniform(mUniforms.starMaxMagnitude, mMaxMagnitude);
+  mStarShader->setUniform(mUniforms.starSolidAngle, mSolidAngle);
 
   float fadeOut = mEnableHDR ? 1.F : sceneBrightness;
-  mStarShader.SetUniform(mUniforms.starLuminanceMul, mLuminanceMultiplicator * fadeOut);
+  mStarShader->setUniform(mUniforms.starLuminanceMul, mLuminanceMultiplicator * fadeOut);
 
   VistaTransformMatrix matInverseMV(matModelView.GetInverted());
   VistaTransformMatrix matInverseP(matProjection.GetInverted());
@@ -475,9 +491,9 @@ bool Stars::Do() {
 
   glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(mStars.size()));
 
-  mStarTexture->Unbind(GL_TEXTURE0);
+  mStarTexture->get()->Unbind(GL_TEXTURE0);
 
-  mStarShader.Release();
+  mStarShader->release();
   mStarVAO.Release();
 
   glDepthMask(GL_TRUE);
@@ -501,7 +517,8 @@ bool Stars::GetBoundingBox(VistaBoundingBox& oBoundingBox) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool Stars::readStarsFromCatalog(CatalogType type, std::string const& filename) {
+bool Stars::readStarsFromCatalog(CatalogType type, std::string const& filename,
+    std::map<CatalogType, std::string> const& catalogs, std::vector<Star>& stars) {
   bool success = false;
   logger().info("Reading star catalog '{}'.", filename);
 
@@ -515,7 +532,7 @@ bool Stars::readStarsFromCatalog(CatalogType type, std::string const& filename)
 
   if (file.is_open()) {
     int  lineCount = 0;
-    bool loadHipparcos(mCatalogs.find(CatalogType::eHipparcos) != mCatalogs.end());
+    bool loadHipparcos(catalogs.find(CatalogType::eHipparcos) != catalogs.end());
 
     // read line by line
     while (!file.eof()) {
@@ -576,19 +593,19 @@ bool Stars::readStarsFromCatalog(CatalogType type, std::string const& filename)
           star.mAscension   = (360.F + 90.F - star.mAscension) / 180.F * Vista::Pi;
           star.mDeclination = star.mDeclination / 180.F * Vista::Pi;
 
-          mStars.emplace_back(star);
+          stars.emplace_back(star);
         }
       }
 
       // print progress status
-      if (mStars.size() % 10000 == 0) {
-        logger().info("Read {} stars so far...", mStars.size());
+      if (stars.size() % 10000 == 0) {
+        logger().info("Read {} stars so far...", stars.size());
       }
     }
     file.close();
     success = true;
 
-    logger().info("Read a total of {} stars.", mStars.size());
+    logger().info("Read a total of {} stars.", stars.size());
   } else {
     logger().error("Failed to load stars: Cannot open catalog file '{}'!", filename);
   }
@@ -598,20 +615,21 @@ bool Stars::readStarsFromCatalog(CatalogType type, std::string const& filename)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void Stars::writeStarCache(const std::string& sCacheFile) const {
-  VistaType::uint32 catalogs = 0;
-  for (auto const& mCatalog : mCatalogs) {
-    catalogs += static_cast<uint32_t>(std::pow(2, static_cast<int>(mCatalog.first)));
+void Stars::writeStarCache(std::string const& sCacheFile,
+    std::map<CatalogType, std::string> const& catalogs, std::vector<Star> const& stars) {
+  VistaType::uint32 catalogMask = 0;
+  for (auto const& catalog : catalogs) {
+    catalogMask += static_cast<uint32_t>(std::pow(2, static_cast<int>(catalog.first)));
   }
 
   VistaByteBufferSerializer serializer;
   serializer.WriteInt32(
       static_cast<VistaType::uint32>(cCacheVersion)); // cache format version number
-  serializer.WriteInt32(catalogs);                    // cache format version number
+  serializer.WriteInt32(catalogMask);                 // cache format version number
   serializer.WriteInt32(static_cast<VistaType::uint32>(
-      mStars.size())); // write number of stars to front of byte stream
+      stars.size())); // write number of stars to front of byte stream
 
-  for (const auto& mStar : mStars) {
+  for (const auto& mStar : stars) {
     // serialize star data into byte stream
     serializer.WriteFloat32(mStar.mVMagnitude);
     serializer.WriteFloat32(mStar.mBMagnitude);
@@ -625,7 +643,7 @@ void Stars::writeStarCache(const std::string& sCacheFile) const {
   file.open(sCacheFile.c_str(), std::ios::out | std::ios::binary);
   if (file.is_open()) {
     // write serialized star data
-    logger().info("Writing {} stars ({} bytes) into '{}'.", mStars.size(),
+    logger().info("Writing {} stars ({} bytes) into '{}'.", stars.size(),
         serializer.GetBufferSize(), sCacheFile);
 
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
@@ -639,7 +657,8 @@ void Stars::writeStarCache(const std::string& sCacheFile) const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool Stars::readStarCache(const std::string& sCacheFile) {
+bool Stars::readStarCache(std::string const& sCacheFile,
+    std::map<CatalogType, std::string> const& catalogs, std::vector<Star>& stars) {
   bool success = false;
 
   // open file
@@ -662,13 +681,13 @@ bool Stars::readStarCache(const std::string& sCacheFile) {
 
     // de-serialize byte stream
     VistaType::uint32 cacheVersion = 0;
-    VistaType::uint32 catalogs     = 0;
+    VistaType::uint32 catalogMask  = 0;
     VistaType::uint32 numStars     = 0;
 
     VistaByteBufferDeSerializer deserializer;
     deserializer.SetBuffer(&data[0], size); // prepare for de-serialization
     deserializer.ReadInt32(cacheVersion);   // read cache format version number
-    deserializer.ReadInt32(catalogs);       // read which catalogs were loaded
+    deserializer.ReadInt32(catalogMask);    // read which catalogs were loaded
     deserializer.ReadInt32(numStars);       // read number of stars from front of byte stream
 
     if (cacheVersion != cCacheVersion) {
@@ -676,11 +695,11 @@ bool Stars::readStarCache(const std::string& sCacheFile) {
     }
 
     VistaType::uint32 catalogsToLoad = 0;
-    for (const auto& mCatalog : mCatalogs) {
-      catalogsToLoad += static_cast<uint32_t>(std::pow(2, static_cast<int>(mCatalog.first)));
+    for (const auto& catalog : catalogs) {
+      catalogsToLoad += static_cast<uint32_t>(std::pow(2, static_cast<int>(catalog.first)));
     }
 
-    if (catalogs != catalogsToLoad) {
+    if (catalogMask != catalogsToLoad) {
       return false;
     }
 
@@ -692,17 +711,17 @@ bool Stars::readStarCache(const std::string& sCacheFile) {
       deserializer.ReadFloat32(star.mDeclination);
       deserializer.ReadFloat32(star.mParallax);
 
-      mStars.emplace_back(star);
+      stars.emplace_back(star);
 
       // print progress status
-      if (mStars.size() % 100000 == 0) {
-        logger().info("Read {} stars so far...", mStars.size());
+      if (stars.size() % 100000 == 0) {
+        logger().info("Read {} stars so far...", stars.size());
       }
     }
 
     success = true;
 
-    logger().info("Read a total of {} stars.", mStars.size());
+    logger().info("Read a total of {} stars.", stars.size());
   }
 
   return success;
@@ -11,7 +11,6 @@
 #include <VistaBase/VistaColor.h>
 #include <VistaKernel/GraphicsManager/VistaOpenGLDraw.h>
 #include <VistaOGLExt/VistaBufferObject.h>
-#include <VistaOGLExt/VistaGLSLShader.h>
 #include <VistaOGLExt/VistaTexture.h>
 #include <VistaOGLExt/VistaVertexArrayObject.h>
 
@@ -21,6 +20,11 @@
 #include <memory>
 #include <vector>
 
+namespace cs::graphics {
+class AsyncTexture;
+class ShaderProgram;
+} // namespace cs::graphics
+
 namespace csp::stars {
 
 /// If added to the scene graph, this will draw a configurable star background. It is possible to
@@ -50,6 +54,15 @@ class Stars : public IVistaOpenGLDraw {
 
   enum class DrawMode { ePoint, eSmoothPoint, eDisc, eSmoothDisc, eScaledDisc, eSprite };
 
+  /// Data structure of one record from star catalog.
+  struct Star {
+    float mVMagnitude;
+    float mBMagnitude;
+    float mAscension;
+    float mDeclination;
+    float mParallax;
+  };
+
   /// It is possible to load multiple catalogs, currently Hipparcos and any of Tycho or Tycho2 can
   /// be loaded together. Stars which are in both catalogs will be loaded from Hipparcos. Once
   /// loaded, the stars will be written to a binary cache file. Subsequent instantiations of this
@@ -58,6 +71,15 @@ class Stars : public IVistaOpenGLDraw {
   void setCatalogs(std::map<CatalogType, std::string> catalogs);
   std::map<CatalogType, std::string> const& getCatalogs() const;
 
+  /// Reads the stars of the given catalogs, or from the cache file if it has been written for the
+  /// same catalogs. This does not require an OpenGL context, so it can be called on a worker
+  /// thread. The result can be passed to setStars().
+  static std::vector<Star> loadStars(
+      std::map<CatalogType, std::string> const& catalogs, std::string const& cacheFile);
+
+  /// Like setCatalogs(), but the stars have already been loaded with loadStars().
+  void setStars(std::map<CatalogType, std::string> catalogs, std::vector<Star> stars);
+
   /// Subsequent calls to setCatalogs() will use this cache file. Defaults to "star_cache.dat".
   void               setCacheFile(std::string cacheFile);
   std::string const& getCacheFile() const;
@@ -119,47 +141,41 @@ class Stars : public IVistaOpenGLDraw {
   bool GetBoundingBox(VistaBoundingBox& oBoundingBox) override;
 
  private:
-  /// Data structure of one record from star catalog.
-  struct Star {
-    float mVMagnitude;
-    float mBMagnitude;
-    float mAscension;
-    float mDeclination;
-    float mParallax;
-  };
-
-  /// Reads star data from binary file.
-  bool readStarsFromCatalog(CatalogType type, std::string const& filename);
+  /// Reads star data from a catalog file and appends it to the given stars.
+  static bool readStarsFromCatalog(CatalogType type, std::string const& filename,
+      std::map<CatalogType, std::string> const& catalogs, std::vector<Star>& stars);
 
-  /// Writes internal star data read from catalog into a binary file.
-  void writeStarCache(const std::string& cacheFile) const;
+  /// Writes star data read from catalogs into a binary file.
+  static void writeStarCache(std::string const& cacheFile,
+      std::map<CatalogType, std::string> const& catalogs, std::vector<Star> const& stars);
 
   /// Reads star data from binary file.
-  bool readStarCache(const std::string& cacheFile);
+  static bool readStarCache(std::string const& cacheFile,
+      std::map<CatalogType, std::string> const& catalogs, std::vector<Star>& stars);
 
   /// Build vertex array objects from given star list.
   void buildStarVAO();
   void buildBackgroundVAO();
 
-  std::unique_ptr<VistaTexture> mStarTexture;
-  std::string                   mStarTextureFile;
+  std::shared_ptr<cs::graphics::AsyncTexture> mStarTexture;
+  std::string                                 mStarTextureFile;
 
-  std::unique_ptr<VistaTexture> mCelestialGridTexture;
-  std::string                   mCelestialGridTextureFile;
+  std::shared_ptr<cs::graphics::AsyncTexture> mCelestialGridTexture;
+  std::string                                 mCelestialGridTextureFile;
 
-  std::unique_ptr<VistaTexture> mStarFiguresTexture;
-  std::string                   mStarFiguresTextureFile;
+  std::shared_ptr<cs::graphics::AsyncTexture> mStarFiguresTexture;
+  std::string                                 mStarFiguresTextureFile;
 
   std::string mCacheFile = "star_cache.dat";
 
-  VistaGLSLShader        mStarShader;
-  VistaGLSLShader        mBackgroundShader;
-  VistaColor             mBackgroundColor1;
-  VistaColor             mBackgroundColor2;
-  VistaVertexArrayObject mStarVAO;
-  VistaBufferObject      mStarVBO;
-  VistaVertexArrayObject mBackgroundVAO;
-  VistaBufferObject      mBackgroundVBO;
+  std::shared_ptr<cs::graphics::ShaderProgram> mStarShader;
+  std::shared_ptr<cs::graphics::ShaderProgram> mBackgroundShader;
+  VistaColor                                   mBackgroundColor1;
+  VistaColor                                   mBackgroundColor2;
+  VistaVertexArrayObject                       mStarVAO;
+  VistaBufferObject                            mStarVBO;
+  VistaVertexArrayObject                       mBackgroundVAO;
+  VistaBufferObject                            mBackgroundVBO;
 
   std::vector<Star>                  mStars;
   std::map<CatalogType, std::string> mCatalogs;
@@ -177,11 +177,12 @@ void Plugin::init() {
   logger().info("Loading plugin...");
 
   // We store all emitted log messages (up to a maximum of 1000) in a std::deque in order to be able
-  // to answer to /log requests.
+  // to answer to /log requests. The signal is emitted once per frame on the main thread, so the
+  // mutex is only contended by the /log requests.
   mOnLogMessageConnection = cs::utils::onLogMessage().connect(
       [this](
           std::string const& logger, spdlog::level::level_enum level, std::string const& message) {
-        const std::unordered_map<spdlog::level::level_enum, std::string> mapping = {
+        static const std::unordered_map<spdlog::level::level_enum, std::string> mapping = {
             {spdlog::level::trace, "T"}, {spdlog::level::debug, "D"}, {spdlog::level::info, "I"},
             {spdlog::level::warn, "W"}, {spdlog::level::err, "E"}, {spdlog::level::critical, "C"}};
 
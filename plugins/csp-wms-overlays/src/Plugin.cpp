@@ -10,6 +10,7 @@
 #include "WebMapService.hpp"
 #include "logger.hpp"
 
+#include "../../../src/cs-core/GraphicsEngine.hpp"
 #include "../../../src/cs-core/GuiManager.hpp"
 #include "../../../src/cs-core/InputManager.hpp"
 #include "../../../src/cs-core/Settings.hpp"
@@ -19,6 +20,8 @@
 #include <VistaKernel/DisplayManager/VistaDisplayManager.h>
 #include <VistaKernel/VistaSystem.h>
 
+#include <future>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 EXPORT_FN cs::core::PluginBase* create() {
@@ -100,10 +103,67 @@ void to_json(nlohmann::json& j, Plugin::Settings const& o) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void Plugin::prepare() {
+
+  // Requesting and parsing the capabilities of all servers is the most expensive part of the
+  // initialization. As it requires neither OpenGL nor the user interface, it is done here on a
+  // worker thread. The servers of all bodies are requested concurrently.
+  Settings settings;
+  from_json(mAllSettings->mPlugins.at("csp-wms-overlays"), settings);
+
+  size_t serverCount = 0;
+  for (auto const& [bodyName, body] : settings.mBodies) {
+    serverCount += body.mWms.size();
+  }
+
+  if (serverCount == 0) {
+    return;
+  }
+
+  cs::utils::ThreadPool threadPool(serverCount);
+
+  std::vector<std::pair<std::string, std::future<std::optional<WebMapService>>>> services;
+
+  for (auto const& [bodyName, body] : settings.mBodies) {
+
+    // Bodies without any valid server are recorded as well, so that onLoad() does not request
+    // their servers again.
+    mPreparedWms[bodyName];
+
+    for (auto const& wmsUrl : body.mWms) {
+      services.emplace_back(bodyName,
+          threadPool.enqueue([&settings, wmsUrl]() -> std::optional<WebMapService> {
+            try {
+              return WebMapService(wmsUrl, settings.mUseCapabilityCache.get(),
+                  settings.mCapabilityCache.get());
+            } catch (std::exception const& e) {
+              logger().warn("Failed to parse capabilities for '{}': '{}'!", wmsUrl, e.what());
+              return std::nullopt;
+            }
+          }));
+    }
+  }
+
+  for (auto& [bodyName, service] : services) {
+    auto wms = service.get();
+    if (wms) {
+      mPreparedWms[bodyName].push_back(std::move(*wms));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void Plugin::init() {
   logger().info("Loading plugin...");
 
-  mOnLoadConnection = mAllSettings->onLoad().connect([this]() { onLoad(); });
+  // Reconfiguring the overlays discards their caches and requests the capabilities of all servers
+  // again, so we skip this if the settings of this plugin did not change.
+  mOnLoadConnection = mAllSettings->onLoad().connect([this]() {
+    if (mAllSettings->hasPluginSettingsChanged("csp-wms-overlays")) {
+      onLoad();
+    }
+  });
   mOnSaveConnection = mAllSettings->onSave().connect([this]() { onSave(); });
 
   mGuiManager->addPluginTabToSideBarFromHTML(
@@ -413,6 +473,16 @@ void Plugin::init() {
     }
   });
 
+  // Report the number of textures which are currently requested from the map servers. This allows
+  // other components (e.g. csp-recorder) to wait until all overlays are fully loaded.
+  mPendingRequestsCallback = mGraphicsEngine->registerPendingRequestsCallback([this]() {
+    uint32_t pending = 0;
+    for (auto const& [name, overlay] : mWMSOverlays) {
+      pending += overlay->getPendingRequests();
+    }
+    return pending;
+  });
+
   onLoad();
 
   logger().info("Loading done.");
@@ -428,6 +498,7 @@ void Plugin::deInit() {
 
   mSolarSystem->pActiveObject.disconnect(mActiveObjectConnection);
   mSolarSystem->pCurrentObserverSpeed.disconnect(mObserverSpeedConnection);
+  mGraphicsEngine->unregisterPendingRequestsCallback(mPendingRequestsCallback);
 
   mGuiManager->removePluginTab("WMS Overlays");
   mGuiManager->removeSettingsSection("WMS Overlays");
@@ -536,6 +607,19 @@ void Plugin::onLoad() {
 
     mWMSOverlays.emplace(settings.first, wmsOverlay);
 
+    // The capabilities of the servers have usually been requested in prepare() already. In this
+    // case, the overlay can be set up right away.
+    auto prepared = mPreparedWms.find(settings.first);
+    if (prepared != mPreparedWms.end()) {
+      for (auto& wms : prepared->second) {
+        mWms[settings.first].push_back(std::move(wms));
+      }
+
+      initOverlay(settings.first, settings.second);
+      logger().info("Finished loading WMS servers for {}.", settings.first);
+      continue;
+    }
+
     mWmsCreationThreads.emplace(settings.first, settings.second.mWms.size());
     mWmsCreationProgress.emplace(settings.first, 0);
     for (auto const& wmsUrl : settings.second.mWms) {
@@ -552,6 +636,10 @@ void Plugin::onLoad() {
     }
   }
 
+  // The prepared servers are only used once. If the settings are reloaded later, the capabilities
+  // are requested again.
+  mPreparedWms.clear();
+
   mSolarSystem->pActiveObject.touch(mActiveObjectConnection);
 }
 
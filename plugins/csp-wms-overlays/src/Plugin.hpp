@@ -80,6 +80,7 @@ class Plugin : public cs::core::PluginBase {
     std::map<std::string, Body> mBodies;
   };
 
+  void prepare() override;
   void init() override;
   void deInit() override;
 
@@ -126,6 +127,10 @@ class Plugin : public cs::core::PluginBase {
   std::map<std::string, std::shared_ptr<TextureOverlayRenderer>> mWMSOverlays;
   std::map<std::string, std::vector<WebMapService>>              mWms;
 
+  // The servers of each body are created in prepare() on a worker thread and moved to mWms in the
+  // first call to onLoad().
+  std::map<std::string, std::vector<WebMapService>> mPreparedWms;
+
   std::shared_ptr<TextureOverlayRenderer> mActiveOverlay;
   /// The currently active WebMapService for each center name.
   std::map<std::string, std::optional<WebMapService>> mActiveServers;
@@ -144,6 +149,7 @@ class Plugin : public cs::core::PluginBase {
   int mObserverSpeedConnection = -1;
   int mOnLoadConnection        = -1;
   int mOnSaveConnection        = -1;
+  int mPendingRequestsCallback = -1;
 };
 
 } // namespace csp::wmsoverlays
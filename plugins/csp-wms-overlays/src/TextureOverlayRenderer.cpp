@@ -13,6 +13,8 @@
 #include "../../../src/cs-core/Settings.hpp"
 #include "../../../src/cs-core/SolarSystem.hpp"
 #include "../../../src/cs-core/TimeControl.hpp"
+#include "../../../src/cs-graphics/ShaderCache.hpp"
+#include "../../../src/cs-graphics/ShaderProgram.hpp"
 #include "../../../src/cs-graphics/TextureLoader.hpp"
 #include "../../../src/cs-scene/IntersectableObject.hpp"
 #include "../../../src/cs-utils/utils.hpp"
@@ -29,7 +31,6 @@
 #include <VistaKernel/VistaSystem.h>
 #include <VistaKernelOpenSGExt/VistaOpenSGMaterialTools.h>
 #include <VistaOGLExt/VistaBufferObject.h>
-#include <VistaOGLExt/VistaGLSLShader.h>
 #include <VistaOGLExt/VistaTexture.h>
 
 // Standard includes
@@ -134,6 +135,12 @@ std::string const& TextureOverlayRenderer::getObjectName() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+uint32_t TextureOverlayRenderer::getPendingRequests() const {
+  return static_cast<uint32_t>(mTexturesBuffer.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void TextureOverlayRenderer::configure(Plugin::Settings::Body settings) {
   mSimpleWMSOverlaySettings = std::move(settings);
   pBounds                   = mSimpleWMSOverlaySettings.mActiveBounds.get();
@@ -381,8 +388,6 @@ bool TextureOverlayRenderer::Do() {
   }
 
   if (mShaderDirty) {
-    mShader = VistaGLSLShader();
-
     std::string defines = "#version 440\n";
 
     if (mSettings->mGraphics.pEnableHDR.get()) {
@@ -393,10 +398,8 @@ bool TextureOverlayRenderer::Do() {
       defines += "#define ENABLE_LIGHTING\n";
     }
 
-    mShader.InitGeometryShaderFromString(SURFACE_GEOM);
-    mShader.InitVertexShaderFromString(SURFACE_VERT);
-    mShader.InitFragmentShaderFromString(defines + SURFACE_FRAG);
-    mShader.Link();
+    mShader = cs::graphics::ShaderCache::get().getShader(
+        SURFACE_VERT, defines + SURFACE_FRAG, SURFACE_GEOM);
 
     mShaderDirty = false;
   }
@@ -559,7 +562,7 @@ bool TextureOverlayRenderer::Do() {
   glm::dmat4 matInvMVP = glm::inverse(glm::dmat4(matP) * glm::dmat4(matV) * transform);
 
   // Bind shader before draw
-  mShader.Bind();
+  mShader->bind();
 
   // Only bind the enabled textures.
   depthBuffer.Bind(GL_TEXTURE0);
@@ -567,27 +570,27 @@ bool TextureOverlayRenderer::Do() {
     mWMSTexture.Bind(GL_TEXTURE1);
 
     if (mSecondWMSTextureUsed) {
-      mShader.SetUniform(mShader.GetUniformLocation("uFade"), mFade);
+      mShader->setUniform(mShader->getUniformLocation("uFade"), mFade);
       mSecondWMSTexture.Bind(GL_TEXTURE2);
     }
   }
 
-  mShader.SetUniform(mShader.GetUniformLocation("uDepthBuffer"), 0);
-  mShader.SetUniform(mShader.GetUniformLocation("uFirstTexture"), 1);
-  mShader.SetUniform(mShader.GetUniformLocation("uSecondTexture"), 2);
+  mShader->setUniform(mShader->getUniformLocation("uDepthBuffer"), 0);
+  mShader->setUniform(mShader->getUniformLocation("uFirstTexture"), 1);
+  mShader->setUniform(mShader->getUniformLocation("uSecondTexture"), 2);
 
-  mShader.SetUniform(mShader.GetUniformLocation("uUseFirstTexture"), mWMSTextureUsed);
-  mShader.SetUniform(mShader.GetUniformLocation("uUseSecondTexture"), mSecondWMSTextureUsed);
+  mShader->setUniform(mShader->getUniformLocation("uUseFirstTexture"), mWMSTextureUsed);
+  mShader->setUniform(mShader->getUniformLocation("uUseSecondTexture"), mSecondWMSTextureUsed);
 
-  GLint loc = mShader.GetUniformLocation("uMatInvMVP");
+  GLint loc = mShader->getUniformLocation("uMatInvMVP");
   glUniformMatrix4dv(loc, 1, GL_FALSE, glm::value_ptr(matInvMVP));
 
   // Double precision bounds
-  loc = mShader.GetUniformLocation("uLatRange");
+  loc = mShader->getUniformLocation("uLatRange");
   glUniform2dv(loc, 1,
       glm::value_ptr(
           cs::utils::convert::toRadians(glm::dvec2(getBounds().mMinLat, getBounds().mMaxLat))));
-  loc = mShader.GetUniformLocation("uLonRange");
+  loc = mShader->getUniformLocation("uLonRange");
   glUniform2dv(loc, 1,
       glm::value_ptr(
           cs::utils::convert::toRadians(glm::dvec2(getBounds().mMinLon, getBounds().mMaxLon))));
@@ -617,13 +620,13 @@ bool TextureOverlayRenderer::Do() {
         glm::inverse(transform) * glm::dvec4(mSolarSystem->getSunDirection(transform[3]), 0.0));
   }
 
-  mShader.SetUniform(mShader.GetUniformLocation("uSunDirection"), sunDirection[0], sunDirection[1],
-      sunDirection[2]);
-  mShader.SetUniform(mShader.GetUniformLocation("uSunIlluminance"), sunIlluminance);
-  mShader.SetUniform(mShader.GetUniformLocation("uAmbientBrightness"), ambientBrightness);
+  mShader->setUniform(mShader->getUniformLocation("uSunDirection"), sunDirection[0],
+      sunDirection[1], sunDirection[2]);
+  mShader->setUniform(mShader->getUniformLocation("uSunIlluminance"), sunIlluminance);
+  mShader->setUniform(mShader->getUniformLocation("uAmbientBrightness"), ambientBrightness);
 
   // provide radii to shader
-  mShader.SetUniform(mShader.GetUniformLocation("uRadii"), static_cast<float>(radii[0]),
+  mShader->setUniform(mShader->getUniformLocation("uRadii"), static_cast<float>(radii[0]),
       static_cast<float>(radii[1]), static_cast<float>(radii[2]));
 
   int depthBits = 0;
@@ -642,7 +645,7 @@ bool TextureOverlayRenderer::Do() {
   }
 
   // Release shader
-  mShader.Release();
+  mShader->release();
 
   glEnable(GL_DEPTH_TEST);
   glDepthMask(GL_TRUE);
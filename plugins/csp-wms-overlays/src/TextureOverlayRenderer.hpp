@@ -15,16 +15,15 @@
 
 #include <VistaKernel/GraphicsManager/VistaOpenGLDraw.h>
 #include <VistaMath/VistaBoundingBox.h>
-#include <VistaOGLExt/VistaGLSLShader.h>
 #include <VistaOGLExt/VistaTexture.h>
 
 #include <array>
 #include <functional>
 #include <future>
+#include <memory>
 #include <unordered_map>
 
 // FORWARD DEFINITIONS
-class VistaGLSLShader;
 class VistaOpenGLNode;
 class VistaTexture;
 class VistaViewport;
@@ -35,6 +34,10 @@ class TimeControl;
 class Settings;
 } // namespace cs::core
 
+namespace cs::graphics {
+class ShaderProgram;
+} // namespace cs::graphics
+
 namespace csp::wmsoverlays {
 
 /// Class which gets a geo-referenced texture and overlays if onto the previous rendered scene.
@@ -68,6 +71,9 @@ class TextureOverlayRenderer : public IVistaOpenGLDraw {
   /// The bounds will be updated the next time the Do() method is called.
   void requestUpdateBounds();
 
+  /// Returns the number of textures which have been requested but are not yet loaded.
+  uint32_t getPendingRequests() const;
+
   /// The current map bounds of this overlay.
   /// This may be used for setting the bounds.
   cs::utils::Property<Bounds> pBounds;
@@ -101,7 +107,7 @@ class TextureOverlayRenderer : public IVistaOpenGLDraw {
   std::unique_ptr<VistaOpenGLNode> mGLNode;
 
   /// Vista GLSL shader object used for rendering
-  VistaGLSLShader mShader;
+  std::shared_ptr<cs::graphics::ShaderProgram> mShader;
 
   /// Code for the geometry shader
   static const std::string SURFACE_GEOM;
@@ -320,8 +320,24 @@ class StatusbarApi extends IApi {
    * @param message {string} The message.
    */
   printMessage(level, channel, message) {
-    this._outputField.insertAdjacentHTML(
-        "afterbegin", `<div class='message level-${level}'>[${level}] ${channel} ${message}</div>`);
+    this.printMessages([[level, channel, message]]);
+  }
+
+  /**
+   * Print multiple messages to the console at once. This is used by CosmoScout VR to show all
+   * messages which were logged during one frame. The layout is only updated once for all messages.
+   * @param messages {Array} An array of [level, channel, message] arrays, oldest message first.
+   */
+  printMessages(messages) {
+    // Only the last 100 messages will be visible anyways.
+    const newMessages = messages.slice(-100);
+
+    let html = '';
+    newMessages.forEach(([level, channel, message]) => {
+      html = `<div class='message level-${level}'>[${level}] ${channel} ${message}</div>` + html;
+    });
+
+    this._outputField.insertAdjacentHTML("afterbegin", html);
 
     while (this._outputField.children.length > 100) {
       this._outputField.removeChild(this._outputField.lastChild);
@@ -329,7 +345,9 @@ class StatusbarApi extends IApi {
 
     // Flush all pending style changes to ensure the initial transition gets triggered
     getComputedStyle(this._outputField.firstChild).opacity;
-    this._outputField.firstChild.classList.add("initial-transition");
+    for (let i = 0; i < newMessages.length; ++i) {
+      this._outputField.children[i].classList.add("initial-transition");
+    }
   }
 
   /**
@@ -19,6 +19,7 @@
 #include "../cs-scene/CelestialSurface.hpp"
 #include "../cs-utils/Downloader.hpp"
 #include "../cs-utils/FrameStats.hpp"
+#include "../cs-utils/ThreadPool.hpp"
 #include "../cs-utils/convert.hpp"
 #include "../cs-utils/filesystem.hpp"
 #include "../cs-utils/logger.hpp"
@@ -40,6 +41,7 @@
 #include <VistaKernel/VistaSystem.h>
 #include <VistaOGLExt/VistaShaderRegistry.h>
 #include <curlpp/cURLpp.hpp>
+#include <chrono>
 #include <memory>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -177,6 +179,9 @@ void Application::Quit() {
   // Do not attempt to print anything to the on-screen console.
   cs::utils::onLogMessage().disconnect(mOnMessageConnection);
 
+  // Wait for plugins which are still being prepared on the worker threads.
+  mPluginPreparer.reset();
+
   // De-init all plugins first.
   for (auto const& plugin : mPlugins) {
     plugin.second.mPlugin->deInit();
@@ -371,6 +376,9 @@ void Application::FrameUpdate() {
 
     // Store the frame at which we should start loading the plugins.
     mStartPluginLoadingAtFrame = GetFrameCount();
+
+    // The expensive parts of the plugin initialization can already start in the background.
+    preparePlugins();
   }
 
   // load plugins at application startup -----------------------------------------------------------
@@ -379,32 +387,60 @@ void Application::FrameUpdate() {
   // loading the plugins.
   if (mDownloadedData && !mLoadedAllPlugins) {
 
-    // Before loading the first plugin and between loading the individual plugins, we will draw some
-    // frames. This allows the loading screen to update the status message and move the progress
-    // bar. For now, we wait a hard-coded number of 25 frames before and between loading of the
-    // plugins.
+    // Before initializing the first plugin and between initializing the individual plugins, we will
+    // draw some frames. This allows the loading screen to update the status message and move the
+    // progress bar. The prepare() methods of the plugins run on worker threads in the meantime. For
+    // now, we wait a hard-coded number of 25 frames before the first plugin and 5 frames between
+    // the plugins.
     const int32_t cLoadingDelay = 25;
+    const int32_t cPluginDelay  = 5;
 
-    // Every 25th frame something happens. At frame X we will show the name of the plugin on the
-    // loading screen which will be loaded at frame X+25. At frame X+25 we will load the according
-    // plugin and also update the loading screen to display the name of the plugin which is going to
-    // be loaded at frame X+50. And so on.
-    if (((GetFrameCount() - mStartPluginLoadingAtFrame) % cLoadingDelay) == 0) {
+    int32_t pluginCount = static_cast<int32_t>(mPlugins.size());
 
-      // Calculate the index of the plugin which should be loaded this frame.
-      int32_t pluginToLoad = (GetFrameCount() - mStartPluginLoadingAtFrame) / cLoadingDelay - 1;
+    if (GetFrameCount() == mStartPluginLoadingAtFrame && pluginCount > 0) {
+      mGuiManager->setLoadingScreenStatus("Loading " + mPlugins.begin()->first + " ...");
+      mGuiManager->setLoadingScreenProgress(0.F, true);
+    }
 
-      if (pluginToLoad >= 0 && pluginToLoad < static_cast<int32_t>(mPlugins.size())) {
+    int32_t initAtFrame =
+        std::max(mStartPluginLoadingAtFrame + cLoadingDelay, mInitNextPluginAtFrame);
 
-        // Get an iterator pointing to the plugin handle.
-        auto plugin = mPlugins.begin();
-        std::advance(plugin, pluginToLoad);
+    if (GetFrameCount() >= initAtFrame) {
 
-        initPlugin(plugin->first);
+      if (mNextPluginToInit < pluginCount) {
+        auto plugin = mPlugins.begin();
+        std::advance(plugin, mNextPluginToInit);
+
+        // init() is only called once the plugin has been prepared. If this takes longer, we will
+        // check again in the next frame.
+        auto& preparation = plugin->second.mPreparation;
+        bool  prepared    = !preparation.valid() ||
+                        preparation.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+
+        if (prepared) {
+          initPlugin(plugin->first);
+          ++mNextPluginToInit;
+
+          // Delay the next plugin by some frames.
+          mInitNextPluginAtFrame = GetFrameCount() + cPluginDelay;
+
+          // If there is a plugin going to be initialized next, display its name on the loading
+          // screen and update the progress accordingly.
+          if (mNextPluginToInit < pluginCount) {
+            std::advance(plugin, 1);
+            mGuiManager->setLoadingScreenStatus("Loading " + plugin->first + " ...");
+            mGuiManager->setLoadingScreenProgress(
+                100.F * static_cast<float>(mNextPluginToInit) / pluginCount, true);
+          }
+        }
 
-      } else if (pluginToLoad == static_cast<int32_t>(mPlugins.size())) {
+      } else {
 
         logger().info("Ready for Takeoff!");
+        printPluginStartupTimes();
+
+        // All preparations have finished, so the worker threads are not required anymore.
+        mPluginPreparer.reset();
 
         // Once all plugins have been loaded, we set a boolean indicating this state.
         mLoadedAllPlugins = true;
@@ -420,16 +456,6 @@ void Application::FrameUpdate() {
         // Call code which has to be executed whenever the settings are reloaded.
         onLoad();
       }
-
-      // If there is a plugin going to be loaded after the next cLoadingDelay frames, display its
-      // name on the loading screen and update the progress accordingly.
-      if (pluginToLoad + 1 < static_cast<int32_t>(mPlugins.size())) {
-        auto plugin = mPlugins.begin();
-        std::advance(plugin, pluginToLoad + 1);
-        mGuiManager->setLoadingScreenStatus("Loading " + plugin->first + " ...");
-        mGuiManager->setLoadingScreenProgress(
-            100.F * static_cast<float>(pluginToLoad + 1) / mPlugins.size(), true);
-      }
     }
   }
 
@@ -564,6 +590,28 @@ void Application::FrameUpdate() {
   {
     cs::utils::FrameStats::ScopedTimer timer("Update User Interface");
 
+    // Log messages may be emitted from any thread. They are collected and delivered here once per
+    // frame. All messages which were logged since the last frame are shown in the on-screen
+    // console with a single call.
+    cs::utils::processLogMessages();
+
+    if (!mPendingLogMessages.empty()) {
+      // Log messages may contain invalid UTF-8 (e.g. file paths or server responses). These
+      // characters are replaced instead of throwing an exception.
+      auto messages = nlohmann::json(mPendingLogMessages)
+                          .dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+      mGuiManager->getGui()->executeJavascript(
+          fmt::format("CosmoScout.statusbar.printMessages({});", messages));
+      mPendingLogMessages.clear();
+    }
+
+    // The observer settings are set deferred in SolarSystem::update(). Applying them here notifies
+    // the user interface at most once per frame.
+    mSettings->mObserver.pCenter.flush();
+    mSettings->mObserver.pFrame.flush();
+    mSettings->mObserver.pPosition.flush();
+    mSettings->mObserver.pRotation.flush();
+
     // Call update on all APIs
     if (mLoadedAllPlugins) {
       mGuiManager->getGui()->callJavascript("CosmoScout.update");
@@ -733,7 +781,7 @@ void Application::openPlugin(std::string const& name) {
         logger().info("Opening plugin '{}'.", name);
 
         // Actually call the plugin's constructor and add the returned pointer to out list.
-        mPlugins.insert(std::pair<std::string, Plugin>(name, {pluginHandle, pluginConstructor()}));
+        mPlugins.emplace(name, Plugin{pluginHandle, pluginConstructor()});
       } else {
         logger().warn("Failed to load plugin '{}': {}", name, LIBERROR());
       }
@@ -747,20 +795,76 @@ void Application::openPlugin(std::string const& name) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void Application::preparePlugins() {
+  if (mPlugins.empty()) {
+    return;
+  }
+
+  auto threads = std::min(
+      static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1U)), mPlugins.size());
+  mPluginPreparer = std::make_unique<cs::utils::ThreadPool>(threads);
+
+  // The thread pool executes the most recently added tasks first. As the plugins are initialized in
+  // the order of mPlugins, we add them in reverse order.
+  for (auto it = mPlugins.rbegin(); it != mPlugins.rend(); ++it) {
+    auto& plugin = *it;
+
+    if (plugin.second.mIsInitialized || plugin.second.mPreparation.valid()) {
+      continue;
+    }
+
+    // setAPI() only stores some pointers, so it is fine to call it on the main thread.
+    plugin.second.mPlugin->setAPI(mSettings, mSolarSystem, mGuiManager, mInputManager,
+        GetVistaSystem()->GetGraphicsManager()->GetSceneGraph(), mGraphicsEngine, mTimeControl);
+
+    // The map nodes are not moved, so the worker thread can safely write the timing. It is only
+    // read after the future has become ready.
+    auto* state                = &plugin.second;
+    plugin.second.mPreparation = mPluginPreparer->enqueue([state]() {
+      auto start = std::chrono::steady_clock::now();
+      state->mPlugin->prepare();
+      state->mPrepareTime = std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - start)
+                                .count();
+    });
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void Application::initPlugin(std::string const& name) {
   auto plugin = mPlugins.find(name);
 
   if (plugin != mPlugins.end()) {
     if (!plugin->second.mIsInitialized) {
 
-      // First provide the plugin with all required class instances.
-      plugin->second.mPlugin->setAPI(mSettings, mSolarSystem, mGuiManager, mInputManager,
-          GetVistaSystem()->GetGraphicsManager()->GetSceneGraph(), mGraphicsEngine, mTimeControl);
-
       // Then do the actual initialization. This may actually take a while and the application will
-      // become unresponsive in the meantime.
+      // become unresponsive in the meantime. Most of the work should be done in prepare() which
+      // usually has been started on a worker thread by preparePlugins().
       try {
+        if (plugin->second.mPreparation.valid()) {
+          // This rethrows any exception thrown by prepare().
+          std::future<void> preparation = std::move(plugin->second.mPreparation);
+          preparation.get();
+        } else {
+          // First provide the plugin with all required class instances.
+          plugin->second.mPlugin->setAPI(mSettings, mSolarSystem, mGuiManager, mInputManager,
+              GetVistaSystem()->GetGraphicsManager()->GetSceneGraph(), mGraphicsEngine,
+              mTimeControl);
+
+          auto start = std::chrono::steady_clock::now();
+          plugin->second.mPlugin->prepare();
+          plugin->second.mPrepareTime = std::chrono::duration<double, std::milli>(
+              std::chrono::steady_clock::now() - start)
+                                            .count();
+        }
+
+        auto start = std::chrono::steady_clock::now();
         plugin->second.mPlugin->init();
+        plugin->second.mInitTime =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                .count();
+
         plugin->second.mIsInitialized = true;
 
         // Plugin finished loading -> init its custom components.
@@ -776,6 +880,24 @@ void Application::initPlugin(std::string const& name) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void Application::printPluginStartupTimes() const {
+  double totalPrepare = 0.0;
+  double totalInit    = 0.0;
+
+  logger().info("Plugin startup times (prepare() on worker threads, init() on main thread):");
+
+  for (auto const& plugin : mPlugins) {
+    logger().info("  {:<30} {:9.1f} ms {:9.1f} ms", plugin.first, plugin.second.mPrepareTime,
+        plugin.second.mInitTime);
+    totalPrepare += plugin.second.mPrepareTime;
+    totalInit += plugin.second.mInitTime;
+  }
+
+  logger().info("  {:<30} {:9.1f} ms {:9.1f} ms", "Total", totalPrepare, totalInit);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void Application::deinitPlugin(std::string const& name) {
   auto plugin = mPlugins.find(name);
 
@@ -889,16 +1011,16 @@ void Application::connectSlots() {
         fmt::format("CosmoScout.state.observerSpeed = {};", speed));
   });
 
-  // Show log messages in the user interface.
+  // Show log messages in the user interface. The messages are collected here and sent to the user
+  // interface in one batch once per frame, see FrameUpdate().
   mOnMessageConnection = cs::utils::onLogMessage().connect(
       [this](
           std::string const& logger, spdlog::level::level_enum level, std::string const& message) {
-        const std::unordered_map<spdlog::level::level_enum, std::string> mapping = {
+        static const std::unordered_map<spdlog::level::level_enum, std::string> mapping = {
             {spdlog::level::trace, "T"}, {spdlog::level::debug, "D"}, {spdlog::level::info, "I"},
             {spdlog::level::warn, "W"}, {spdlog::level::err, "E"}, {spdlog::level::critical, "C"}};
 
-        mGuiManager->getGui()->callJavascript(
-            "CosmoScout.statusbar.printMessage", mapping.at(level), logger, message);
+        mPendingLogMessages.push_back({mapping.at(level), logger, message});
       });
 }
 
@@ -9,10 +9,14 @@
 #define CS_APPLICATION_HPP
 
 #include <VistaKernel/VistaFrameLoop.h>
+#include <array>
+#include <future>
 #include <limits>
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 #ifdef __linux__
 #include "dlfcn.h"
@@ -41,6 +45,7 @@ class MouseRay;
 
 namespace cs::utils {
 class Downloader;
+class ThreadPool;
 } // namespace cs::utils
 
 /// This is the core class of CosmoScout VR. The application and all plugins are initialized and
@@ -61,10 +66,12 @@ class Downloader;
 ///      - After a few seconds, the data download in a background thread is started. Until
 ///        everything is downloaded, the progress is shown on the loading screen.
 ///      - SolarSystem::init() is called once the data download has finished.
+///      - PluginBase::setAPI() for each plugin
+///      - PluginBase::prepare() for all plugins in parallel on worker threads
 ///      - For each plugin:
 ///        - Show plugin name on the loading screen and wait some frames to make sure that the text
 ///          is updated.
-///        - PluginBase::setAPI()
+///        - Wait for PluginBase::prepare() of this plugin to finish
 ///        - PluginBase::init()
 ///      - When the last plugin finished loading, the loading screen is removed and the observer is
 ///        animated to its initial position in space.
@@ -105,6 +112,13 @@ class Application : public VistaFrameLoop {
     COSMOSCOUT_LIBTYPE    mHandle;
     cs::core::PluginBase* mPlugin        = nullptr;
     bool                  mIsInitialized = false;
+
+    /// This is valid while PluginBase::prepare() is executed on a worker thread.
+    std::future<void> mPreparation;
+
+    /// The time spent in PluginBase::prepare() and PluginBase::init() in milliseconds.
+    double mPrepareTime = 0.0;
+    double mInitTime    = 0.0;
   };
 
   /// Called whenever the settings are (re-)loaded;
@@ -113,9 +127,18 @@ class Application : public VistaFrameLoop {
   /// Opens a plugin from a shared library. Only the create() method of the plugin is called.
   void openPlugin(std::string const& name);
 
-  /// Calls setAPI() and init() on the given plugin. openPlugin() has to be called before.
+  /// Calls setAPI() on all opened plugins and starts their prepare() methods in parallel on
+  /// worker threads. initPlugin() will then wait for the respective preparation to finish.
+  void preparePlugins();
+
+  /// Calls setAPI(), prepare() and init() on the given plugin. openPlugin() has to be called
+  /// before. If preparePlugins() has been called before, only init() is called once the
+  /// preparation has finished.
   void initPlugin(std::string const& name);
 
+  /// Prints the time spent in prepare() and init() for each plugin.
+  void printPluginStartupTimes() const;
+
   /// Calls deinit() on the given plugin. initPlugin() has to be called before.
   void deinitPlugin(std::string const& name);
 
@@ -175,16 +198,23 @@ class Application : public VistaFrameLoop {
   std::unique_ptr<cs::core::DragNavigation> mDragNavigation;
   std::map<std::string, Plugin>             mPlugins;
   std::unique_ptr<cs::utils::Downloader>    mDownloader;
+  std::unique_ptr<cs::utils::ThreadPool>    mPluginPreparer;
   std::unique_ptr<IVistaClusterDataSync>    mSceneSync;
   std::unique_ptr<cs::graphics::MouseRay>   mMouseRay;
 
   bool mDownloadedData            = false;
   bool mLoadedAllPlugins          = false;
   int  mStartPluginLoadingAtFrame = 0;
+  int  mNextPluginToInit          = 0;
+  int  mInitNextPluginAtFrame     = 0;
   int  mHideLoadingScreenAtFrame  = 0;
 
   int mOnMessageConnection = -1;
 
+  // Log messages which will be shown in the on-screen console at the end of the current frame. Each
+  // entry contains the level, the logger name and the message.
+  std::vector<std::array<std::string, 3>> mPendingLogMessages;
+
   // Used to reset the observer to the last known working simulation time in case of missing SPICE
   // data.
   double mLastUpdateSimulationTime = std::numeric_limits<double>::max();
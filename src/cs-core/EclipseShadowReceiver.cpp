@@ -14,7 +14,6 @@
 #include "GraphicsEngine.hpp"
 #include "SolarSystem.hpp"
 
-#include <VistaOGLExt/VistaGLSLShader.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <utility>
 
@@ -56,14 +55,13 @@ std::string EclipseShadowReceiver::getShaderSnippet() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void EclipseShadowReceiver::init(VistaGLSLShader* shader, uint32_t textureOffset) {
-  mShader        = shader;
+void EclipseShadowReceiver::init(uint32_t program, uint32_t textureOffset) {
   mTextureOffset = textureOffset;
 
-  mUniforms.sun          = glGetUniformLocation(shader->GetProgram(), "uEclipseSun");
-  mUniforms.numOccluders = glGetUniformLocation(shader->GetProgram(), "uEclipseNumOccluders");
-  mUniforms.occluders    = glGetUniformLocation(shader->GetProgram(), "uEclipseOccluders");
-  mUniforms.shadowMaps   = glGetUniformLocation(shader->GetProgram(), "uEclipseShadowMaps");
+  mUniforms.sun          = glGetUniformLocation(program, "uEclipseSun");
+  mUniforms.numOccluders = glGetUniformLocation(program, "uEclipseNumOccluders");
+  mUniforms.occluders    = glGetUniformLocation(program, "uEclipseOccluders");
+  mUniforms.shadowMaps   = glGetUniformLocation(program, "uEclipseShadowMaps");
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -76,17 +74,19 @@ void EclipseShadowReceiver::update(scene::CelestialObject const& shadowReceiver)
     return;
   }
 
-  // Acquire a list of all potentially relevant eclipse shadow maps.
-  mShadowMaps = mSolarSystem->getEclipseShadowMaps(shadowReceiver, mAllowSelfShadowing);
+  // Acquire a list of all potentially relevant eclipse shadow casters. Their shadow volumes have
+  // been computed by the SolarSystem for this frame already.
+  auto casters = mSolarSystem->getEclipseShadowCasters(shadowReceiver, mAllowSelfShadowing);
 
   // For each shadow-casting body, we store the observer-relative position and the observer-relative
   // radius. For now, all occluders are considered to be spheres.
-  for (size_t i(0); i < mShadowMaps.size() && i < MAX_BODIES; ++i) {
-    auto object = mSolarSystem->getObject(mShadowMaps[i]->mOccluder);
-    auto pos    = object->getObserverRelativePosition();
+  mShadowMaps.clear();
+  for (size_t i(0); i < casters.size(); ++i) {
+    mShadowMaps.push_back(casters[i]->mShadowMap);
 
-    mOccluders[i] = glm::vec4(
-        pos, object->getRadii()[0] * object->getScale() / mSolarSystem->getObserver().getScale());
+    if (i < MAX_BODIES) {
+      mOccluders[i] = casters[i]->mOccluder;
+    }
   }
 }
 
@@ -94,7 +94,7 @@ void EclipseShadowReceiver::update(scene::CelestialObject const& shadowReceiver)
 
 void EclipseShadowReceiver::preRender() const {
 
-  mShader->SetUniform(mUniforms.numOccluders, static_cast<int>(mShadowMaps.size()));
+  glUniform1i(mUniforms.numOccluders, static_cast<int>(mShadowMaps.size()));
 
   // Bind all eclipse shadow maps and upload the respective caster positions and radii.
   if (!mShadowMaps.empty()) {
@@ -111,7 +111,7 @@ void EclipseShadowReceiver::preRender() const {
     // Also, the Sun's position and radius is required.
     auto sunPos    = mSolarSystem->pSunPosition.get();
     auto sunRadius = mSolarSystem->getSun()->getRadii()[0] / mSolarSystem->getObserver().getScale();
-    mShader->SetUniform(mUniforms.sun, static_cast<float>(sunPos.x), static_cast<float>(sunPos.y),
+    glUniform4f(mUniforms.sun, static_cast<float>(sunPos.x), static_cast<float>(sunPos.y),
         static_cast<float>(sunPos.z), static_cast<float>(sunRadius));
   }
 }
@@ -126,4 +126,10 @@ void EclipseShadowReceiver::postRender() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+bool EclipseShadowReceiver::hasOccluders() const {
+  return !mShadowMaps.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace cs::core
\ No newline at end of file
@@ -15,8 +15,6 @@
 #include <memory>
 #include <vector>
 
-class VistaGLSLShader;
-
 namespace cs::scene {
 class CelestialObject;
 class CelestialObserver;
@@ -71,10 +69,10 @@ class CS_CORE_EXPORT EclipseShadowReceiver {
   /// needsRecompilation() and if this returns true, you'll have to re-call this method.
   std::string getShaderSnippet() const;
 
-  /// This should be called once the shader has been compiled. The textureOffset will be used for
-  /// binding the eclipse shadow maps. There should be at least MAX_BODIES free texture units at
-  /// this point.
-  void init(VistaGLSLShader* shader, uint32_t textureOffset);
+  /// This should be called once the shader program has been compiled. The textureOffset will be
+  /// used for binding the eclipse shadow maps. There should be at least MAX_BODIES free texture
+  /// units at this point.
+  void init(uint32_t program, uint32_t textureOffset);
 
   /// This should be called once each frame.
   void update(scene::CelestialObject const& shadowReceiver);
@@ -86,6 +84,11 @@ class CS_CORE_EXPORT EclipseShadowReceiver {
   /// This should be called after rendering the object. It will unbind all eclipse shadow maps.
   void postRender() const;
 
+  /// Returns true if at least one body may currently cast a shadow onto the receiver. This is
+  /// updated in update(). Renderers can use this to draw objects which are not in any shadow in
+  /// bulk, without calling preRender() and postRender() for each of them.
+  bool hasOccluders() const;
+
  private:
   static constexpr size_t MAX_BODIES = 4;
 
@@ -93,8 +96,7 @@ class CS_CORE_EXPORT EclipseShadowReceiver {
   std::shared_ptr<SolarSystem> mSolarSystem;
   bool                         mAllowSelfShadowing;
 
-  VistaGLSLShader* mShader        = nullptr;
-  uint32_t         mTextureOffset = 0;
+  uint32_t mTextureOffset = 0;
 
   std::array<glm::vec4, MAX_BODIES>                        mOccluders{};
   std::vector<std::shared_ptr<graphics::EclipseShadowMap>> mShadowMaps;
@@ -10,8 +10,10 @@
 #include "../cs-graphics/ClearHDRBufferNode.hpp"
 #include "../cs-graphics/EclipseShadowMap.hpp"
 #include "../cs-graphics/SetupGLNode.hpp"
+#include "../cs-graphics/ShaderCache.hpp"
 #include "../cs-graphics/TextureLoader.hpp"
 #include "../cs-graphics/ToneMappingNode.hpp"
+#include "../cs-utils/FrameStats.hpp"
 #include "../cs-utils/utils.hpp"
 #include "logger.hpp"
 
@@ -168,6 +170,9 @@ GraphicsEngine::GraphicsEngine(std::shared_ptr<core::Settings> settings)
 
   mHDRBuffer = std::make_shared<graphics::HDRBuffer>(multiSamples);
 
+  // Screen-space effects share this snapshot of the scene's depth and color.
+  mSceneSnapshot = std::make_shared<graphics::SceneSnapshot>(mHDRBuffer);
+
   // Create a node which clears the HDRBuffer at the beginning of a frame (this will be enabled only
   // if HDR rendering is enabled).
   mClearNode        = std::make_shared<graphics::ClearHDRBufferNode>(mHDRBuffer);
@@ -215,10 +220,12 @@ GraphicsEngine::GraphicsEngine(std::shared_ptr<core::Settings> settings)
     mToneMappingNode->setMaxAutoExposure(val[1]);
   });
 
-  mSettings->mGraphics.pEnableHDR.connectAndTouch([clearGLNode, toneMappingGLNode](bool enabled) {
-    clearGLNode->SetIsEnabled(enabled);
-    toneMappingGLNode->SetIsEnabled(enabled);
-  });
+  mSettings->mGraphics.pEnableHDR.connectAndTouch(
+      [this, clearGLNode, toneMappingGLNode](bool enabled) {
+        clearGLNode->SetIsEnabled(enabled);
+        toneMappingGLNode->SetIsEnabled(enabled);
+        mSceneSnapshot->setEnableHDR(enabled);
+      });
 
   mSettings->mGraphics.pEnableAutoExposure.connectAndTouch(
       [this](bool enabled) { mToneMappingNode->setEnableAutoExposure(enabled); });
@@ -237,6 +244,9 @@ GraphicsEngine::~GraphicsEngine() {
     // Tell the user what's going on.
     logger().debug("Deleting GraphicsEngine.");
   } catch (...) {}
+
+  // The cached shader programs have to be released while the OpenGL context still exists.
+  graphics::ShaderCache::get().clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -287,6 +297,12 @@ void GraphicsEngine::update(glm::vec3 const& sunDirection) {
     pAverageLuminance = mToneMappingNode->getLastAverageLuminance();
     pMaximumLuminance = mToneMappingNode->getLastMaximumLuminance();
   }
+
+  // Upload textures which have been loaded in the background.
+  {
+    utils::FrameStats::ScopedTimer timer("Upload Textures", utils::FrameStats::TimerMode::eCPU);
+    graphics::TextureLoader::uploadPendingTextures();
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -303,6 +319,12 @@ std::shared_ptr<graphics::HDRBuffer> GraphicsEngine::getHDRBuffer() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+std::shared_ptr<graphics::SceneSnapshot> GraphicsEngine::getSceneSnapshot() const {
+  return mSceneSnapshot;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 std::vector<std::shared_ptr<graphics::EclipseShadowMap>> const&
 GraphicsEngine::getEclipseShadowMaps() const {
   return mEclipseShadowMaps;
@@ -310,6 +332,29 @@ GraphicsEngine::getEclipseShadowMaps() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+int GraphicsEngine::registerPendingRequestsCallback(std::function<uint32_t()> callback) {
+  mPendingRequestsCallbacks.emplace(++mNextPendingRequestsCallbackID, std::move(callback));
+  return mNextPendingRequestsCallbackID;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GraphicsEngine::unregisterPendingRequestsCallback(int id) {
+  mPendingRequestsCallbacks.erase(id);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t GraphicsEngine::getPendingRequests() const {
+  uint32_t pending = graphics::TextureLoader::getPendingCount();
+  for (auto const& [id, callback] : mPendingRequestsCallbacks) {
+    pending += callback();
+  }
+  return pending;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void GraphicsEngine::calculateCascades() {
   float              nearEnd = mSettings->mGraphics.pShadowMapRange.get().x;
   float              farEnd  = mSettings->mGraphics.pShadowMapRange.get().y;
@@ -9,11 +9,14 @@
 #define CS_CORE_GRAPHICS_GraphicsEngine_HPP
 
 #include "../cs-graphics/HDRBuffer.hpp"
+#include "../cs-graphics/SceneSnapshot.hpp"
 #include "../cs-graphics/Shadows.hpp"
 #include "../cs-utils/Property.hpp"
 #include "Settings.hpp"
 
+#include <functional>
 #include <glm/glm.hpp>
+#include <map>
 #include <memory>
 
 namespace cs::graphics {
@@ -55,21 +58,41 @@ class CS_CORE_EXPORT GraphicsEngine {
   std::shared_ptr<graphics::ShadowMap> getShadowMap() const;
   std::shared_ptr<graphics::HDRBuffer> getHDRBuffer() const;
 
+  /// Screen-space effects which need the depth or color of the already rendered scene should get it
+  /// from this snapshot instead of copying the framebuffer themselves. See the SceneSnapshot class
+  /// for details.
+  std::shared_ptr<graphics::SceneSnapshot> getSceneSnapshot() const;
+
   /// Returns a list of all available eclipse shadow maps. You can use the eclipse shadow API of the
   /// SolarSystem to get all relevant eclipse shadow maps for a given position in space.
   std::vector<std::shared_ptr<graphics::EclipseShadowMap>> const& getEclipseShadowMaps() const;
 
+  /// Plugins which load data asynchronously (for example terrain tiles or map overlays) can
+  /// register a callback here which returns the number of their currently pending requests. This
+  /// is used for instance by csp-recorder to wait for all data to arrive before a frame is
+  /// captured. The returned ID can be used to unregister the callback again.
+  int  registerPendingRequestsCallback(std::function<uint32_t()> callback);
+  void unregisterPendingRequestsCallback(int id);
+
+  /// Returns the sum of the values reported by all registered pending-requests callbacks plus the
+  /// number of textures which are still being loaded by the graphics::TextureLoader. This should
+  /// only be called from the main thread.
+  uint32_t getPendingRequests() const;
+
  private:
   void calculateCascades();
 
   std::shared_ptr<core::Settings>                          mSettings;
   std::shared_ptr<graphics::ShadowMap>                     mShadowMap;
   std::shared_ptr<graphics::HDRBuffer>                     mHDRBuffer;
+  std::shared_ptr<graphics::SceneSnapshot>                 mSceneSnapshot;
   std::shared_ptr<graphics::ClearHDRBufferNode>            mClearNode;
   std::shared_ptr<graphics::SetupGLNode>                   mSetupGLNode;
   std::shared_ptr<graphics::ToneMappingNode>               mToneMappingNode;
   std::vector<std::shared_ptr<graphics::EclipseShadowMap>> mEclipseShadowMaps;
   std::shared_ptr<VistaTexture>                            mFallbackEclipseShadowMap;
+  std::map<int, std::function<uint32_t()>>                 mPendingRequestsCallbacks;
+  int                                                      mNextPendingRequestsCallbackID = 0;
 };
 
 } // namespace cs::core
@@ -35,6 +35,10 @@
 #include <VistaKernel/VistaSystem.h>
 #include <VistaKernelOpenSGExt/VistaOpenSGMaterialTools.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace cs::core {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -223,6 +227,76 @@ void InputManager::unregisterSelectable(IVistaNode* pNode) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+InputManager::Intersection InputManager::pickObject(
+    glm::dvec3 const& rayOrigin, glm::dvec3 const& rayDir) {
+
+  // Broadphase: Only objects whose bounding sphere is hit by the ray are candidates. They are
+  // sorted by the distance at which the ray enters their bounding sphere.
+  mPickingCandidates.clear();
+
+  for (auto const& [name, object] : mSettings->mObjects) {
+    auto const& intersectable = object->getIntersectableObject();
+
+    if (!intersectable) {
+      continue;
+    }
+
+    auto const& transform = object->getObserverRelativeTransform();
+    double      radius    = intersectable->getBoundingRadius();
+    double      entry     = 0.0;
+
+    if (!std::isinf(radius)) {
+      radius *= glm::length(glm::dvec3(transform[0]));
+
+      glm::dvec3 toOrigin = rayOrigin - glm::dvec3(transform[3]);
+      double     b        = glm::dot(toOrigin, rayDir);
+      double     det      = b * b - glm::dot(toOrigin, toOrigin) + radius * radius;
+
+      // The ray misses the sphere or the sphere is behind the ray origin.
+      if (det < 0.0 || -b + std::sqrt(det) < 0.0) {
+        continue;
+      }
+
+      entry = std::max(0.0, -b - std::sqrt(det));
+    }
+
+    mPickingCandidates.push_back({entry, &name, &object});
+  }
+
+  std::sort(mPickingCandidates.begin(), mPickingCandidates.end(),
+      [](auto const& a, auto const& b) { return a.mEntry < b.mEntry; });
+
+  // Narrowphase: Run the precise test from near to far. Once we have a hit, all candidates whose
+  // bounding sphere starts farther away cannot be closer.
+  Intersection intersection;
+  double       nearest = std::numeric_limits<double>::infinity();
+
+  for (auto const& candidate : mPickingCandidates) {
+    if (candidate.mEntry >= nearest) {
+      break;
+    }
+
+    auto const& object = *candidate.mObject;
+    glm::dvec3  pos(0.0, 0.0, 0.0);
+
+    if (object->getIntersectableObject()->getIntersection(rayOrigin, rayDir, pos)) {
+      glm::dvec3 hit(object->getObserverRelativeTransform() * glm::dvec4(pos, 1.0));
+      double     distance = glm::length(hit - rayOrigin);
+
+      if (distance < nearest) {
+        nearest                  = distance;
+        intersection.mObject     = object;
+        intersection.mObjectName = *candidate.mName;
+        intersection.mPosition   = pos;
+      }
+    }
+  }
+
+  return intersection;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void InputManager::update() {
   auto* pSG = GetVistaSystem()->GetGraphicsManager()->GetSceneGraph();
 
@@ -237,25 +311,8 @@ void InputManager::update() {
   VistaVector3D v3Direction = qOrientation.GetViewDir();
 
   // Test the Intention Node for Intersection with planets.
-  Intersection intersection;
-  for (auto const& [name, object] : mSettings->mObjects) {
-    if (object->getIntersectableObject()) {
-      glm::dvec3 pos(0.0, 0.0, 0.0);
-
-      bool intersects = object->getIntersectableObject()->getIntersection(
-          glm::dvec3(v3Position[0], v3Position[1], v3Position[2]),
-          glm::dvec3(v3Direction[0], v3Direction[1], v3Direction[2]), pos);
-
-      if (intersects) {
-        intersection.mObject     = object;
-        intersection.mObjectName = name;
-        intersection.mPosition   = pos;
-        break;
-      }
-    }
-  }
-
-  pHoveredObject = intersection;
+  pHoveredObject = pickObject(glm::dvec3(v3Position[0], v3Position[1], v3Position[2]),
+      glm::normalize(glm::dvec3(v3Direction[0], v3Direction[1], v3Direction[2])));
 
   // If there is an active node, we do not want to change any selection state.
   if (pActiveNode.get()) {
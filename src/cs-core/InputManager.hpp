@@ -22,6 +22,7 @@
 #include <glm/glm.hpp>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
@@ -151,7 +152,7 @@ class CS_CORE_EXPORT InputManager : public VistaKeyboardSystemControl::IVistaDir
   void unregisterSelectable(gui::ScreenSpaceGuiArea* pGui);
 
   /// This method computes the intersection between the mouse ray (SELECTION_NODE) and all
-  /// registered objects.
+  /// registered objects. If multiple objects are hit, the one closest to the ray origin is chosen.
   void update();
 
   // overrides of ViSTA base classes ---------------------------------------------------------------
@@ -165,8 +166,23 @@ class CS_CORE_EXPORT InputManager : public VistaKeyboardSystemControl::IVistaDir
   bool HandleKeyPress(int key, int mods, bool bIsKeyRepeat) override;
 
  private:
+  /// An object whose bounding sphere is hit by the mouse ray. mEntry is the distance along the ray
+  /// at which it enters this sphere.
+  struct PickingCandidate {
+    double                                               mEntry;
+    std::string const*                                   mName;
+    std::shared_ptr<const scene::CelestialObject> const* mObject;
+  };
+
+  /// Intersects the given ray with all intersectable objects. Objects whose bounding sphere is not
+  /// hit are skipped; the others are tested from near to far until the nearest hit is known.
+  Intersection pickObject(glm::dvec3 const& rayOrigin, glm::dvec3 const& rayDir);
+
   std::shared_ptr<core::Settings> mSettings;
 
+  // This is reused each frame to avoid allocations.
+  std::vector<PickingCandidate> mPickingCandidates;
+
   VistaIntentionSelect                         mSelection;
   std::unordered_set<VistaNodeAdapter*>        mAdapters;
   std::unordered_set<gui::ScreenSpaceGuiArea*> mScreenSpaceGuis;
@@ -52,8 +52,17 @@ class CS_CORE_EXPORT PluginBase {
       VistaSceneGraph* sceneGraph, std::shared_ptr<GraphicsEngine> graphicsEngine,
       std::shared_ptr<TimeControl> timeControl);
 
+  /// Override this function to perform the expensive parts of your initialization which neither
+  /// require the OpenGL context nor access to the scene graph or the user interface. This includes
+  /// reading files, parsing data or precomputing look-up tables. At application startup, this is
+  /// called on a worker thread concurrently to the prepare() methods of other plugins. Hence it
+  /// must not modify any shared state of the application. It will be called after setAPI() and
+  /// before init(). If it throws, init() will not be called.
+  virtual void prepare(){};
+
   /// Override this function to initialize your plugin. It will be called directly after
-  /// application startup and before the update loop starts.
+  /// application startup and before the update loop starts. It is always called on the main
+  /// thread, after prepare() has finished.
   virtual void init(){};
 
   /// Override this function for cleaning up after yourself, when the plugin terminates. We don't
@@ -34,67 +34,139 @@ namespace cs::utils {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+cs::scene::CelestialObject objectFromJson(nlohmann::json const& data) {
+  cs::scene::CelestialObject object;
+
+  // First, we parse the required parameters.
+  std::string                center, frame;
+  std::array<std::string, 2> existence;
+  cs::core::Settings::deserialize(data, "center", center);
+  cs::core::Settings::deserialize(data, "frame", frame);
+  cs::core::Settings::deserialize(data, "existence", existence);
+
+  object.setCenterName(center);
+  object.setFrameName(frame);
+  object.setExistenceAsStrings(existence);
+
+  // All others are optional.
+  std::optional<glm::dvec3> position, radii;
+  std::optional<glm::dquat> rotation;
+  std::optional<double>     scale, bodyCullingRadius, orbitCullingRadius;
+  std::optional<bool>       trackable, collidable;
+  cs::core::Settings::deserialize(data, "position", position);
+  cs::core::Settings::deserialize(data, "rotation", rotation);
+  cs::core::Settings::deserialize(data, "scale", scale);
+  cs::core::Settings::deserialize(data, "radii", radii);
+  cs::core::Settings::deserialize(data, "bodyCullingRadius", bodyCullingRadius);
+  cs::core::Settings::deserialize(data, "orbitCullingRadius", orbitCullingRadius);
+  cs::core::Settings::deserialize(data, "trackable", trackable);
+  cs::core::Settings::deserialize(data, "collidable", collidable);
+
+  if (position.has_value()) {
+    object.setPosition(position.value());
+  }
+  if (rotation.has_value()) {
+    object.setRotation(rotation.value());
+  }
+  if (scale.has_value()) {
+    object.setScale(scale.value());
+  }
+  if (radii.has_value()) {
+    object.setRadii(radii.value());
+  }
+  if (bodyCullingRadius.has_value()) {
+    object.setBodyCullingRadius(bodyCullingRadius.value());
+  }
+  if (orbitCullingRadius.has_value()) {
+    object.setOrbitCullingRadius(orbitCullingRadius.value());
+  }
+  if (trackable.has_value()) {
+    object.setIsTrackable(trackable.value());
+  }
+  if (collidable.has_value()) {
+    object.setIsCollidable(collidable.value());
+  }
+
+  return object;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+nlohmann::json objectToJson(cs::scene::CelestialObject const& object) {
+  nlohmann::json i;
+
+  cs::core::Settings::serialize(i, "center", object.getCenterName());
+  cs::core::Settings::serialize(i, "frame", object.getFrameName());
+  cs::core::Settings::serialize(i, "existence", object.getExistenceAsStrings());
+
+  if (object.getPosition() != glm::dvec3(0.0, 0.0, 0.0)) {
+    cs::core::Settings::serialize(i, "position", object.getPosition());
+  }
+  if (object.getRotation() != glm::dquat(1.0, 0.0, 0.0, 0.0)) {
+    cs::core::Settings::serialize(i, "rotation", object.getRotation());
+  }
+  if (object.getScale() != 1.0) {
+    cs::core::Settings::serialize(i, "scale", object.getScale());
+  }
+  if (object.hasCustomRadii()) {
+    cs::core::Settings::serialize(i, "radii", object.getRadii());
+  }
+  if (object.getBodyCullingRadius() != 0) {
+    cs::core::Settings::serialize(i, "bodyCullingRadius", object.getBodyCullingRadius());
+  }
+  if (object.getOrbitCullingRadius() != 0) {
+    cs::core::Settings::serialize(i, "orbitCullingRadius", object.getOrbitCullingRadius());
+  }
+  if (!object.getIsTrackable()) {
+    cs::core::Settings::serialize(i, "trackable", object.getIsTrackable());
+  }
+  if (!object.getIsCollidable()) {
+    cs::core::Settings::serialize(i, "collidable", object.getIsCollidable());
+  }
+
+  return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void from_json(nlohmann::json const&                                               j,
     ObservableMap<std::string, std::shared_ptr<const cs::scene::CelestialObject>>& o) {
 
-  o.clear();
+  // Objects which are not present anymore are removed.
+  std::vector<std::string> removed;
+  for (auto const& entry : o) {
+    if (j.find(entry.first) == j.end()) {
+      removed.push_back(entry.first);
+    }
+  }
+
+  for (auto const& name : removed) {
+    o.erase(name);
+  }
 
+  // Objects which did not change are kept. This way, plugins do not have to re-attach their
+  // surfaces or intersectable objects and no onRemove / onAdd signals are emitted for them.
   for (auto const& el : j.items()) {
-    std::string                name = el.key();
-    nlohmann::json             data = el.value();
-    cs::scene::CelestialObject object;
-
-    // First, we parse the required parameters.
-    std::string                center, frame;
-    std::array<std::string, 2> existence;
-    cs::core::Settings::deserialize(data, "center", center);
-    cs::core::Settings::deserialize(data, "frame", frame);
-    cs::core::Settings::deserialize(data, "existence", existence);
-
-    object.setCenterName(center);
-    object.setFrameName(frame);
-    object.setExistenceAsStrings(existence);
-
-    // All others are optional.
-    std::optional<glm::dvec3> position, radii;
-    std::optional<glm::dquat> rotation;
-    std::optional<double>     scale, bodyCullingRadius, orbitCullingRadius;
-    std::optional<bool>       trackable, collidable;
-    cs::core::Settings::deserialize(data, "position", position);
-    cs::core::Settings::deserialize(data, "rotation", rotation);
-    cs::core::Settings::deserialize(data, "scale", scale);
-    cs::core::Settings::deserialize(data, "radii", radii);
-    cs::core::Settings::deserialize(data, "bodyCullingRadius", bodyCullingRadius);
-    cs::core::Settings::deserialize(data, "orbitCullingRadius", orbitCullingRadius);
-    cs::core::Settings::deserialize(data, "trackable", trackable);
-    cs::core::Settings::deserialize(data, "collidable", collidable);
-
-    if (position.has_value()) {
-      object.setPosition(position.value());
-    }
-    if (rotation.has_value()) {
-      object.setRotation(rotation.value());
-    }
-    if (scale.has_value()) {
-      object.setScale(scale.value());
-    }
-    if (radii.has_value()) {
-      object.setRadii(radii.value());
-    }
-    if (bodyCullingRadius.has_value()) {
-      object.setBodyCullingRadius(bodyCullingRadius.value());
-    }
-    if (orbitCullingRadius.has_value()) {
-      object.setOrbitCullingRadius(orbitCullingRadius.value());
-    }
-    if (trackable.has_value()) {
-      object.setIsTrackable(trackable.value());
-    }
-    if (collidable.has_value()) {
-      object.setIsCollidable(collidable.value());
+    auto object   = objectFromJson(el.value());
+    auto existing = o.find(el.key());
+
+    if (existing != o.end()) {
+      if (objectToJson(*existing->second) == objectToJson(object)) {
+        continue;
+      }
+
+      o.erase(el.key());
     }
 
-    o.insert(name, std::make_shared<cs::scene::CelestialObject>(object));
+    o.insert(el.key(), std::make_shared<cs::scene::CelestialObject>(object));
   }
 }
 
@@ -104,39 +176,7 @@ void to_json(nlohmann::json&
   j.clear();
 
   for (auto const& [name, object] : o) {
-
-    nlohmann::json i;
-
-    cs::core::Settings::serialize(i, "center", object->getCenterName());
-    cs::core::Settings::serialize(i, "frame", object->getFrameName());
-    cs::core::Settings::serialize(i, "existence", object->getExistenceAsStrings());
-
-    if (object->getPosition() != glm::dvec3(0.0, 0.0, 0.0)) {
-      cs::core::Settings::serialize(i, "position", object->getPosition());
-    }
-    if (object->getRotation() != glm::dquat(1.0, 0.0, 0.0, 0.0)) {
-      cs::core::Settings::serialize(i, "rotation", object->getRotation());
-    }
-    if (object->getScale() != 1.0) {
-      cs::core::Settings::serialize(i, "scale", object->getScale());
-    }
-    if (object->hasCustomRadii()) {
-      cs::core::Settings::serialize(i, "radii", object->getRadii());
-    }
-    if (object->getBodyCullingRadius() != 0) {
-      cs::core::Settings::serialize(i, "bodyCullingRadius", object->getBodyCullingRadius());
-    }
-    if (object->getOrbitCullingRadius() != 0) {
-      cs::core::Settings::serialize(i, "orbitCullingRadius", object->getOrbitCullingRadius());
-    }
-    if (!object->getIsTrackable()) {
-      cs::core::Settings::serialize(i, "trackable", object->getIsTrackable());
-    }
-    if (!object->getIsCollidable()) {
-      cs::core::Settings::serialize(i, "collidable", object->getIsCollidable());
-    }
-
-    j[name] = i;
+    j[name] = objectToJson(*object);
   }
 }
 
@@ -436,19 +476,41 @@ void Settings::loadFromFile(std::string const& fileName) {
   nlohmann::json settings;
   i >> settings;
 
-  from_json(settings, *this);
-
-  // Notify listeners that values might have changed.
-  mOnLoad.emit();
+  load(settings);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Settings::loadFromJson(std::string const& json) {
 
-  nlohmann::json settings = nlohmann::json::parse(json);
+  load(nlohmann::json::parse(json));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Settings::hasPluginSettingsChanged(std::string const& plugin) const {
+  return mChangedPlugins.find(plugin) != mChangedPlugins.end();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Settings::load(nlohmann::json const& settings) {
+
+  // Let the plugins store their current state, so that we can find out which of them are actually
+  // affected by the new settings.
+  mOnSave.emit();
+  auto previousPlugins = mPlugins;
+
   from_json(settings, *this);
 
+  mChangedPlugins.clear();
+  for (auto const& [name, pluginSettings] : mPlugins) {
+    auto previous = previousPlugins.find(name);
+    if (previous == previousPlugins.end() || previous->second != pluginSettings) {
+      mChangedPlugins.insert(name);
+    }
+  }
+
   // Notify listeners that values might have changed.
   mOnLoad.emit();
 }
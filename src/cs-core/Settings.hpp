@@ -27,6 +27,7 @@
 #include <map>
 #include <nlohmann/json.hpp>
 #include <optional>
+#include <set>
 #include <spdlog/spdlog.h>
 #include <string>
 #include <vector>
@@ -139,6 +140,14 @@ class CS_CORE_EXPORT Settings {
   /// will be emitted.
   void loadFromJson(std::string const& json);
 
+  /// Settings are applied incrementally: Properties only emit their onChange signal if their value
+  /// actually changed and CelestialObjects which did not change are kept. Before loading, the
+  /// onSave signal is emitted so that the plugins store their current state in mPlugins. This
+  /// returns true if the settings of the given plugin differ from this state after the last call
+  /// to loadFromFile() or loadFromJson(). Plugins can use this in their onLoad handler to skip
+  /// expensive reconfiguration if nothing changed.
+  bool hasPluginSettingsChanged(std::string const& plugin) const;
+
   /// Writes the current settings to a JSON file. Before the state is written to file, the onSave
   /// signal will be emitted.
   void saveToFile(std::string const& fileName) const;
@@ -545,8 +554,12 @@ class CS_CORE_EXPORT Settings {
       nlohmann::json& j, std::string const& property, utils::DefaultProperty<T> const& target);
 
  private:
+  void load(nlohmann::json const& settings);
+
   mutable utils::Signal<> mOnLoad;
   mutable utils::Signal<> mOnSave;
+
+  std::set<std::string> mChangedPlugins;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -129,68 +129,60 @@ double SolarSystem::getSunLuminance() const {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::vector<std::shared_ptr<graphics::EclipseShadowMap>> SolarSystem::getEclipseShadowMaps(
+std::vector<SolarSystem::EclipseShadowCaster const*> SolarSystem::getEclipseShadowCasters(
     scene::CelestialObject const& receiver, bool allowSelfShadowing) const {
 
-  std::vector<std::shared_ptr<graphics::EclipseShadowMap>> result;
+  std::vector<EclipseShadowCaster const*> result;
 
-  // Loop through all registered eclipse shadow casters and test if they are casting a shadow onto
-  // the given receiver. All involved objects are considered to be spheres.
-  for (auto const& shadowMap : mGraphicsEngine->getEclipseShadowMaps()) {
-    auto occluder = getObject(shadowMap->mOccluder);
+  auto   pRec = receiver.getObserverRelativePosition() * mObserver.getScale();
+  double rRec = receiver.getRadii()[0];
+
+  for (auto const& caster : mEclipseShadowCasters) {
 
     // Avoid self-shadowing.
-    if (allowSelfShadowing || receiver.getCenterName() != occluder->getCenterName()) {
+    if (!allowSelfShadowing && receiver.getCenterName() == caster.mCenterName) {
+      continue;
+    }
 
-      // Get observer-centric positions.
-      auto pSun = mSun->getObserverRelativePosition() * mObserver.getScale();
-      auto pRec = receiver.getObserverRelativePosition() * mObserver.getScale();
-      auto pOcc = occluder->getObserverRelativePosition() * mObserver.getScale();
+    // Convert to caster-centric.
+    auto   toRec = pRec - caster.mPosition;
+    double dRec  = glm::length(toRec);
 
-      // Convert to receiver-centric.
-      pSun = pSun - pOcc;
-      pRec = pRec - pOcc;
+    // Do not consider cases where the receiver is really far away.
+    if (dRec > caster.mMaxDistance) {
+      continue;
+    }
 
-      double dSun = glm::length(pSun);
-      double dRec = glm::length(pRec);
+    // Project the vector from the occluder to the receiver onto the sun-occluder axis to get the
+    // position in shadow space. Do not consider cases where the receiver is in front of the caster.
+    double posX = glm::dot(toRec, caster.mShadowDirection);
 
-      // Do not consider cases where the receiver is really far away.
-      if (dRec > 0.1 * dSun) {
-        continue;
-      }
+    if (posX < 0.0) {
+      continue;
+    }
 
-      // Do not consider cases where the receiver is in front of the caster.
-      if (glm::dot(pSun / dSun, pRec / dRec) > 0) {
-        continue;
-      }
+    double posY = glm::length(toRec - posX * caster.mShadowDirection);
 
-      double rOcc = occluder->getRadii()[0];
-      double rRec = receiver.getRadii()[0];
-      double rSun = mSun->getRadii()[0];
+    // Distance of the penumbra cone from the sun-occluder axis at posX.
+    double penumbra = caster.mPenumbraSlope * (posX + caster.mPenumbraDistance);
 
-      // Compute distances to the tips of the umbra and penumbra cones.
-      double dUmbra    = dSun * rOcc / (rSun - rOcc);
-      double dPenumbra = dSun * rOcc / (rSun + rOcc);
+    if (posY < penumbra + rRec) {
+      result.push_back(&caster);
+    }
+  }
 
-      // Compute slopes of the penumbra cone.
-      double mPenumbra = rOcc / std::sqrt(dPenumbra * dUmbra - rOcc * rOcc);
+  return result;
+}
 
-      // Project the vector from the occluder to the receiver onto the sun-occluder axis.
-      auto toOcc        = -pRec;
-      auto sunToOccNorm = -pSun / dSun;
-      auto toOccProj    = glm::dot(toOcc, sunToOccNorm) * sunToOccNorm;
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-      // Get position in shadow space.
-      double posX = glm::length(toOccProj);
-      double posY = glm::length(toOcc - toOccProj);
+std::vector<std::shared_ptr<graphics::EclipseShadowMap>> SolarSystem::getEclipseShadowMaps(
+    scene::CelestialObject const& receiver, bool allowSelfShadowing) const {
 
-      // Distances of the penumbra and umbra cones from the sun-occluder axis at posX.
-      double penumbra = mPenumbra * (posX + dPenumbra);
+  std::vector<std::shared_ptr<graphics::EclipseShadowMap>> result;
 
-      if (posY < penumbra + rRec) {
-        result.push_back(shadowMap);
-      }
-    }
+  for (auto const* caster : getEclipseShadowCasters(receiver, allowSelfShadowing)) {
+    result.push_back(caster->mShadowMap);
   }
 
   return result;
@@ -198,6 +190,49 @@ std::vector<std::shared_ptr<graphics::EclipseShadowMap>> SolarSystem::getEclipse
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void SolarSystem::updateEclipseShadowCasters() {
+  mEclipseShadowCasters.clear();
+
+  auto   pSun = mSun->getObserverRelativePosition() * mObserver.getScale();
+  double rSun = mSun->getRadii()[0];
+
+  // The occluders are looked up and their shadow cones are computed only once per frame. The
+  // receivers then only need to test their position against these.
+  for (auto const& shadowMap : mGraphicsEngine->getEclipseShadowMaps()) {
+    auto occluder = getObject(shadowMap->mOccluder);
+
+    if (!occluder) {
+      continue;
+    }
+
+    EclipseShadowCaster caster;
+    caster.mShadowMap  = shadowMap;
+    caster.mCenterName = occluder->getCenterName();
+    caster.mPosition   = occluder->getObserverRelativePosition() * mObserver.getScale();
+
+    auto   toOcc = caster.mPosition - pSun;
+    double dSun  = glm::length(toOcc);
+    double rOcc  = occluder->getRadii()[0];
+
+    caster.mShadowDirection = toOcc / dSun;
+    caster.mMaxDistance     = 0.1 * dSun;
+
+    // Compute distances to the tips of the umbra and penumbra cones.
+    double dUmbra            = dSun * rOcc / (rSun - rOcc);
+    caster.mPenumbraDistance = dSun * rOcc / (rSun + rOcc);
+
+    // Compute slopes of the penumbra cone.
+    caster.mPenumbraSlope = rOcc / std::sqrt(caster.mPenumbraDistance * dUmbra - rOcc * rOcc);
+
+    caster.mOccluder = glm::vec4(occluder->getObserverRelativePosition(),
+        rOcc * occluder->getScale() / mObserver.getScale());
+
+    mEclipseShadowCasters.push_back(std::move(caster));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void SolarSystem::setObserver(scene::CelestialObserver const& observer) {
   mObserver = observer;
 }
@@ -262,6 +297,10 @@ void SolarSystem::update() {
     pSunPosition = mSun->getObserverRelativePosition();
   }
 
+  // The shadow volumes have to be computed after all objects have been moved and before any
+  // receiver is updated by the plugins.
+  updateEclipseShadowCasters();
+
   // Calculate luminous power of the Sun. This can be calculated by multiplying the illuminance at
   // the average distance of Earth with the surface area of a sphere with a radius of the average
   // distance of Earth.
@@ -293,11 +332,12 @@ void SolarSystem::update() {
     mLastTime     = now;
   }
 
-  // Update settings properties.
-  mSettings->mObserver.pCenter   = mObserver.getCenterName();
-  mSettings->mObserver.pFrame    = mObserver.getFrameName();
-  mSettings->mObserver.pPosition = mObserver.getPosition();
-  mSettings->mObserver.pRotation = mObserver.getRotation();
+  // Update settings properties. These change almost every frame and are mainly used to update the
+  // user interface. Hence they are applied only once per frame by the Application.
+  mSettings->mObserver.pCenter.setDeferred(mObserver.getCenterName());
+  mSettings->mObserver.pFrame.setDeferred(mObserver.getFrameName());
+  mSettings->mObserver.pPosition.setDeferred(mObserver.getPosition());
+  mSettings->mObserver.pRotation.setDeferred(mObserver.getRotation());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -16,6 +16,8 @@
 
 #include <chrono>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace cs::graphics {
@@ -119,9 +121,31 @@ class CS_CORE_EXPORT SolarSystem {
 
   // Eclipse Shadow API ----------------------------------------------------------------------------
 
+  /// The shadow volume of an eclipse shadow caster. All involved objects are considered to be
+  /// spheres. These are computed once each frame in update(), so that testing a receiver against
+  /// a caster only requires a few dot products.
+  struct EclipseShadowCaster {
+    std::shared_ptr<graphics::EclipseShadowMap> mShadowMap;
+    std::string                                 mCenterName;
+
+    glm::dvec3 mPosition;         ///< Observer-relative position of the caster in meters.
+    glm::dvec3 mShadowDirection;  ///< Normalized direction from the Sun to the caster.
+    double     mMaxDistance;      ///< Receivers farther away from the caster are ignored.
+    double     mPenumbraDistance; ///< The distance between the tip of the penumbra cone and caster.
+    double     mPenumbraSlope;    ///< The slope of the penumbra cone.
+
+    /// Observer-relative position and radius of the caster in scene units, as required by the
+    /// shaders of the EclipseShadowReceiver.
+    glm::vec4 mOccluder;
+  };
+
   /// Returns all eclipse shadow casters which may cast a shadow on the given object. If
-  /// allowSelfShadowing is set to true, this will also return the eclipse shadow map of the given
-  /// body (if there is one).
+  /// allowSelfShadowing is set to true, this will also return the eclipse shadow caster of the
+  /// given body (if there is one). The returned pointers are valid until the next call to update().
+  std::vector<EclipseShadowCaster const*> getEclipseShadowCasters(
+      scene::CelestialObject const& receiver, bool allowSelfShadowing) const;
+
+  /// Same as above, but only the eclipse shadow maps are returned.
   std::vector<std::shared_ptr<graphics::EclipseShadowMap>> getEclipseShadowMaps(
       scene::CelestialObject const& receiver, bool allowSelfShadowing) const;
 
@@ -209,12 +233,17 @@ class CS_CORE_EXPORT SolarSystem {
       double dEndTime, int iSamples);
 
  private:
+  /// Computes the shadow volumes of all eclipse shadow casters for the current frame.
+  void updateEclipseShadowCasters();
+
   std::shared_ptr<Settings>                     mSettings;
   std::shared_ptr<GraphicsEngine>               mGraphicsEngine;
   std::shared_ptr<TimeControl>                  mTimeControl;
   scene::CelestialObserver                      mObserver;
   std::shared_ptr<const scene::CelestialObject> mSun;
 
+  std::vector<EclipseShadowCaster> mEclipseShadowCasters;
+
   bool mIsInitialized              = false;
   bool mSpiceFrameChangedLastFrame = false;
 
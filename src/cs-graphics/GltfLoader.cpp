@@ -28,64 +28,16 @@
 #include <fstream>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "internal/gltfcache.hpp"
 #include "internal/gltfmodel.hpp"
 
 namespace cs::graphics {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-namespace {
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
-template <typename T>
-bool FromString(std::string const& v, T& out) {
-  std::istringstream iss(v);
-  iss >> out;
-  return (iss.rdstate() & std::stringstream::failbit) == 0;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
-std::string GetFilePathExtension(const std::string& FileName) {
-  if (FileName.find_last_of('.') != std::string::npos) {
-    return FileName.substr(FileName.find_last_of('.') + 1);
-  }
-
-  return "";
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
-} // namespace
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 GltfLoader::GltfLoader(const std::string& sGltfFile, const std::string& cubemapFilepath)
     : mShared(std::make_shared<internal::GltfShared>()) {
-  tinygltf::TinyGLTF loader;
-  std::string        err;
-  std::string        warn;
-  std::string        ext = GetFilePathExtension(sGltfFile);
-
-  bool ret = false;
-  if (ext == "glb") {
-    // Assume binary glTF.
-    ret = loader.LoadBinaryFromFile(&mShared->mTinyGltfModel, &err, &warn, sGltfFile);
-  } else {
-    // Assume ascii glTF.
-    ret = loader.LoadASCIIFromFile(&mShared->mTinyGltfModel, &err, &warn, sGltfFile);
-  }
-
-  if (!err.empty()) {
-    throw std::runtime_error(err);
-  }
-  if (!ret) {
-    std::string msg("Failed to load .glTF: ");
-    throw std::runtime_error(msg + sGltfFile);
-  }
-
-  mShared->init(mShared->mTinyGltfModel, cubemapFilepath);
+  mShared->mAsset = internal::getGltfAsset(sGltfFile, cubemapFilepath);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -168,23 +120,24 @@ void build_node(VistaSceneGraph& sg, std::shared_ptr<internal::GltfShared> const
   apply_transform(*transform_node, tinygltf_node);
   transform_node->SetName(tinygltf_node.name);
   for (int i : tinygltf_node.children) {
-    build_node(sg, shared, transform_node, shared->mTinyGltfModel.nodes[i]);
+    build_node(sg, shared, transform_node, shared->mAsset->mTinyGltfModel.nodes[i]);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool GltfLoader::attachTo(VistaSceneGraph* pSG, VistaTransformNode* parent) {
-  if (mShared->mTinyGltfModel.scenes.empty()) {
+  auto const& model = mShared->mAsset->mTinyGltfModel;
+
+  if (model.scenes.empty()) {
     return false;
   }
 
-  auto const& scene = (mShared->mTinyGltfModel.defaultScene >= 0)
-                          ? mShared->mTinyGltfModel.scenes[mShared->mTinyGltfModel.defaultScene]
-                          : mShared->mTinyGltfModel.scenes.front();
+  auto const& scene =
+      (model.defaultScene >= 0) ? model.scenes[model.defaultScene] : model.scenes.front();
 
   for (int i : scene.nodes) {
-    build_node(*pSG, mShared, parent, mShared->mTinyGltfModel.nodes[i]);
+    build_node(*pSG, mShared, parent, model.nodes[i]);
   }
   return true;
 }
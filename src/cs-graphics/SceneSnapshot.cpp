@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "SceneSnapshot.hpp"
+
+#include "HDRBuffer.hpp"
+
+#include <VistaKernel/DisplayManager/VistaDisplayManager.h>
+#include <VistaKernel/DisplayManager/VistaViewport.h>
+#include <VistaKernel/VistaFrameLoop.h>
+#include <VistaKernel/VistaSystem.h>
+#include <VistaOGLExt/VistaTexture.h>
+
+#include <array>
+
+namespace cs::graphics {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SceneSnapshot::SceneSnapshot(std::shared_ptr<HDRBuffer> hdrBuffer)
+    : mHDRBuffer(std::move(hdrBuffer)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SceneSnapshot::~SceneSnapshot() {
+  // Destructor must not be inline as the std::unique_ptrs would otherwise not accept incomplete
+  // types in the header.
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneSnapshot::setEnableHDR(bool enable) {
+  mEnableHDR = enable;
+
+  // The copies are not required anymore in HDR mode.
+  if (mEnableHDR) {
+    mSnapshots.clear();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool SceneSnapshot::getEnableHDR() const {
+  return mEnableHDR;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t SceneSnapshot::getMultiSamples() const {
+  return mEnableHDR ? mHDRBuffer->getMultiSamples() : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VistaTexture* SceneSnapshot::getDepth() {
+  if (mEnableHDR) {
+    return mHDRBuffer->getDepthAttachment();
+  }
+
+  auto& snapshot = getCurrentSnapshot();
+  update(snapshot, snapshot.mDepth, snapshot.mDepthFrame, GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT);
+  return snapshot.mDepth.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VistaTexture* SceneSnapshot::getColor() {
+  if (mEnableHDR) {
+    return mHDRBuffer->getCurrentReadAttachment();
+  }
+
+  auto& snapshot = getCurrentSnapshot();
+  update(snapshot, snapshot.mColor, snapshot.mColorFrame, GL_RGB8, GL_RGB);
+  return snapshot.mColor.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneSnapshot::invalidateColor() {
+  if (!mEnableHDR) {
+    getCurrentSnapshot().mColorFrame = -1;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneSnapshot::invalidateDepth() {
+  if (!mEnableHDR) {
+    getCurrentSnapshot().mDepthFrame = -1;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SceneSnapshot::Snapshot& SceneSnapshot::getCurrentSnapshot() {
+  auto const* renderInfo = GetVistaSystem()->GetDisplayManager()->GetCurrentRenderInfo();
+  return mSnapshots[{renderInfo->m_pViewport, static_cast<int>(renderInfo->m_eEyeRenderMode)}];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneSnapshot::update(Snapshot& snapshot, std::unique_ptr<VistaTexture>& texture, int& frame,
+    int internalFormat, int format) {
+
+  int currentFrame = GetVistaSystem()->GetFrameLoop()->GetFrameCount();
+
+  std::array<GLint, 4> viewport{};
+  glGetIntegerv(GL_VIEWPORT, viewport.data());
+
+  // If the viewport has been resized, both textures have to be re-allocated.
+  if (viewport.at(2) != snapshot.mWidth || viewport.at(3) != snapshot.mHeight) {
+    snapshot.mWidth      = viewport.at(2);
+    snapshot.mHeight     = viewport.at(3);
+    snapshot.mDepthFrame = -1;
+    snapshot.mColorFrame = -1;
+    snapshot.mDepth.reset();
+    snapshot.mColor.reset();
+  }
+
+  if (frame == currentFrame) {
+    return;
+  }
+
+  if (!texture) {
+    texture = std::make_unique<VistaTexture>(GL_TEXTURE_2D);
+    texture->Bind();
+    texture->SetWrapS(GL_CLAMP_TO_EDGE);
+    texture->SetWrapT(GL_CLAMP_TO_EDGE);
+    texture->SetMinFilter(GL_NEAREST);
+    texture->SetMagFilter(GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, snapshot.mWidth, snapshot.mHeight, 0, format,
+        GL_FLOAT, nullptr);
+  } else {
+    texture->Bind();
+  }
+
+  // The storage has been allocated above, so we can copy without re-allocating it each frame.
+  glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, viewport.at(0), viewport.at(1), snapshot.mWidth,
+      snapshot.mHeight);
+  texture->Unbind();
+
+  frame = currentFrame;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cs::graphics
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CS_GRAPHICS_SCENE_SNAPSHOT_HPP
+#define CS_GRAPHICS_SCENE_SNAPSHOT_HPP
+
+#include "cs_graphics_export.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+
+class VistaTexture;
+class VistaViewport;
+
+namespace cs::graphics {
+
+class HDRBuffer;
+
+/// The SceneSnapshot provides the depth and color of the already rendered scene to screen-space
+/// effects such as atmospheres. All of these effects share the same snapshot, so the framebuffer
+/// has to be read only once per frame, regardless of how many effects use it.
+///
+/// If HDR rendering is enabled, no copy is made at all. Instead, the attachments of the HDRBuffer
+/// are returned directly. Be aware that these are textures with the target
+/// GL_TEXTURE_2D_MULTISAMPLE if getMultiSamples() returns a value larger than zero.
+///
+/// If HDR rendering is disabled, the depth and color of the currently bound framebuffer are copied
+/// to GL_TEXTURE_2D textures when they are requested for the first time in a frame. There is a
+/// separate copy for each viewport and eye. As the copies are not updated during the rest of the
+/// frame, they should only be requested by nodes which are drawn after all opaque geometry (that
+/// is cs::utils::DrawOrder::eAtmospheres or later). Effects which read the color snapshot and write
+/// the result back to the color buffer have to call invalidateColor() afterwards. Else, the next
+/// effect would read the outdated snapshot and overwrite their output.
+class CS_GRAPHICS_EXPORT SceneSnapshot {
+ public:
+  explicit SceneSnapshot(std::shared_ptr<HDRBuffer> hdrBuffer);
+
+  SceneSnapshot(SceneSnapshot const& other) = delete;
+  SceneSnapshot(SceneSnapshot&& other)      = delete;
+
+  SceneSnapshot& operator=(SceneSnapshot const& other) = delete;
+  SceneSnapshot& operator=(SceneSnapshot&& other) = delete;
+
+  ~SceneSnapshot();
+
+  /// This is called by the GraphicsEngine whenever HDR rendering is toggled.
+  void setEnableHDR(bool enable);
+  bool getEnableHDR() const;
+
+  /// Returns the number of samples of the textures returned by getDepth() and getColor(). This is
+  /// always zero if HDR rendering is disabled.
+  uint32_t getMultiSamples() const;
+
+  /// Returns the depth of the scene for the currently rendered viewport and eye.
+  VistaTexture* getDepth();
+
+  /// Returns the color of the scene for the currently rendered viewport and eye. In HDR mode, this
+  /// is the HDRBuffer's current read attachment. Effects which draw over the entire viewport
+  /// should call HDRBuffer::doPingPong() before requesting the color in this case.
+  VistaTexture* getColor();
+
+  /// Marks the color copy of the currently rendered viewport and eye as outdated, so that the next
+  /// call to getColor() copies the framebuffer again. This does nothing in HDR mode.
+  void invalidateColor();
+
+  /// Marks the depth copy of the currently rendered viewport and eye as outdated, so that the next
+  /// call to getDepth() copies the framebuffer again. Effects drawn after
+  /// cs::utils::DrawOrder::eOpaqueNonHDR can use this to include the depth of the items drawn in
+  /// between. This does nothing in HDR mode.
+  void invalidateDepth();
+
+ private:
+  // The copies of the framebuffer for one viewport and eye. The frame members store the frame
+  // count at which the textures have been copied the last time.
+  struct Snapshot {
+    std::unique_ptr<VistaTexture> mDepth;
+    std::unique_ptr<VistaTexture> mColor;
+    int                           mDepthFrame = -1;
+    int                           mColorFrame = -1;
+    int                           mWidth      = 0;
+    int                           mHeight     = 0;
+  };
+
+  Snapshot& getCurrentSnapshot();
+
+  // Copies the given buffer of the current viewport to the texture if this has not been done in
+  // this frame yet.
+  void update(Snapshot& snapshot, std::unique_ptr<VistaTexture>& texture, int& frame,
+      int internalFormat, int format);
+
+  std::shared_ptr<HDRBuffer>                         mHDRBuffer;
+  std::map<std::pair<VistaViewport*, int>, Snapshot> mSnapshots;
+  bool                                               mEnableHDR = false;
+};
+
+} // namespace cs::graphics
+
+#endif // CS_GRAPHICS_SCENE_SNAPSHOT_HPP
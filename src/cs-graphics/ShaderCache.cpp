@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "ShaderCache.hpp"
+
+#include "../cs-utils/filesystem.hpp"
+#include "../cs-utils/utils.hpp"
+#include "ShaderProgram.hpp"
+#include "logger.hpp"
+
+#include <GL/glew.h>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+namespace cs::graphics {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr const char* CACHE_DIRECTORY = "cache/shaders";
+
+// Increase this whenever the format of the cache files changes. This invalidates all existing
+// cache files.
+constexpr uint32_t            CACHE_VERSION = 1;
+constexpr std::array<char, 4> CACHE_MAGIC   = {'C', 'S', 'P', 'B'};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string getGLString(GLenum name) {
+  auto const* value = glGetString(name);
+  return value ? reinterpret_cast<char const*>(value) : "";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ShaderCache& ShaderCache::get() {
+  static ShaderCache instance;
+  return instance;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ShaderCache::~ShaderCache() = default;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<ShaderProgram> ShaderCache::getShader(std::string const& vertexSource,
+    std::string const& fragmentSource, std::string const& geometrySource) {
+
+  // The stages are separated by a character which cannot be part of valid GLSL code. This way, no
+  // two different combinations of sources can result in the same key.
+  std::string key;
+  key.reserve(vertexSource.size() + fragmentSource.size() + geometrySource.size() + 2);
+  key.append(vertexSource).append(1, '\0');
+  key.append(geometrySource).append(1, '\0');
+  key.append(fragmentSource);
+
+  ++mRequestCount;
+
+  auto it = mShaders.find(key);
+  if (it != mShaders.end()) {
+    it->second.mLastRequest = mRequestCount;
+    return it->second.mProgram;
+  }
+
+  // Program binaries are only valid for the driver which created them. Hence the driver details
+  // are part of the file name.
+  if (!mDriverInfo) {
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    if (formats > 0) {
+      mDriverInfo = getGLString(GL_VENDOR) + "\n" + getGLString(GL_RENDERER) + "\n" +
+                    getGLString(GL_VERSION);
+    } else {
+      logger().info("The OpenGL driver does not support program binaries. Shader programs will not "
+                    "be cached on disk.");
+      mDriverInfo = "";
+    }
+  }
+
+  bool        useDisk = !mDriverInfo->empty();
+  std::string file;
+
+  if (useDisk) {
+    file = std::string(CACHE_DIRECTORY) + "/" + utils::hashString(key + '\0' + *mDriverInfo) +
+           "-v" + std::to_string(CACHE_VERSION) + ".bin";
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::shared_ptr<ShaderProgram> shader;
+
+  if (useDisk && boost::filesystem::exists(file)) {
+    shader = loadFromDisk(file);
+  }
+
+  if (shader) {
+    auto duration =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    logger().debug("Loaded shader program {} from '{}' in {:.1f} ms.", mShaders.size(), file,
+        duration.count());
+  } else {
+    shader = std::make_shared<ShaderProgram>();
+
+    // Failed programs are cached as well, so that they are not compiled again every frame.
+    bool linked = shader->link(vertexSource, fragmentSource, geometrySource, useDisk);
+
+    auto duration =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    logger().debug("Compiled shader program {} in {:.1f} ms.", mShaders.size(), duration.count());
+
+    if (useDisk && linked) {
+      saveToDisk(*shader, file);
+    }
+  }
+
+  evictUnused();
+
+  mShaders.emplace(std::move(key), Entry{shader, mRequestCount});
+
+  return shader;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderCache::clear() {
+  mShaders.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t ShaderCache::size() const {
+  return mShaders.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<ShaderProgram> ShaderCache::loadFromDisk(std::string const& file) const {
+  std::ifstream stream(file, std::ios::binary);
+
+  std::array<char, 4> magic{};
+  uint32_t            version    = 0;
+  uint32_t            infoLength = 0;
+  stream.read(magic.data(), magic.size());
+  stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+  stream.read(reinterpret_cast<char*>(&infoLength), sizeof(infoLength));
+
+  if (!stream || magic != CACHE_MAGIC || version != CACHE_VERSION ||
+      infoLength != mDriverInfo->size()) {
+    logger().warn("Ignoring invalid cache file '{}'.", file);
+    return nullptr;
+  }
+
+  // The driver info is stored as well, so that we never pass a binary of another driver to
+  // glProgramBinary() in case two file names collide.
+  std::string info(infoLength, ' ');
+  stream.read(info.data(), infoLength);
+
+  uint32_t format = 0;
+  uint32_t length = 0;
+  stream.read(reinterpret_cast<char*>(&format), sizeof(format));
+  stream.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+  if (!stream || info != *mDriverInfo) {
+    logger().warn("Ignoring invalid cache file '{}'.", file);
+    return nullptr;
+  }
+
+  std::vector<char> binary(length);
+  stream.read(binary.data(), length);
+
+  if (!stream) {
+    logger().warn("Ignoring invalid cache file '{}'.", file);
+    return nullptr;
+  }
+
+  auto shader = std::make_shared<ShaderProgram>();
+
+  if (!shader->loadBinary(format, binary)) {
+    logger().debug("The driver rejected the program binary '{}'. Compiling it again.", file);
+    return nullptr;
+  }
+
+  return shader;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Failing to write the cache is not fatal, the program will simply be compiled again next time.
+void ShaderCache::saveToDisk(ShaderProgram const& program, std::string const& file) const {
+  uint32_t          format = 0;
+  std::vector<char> binary;
+
+  if (!program.getBinary(format, binary)) {
+    return;
+  }
+
+  try {
+    cs::utils::filesystem::createDirectoryRecursively(
+        boost::filesystem::system_complete(CACHE_DIRECTORY));
+  } catch (std::exception const& e) {
+    logger().warn("Failed to create cache directory '{}': {}", CACHE_DIRECTORY, e.what());
+    return;
+  }
+
+  auto infoLength = static_cast<uint32_t>(mDriverInfo->size());
+  auto length     = static_cast<uint32_t>(binary.size());
+
+  std::ofstream stream(file, std::ios::binary);
+  stream.write(CACHE_MAGIC.data(), CACHE_MAGIC.size());
+  stream.write(reinterpret_cast<char const*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+  stream.write(reinterpret_cast<char const*>(&infoLength), sizeof(infoLength));
+  stream.write(mDriverInfo->data(), infoLength);
+  stream.write(reinterpret_cast<char const*>(&format), sizeof(format));
+  stream.write(reinterpret_cast<char const*>(&length), sizeof(length));
+  stream.write(binary.data(), length);
+
+  if (!stream) {
+    logger().warn("Failed to write cache file '{}'.", file);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderCache::evictUnused() {
+
+  // A program is unused if the cache holds the only reference to it.
+  std::vector<decltype(mShaders)::iterator> unused;
+  for (auto it = mShaders.begin(); it != mShaders.end(); ++it) {
+    if (it->second.mProgram.use_count() == 1) {
+      unused.push_back(it);
+    }
+  }
+
+  if (unused.size() <= MAX_UNUSED_PROGRAMS) {
+    return;
+  }
+
+  // Drop the least recently requested ones.
+  auto count = static_cast<std::ptrdiff_t>(unused.size() - MAX_UNUSED_PROGRAMS);
+  std::partial_sort(unused.begin(), unused.begin() + count, unused.end(),
+      [](auto const& a, auto const& b) { return a->second.mLastRequest < b->second.mLastRequest; });
+
+  for (auto it = unused.begin(); it != unused.begin() + count; ++it) {
+    mShaders.erase(*it);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cs::graphics
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CS_GRAPHICS_SHADER_CACHE_HPP
+#define CS_GRAPHICS_SHADER_CACHE_HPP
+
+#include "cs_graphics_export.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace cs::graphics {
+
+class ShaderProgram;
+
+/// The ShaderCache keeps linked shader programs in memory, keyed by their complete source code
+/// (including all defines). Requesting a program whose sources have been seen before returns the
+/// already linked instance instead of compiling it again. This removes the hitches which would
+/// otherwise occur whenever a setting which requires a recompilation (e.g. HDR rendering or
+/// lighting) is toggled back and forth. Also, objects which use identical shaders (like multiple
+/// bodies with the same settings) share a single program. Programs which are not used anymore are
+/// kept as well; but if there are more than MAX_UNUSED_PROGRAMS of them, the ones which have not
+/// been requested for the longest time are dropped.
+///
+/// In addition, the binaries of all linked programs are stored in the cache/shaders directory. If a
+/// program is requested which is not in memory, the ShaderCache first tries to restore it from
+/// there. The files are named after a hash of the sources and the OpenGL vendor, renderer and
+/// version strings, so that a driver update does not pick up incompatible binaries. If the driver
+/// still rejects a binary, the program is compiled from its sources.
+///
+/// As the returned programs may be shared, users must not attach additional shader objects to them
+/// and must set all uniforms they rely on before each draw call.
+class CS_GRAPHICS_EXPORT ShaderCache {
+ public:
+  /// Access the singleton instance.
+  static ShaderCache& get();
+
+  ShaderCache(ShaderCache const& other) = delete;
+  ShaderCache(ShaderCache&& other)      = delete;
+
+  ShaderCache& operator=(ShaderCache const& other) = delete;
+  ShaderCache& operator=(ShaderCache&& other) = delete;
+
+  ~ShaderCache();
+
+  /// Returns a linked program consisting of the given stages. The geometry shader is optional. If
+  /// a program with exactly the same sources has been requested before, this instance is returned.
+  std::shared_ptr<ShaderProgram> getShader(std::string const& vertexSource,
+      std::string const& fragmentSource, std::string const& geometrySource = "");
+
+  /// Drops all cached programs. Programs which are still used somewhere stay alive until they are
+  /// released by their users. This is called by the GraphicsEngine before the OpenGL context is
+  /// destroyed.
+  void clear();
+
+  /// Returns the number of currently cached programs.
+  size_t size() const;
+
+  /// At most this many programs which are not used anywhere are kept in memory.
+  static const size_t MAX_UNUSED_PROGRAMS = 32;
+
+ private:
+  struct Entry {
+    std::shared_ptr<ShaderProgram> mProgram;
+    uint64_t                       mLastRequest = 0;
+  };
+
+  ShaderCache() = default;
+
+  // Tries to restore the program from the given cache file. Returns nullptr on failure.
+  std::shared_ptr<ShaderProgram> loadFromDisk(std::string const& file) const;
+
+  // Stores the binary of the given program in the given cache file.
+  void saveToDisk(ShaderProgram const& program, std::string const& file) const;
+
+  // Drops the least recently requested unused programs if there are too many of them.
+  void evictUnused();
+
+  std::unordered_map<std::string, Entry> mShaders;
+  uint64_t                               mRequestCount = 0;
+
+  // The OpenGL vendor, renderer and version. This is retrieved on the first request. If the driver
+  // does not support any program binary formats, it is set to an empty string and the disk cache
+  // is not used.
+  std::optional<std::string> mDriverInfo;
+};
+
+} // namespace cs::graphics
+
+#endif // CS_GRAPHICS_SHADER_CACHE_HPP
@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "ShaderProgram.hpp"
+
+#include "logger.hpp"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace cs::graphics {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns 0 if the shader cannot be compiled.
+GLuint createShader(GLenum type, std::string const& source) {
+  GLuint      shader  = glCreateShader(type);
+  char const* pSource = source.c_str();
+  glShaderSource(shader, 1, &pSource, nullptr);
+  glCompileShader(shader);
+
+  int rvalue = 0;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &rvalue);
+  if (rvalue != GL_TRUE) {
+    auto log_length = 0;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
+    std::vector<char> v(log_length);
+    glGetShaderInfoLog(shader, log_length, nullptr, v.data());
+    std::string log(begin(v), end(v));
+    glDeleteShader(shader);
+    logger().error("ERROR: Failed to compile shader: {}", log);
+    return 0;
+  }
+
+  return shader;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ShaderProgram::ShaderProgram()
+    : mProgram(glCreateProgram()) {
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ShaderProgram::~ShaderProgram() {
+  glDeleteProgram(mProgram);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ShaderProgram::link(std::string const& vertexSource, std::string const& fragmentSource,
+    std::string const& geometrySource, bool retrievable) {
+
+  std::vector<GLuint> shaders;
+  shaders.push_back(createShader(GL_VERTEX_SHADER, vertexSource));
+
+  if (!geometrySource.empty()) {
+    shaders.push_back(createShader(GL_GEOMETRY_SHADER, geometrySource));
+  }
+
+  shaders.push_back(createShader(GL_FRAGMENT_SHADER, fragmentSource));
+
+  // The program is left unlinked if any stage failed to compile. Like for VistaGLSLShader, drawing
+  // with it will not produce any output then.
+  if (std::find(shaders.begin(), shaders.end(), 0U) != shaders.end()) {
+    for (auto shader : shaders) {
+      glDeleteShader(shader);
+    }
+    return false;
+  }
+
+  for (auto shader : shaders) {
+    glAttachShader(mProgram, shader);
+  }
+
+  if (retrievable) {
+    glProgramParameteri(mProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
+  glLinkProgram(mProgram);
+
+  // The shader objects are not required anymore once the program has been linked.
+  for (auto shader : shaders) {
+    glDetachShader(mProgram, shader);
+    glDeleteShader(shader);
+  }
+
+  int rvalue = 0;
+  glGetProgramiv(mProgram, GL_LINK_STATUS, &rvalue);
+  if (rvalue != GL_TRUE) {
+    auto log_length = 0;
+    glGetProgramiv(mProgram, GL_INFO_LOG_LENGTH, &log_length);
+    std::vector<char> v(log_length);
+    glGetProgramInfoLog(mProgram, log_length, nullptr, v.data());
+    std::string log(begin(v), end(v));
+
+    logger().error("ERROR: Failed to link shader program: {}", log);
+    return false;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ShaderProgram::loadBinary(uint32_t format, std::vector<char> const& binary) {
+  glProgramBinary(mProgram, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+  int rvalue = 0;
+  glGetProgramiv(mProgram, GL_LINK_STATUS, &rvalue);
+  return rvalue == GL_TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ShaderProgram::getBinary(uint32_t& format, std::vector<char>& binary) const {
+  int length = 0;
+  glGetProgramiv(mProgram, GL_PROGRAM_BINARY_LENGTH, &length);
+
+  if (length <= 0) {
+    return false;
+  }
+
+  binary.resize(length);
+
+  GLenum  binaryFormat = 0;
+  GLsizei written      = 0;
+  glGetProgramBinary(mProgram, length, &written, &binaryFormat, binary.data());
+
+  if (written <= 0) {
+    return false;
+  }
+
+  binary.resize(written);
+  format = binaryFormat;
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderProgram::bind() const {
+  glUseProgram(mProgram);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderProgram::release() const {
+  glUseProgram(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t ShaderProgram::getProgram() const {
+  return mProgram;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int32_t ShaderProgram::getUniformLocation(std::string const& name) const {
+  return glGetUniformLocation(mProgram, name.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderProgram::setUniform(int32_t location, int value) const {
+  glUniform1i(location, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderProgram::setUniform(int32_t location, float value) const {
+  glUniform1f(location, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderProgram::setUniform(int32_t location, float x, float y) const {
+  glUniform2f(location, x, y);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderProgram::setUniform(int32_t location, float x, float y, float z) const {
+  glUniform3f(location, x, y, z);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderProgram::setUniform(int32_t location, float x, float y, float z, float w) const {
+  glUniform4f(location, x, y, z, w);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderProgram::setUniform(
+    int32_t location, int components, int count, float const* values) const {
+  switch (components) {
+  case 1:
+    glUniform1fv(location, count, values);
+    break;
+  case 2:
+    glUniform2fv(location, count, values);
+    break;
+  case 3:
+    glUniform3fv(location, count, values);
+    break;
+  case 4:
+    glUniform4fv(location, count, values);
+    break;
+  default:
+    throw std::runtime_error(
+        "Failed to set uniform: Invalid component count " + std::to_string(components) + "!");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ShaderProgram::setUniform(
+    int32_t location, int components, int count, int const* values) const {
+  switch (components) {
+  case 1:
+    glUniform1iv(location, count, values);
+    break;
+  case 2:
+    glUniform2iv(location, count, values);
+    break;
+  case 3:
+    glUniform3iv(location, count, values);
+    break;
+  case 4:
+    glUniform4iv(location, count, values);
+    break;
+  default:
+    throw std::runtime_error(
+        "Failed to set uniform: Invalid component count " + std::to_string(components) + "!");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cs::graphics
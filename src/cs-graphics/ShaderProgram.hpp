@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CS_GRAPHICS_SHADER_PROGRAM_HPP
+#define CS_GRAPHICS_SHADER_PROGRAM_HPP
+
+#include "cs_graphics_export.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cs::graphics {
+
+/// A linked OpenGL shader program. In contrast to VistaGLSLShader, the program can not only be
+/// linked from GLSL sources but also be restored from a program binary which has been retrieved
+/// with getBinary() before. This is used by the ShaderCache to skip compilation at start-up.
+///
+/// The methods for setting uniforms behave like those of VistaGLSLShader: They affect the currently
+/// bound program, so bind() has to be called before.
+class CS_GRAPHICS_EXPORT ShaderProgram {
+ public:
+  /// Creates an empty program object. Use link() or loadBinary() to make it usable.
+  ShaderProgram();
+
+  ShaderProgram(ShaderProgram const& other) = delete;
+  ShaderProgram(ShaderProgram&& other)      = delete;
+
+  ShaderProgram& operator=(ShaderProgram const& other) = delete;
+  ShaderProgram& operator=(ShaderProgram&& other) = delete;
+
+  ~ShaderProgram();
+
+  /// Compiles the given stages and links them. The geometry shader is optional. If retrievable is
+  /// set to true, the driver is asked to keep the program binary around so that getBinary() can be
+  /// used afterwards. If compiling or linking fails, the error is logged, false is returned and the
+  /// program will not draw anything.
+  bool link(std::string const& vertexSource, std::string const& fragmentSource,
+      std::string const& geometrySource = "", bool retrievable = false);
+
+  /// Restores the program from a binary which has been retrieved with getBinary(). This returns
+  /// false if the driver rejects the binary, for example because the driver has been updated in
+  /// the meantime. In this case, link() has to be used instead.
+  bool loadBinary(uint32_t format, std::vector<char> const& binary);
+
+  /// Retrieves the binary of the linked program. This returns false if the driver does not provide
+  /// a binary for this program.
+  bool getBinary(uint32_t& format, std::vector<char>& binary) const;
+
+  /// Makes this the current program.
+  void bind() const;
+
+  /// Resets the current program.
+  void release() const;
+
+  /// Returns the name of the OpenGL program object.
+  uint32_t getProgram() const;
+
+  /// Returns the location of the given uniform or -1 if the program has no such active uniform.
+  int32_t getUniformLocation(std::string const& name) const;
+
+  /// Sets the value of a uniform of the currently bound program.
+  void setUniform(int32_t location, int value) const;
+  void setUniform(int32_t location, float value) const;
+  void setUniform(int32_t location, float x, float y) const;
+  void setUniform(int32_t location, float x, float y, float z) const;
+  void setUniform(int32_t location, float x, float y, float z, float w) const;
+
+  /// Sets count vectors of the given size (one to four components) of a uniform of the currently
+  /// bound program.
+  void setUniform(int32_t location, int components, int count, float const* values) const;
+  void setUniform(int32_t location, int components, int count, int const* values) const;
+
+ private:
+  uint32_t mProgram = 0;
+};
+
+} // namespace cs::graphics
+
+#endif // CS_GRAPHICS_SHADER_PROGRAM_HPP
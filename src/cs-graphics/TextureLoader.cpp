@@ -7,6 +7,7 @@
 
 #include "TextureLoader.hpp"
 
+#include "../cs-utils/ThreadPool.hpp"
 #include "logger.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -20,118 +21,400 @@
 #undef STB_IMAGE_RESIZE_IMPLEMENTATION
 
 #include <VistaOGLExt/VistaOGLUtils.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <gli/gli.hpp>
 #include <iostream>
+#include <list>
+#include <optional>
 #include <tiffio.h>
 #include <vector>
 
 namespace cs::graphics {
 
+namespace {
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::unique_ptr<VistaTexture> TextureLoader::loadFromFile(std::string const& sFileName) {
+// The decoded contents of an image file. This is created on a worker thread and uploaded to the GPU
+// on the main thread.
+struct ImageData {
+  int    mWidth    = 0;
+  int    mHeight   = 0;
+  GLenum mFormat   = GL_RGBA;
+  GLenum mDataType = GL_UNSIGNED_BYTE;
 
-  std::string suffix = sFileName.substr(sFileName.rfind('.'));
+  // The pixels of the image. Depending on the library which decoded the image, they have to be
+  // freed in different ways.
+  std::unique_ptr<void, void (*)(void*)> mPixels{nullptr, &std::free};
+  size_t                                 mSize = 0;
 
-  if (suffix == ".tga") {
-    // load with vista
-    logger().debug("Loading Texture '{}' with Vista.", sFileName);
-    return std::unique_ptr<VistaTexture>(VistaOGLUtils::LoadTextureFromTga(sFileName));
+  // *.ktx and *.dds files are loaded with gli, the members above are unused in this case.
+  gli::texture mTexture;
+
+  // *.tga files are loaded by Vista which does not separate decoding from uploading. Hence these
+  // are not decoded in the background.
+  bool mIsTga = false;
+
+  size_t getSize() const {
+    return mTexture.empty() ? mSize : mTexture.size();
   }
+};
 
-  std::unique_ptr<VistaTexture> result = std::make_unique<VistaTexture>(GL_TEXTURE_2D);
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  if (suffix == ".tiff" || suffix == ".tif") {
-    // load with tifflib
-    logger().debug("Loading Texture '{}' with libtiff.", sFileName);
+std::optional<ImageData> decodeTiff(std::string const& fileName) {
+  logger().debug("Loading Texture '{}' with libtiff.", fileName);
 
-    auto* data = TIFFOpen(sFileName.c_str(), "r");
-    if (!data) {
-      logger().error("Failed to load '{}' with libtiff!", sFileName);
-      return nullptr;
-    }
+  auto* data = TIFFOpen(fileName.c_str(), "r");
+  if (!data) {
+    logger().error("Failed to load '{}' with libtiff!", fileName);
+    return std::nullopt;
+  }
 
-    uint32 width{};
-    uint32 height{};
-    TIFFGetField(data, TIFFTAG_IMAGELENGTH, &height);
-    TIFFGetField(data, TIFFTAG_IMAGEWIDTH, &width);
+  uint32 width{};
+  uint32 height{};
+  TIFFGetField(data, TIFFTAG_IMAGELENGTH, &height);
+  TIFFGetField(data, TIFFTAG_IMAGEWIDTH, &width);
 
-    uint16 bpp{};
-    TIFFGetField(data, TIFFTAG_BITSPERSAMPLE, &bpp);
+  uint16 bpp{};
+  TIFFGetField(data, TIFFTAG_BITSPERSAMPLE, &bpp);
 
-    int16 channels{};
-    TIFFGetField(data, TIFFTAG_SAMPLESPERPIXEL, &channels);
+  int16 channels{};
+  TIFFGetField(data, TIFFTAG_SAMPLESPERPIXEL, &channels);
 
-    if (bpp != 8) {
-      logger().error(
-          "Failed to load '{}' with libtiff: Only 8 bit per sample are supported right now!",
-          sFileName);
-      return nullptr;
-    }
+  if (bpp != 8) {
+    logger().error(
+        "Failed to load '{}' with libtiff: Only 8 bit per sample are supported right now!",
+        fileName);
+    TIFFClose(data);
+    return std::nullopt;
+  }
 
-    std::vector<char> pixels(width * height * channels);
+  ImageData image;
+  image.mWidth  = static_cast<int>(width);
+  image.mHeight = static_cast<int>(height);
+  image.mSize   = static_cast<size_t>(width) * height * channels;
+  image.mPixels = {_TIFFmalloc(static_cast<tmsize_t>(image.mSize)), &_TIFFfree};
 
-    for (unsigned y = 0; y < height; y++) {
-      TIFFReadScanline(data, &pixels[width * channels * y], y);
-    }
+  auto* pixels = static_cast<char*>(image.mPixels.get());
+  for (unsigned y = 0; y < height; y++) {
+    TIFFReadScanline(data, &pixels[width * channels * y], y);
+  }
 
-    GLenum ePixelFormat = GL_RGBA;
+  if (channels == 1) {
+    image.mFormat = GL_RED;
+  } else if (channels == 2) {
+    image.mFormat = GL_RG;
+  } else if (channels == 3) {
+    image.mFormat = GL_RGB;
+  }
 
-    if (channels == 1) {
-      ePixelFormat = GL_RED;
-    } else if (channels == 2) {
-      ePixelFormat = GL_RG;
-    } else if (channels == 3) {
-      ePixelFormat = GL_RGB;
-    }
+  TIFFClose(data);
 
-    result->UploadTexture(width, height, pixels.data(), true, ePixelFormat);
+  return image;
+}
 
-    TIFFClose(data);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::optional<ImageData> decodeStb(std::string const& fileName, bool hdr) {
+  int width{};
+  int height{};
+  int bpp{};
+  int channels = 4;
+
+  ImageData image;
+
+  if (hdr) {
+    logger().debug("Loading HDR Texture '{}' with stbi.", fileName);
+    image.mPixels   = {
+        stbi_loadf(fileName.c_str(), &width, &height, &bpp, channels), &stbi_image_free};
+    image.mDataType = GL_FLOAT;
+  } else {
+    logger().debug("Loading Texture '{}' with stbi.", fileName);
+    image.mPixels = {
+        stbi_load(fileName.c_str(), &width, &height, &bpp, channels), &stbi_image_free};
+  }
+
+  if (!image.mPixels) {
+    logger().error("Failed to load '{}' with stbi!", fileName);
+    return std::nullopt;
+  }
+
+  image.mWidth  = width;
+  image.mHeight = height;
+  image.mSize   = static_cast<size_t>(width) * height * channels * (hdr ? sizeof(float) : 1);
+
+  return image;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::optional<ImageData> decodeGli(std::string const& fileName) {
+  logger().debug("Loading Texture '{}' with gli.", fileName);
 
-  } else if (suffix == ".hdr") {
+  ImageData image;
+  image.mTexture = gli::load(fileName);
 
-    // load with stb image
-    logger().debug("Loading HDR Texture '{}' with stbi.", sFileName);
+  if (image.mTexture.empty()) {
+    logger().error("Failed to load '{}' with gli!", fileName);
+    return std::nullopt;
+  }
+
+  if (image.mTexture.target() != gli::TARGET_2D) {
+    logger().error("Failed to load '{}' with gli: Only 2D textures are supported!", fileName);
+    return std::nullopt;
+  }
+
+  return image;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This does not require an OpenGL context and can therefore be called from any thread.
+std::optional<ImageData> decode(std::string const& fileName) {
+  auto pos = fileName.rfind('.');
+  if (pos == std::string::npos) {
+    logger().error("Failed to load '{}': The file has no extension!", fileName);
+    return std::nullopt;
+  }
+
+  std::string suffix = fileName.substr(pos);
+  std::transform(suffix.begin(), suffix.end(), suffix.begin(), ::tolower);
+
+  if (suffix == ".tga") {
+    ImageData image;
+    image.mIsTga = true;
+    return image;
+  }
+
+  if (suffix == ".tiff" || suffix == ".tif") {
+    return decodeTiff(fileName);
+  }
 
-    int width{};
-    int height{};
-    int bpp{};
-    int channels = 4;
+  if (suffix == ".ktx" || suffix == ".dds") {
+    return decodeGli(fileName);
+  }
+
+  return decodeStb(fileName, suffix == ".hdr");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<VistaTexture> uploadGli(gli::texture const& texture) {
+  gli::gl GL(gli::gl::PROFILE_GL33);
+  auto    format = GL.translate(texture.format(), texture.swizzles());
+  auto    extent = texture.extent();
 
-    float* pixels = stbi_loadf(sFileName.c_str(), &width, &height, &bpp, channels);
+  bool compressed = gli::is_compressed(texture.format());
+  auto levels     = static_cast<GLsizei>(texture.levels());
+
+  // If the file contains no mipmaps, we generate them on the GPU. This is not possible for
+  // compressed formats.
+  bool generateMipmaps = levels == 1 && !compressed;
+  if (generateMipmaps) {
+    levels = 1 + static_cast<GLsizei>(std::floor(std::log2(std::max(extent.x, extent.y))));
+  }
 
-    if (!pixels) {
-      logger().error("Failed to load '{}' with stbi!", sFileName);
-      return nullptr;
+  auto result = std::make_unique<VistaTexture>(GL_TEXTURE_2D);
+  result->Bind();
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, format.Swizzles[0]);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, format.Swizzles[1]);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, format.Swizzles[2]);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, format.Swizzles[3]);
+  glTexParameteri(
+      GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  glTexStorage2D(GL_TEXTURE_2D, levels, format.Internal, extent.x, extent.y);
+
+  // The levels stored by gli are tightly packed.
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  for (std::size_t level = 0; level < texture.levels(); ++level) {
+    auto levelExtent = texture.extent(level);
+    if (compressed) {
+      glCompressedTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), 0, 0, levelExtent.x,
+          levelExtent.y, format.Internal, static_cast<GLsizei>(texture.size(level)),
+          texture.data(0, 0, level));
+    } else {
+      glTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), 0, 0, levelExtent.x,
+          levelExtent.y, format.External, format.Type, texture.data(0, 0, level));
     }
+  }
 
-    result->Bind();
-    gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA32F, width, height, GL_RGBA, GL_FLOAT, pixels);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  if (generateMipmaps) {
+    glGenerateMipmap(GL_TEXTURE_2D);
+  }
+
+  result->Unbind();
+
+  return result;
+}
 
-    stbi_image_free(pixels);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This has to be called on the main thread.
+std::unique_ptr<VistaTexture> upload(ImageData const& image, std::string const& fileName) {
+  if (image.mIsTga) {
+    logger().debug("Loading Texture '{}' with Vista.", fileName);
+    return std::unique_ptr<VistaTexture>(VistaOGLUtils::LoadTextureFromTga(fileName));
+  }
+
+  if (!image.mTexture.empty()) {
+    return uploadGli(image.mTexture);
+  }
+
+  auto result = std::make_unique<VistaTexture>(GL_TEXTURE_2D);
 
+  if (image.mDataType == GL_FLOAT) {
+    // The mipmaps of HDR textures are generated on the GPU.
+    result->Bind();
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, image.mWidth, image.mHeight, 0, image.mFormat,
+        GL_FLOAT, image.mPixels.get());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    result->Unbind();
   } else {
-    // load with stb image
-    logger().debug("Loading Texture '{}' with stbi.", sFileName);
+    result->UploadTexture(image.mWidth, image.mHeight, image.mPixels.get(), true, image.mFormat);
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The state shared by all asynchronous texture loads. This is only accessed from the main thread.
+struct AsyncState {
+  struct PendingTexture {
+    std::weak_ptr<AsyncTexture>           mTarget;
+    std::future<std::optional<ImageData>> mImage;
+  };
+
+  std::unique_ptr<cs::utils::ThreadPool> mThreadPool;
+  std::list<PendingTexture>              mPending;
+  std::weak_ptr<VistaTexture>            mPlaceholder;
+};
+
+AsyncState& getAsyncState() {
+  static AsyncState state;
+  return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+VistaTexture* AsyncTexture::get() const {
+  return mTexture ? mTexture.get() : mPlaceholder.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool AsyncTexture::isReady() const {
+  return mTexture != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool AsyncTexture::hasFailed() const {
+  return mFailed;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    int width{};
-    int height{};
-    int bpp{};
-    int channels = 4;
+std::string const& AsyncTexture::getFileName() const {
+  return mFileName;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<VistaTexture> TextureLoader::loadFromFile(std::string const& sFileName) {
+  auto image = decode(sFileName);
+
+  if (!image) {
+    return nullptr;
+  }
+
+  return upload(*image, sFileName);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<AsyncTexture> TextureLoader::loadFromFileAsync(std::string const& sFileName) {
+  auto& state = getAsyncState();
+
+  // All handles share the same placeholder. It is a single transparent black pixel.
+  auto placeholder = state.mPlaceholder.lock();
+  if (!placeholder) {
+    placeholder = std::make_shared<VistaTexture>(GL_TEXTURE_2D);
+    std::array<uint8_t, 4> pixel{};
+    placeholder->UploadTexture(1, 1, pixel.data(), false);
+    state.mPlaceholder = placeholder;
+  }
+
+  if (!state.mThreadPool) {
+    auto threads = std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U);
+    state.mThreadPool = std::make_unique<cs::utils::ThreadPool>(threads);
+  }
 
-    unsigned char* pixels = stbi_load(sFileName.c_str(), &width, &height, &bpp, channels);
+  auto texture          = std::make_shared<AsyncTexture>();
+  texture->mFileName    = sFileName;
+  texture->mPlaceholder = placeholder;
 
-    if (!pixels) {
-      logger().error("Failed to load '{}' with stbi!", sFileName);
-      return nullptr;
+  state.mPending.push_back(
+      {texture, state.mThreadPool->enqueue([sFileName]() { return decode(sFileName); })});
+
+  return texture;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TextureLoader::uploadPendingTextures(size_t maxBytes) {
+  auto&  state    = getAsyncState();
+  size_t uploaded = 0;
+
+  for (auto it = state.mPending.begin(); it != state.mPending.end() && uploaded < maxBytes;) {
+    auto target = it->mTarget.lock();
+
+    // If the handle has been dropped in the meantime, the decoded image is simply discarded.
+    if (!target) {
+      it = state.mPending.erase(it);
+      continue;
+    }
+
+    if (it->mImage.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      ++it;
+      continue;
+    }
+
+    auto image = it->mImage.get();
+
+    if (image) {
+      target->mTexture = upload(*image, target->mFileName);
+      uploaded += image->getSize();
     }
 
-    result->UploadTexture(width, height, pixels);
+    target->mFailed = target->mTexture == nullptr;
 
-    stbi_image_free(pixels);
+    it = state.mPending.erase(it);
   }
+}
 
-  return result;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TextureLoader::getPendingCount() {
+  return static_cast<uint32_t>(getAsyncState().mPending.size());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
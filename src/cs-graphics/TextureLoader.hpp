@@ -15,12 +15,57 @@
 #include <string>
 
 namespace cs::graphics {
+
+/// A handle to a texture which is loaded in the background by TextureLoader::loadFromFileAsync().
+/// Until the texture has been uploaded, get() returns a small placeholder texture. Hence, users
+/// can simply bind whatever get() returns each frame.
+class CS_GRAPHICS_EXPORT AsyncTexture {
+ public:
+  /// Returns the loaded texture or the placeholder if the texture is not available (yet). This
+  /// never returns nullptr.
+  VistaTexture* get() const;
+
+  /// Returns true once the texture has been uploaded to the GPU.
+  bool isReady() const;
+
+  /// Returns true if the file could not be loaded. In this case, get() keeps returning the
+  /// placeholder.
+  bool hasFailed() const;
+
+  /// Returns the file this texture is loaded from.
+  std::string const& getFileName() const;
+
+ private:
+  friend class TextureLoader;
+
+  std::string                   mFileName;
+  std::shared_ptr<VistaTexture> mPlaceholder;
+  std::unique_ptr<VistaTexture> mTexture;
+  bool                          mFailed = false;
+};
+
 /// For loading VistaTextures.
 class CS_GRAPHICS_EXPORT TextureLoader {
  public:
   /// Loads a VistaTexture from the given file. This support *.tga, *.tif, *.hdr as well as all
-  /// image formats supported by stb_image (including *.bmp, *.jpeg and *.png).
+  /// image formats supported by stb_image (including *.bmp, *.jpeg and *.png). Furthermore, *.ktx
+  /// and *.dds files are loaded with gli. These may contain precomputed mipmaps and GPU-compressed
+  /// formats and are therefore the fastest option for large textures.
   static std::unique_ptr<VistaTexture> loadFromFile(std::string const& sFileName);
+
+  /// Same as loadFromFile(), but the file is read and decoded on a background thread. The returned
+  /// handle provides a placeholder texture until the image has been uploaded. This has to be called
+  /// from the main thread.
+  static std::shared_ptr<AsyncTexture> loadFromFileAsync(std::string const& sFileName);
+
+  /// Uploads textures which have been decoded in the background. Textures are uploaded until the
+  /// given number of bytes has been transferred in this call; at least one texture is uploaded if
+  /// any is available. This is called once each frame by the GraphicsEngine.
+  static void uploadPendingTextures(size_t maxBytes = 32 * 1024 * 1024);
+
+  /// Returns the number of textures which have been requested with loadFromFileAsync() but have not
+  /// been uploaded yet.
+  static uint32_t getPendingCount();
 };
 
 } // namespace cs::graphics
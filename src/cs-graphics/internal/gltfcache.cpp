@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "gltfcache.hpp"
+
+#include "../../cs-utils/filesystem.hpp"
+#include "../../cs-utils/utils.hpp"
+#include "../logger.hpp"
+#include "gltfmodel.hpp"
+
+#include <GL/glew.h>
+#include <boost/filesystem.hpp>
+#include <gli/gli.hpp>
+
+#include <array>
+#include <map>
+
+namespace cs::graphics::internal {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The precomputed textures for image based lighting are stored in this directory.
+constexpr const char* CACHE_DIRECTORY = "cache/gltf";
+
+// Increase this whenever the computation of the cached textures changes. This invalidates all
+// existing cache files.
+constexpr int CACHE_VERSION = 1;
+
+constexpr int         BRDF_LUT_SIZE   = 512;
+constexpr int         IRRADIANCE_SIZE = 32;
+constexpr std::size_t SPECULAR_LEVELS = 10;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string getCacheFile(std::string const& name) {
+  return std::string(CACHE_DIRECTORY) + "/" + name + "-v" + std::to_string(CACHE_VERSION) + ".ktx";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns an empty texture if the file does not exist or does not contain a texture of the given
+// target.
+gli::texture loadFromCache(std::string const& file, gli::target target) {
+  if (!boost::filesystem::exists(file)) {
+    return gli::texture();
+  }
+
+  gli::texture texture = gli::load(file);
+
+  if (texture.empty() || texture.target() != target) {
+    logger().warn("Ignoring invalid cache file '{}'.", file);
+    return gli::texture();
+  }
+
+  return texture;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Failing to write the cache is not fatal, the textures will simply be computed again next time.
+void saveToCache(gli::texture const& texture, std::string const& file) {
+  try {
+    cs::utils::filesystem::createDirectoryRecursively(
+        boost::filesystem::system_complete(CACHE_DIRECTORY));
+
+    if (!gli::save_ktx(texture, file)) {
+      logger().warn("Failed to write cache file '{}'.", file);
+    }
+  } catch (std::exception const& e) {
+    logger().warn("Failed to create cache directory '{}': {}", CACHE_DIRECTORY, e.what());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The BRDF look-up table does not depend on the model nor on the cubemap. Hence, there is only one
+// instance of it.
+std::shared_ptr<Texture> getBrdfLUT() {
+  static std::weak_ptr<Texture> cache;
+
+  if (auto lut = cache.lock()) {
+    return lut;
+  }
+
+  auto file   = getCacheFile("brdf-lut-" + std::to_string(BRDF_LUT_SIZE));
+  auto cached = loadFromCache(file, gli::TARGET_2D);
+
+  std::shared_ptr<Texture> lut;
+
+  if (!cached.empty() && cached.format() == gli::FORMAT_RG16_SFLOAT_PACK16 &&
+      cached.extent() == gli::extent3d(BRDF_LUT_SIZE, BRDF_LUT_SIZE, 1)) {
+    lut = std::make_shared<Texture>(createBrdfLUT(BRDF_LUT_SIZE, BRDF_LUT_SIZE, cached.data()));
+  } else {
+    lut = std::make_shared<Texture>(createBrdfLUT(BRDF_LUT_SIZE, BRDF_LUT_SIZE));
+
+    gli::texture2d data(
+        gli::FORMAT_RG16_SFLOAT_PACK16, gli::extent2d(BRDF_LUT_SIZE, BRDF_LUT_SIZE), 1);
+
+    glBindTexture(GL_TEXTURE_2D, *lut->image);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RG, GL_HALF_FLOAT, data.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    saveToCache(data, file);
+  }
+
+  cache = lut;
+  return lut;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns the image based lighting textures for the given cubemap. They are shared by all models
+// which use the same cubemap.
+std::shared_ptr<ImageBasedLighting const> getImageBasedLighting(std::string const& cubemapFile) {
+  static std::map<std::string, std::weak_ptr<ImageBasedLighting const>> cache;
+
+  auto& cached = cache[cubemapFile];
+  if (auto ibl = cached.lock()) {
+    return ibl;
+  }
+
+  if (!boost::filesystem::exists(cubemapFile)) {
+    throw std::runtime_error("GltfShared: Cannot open cubemap: " + cubemapFile);
+  }
+
+  // The cache files are keyed by the location, the size and the modification time of the cubemap.
+  auto key = utils::hashString(boost::filesystem::system_complete(cubemapFile).string() + "\n" +
+                        std::to_string(boost::filesystem::file_size(cubemapFile)) + "\n" +
+                        std::to_string(boost::filesystem::last_write_time(cubemapFile)));
+
+  auto diffuseFile  = getCacheFile("irradiance-" + key);
+  auto specularFile = getCacheFile("specular-" + key);
+
+  gli::texture_cube diffuse(loadFromCache(diffuseFile, gli::TARGET_CUBE));
+  gli::texture_cube specular(loadFromCache(specularFile, gli::TARGET_CUBE));
+
+  if (diffuse.empty() || specular.empty()) {
+    logger().debug("Filtering cubemap '{}'. This may take a while...", cubemapFile);
+
+    gli::texture_cube input(gli::load(cubemapFile));
+    if (input.empty()) {
+      throw std::runtime_error("GltfShared: Failed to load cubemap: " + cubemapFile);
+    }
+
+    // The filtering changes the viewport, so we restore it afterwards.
+    std::array<GLint, 4> viewport{};
+    glGetIntegerv(GL_VIEWPORT, viewport.data());
+
+    diffuse  = irradianceCubemap(input, IRRADIANCE_SIZE, IRRADIANCE_SIZE);
+    specular = prefilterCubemapGGX(input, SPECULAR_LEVELS);
+
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    glScissor(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    saveToCache(diffuse, diffuseFile);
+    saveToCache(specular, specularFile);
+  }
+
+  auto ibl             = std::make_shared<ImageBasedLighting>();
+  ibl->mBrdfLUT        = getBrdfLUT();
+  ibl->mDiffuseEnvMap  = uploadCubemap(diffuse);
+  ibl->mSpecularEnvMap = uploadCubemap(specular);
+
+  cached = ibl;
+  return ibl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<GltfAsset const> getGltfAsset(
+    std::string const& gltfFile, std::string const& cubemapFile) {
+  static std::map<std::pair<std::string, std::string>, std::weak_ptr<GltfAsset const>> cache;
+
+  auto& cached = cache[{gltfFile, cubemapFile}];
+  if (auto asset = cached.lock()) {
+    return asset;
+  }
+
+  auto asset = std::make_shared<GltfAsset>();
+
+  tinygltf::TinyGLTF loader;
+  std::string        err;
+  std::string        warn;
+
+  bool ret = false;
+  if (boost::filesystem::extension(gltfFile) == ".glb") {
+    // Assume binary glTF.
+    ret = loader.LoadBinaryFromFile(&asset->mTinyGltfModel, &err, &warn, gltfFile);
+  } else {
+    // Assume ascii glTF.
+    ret = loader.LoadASCIIFromFile(&asset->mTinyGltfModel, &err, &warn, gltfFile);
+  }
+
+  if (!err.empty()) {
+    throw std::runtime_error(err);
+  }
+  if (!ret) {
+    std::string msg("Failed to load .glTF: ");
+    throw std::runtime_error(msg + gltfFile);
+  }
+
+  glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+  asset->init(asset->mTinyGltfModel, getImageBasedLighting(cubemapFile));
+
+  cached = asset;
+  return asset;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cs::graphics::internal
@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef CS_GRAPHICS_GLTFCACHE_HPP
+#define CS_GRAPHICS_GLTFCACHE_HPP
+
+#include <memory>
+#include <string>
+
+namespace cs::graphics::internal {
+
+struct GltfAsset;
+
+/// Returns the GPU resources of the given GLTF model, lit by the given cubemap. All callers which
+/// request the same combination of files share the same resources. The resources are released
+/// once the last user drops its reference.
+///
+/// The textures required for image based lighting are only computed once per cubemap, regardless
+/// of the model. They are stored as KTX files in the directory "cache/gltf", so that they do not
+/// have to be computed again on the next start. The cache files are invalidated automatically if
+/// the cubemap file is modified.
+///
+/// Throws a std::runtime_error if the model or the cubemap cannot be loaded.
+std::shared_ptr<GltfAsset const> getGltfAsset(
+    std::string const& gltfFile, std::string const& cubemapFile);
+
+} // namespace cs::graphics::internal
+
+#endif // CS_GRAPHICS_GLTFCACHE_HPP
@@ -928,7 +928,7 @@ std::shared_ptr<GLuint> createGPUsampler(tinygltf::Sampler const& s) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Texture createBrdfLUT(int width, int height) {
+Texture createBrdfLUT(int width, int height, void const* data) {
   std::shared_ptr<GLuint> texture_ptr(new GLuint(0), [](GLuint* ptr) {
     if (*ptr != 0u) {
       glDeleteTextures(1, ptr);
@@ -941,17 +941,21 @@ Texture createBrdfLUT(int width, int height) {
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, width, height, 0, GL_RG, GL_HALF_FLOAT, nullptr);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, width, height, 0, GL_RG, GL_HALF_FLOAT, data);
 
-  auto program = createCompute(compute_brdf_lut);
+  if (data == nullptr) {
+    auto program = createCompute(compute_brdf_lut);
 
-  glUseProgram(program);
-  glBindImageTexture(0, *texture_ptr, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG16F);
-  glDispatchCompute(static_cast<GLuint>(width) / 16, static_cast<GLuint>(height) / 16, 1);
-  glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
-  glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG16F);
+    glUseProgram(program);
+    glBindImageTexture(0, *texture_ptr, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG16F);
+    glDispatchCompute(static_cast<GLuint>(width) / 16, static_cast<GLuint>(height) / 16, 1);
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RG16F);
+
+    glDeleteProgram(program);
+  }
 
-  glDeleteProgram(program);
+  glBindTexture(GL_TEXTURE_2D, 0);
   CheckGLErrors("in createBrdfLUT");
 
   tinygltf::Sampler sampler;
@@ -966,7 +970,7 @@ Texture createBrdfLUT(int width, int height) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void GltfShared::buildMeshes(tinygltf::Model const& gltf) {
+void GltfAsset::buildMeshes(tinygltf::Model const& gltf) {
   for (auto const& gltfMesh : gltf.meshes) {
     Mesh mesh;
     for (auto const& primitive : gltfMesh.primitives) {
@@ -995,7 +999,7 @@ void GltfShared::buildMeshes(tinygltf::Model const& gltf) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Primitive GltfShared::createMeshPrimitive(
+Primitive GltfAsset::createMeshPrimitive(
     tinygltf::Model const& gltf, tinygltf::Primitive const& primitive) {
   Primitive myPrimitive;
   myPrimitive.hasIndices = primitive.indices >= 0;
@@ -1083,17 +1087,17 @@ Primitive GltfShared::createMeshPrimitive(
   // textures used for Image Based Lighting (IBL)
   auto texVarIter = myPrimitive.programInfo.textures.find("u_brdfLUT");
   if (texVarIter != myPrimitive.programInfo.textures.end()) {
-    myPrimitive.textures.emplace_back(mTextures[mBrdfLUTindex], texVarIter->second);
+    myPrimitive.textures.emplace_back(*mIBL->mBrdfLUT, texVarIter->second);
   }
 
   texVarIter = myPrimitive.programInfo.textures.find("u_DiffuseEnvSampler");
   if (texVarIter != myPrimitive.programInfo.textures.end()) {
-    myPrimitive.textures.emplace_back(mTextures[mDiffuseEnvMapIndex], texVarIter->second);
+    myPrimitive.textures.emplace_back(mIBL->mDiffuseEnvMap, texVarIter->second);
   }
 
   texVarIter = myPrimitive.programInfo.textures.find("u_SpecularEnvSampler");
   if (texVarIter != myPrimitive.programInfo.textures.end()) {
-    myPrimitive.textures.emplace_back(mTextures[mSpecularEnvMapIndex], texVarIter->second);
+    myPrimitive.textures.emplace_back(mIBL->mSpecularEnvMap, texVarIter->second);
   }
 
   // ----------------------------------------------
@@ -1224,18 +1228,9 @@ void Primitive::draw(glm::mat4 const& projMat, glm::mat4 const& viewMat, glm::ma
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void GltfShared::init(tinygltf::Model const& gltf, std::string const& cubemapFilepath) {
-
-  // save current viewport
-  std::array<GLint, 4> current_viewport{};
-  glGetIntegerv(GL_VIEWPORT, current_viewport.data());
+void GltfAsset::init(tinygltf::Model const& gltf, std::shared_ptr<ImageBasedLighting const> ibl) {
+  mIBL = std::move(ibl);
 
-  {
-    std::ifstream f(cubemapFilepath.c_str());
-    if (!f.good()) {
-      throw std::runtime_error("GltfShared: Cannot open cubemap: " + cubemapFilepath);
-    }
-  }
   std::vector<std::shared_ptr<unsigned int>> sharedImages;
   for (auto const& i : gltf.images) {
     sharedImages.emplace_back(createGPUimage(i, true));
@@ -1257,27 +1252,7 @@ void GltfShared::init(tinygltf::Model const& gltf, std::string const& cubemapFil
     mTextures.emplace_back(Texture{GL_TEXTURE_2D, sampler, sharedImages.at(t.source)});
   }
 
-  mBrdfLUTindex = static_cast<int>(mTextures.size());
-  mTextures.push_back(createBrdfLUT(512, 512));
-
-  glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
-  gli::texture_cube inputGliTex(gli::load(cubemapFilepath));
-
-  // diffuse env map
-  mDiffuseEnvMapIndex = static_cast<int>(mTextures.size());
-  auto diffuseGliTex  = irradianceCubemap(inputGliTex, 32, 32);
-  mTextures.push_back(uploadCubemap(diffuseGliTex));
-
-  // specular env map
-  mSpecularEnvMapIndex = static_cast<int>(mTextures.size());
-  auto specularGliTex  = prefilterCubemapGGX(inputGliTex, 10);
-  mTextures.push_back(uploadCubemap(specularGliTex));
-
   buildMeshes(gltf);
-
-  // reset current viewport
-  glViewport(current_viewport[0], current_viewport[1], current_viewport[2], current_viewport[3]);
-  glScissor(current_viewport[0], current_viewport[1], current_viewport[2], current_viewport[3]);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1320,7 +1295,7 @@ bool VistaGltfNode::Do() {
   glDisable(GL_CULL_FACE);
 
   if (mMeshIndex >= 0 && mShared) {
-    mShared->mMeshes[mMeshIndex].draw(projMat, viewMat, modelMat, *mShared);
+    mShared->mAsset->mMeshes[mMeshIndex].draw(projMat, viewMat, modelMat, *mShared);
   }
 
   glEnable(GL_CULL_FACE);
@@ -1332,8 +1307,8 @@ bool VistaGltfNode::Do() {
 
 bool VistaGltfNode::GetBoundingBox(VistaBoundingBox& bb) {
   if (mMeshIndex >= 0 && mShared) {
-    auto& mi = mShared->mMeshes[mMeshIndex].minPos;
-    auto& ma = mShared->mMeshes[mMeshIndex].maxPos;
+    auto const& mi = mShared->mAsset->mMeshes[mMeshIndex].minPos;
+    auto const& ma = mShared->mAsset->mMeshes[mMeshIndex].maxPos;
     bb.SetBounds(glm::value_ptr(mi), glm::value_ptr(ma));
   }
 
@@ -18,6 +18,10 @@
 #include <tiny_gltf.h>
 #include <vector>
 
+namespace gli {
+class texture_cube;
+} // namespace gli
+
 namespace cs::graphics::internal {
 
 struct GltfShared;
@@ -138,29 +142,56 @@ struct Mesh {
   glm::vec3 maxPos = glm::vec3(std::numeric_limits<float>::max());
 };
 
-/// Represents a GLTF model.
-struct GltfShared {
-  void init(tinygltf::Model const& gltf, const std::string& cubemapFilepath);
+/// The textures used for image based lighting. They only depend on the environment map, so they
+/// can be shared by all models which use the same map. The BRDF look-up table does not even depend
+/// on the environment map.
+struct ImageBasedLighting {
+  std::shared_ptr<Texture> mBrdfLUT;
+  Texture                  mDiffuseEnvMap;
+  Texture                  mSpecularEnvMap;
+};
+
+/// Contains the GPU resources of a GLTF model. These are shared by all instances of the same model
+/// which use the same environment map, see getGltfAsset() in gltfcache.hpp.
+struct GltfAsset {
+  void init(tinygltf::Model const& gltf, std::shared_ptr<ImageBasedLighting const> ibl);
 
  private:
   void      buildMeshes(tinygltf::Model const& gltf);
   Primitive createMeshPrimitive(tinygltf::Model const& gltf, tinygltf::Primitive const& primitive);
 
  public:
-  glm::vec3            m_lightColor     = glm::vec3(0.0F, 0.0F, 0.0F);
-  glm::vec3            m_lightDirection = glm::vec3(0.0F, 0.0F, 1.0F);
-  float                m_lightIntensity = 1.0F;
-  bool                 m_enableHDR      = false;
-  float                m_IBLIntensity   = 1.0F;
-  glm::mat3            m_IBLrotation    = glm::mat3(1.0F);
-  tinygltf::Model      mTinyGltfModel;
-  std::vector<Texture> mTextures;
-  std::vector<Mesh>    mMeshes;
-  int                  mBrdfLUTindex        = -1;
-  int                  mDiffuseEnvMapIndex  = -1;
-  int                  mSpecularEnvMapIndex = -1;
+  tinygltf::Model                           mTinyGltfModel;
+  std::shared_ptr<ImageBasedLighting const> mIBL;
+  std::vector<Texture>                      mTextures;
+  std::vector<Mesh>                         mMeshes;
 };
 
+/// Represents an instance of a GLTF model. The render parameters are specific to each instance, the
+/// GPU resources may be shared with other instances.
+struct GltfShared {
+  glm::vec3                        m_lightColor     = glm::vec3(0.0F, 0.0F, 0.0F);
+  glm::vec3                        m_lightDirection = glm::vec3(0.0F, 0.0F, 1.0F);
+  float                            m_lightIntensity = 1.0F;
+  bool                             m_enableHDR      = false;
+  float                            m_IBLIntensity   = 1.0F;
+  glm::mat3                        m_IBLrotation    = glm::mat3(1.0F);
+  std::shared_ptr<GltfAsset const> mAsset;
+};
+
+/// Creates the BRDF look-up table with the format GL_RG16F. If data is given, it has to contain
+/// width * height half-float pairs which are uploaded instead of computing the table on the GPU.
+Texture createBrdfLUT(int width, int height, void const* data = nullptr);
+
+/// Uploads the given cubemap to the GPU.
+Texture uploadCubemap(gli::texture_cube const& gliTex);
+
+/// Computes the specular environment map with the given number of mipmap levels.
+gli::texture_cube prefilterCubemapGGX(gli::texture_cube const& inputCubemap, std::size_t levels);
+
+/// Computes the diffuse environment map with the given resolution.
+gli::texture_cube irradianceCubemap(gli::texture_cube const& inputCubemap, int width, int height);
+
 /// A Vista wrapper for the GLTF model responsible for rendering.
 class VistaGltfNode : public IVistaOpenGLDraw {
  public:
@@ -11,6 +11,7 @@
 #include "cs_scene_export.hpp"
 
 #include <glm/fwd.hpp>
+#include <limits>
 
 namespace cs::scene {
 
@@ -27,6 +28,15 @@ class IntersectableObject {
   /// @return             If an intersection happened.
   virtual bool getIntersection(
       glm::dvec3 const& rayPos, glm::dvec3 const& rayDir, glm::dvec3& pos) const = 0;
+
+  /// Returns the radius of a sphere around the origin of the CelestialObject which encloses all
+  /// points which getIntersection() may return. The radius is given in the object's local
+  /// coordinates, i.e. without the scene scale. The InputManager uses this to skip the precise
+  /// intersection test for objects which cannot be hit and to test the remaining objects from near
+  /// to far. The default implementation returns infinity, so the object will always be tested.
+  virtual double getBoundingRadius() const {
+    return std::numeric_limits<double>::infinity();
+  }
 };
 
 } // namespace cs::scene
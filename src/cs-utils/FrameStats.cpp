@@ -10,6 +10,7 @@
 #include "logger.hpp"
 
 #include <GL/glew.h>
+#include <algorithm>
 #include <thread>
 #include <utility>
 
@@ -176,6 +177,16 @@ void FrameStats::endPrimitivesQuery(int32_t id) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void FrameStats::addCPUTimerRange(std::string name, int64_t start, int64_t end) {
+
+  // Only attempt to add the range if pEnableMeasurements is set to true.
+  if (pEnableMeasurements.get()) {
+    mQueryPools.at(mCurrentQueryPool)->addCPUTimerRange(std::move(name), start, end);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 std::vector<FrameStats::TimerQueryResult> const& FrameStats::getTimerQueryResults() {
 
   // We return the ranges from the last-but-one frame.
@@ -342,6 +353,26 @@ void QueryPool::endPrimitivesQuery(int32_t id) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void QueryPool::addCPUTimerRange(std::string name, int64_t start, int64_t end) {
+
+  // The first range is always the one of the entire frame.
+  if (!mTimerQueryResults.empty()) {
+    start = std::max(start, mTimerQueryResults.front().mCPUStart);
+    end   = std::max(end, start);
+  }
+
+  FrameStats::TimerQueryResult result;
+  result.mMode         = FrameStats::TimerMode::eCPU;
+  result.mName         = std::move(name);
+  result.mNestingLevel = mCurrentNestingLevel;
+  result.mCPUStart     = start;
+  result.mCPUEnd       = end;
+
+  mTimerQueryResults.push_back(std::move(result));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void QueryPool::fetchQueries() {
 
   // Wait for the last query to finish.
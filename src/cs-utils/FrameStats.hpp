@@ -174,6 +174,13 @@ class CS_UTILS_EXPORT FrameStats {
   void endSamplesQuery(int32_t id);
   void endPrimitivesQuery(int32_t id);
 
+  /// Adds a CPU timing range which has been measured elsewhere, for instance by a task running on a
+  /// worker thread. The timestamps have to be nanoseconds obtained from the
+  /// std::chrono::high_resolution_clock. The range will be nested in all currently active ranges.
+  /// Parts of the range which lie before the start of the current frame are clipped. Like all
+  /// other methods, this must be called from the main thread.
+  void addCPUTimerRange(std::string name, int64_t start, int64_t end);
+
   /// This will retrieve the recorded results from the last-but-one frame. This is to prevent any
   /// synchronization between CPU and GPU: In one frame timings are recorded and queries are
   /// dispatched, then we wait one full frame until we attempt to read the query results. Then, in
@@ -228,6 +235,9 @@ class CS_UTILS_EXPORT QueryPool {
   void endSamplesQuery(int32_t id);
   void endPrimitivesQuery(int32_t id);
 
+  /// Adds an already measured CPU range. See FrameStats::addCPUTimerRange() for details.
+  void addCPUTimerRange(std::string name, int64_t start, int64_t end);
+
   /// Fetches timestamps from GPU. This needs to be called before get*Results() and blocks until all
   /// queries are done.
   void fetchQueries();
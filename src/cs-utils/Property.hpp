@@ -11,6 +11,8 @@
 #include "Signal.hpp"
 
 #include <iostream>
+#include <optional>
+#include <utility>
 
 namespace cs::utils {
 
@@ -41,15 +43,17 @@ class Property {
       : mOnChange(std::move(other.mOnChange))
       , mConnection(other.mConnection)
       , mConnectionID(other.mConnectionID)
-      , mValue(other.mValue) {
+      , mValue(std::move(other.mValue))
+      , mDeferredValue(std::move(other.mDeferredValue)) {
   }
 
   Property& operator=(Property<T>&& other) noexcept {
     if (this != &other) {
-      mOnChange     = std::move(other.mOnChange);
-      mConnection   = other.mConnection;
-      mConnectionID = other.mConnectionID;
-      mValue        = other.mValue;
+      mOnChange      = std::move(other.mOnChange);
+      mConnection    = other.mConnection;
+      mConnectionID  = other.mConnectionID;
+      mValue         = std::move(other.mValue);
+      mDeferredValue = std::move(other.mDeferredValue);
     }
 
     return *this;
@@ -64,13 +68,13 @@ class Property {
   /// The given function is called when the internal value is about to be changed. The new value
   /// is passed as parameter, to access the old value you can use the get() method, as the internal
   /// value will be overwritten after the signal emission.
-  virtual int connect(std::function<void(T)> const& slot) const {
-    return mOnChange.connect(slot);
+  virtual int connect(std::function<void(T const&)> slot) const {
+    return mOnChange.connect(std::move(slot));
   }
 
   /// Same as above, but in addition, the given function is immediately called once.
-  virtual int connectAndTouch(std::function<void(T)> const& slot) const {
-    int connection = mOnChange.connect(slot);
+  virtual int connectAndTouch(std::function<void(T const&)> slot) const {
+    int connection = mOnChange.connect(std::move(slot));
     touch(connection);
     return connection;
   }
@@ -128,6 +132,30 @@ class Property {
     mValue = value;
   }
 
+  /// Stores a new value without applying it. The value is applied with set() once flush() is
+  /// called. This can be used to coalesce multiple changes within one frame into a single
+  /// notification: If the value is set several times before flush() is called, onChange() will be
+  /// emitted at most once. It will not be emitted at all if the final value equals the current one.
+  /// Until then, get() still returns the previous value.
+  void setDeferred(T const& value) {
+    mDeferredValue = value;
+  }
+
+  /// Returns true if setDeferred() has been called since the last call to flush().
+  bool hasDeferredValue() const {
+    return mDeferredValue.has_value();
+  }
+
+  /// Applies the value given to setDeferred(), if any. onChange() will be emitted if the value
+  /// changed.
+  void flush() {
+    if (mDeferredValue) {
+      T value = std::move(*mDeferredValue);
+      mDeferredValue.reset();
+      set(value);
+    }
+  }
+
   /// Emits onChange() even if the value did not change.
   void touch() const {
     mOnChange.emit(mValue);
@@ -182,6 +210,7 @@ class Property {
   mutable Property<T> const* mConnection{nullptr};
   mutable int                mConnectionID{-1};
   T                          mValue{}; // Default initialize (primitives => 0 | false).
+  std::optional<T>           mDeferredValue;
 };
 
 /// Stream operators.
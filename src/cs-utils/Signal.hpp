@@ -8,9 +8,11 @@
 #ifndef CS_UTILS_SIGNAL_HPP
 #define CS_UTILS_SIGNAL_HPP
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
-#include <map>
+#include <utility>
+#include <vector>
 
 #include <cs_utils_export.hpp>
 #include <spdlog/spdlog.h>
@@ -21,11 +23,20 @@ CS_UTILS_EXPORT spdlog::logger& logger();
 
 /// A signal object may call multiple slots with the same signature. You can connect functions to
 /// the signal which will be called when the emit() method on the signal object is invoked. Any
-/// argument passed to emit() will be passed to the given functions.
+/// argument passed to emit() will be passed to the given functions as const reference, so no copies
+/// are made for each slot.
+///
+/// Signals are emitted very often, many of them once per frame. Therefore, the slots are stored in
+/// a contiguous array which is sorted by connection ID. The std::function objects store small
+/// callables (like lambdas capturing only the this pointer) without a heap allocation. Functions
+/// which are connected or disconnected while the signal is being emitted are added or removed once
+/// the emission finished. Functions connected during an emission are not called by this emission.
 template <typename... Args>
 class Signal {
 
  public:
+  using Slot = std::function<void(Args const&...)>;
+
   Signal() = default;
 
   /// Copy creates new signal.
@@ -50,31 +61,41 @@ class Signal {
 
   /// Connects a std::function to the signal. The returned value can be used to disconnect the
   /// function again.
-  int connect(std::function<void(Args...)> const& slot) const {
-    mSlots.insert(std::make_pair(++mCurrentID, slot));
+  int connect(Slot slot) const {
+    if (mActiveCalls > 0) {
+      mSlotsToConnect.emplace_back(++mCurrentID, std::move(slot));
+    } else {
+      mSlots.emplace_back(++mCurrentID, std::move(slot));
+    }
     return mCurrentID;
   }
 
   /// Disconnects a previously connected function.
   void disconnect(int id) const {
-    if (mIsIterating) {
+    if (mActiveCalls > 0) {
       mSlotsToDisconnect.push_back(id);
     } else {
-      mSlots.erase(id);
+      erase(id);
     }
   }
 
   /// Disconnects all previously connected functions.
   void disconnectAll() const {
-    if (mIsIterating) {
+    if (mActiveCalls > 0) {
       mDisconnectAllRequested = true;
+      mSlotsToConnect.clear();
     } else {
       mSlots.clear();
     }
   }
 
+  /// Returns the number of connected functions.
+  std::size_t size() const {
+    return mSlots.size();
+  }
+
   /// Calls all connected functions.
-  void emit(Args... p) {
+  void emit(Args const&... p) {
     if (mIsIterating) {
       logger().warn(
           "Recursive invocation of emit! To avoid a stack overflow, the recursive invocation was "
@@ -83,6 +104,7 @@ class Signal {
     }
 
     mIsIterating = true;
+    ++mActiveCalls;
 
     for (auto const& it : mSlots) {
       it.second(p...);
@@ -93,7 +115,7 @@ class Signal {
   }
 
   /// Calls all connected functions except for one.
-  void emitForAllButOne(int excludedConnectionID, Args... p) {
+  void emitForAllButOne(int excludedConnectionID, Args const&... p) {
     if (mIsIterating) {
       logger().warn(
           "Recursive invocation of emit! To avoid a stack overflow, the recursive invocation was "
@@ -102,6 +124,7 @@ class Signal {
     }
 
     mIsIterating = true;
+    ++mActiveCalls;
 
     for (auto const& it : mSlots) {
       if (it.first != excludedConnectionID) {
@@ -114,10 +137,12 @@ class Signal {
   }
 
   /// Calls only one connected functions.
-  void emitFor(int connectionID, Args... p) {
-    auto const& it = mSlots.find(connectionID);
-    if (it != mSlots.end()) {
+  void emitFor(int connectionID, Args const&... p) {
+    auto it = find(connectionID);
+    if (it != mSlots.end() && it->first == connectionID) {
+      ++mActiveCalls;
       it->second(p...);
+      postEmitCleanUp();
     }
   }
 
@@ -130,23 +155,51 @@ class Signal {
   }
 
  private:
+  using SlotList = std::vector<std::pair<int, Slot>>;
+
+  // As connection IDs are increasing, the slots are always sorted by their ID.
+  typename SlotList::iterator find(int id) const {
+    return std::lower_bound(mSlots.begin(), mSlots.end(), id,
+        [](auto const& slot, int value) { return slot.first < value; });
+  }
+
+  void erase(int id) const {
+    auto it = find(id);
+    if (it != mSlots.end() && it->first == id) {
+      mSlots.erase(it);
+    }
+  }
+
   void postEmitCleanUp() {
+    if (--mActiveCalls > 0) {
+      return;
+    }
+
     if (mDisconnectAllRequested) {
       mSlots.clear();
       mDisconnectAllRequested = false;
-    } else {
-      for (int id : mSlotsToDisconnect) {
-        mSlots.erase(id);
-      }
-      mSlotsToDisconnect.clear();
     }
+
+    for (auto& slot : mSlotsToConnect) {
+      mSlots.push_back(std::move(slot));
+    }
+    mSlotsToConnect.clear();
+
+    for (int id : mSlotsToDisconnect) {
+      erase(id);
+    }
+    mSlotsToDisconnect.clear();
   }
 
-  mutable std::map<int, std::function<void(Args...)>> mSlots;
-  mutable int                                         mCurrentID{0};
+  mutable SlotList mSlots;
+  mutable int      mCurrentID{0};
 
+  // While slots are being called, the slot list must not be modified. Changes are stored here and
+  // applied once the last call returned.
+  mutable int              mActiveCalls            = 0;
   mutable bool             mIsIterating            = false;
   mutable bool             mDisconnectAllRequested = false;
+  mutable SlotList         mSlotsToConnect;
   mutable std::vector<int> mSlotsToDisconnect;
 };
 
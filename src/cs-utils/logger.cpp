@@ -8,6 +8,11 @@
 #include "logger.hpp"
 
 #include <VistaBase/VistaStreamUtils.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <spdlog/details/null_mutex.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <sstream>
@@ -45,18 +50,125 @@ class SpdlogBuffer : public std::streambuf {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-class SignalSink : public spdlog::sinks::base_sink<std::mutex> {
+// Log messages may be emitted from any thread. The SignalSink collects them in a lock-free stack
+// so that logging threads never have to wait for each other or for the main thread. Once per frame,
+// processLogMessages() is called on the main thread which then emits the onLogMessage signal for
+// the collected messages.
+class SignalSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
  public:
+  // If the main thread does not process the messages (e.g. during startup), at most this many
+  // messages are queued. Any further messages are only printed to the console and the log file.
+  static constexpr size_t MAX_QUEUED_MESSAGES = 10000;
+
+  // Once collected, at most this many messages are kept in a ring buffer. If there are more, the
+  // oldest messages will be dropped.
+  static constexpr size_t MAX_BACKLOG_MESSAGES = 1000;
+
+  // At most this many messages are emitted per call to processMessages().
+  static constexpr size_t MAX_MESSAGES_PER_FRAME = 100;
+
+  SignalSink() = default;
+
+  SignalSink(SignalSink const& other) = delete;
+  SignalSink(SignalSink&& other)      = delete;
+
+  SignalSink& operator=(SignalSink const& other) = delete;
+  SignalSink& operator=(SignalSink&& other) = delete;
+
+  ~SignalSink() override {
+    Message* message = mHead.exchange(nullptr);
+    while (message) {
+      std::unique_ptr<Message> current(message);
+      message = current->mNext;
+    }
+  }
+
+  void processMessages() {
+
+    // Take the entire stack at once. As this is a stack, the newest message comes first, so we
+    // reverse the list before appending the messages to the backlog.
+    Message* message  = mHead.exchange(nullptr, std::memory_order_acquire);
+    Message* reversed = nullptr;
+    while (message) {
+      Message* next  = message->mNext;
+      message->mNext = reversed;
+      reversed       = message;
+      message        = next;
+    }
+
+    size_t count = 0;
+    while (reversed) {
+      std::unique_ptr<Message> current(reversed);
+      reversed = current->mNext;
+      mBacklog.push_back(std::move(*current));
+      ++count;
+    }
+
+    mQueued.fetch_sub(count, std::memory_order_relaxed);
+
+    size_t dropped = mDropped.exchange(0, std::memory_order_relaxed);
+    if (mBacklog.size() > MAX_BACKLOG_MESSAGES) {
+      dropped += mBacklog.size() - MAX_BACKLOG_MESSAGES;
+      mBacklog.erase(
+          mBacklog.begin(), mBacklog.end() - static_cast<std::ptrdiff_t>(MAX_BACKLOG_MESSAGES));
+    }
+
+    if (dropped > 0) {
+      onLogMessage.emit(logger().name(), spdlog::level::warn,
+          fmt::format("Skipped {} log messages as they were emitted faster than they could be "
+                      "displayed! See cosmoscout.log for the complete output.",
+              dropped));
+    }
+
+    size_t emitted = std::min(mBacklog.size(), MAX_MESSAGES_PER_FRAME);
+    for (size_t i(0); i < emitted; ++i) {
+      onLogMessage.emit(mBacklog[i].mLogger, mBacklog[i].mLevel, mBacklog[i].mText);
+    }
+
+    mBacklog.erase(mBacklog.begin(), mBacklog.begin() + static_cast<std::ptrdiff_t>(emitted));
+  }
+
   Signal<std::string, spdlog::level::level_enum, std::string> onLogMessage;
 
  protected:
   void sink_it_(spdlog::details::log_msg const& msg) override {
-    onLogMessage.emit(std::string(msg.logger_name.begin(), msg.logger_name.end()), msg.level,
-        std::string(msg.payload.begin(), msg.payload.end()));
+    if (mQueued.fetch_add(1, std::memory_order_relaxed) >= MAX_QUEUED_MESSAGES) {
+      mQueued.fetch_sub(1, std::memory_order_relaxed);
+      mDropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    auto message     = std::make_unique<Message>();
+    message->mLogger = std::string(msg.logger_name.begin(), msg.logger_name.end());
+    message->mLevel  = msg.level;
+    message->mText   = std::string(msg.payload.begin(), msg.payload.end());
+    message->mNext   = mHead.load(std::memory_order_relaxed);
+
+    while (!mHead.compare_exchange_weak(
+        message->mNext, message.get(), std::memory_order_release, std::memory_order_relaxed)) {
+    }
+
+    // The message is now owned by the stack.
+    message.release();
   }
 
   void flush_() override {
   }
+
+ private:
+  struct Message {
+    std::string               mLogger;
+    spdlog::level::level_enum mLevel{};
+    std::string               mText;
+    Message*                  mNext = nullptr;
+  };
+
+  std::atomic<Message*> mHead{nullptr};
+  std::atomic<size_t>   mQueued{0};
+  std::atomic<size_t>   mDropped{0};
+
+  // This is only accessed by the main thread.
+  std::deque<Message> mBacklog;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -105,6 +217,12 @@ Signal<std::string, spdlog::level::level_enum, std::string> const& onLogMessage(
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void processLogMessages() {
+  std::dynamic_pointer_cast<SignalSink>(getLoggerSignalSink())->processMessages();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 std::unique_ptr<spdlog::logger> createLogger(std::string const& name) {
   size_t const prefixLength = 20;
 
@@ -68,10 +68,19 @@ CS_UTILS_EXPORT spdlog::logger& logger();
 /// This creates the default logger for vista and is called at startup by the main() method.
 CS_UTILS_EXPORT void initVistaLogger();
 
-/// This signal is emitted whenever a message is logged with spdlog. The first argument is the
-/// logger's name, the second the log level, the last argument is the message.
+/// This signal is emitted for messages logged with spdlog. The first argument is the logger's name,
+/// the second the log level, the last argument is the message. The signal is not emitted from the
+/// logging thread but only from processLogMessages().
 CS_UTILS_EXPORT Signal<std::string, spdlog::level::level_enum, std::string> const& onLogMessage();
 
+/// Messages may be logged from any thread. They are collected without locking and the onLogMessage
+/// signal is emitted for them when this is called. The Application calls this once per frame on
+/// the main thread. To keep the frame time stable, at most 100 messages are emitted per call. The
+/// remaining messages are kept for the next calls in a ring buffer of 1000 messages; if that
+/// overflows, the oldest messages are skipped. All messages are always printed to the console and
+/// written to the log file.
+CS_UTILS_EXPORT void processLogMessages();
+
 /// Call this method once from your plugin in order to create a new logger. The given name will
 /// be shown together with the log level in each message. The logger will print to the console and
 /// store it's messages in a file called cosmoscout.log. If you want to, you could store the
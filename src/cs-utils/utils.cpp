@@ -13,6 +13,8 @@
 #include <VistaKernel/VistaSystem.h>
 
 #include <array>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 
@@ -111,6 +113,20 @@ std::vector<std::string> splitString(std::string const& s, char delim) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+std::string hashString(std::string const& data) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : data) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+
+  std::stringstream stream;
+  stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return stream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 #ifdef __linux__
 #define CS_POPEN popen
 #define CS_CLOSE pclose
@@ -108,6 +108,10 @@ T fromString(std::string const& v) {
 /// Splits the given string into chunks separated by the delim character.
 CS_UTILS_EXPORT std::vector<std::string> splitString(std::string const& s, char delim);
 
+/// Computes the 64-bit FNV-1a hash of the given string and returns it as a hexadecimal number with
+/// 16 digits. This is not a cryptographic hash; it is meant for naming cache files and the like.
+CS_UTILS_EXPORT std::string hashString(std::string const& data);
+
 /// A template to cast an enum class to its underlying type.
 template <typename T>
 constexpr typename std::underlying_type<T>::type enumCast(T val) {
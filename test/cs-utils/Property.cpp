@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "../../src/cs-utils/Property.hpp"
+#include "../../src/cs-utils/doctest.hpp"
+
+#include <string>
+#include <utility>
+
+namespace cs::utils {
+TEST_CASE("cs::utils::Property::set") {
+  Property<int> a(1);
+
+  int calls = 0;
+  a.connect([&](int /*value*/) { ++calls; });
+
+  a.set(1);
+  CHECK(calls == 0);
+
+  a.set(2);
+  CHECK(a.get() == 2);
+  CHECK(calls == 1);
+}
+
+TEST_CASE("cs::utils::Property::setDeferred") {
+  Property<std::string> a("a");
+
+  int         calls = 0;
+  std::string oldValue;
+  a.connect([&](std::string const& /*value*/) {
+    oldValue = a.get();
+    ++calls;
+  });
+
+  a.setDeferred("b");
+  a.setDeferred("c");
+  CHECK(a.get() == "a");
+  CHECK(a.hasDeferredValue());
+  CHECK(calls == 0);
+
+  a.flush();
+  CHECK(a.get() == "c");
+  CHECK(oldValue == "a");
+  CHECK(calls == 1);
+  CHECK_FALSE(a.hasDeferredValue());
+
+  // Changes which cancel each other out are not reported at all.
+  a.setDeferred("d");
+  a.setDeferred("c");
+  a.flush();
+  CHECK(calls == 1);
+}
+
+TEST_CASE("cs::utils::Property::setDeferred with move") {
+  Property<std::string> a("a");
+  a.setDeferred("b");
+
+  Property<std::string> b(std::move(a));
+  CHECK(b.hasDeferredValue());
+
+  Property<std::string> c;
+  c = std::move(b);
+  c.flush();
+  CHECK(c.get() == "b");
+}
+
+} // namespace cs::utils
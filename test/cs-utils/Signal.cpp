@@ -212,4 +212,30 @@ TEST_CASE("cs::utils::Signal disconnect all slots while emitting for all but one
   CHECK_FALSE(test3);
 }
 
-} // namespace cs::utils
\ No newline at end of file
+TEST_CASE("cs::utils::Signal connect and disconnect while emitting") {
+  Signal<> a;
+
+  int calls = 0;
+  int id    = 0;
+  id        = a.connect([&]() {
+    ++calls;
+    a.disconnect(id);
+
+    // Slots connected during the emission are not called by this emission.
+    a.connect([&]() { calls += 10; });
+  });
+
+  a.emit();
+  CHECK(calls == 1);
+  CHECK(a.size() == 1);
+
+  a.emit();
+  CHECK(calls == 11);
+
+  a.connect([&]() { a.disconnectAll(); });
+  a.emit();
+  CHECK(calls == 21);
+  CHECK(a.size() == 0);
+}
+
+} // namespace cs::utils
@@ -50,4 +50,10 @@ TEST_CASE("cs::utils::endsWith") {
   CHECK_UNARY_FALSE(endsWith("lorem ipsum", "abracadabra simsalabim"));
 }
 
+TEST_CASE("cs::utils::hashString") {
+  CHECK_EQ(hashString(""), "cbf29ce484222325");
+  CHECK_EQ(hashString("a"), "af63dc4c8601ec8c");
+  CHECK_EQ(hashString("foobar"), "85944171f73967e8");
+}
+
 } // namespace cs::utils
\ No newline at end of file
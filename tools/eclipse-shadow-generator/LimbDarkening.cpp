@@ -5,12 +5,12 @@
 // SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
 // SPDX-License-Identifier: MIT
 
-#include "LimbDarkening.cuh"
-#include "math.cuh"
+#include "LimbDarkening.hpp"
+#include "math.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void __host__ __device__ LimbDarkening::init() {
+void CS_HOST_DEVICE LimbDarkening::init() {
   double        totalBrightness = 0.0;
   const int32_t samples         = 2048;
 
@@ -32,7 +32,7 @@ void __host__ __device__ LimbDarkening::init() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-double __host__ __device__ LimbDarkening::get(double r) const {
+double CS_HOST_DEVICE LimbDarkening::get(double r) const {
   return r >= 1.0 ? 0.0 : (1.0 - 0.6 * (1.0 - std::sqrt(1 - r * r))) / mAverage;
 }
 
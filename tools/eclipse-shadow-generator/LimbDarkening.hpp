@@ -8,7 +8,7 @@
 #ifndef LIMB_DARKENING_HPP
 #define LIMB_DARKENING_HPP
 
-#include <cuda_runtime.h>
+#include "compatibility.hpp"
 
 /// This struct implements a simple wavelength-independent limb darkening model.
 class LimbDarkening {
@@ -16,12 +16,12 @@ class LimbDarkening {
  public:
   /// This computes the average brightness over the entire solar disc by sampling so that the get()
   /// method can return normalized values.
-  void __host__ __device__ init();
+  void CS_HOST_DEVICE init();
 
   /// Returns the Sun's brightness at the given radial distance to the center of the solar disc
   /// between [0...1]. The returned values are normalized so that the average brightness over entire
   /// disc is one.
-  double __host__ __device__ get(double r) const;
+  double CS_HOST_DEVICE get(double r) const;
 
  private:
   double mAverage = 1.0;
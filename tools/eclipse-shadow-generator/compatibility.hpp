@@ -5,26 +5,16 @@
 // SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
 // SPDX-License-Identifier: MIT
 
-#include "Arc.hpp"
-#include "Breakpoint.hpp"
+#ifndef COMPATIBILITY_HPP
+#define COMPATIBILITY_HPP
 
-namespace csp::measurementtools {
+// The math code of this tool is compiled by nvcc for the Cuda backend and by the host compiler for
+// the CPU backend. In the latter case, the Cuda function qualifiers are simply removed.
+#ifdef __CUDACC__
+#include <cuda_runtime.h>
+#define CS_HOST_DEVICE __host__ __device__
+#else
+#define CS_HOST_DEVICE
+#endif
 
-Arc::Arc(Site const& s)
-    : mSite(s)
-    , mLeftBreak(nullptr)
-    , mRightBreak(nullptr)
-    , mEvent(nullptr) {
-}
-
-void Arc::invalidateEvent() {
-
-  if (mEvent) {
-    if (mEvent->mIsValid) {
-      mEvent->mIsValid = false;
-    }
-
-    mEvent = nullptr;
-  }
-}
-} // namespace csp::measurementtools
+#endif // COMPATIBILITY_HPP
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "shadows.hpp"
+
+#include "../../src/cs-utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+namespace shadows {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Computes one row of the shadow map. The mode is evaluated outside of the loop so that the
+// compiler can generate a tight loop for each of the modes.
+template <typename F>
+void computeRow(uint32_t y, ShadowSettings const& settings, float* row, F const& getShadow) {
+  for (uint32_t x = 0; x < settings.size; ++x) {
+    auto angles = math::mapPixelToAngles(glm::ivec2(x, y), settings.size,
+        settings.mappingExponent, settings.includeUmbra);
+    row[x] = getShadow(angles);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void computeCPU(Mode mode, ShadowSettings const& settings, LimbDarkening const& limbDarkening,
+    float* shadowMap, uint32_t threads) {
+
+  // The cost per pixel varies a lot in limb-darkening mode. Hence we enqueue each row as a separate
+  // task, so that the rows are balanced dynamically between the worker threads.
+  cs::utils::ThreadPool pool(std::max(threads, 1U));
+
+  std::vector<std::future<void>> rows;
+  rows.reserve(settings.size);
+
+  for (uint32_t y = 0; y < settings.size; ++y) {
+    float* row = shadowMap + static_cast<size_t>(y) * settings.size;
+
+    rows.push_back(pool.enqueue([mode, y, row, &settings, &limbDarkening]() {
+      switch (mode) {
+      case Mode::eLimbDarkening:
+        computeRow(y, settings, row, [&limbDarkening](glm::dvec2 const& angles) {
+          return getLimbDarkeningShadow(angles, limbDarkening);
+        });
+        break;
+      case Mode::eCircles:
+        computeRow(y, settings, row, getCircleIntersectionShadow);
+        break;
+      case Mode::eLinear:
+        computeRow(y, settings, row, getLinearShadow);
+        break;
+      case Mode::eSmoothstep:
+        computeRow(y, settings, row, getSmoothstepShadow);
+        break;
+      }
+    }));
+  }
+
+  for (auto& row : rows) {
+    row.get();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace shadows
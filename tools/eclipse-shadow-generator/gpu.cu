@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "shadows.hpp"
+
+#include <cstdio>
+
+namespace shadows {
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This macro is used in multiple locations to check for Cuda errors.
+// https://stackoverflow.com/questions/14038589/what-is-the-canonical-way-to-check-for-errors-using-the-cuda-runtime-api
+#define gpuErrchk(ans)                                                                             \
+  { gpuAssert((ans), __FILE__, __LINE__); }
+inline void gpuAssert(cudaError_t code, const char* file, int line, bool abort = true) {
+  if (code != cudaSuccess) {
+    fprintf(stderr, "GPUassert: %s %s %d\n", cudaGetErrorString(code), file, line);
+    if (abort) {
+      exit(code);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+__constant__ LimbDarkening  cLimbDarkening;
+__constant__ ShadowSettings cShadowSettings;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Each of the kernels below computes one pixel of the shadow map. See shadows.hpp for a description
+// of the different modes.
+
+__global__ void computeLimbDarkeningShadow(float* shadowMap) {
+  uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
+  uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+  uint32_t i = y * cShadowSettings.size + x;
+
+  if ((x >= cShadowSettings.size) || (y >= cShadowSettings.size)) {
+    return;
+  }
+
+  auto angles = math::mapPixelToAngles(glm::ivec2(x, y), cShadowSettings.size,
+      cShadowSettings.mappingExponent, cShadowSettings.includeUmbra);
+
+  shadowMap[i] = getLimbDarkeningShadow(angles, cLimbDarkening);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+__global__ void computeCircleIntersectionShadow(float* shadowMap) {
+  uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
+  uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+  uint32_t i = y * cShadowSettings.size + x;
+
+  if ((x >= cShadowSettings.size) || (y >= cShadowSettings.size)) {
+    return;
+  }
+
+  auto angles = math::mapPixelToAngles(glm::ivec2(x, y), cShadowSettings.size,
+      cShadowSettings.mappingExponent, cShadowSettings.includeUmbra);
+
+  shadowMap[i] = getCircleIntersectionShadow(angles);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+__global__ void computeLinearShadow(float* shadowMap) {
+  uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
+  uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+  uint32_t i = y * cShadowSettings.size + x;
+
+  if ((x >= cShadowSettings.size) || (y >= cShadowSettings.size)) {
+    return;
+  }
+
+  auto angles = math::mapPixelToAngles(glm::ivec2(x, y), cShadowSettings.size,
+      cShadowSettings.mappingExponent, cShadowSettings.includeUmbra);
+
+  shadowMap[i] = getLinearShadow(angles);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+__global__ void computeSmoothstepShadow(float* shadowMap) {
+  uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
+  uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+  uint32_t i = y * cShadowSettings.size + x;
+
+  if ((x >= cShadowSettings.size) || (y >= cShadowSettings.size)) {
+    return;
+  }
+
+  auto angles = math::mapPixelToAngles(glm::ivec2(x, y), cShadowSettings.size,
+      cShadowSettings.mappingExponent, cShadowSettings.includeUmbra);
+
+  shadowMap[i] = getSmoothstepShadow(angles);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void computeCuda(Mode mode, ShadowSettings const& settings, LimbDarkening const& limbDarkening,
+    float* shadowMap) {
+
+  // Initialize the global Cuda symbols.
+  gpuErrchk(cudaMemcpyToSymbol(cShadowSettings, &settings, sizeof(ShadowSettings)));
+  gpuErrchk(cudaMemcpyToSymbol(cLimbDarkening, &limbDarkening, sizeof(LimbDarkening)));
+
+  // Compute the 2D kernel size.
+  dim3     blockSize(16, 16);
+  uint32_t numBlocksX = (settings.size + blockSize.x - 1) / blockSize.x;
+  uint32_t numBlocksY = (settings.size + blockSize.y - 1) / blockSize.y;
+  dim3     gridSize   = dim3(numBlocksX, numBlocksY);
+
+  // Allocate the device memory for the shadow map.
+  size_t bytes  = static_cast<size_t>(settings.size) * settings.size * sizeof(float);
+  float* shadow = nullptr;
+  gpuErrchk(cudaMalloc(&shadow, bytes));
+
+  // Compute the shadow map based on the given mode.
+  switch (mode) {
+  case Mode::eLimbDarkening:
+    computeLimbDarkeningShadow<<<gridSize, blockSize>>>(shadow);
+    break;
+  case Mode::eCircles:
+    computeCircleIntersectionShadow<<<gridSize, blockSize>>>(shadow);
+    break;
+  case Mode::eLinear:
+    computeLinearShadow<<<gridSize, blockSize>>>(shadow);
+    break;
+  case Mode::eSmoothstep:
+    computeSmoothstepShadow<<<gridSize, blockSize>>>(shadow);
+    break;
+  }
+
+  gpuErrchk(cudaPeekAtLastError());
+  gpuErrchk(cudaDeviceSynchronize());
+
+  gpuErrchk(cudaMemcpy(shadowMap, shadow, bytes, cudaMemcpyDeviceToHost));
+  gpuErrchk(cudaFree(shadow));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace shadows
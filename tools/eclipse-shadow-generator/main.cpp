@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#include "../../src/cs-utils/CommandLine.hpp"
+
+#include "LimbDarkening.hpp"
+#include "shadows.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image.h>
+#include <stb_image_write.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// This tool can be used to create the eclipse shadow maps used by CosmoScout VR. See the         //
+// README.md file in this directory for usage instructions!                                       //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Converts the value of the --mode argument to the corresponding enum value. Returns false if the
+// name is invalid.
+bool parseMode(std::string const& name, shadows::Mode& mode) {
+  if (name == "limb-darkening") {
+    mode = shadows::Mode::eLimbDarkening;
+  } else if (name == "circles") {
+    mode = shadows::Mode::eCircles;
+  } else if (name == "linear") {
+    mode = shadows::Mode::eLinear;
+  } else if (name == "smoothstep") {
+    mode = shadows::Mode::eSmoothstep;
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Computes the shadow map with the given backend and returns the required time in milliseconds.
+double compute(std::string const& backend, shadows::Mode mode,
+    shadows::ShadowSettings const& settings, LimbDarkening const& limbDarkening, float* shadowMap,
+    uint32_t threads) {
+
+  auto start = std::chrono::steady_clock::now();
+
+#ifdef ECLIPSE_SHADOW_GENERATOR_WITH_CUDA
+  if (backend == "cuda") {
+    shadows::computeCuda(mode, settings, limbDarkening, shadowMap);
+  } else {
+    shadows::computeCPU(mode, settings, limbDarkening, shadowMap, threads);
+  }
+#else
+  shadows::computeCPU(mode, settings, limbDarkening, shadowMap, threads);
+#endif
+
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Computes the shadow map in all modes with all available backends and prints the timings. If more
+// than one backend is available, the maximum difference between their results is printed as well.
+void runBenchmark(std::vector<std::string> const& backends,
+    shadows::ShadowSettings const& settings, LimbDarkening const& limbDarkening, uint32_t threads) {
+
+  std::vector<std::string> modes = {"limb-darkening", "circles", "linear", "smoothstep"};
+  size_t                   count = static_cast<size_t>(settings.size) * settings.size;
+
+  std::cout << "Benchmarking a " << settings.size << "x" << settings.size << " shadow map using "
+            << threads << " CPU threads." << std::endl;
+
+  for (auto const& name : modes) {
+    shadows::Mode mode{};
+    parseMode(name, mode);
+
+    std::vector<std::vector<float>> results;
+
+    for (auto const& backend : backends) {
+      results.emplace_back(count);
+      double ms = compute(backend, mode, settings, limbDarkening, results.back().data(), threads);
+      std::cout << std::left << std::setw(16) << name << std::setw(6) << backend << std::right
+                << std::setw(12) << std::fixed << std::setprecision(2) << ms << " ms" << std::endl;
+    }
+
+    for (size_t b = 1; b < results.size(); ++b) {
+      float maxError = 0.F;
+      for (size_t i = 0; i < count; ++i) {
+        maxError = std::max(maxError, std::abs(results[0][i] - results[b][i]));
+      }
+      std::cout << std::left << std::setw(16) << name << "max. difference " << backends[0]
+                << " / " << backends[b] << ": " << std::scientific << maxError << std::endl;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+
+  stbi_flip_vertically_on_write(1);
+
+  shadows::ShadowSettings settings;
+
+#ifdef ECLIPSE_SHADOW_GENERATOR_WITH_CUDA
+  std::vector<std::string> backends = {"cuda", "cpu"};
+#else
+  std::vector<std::string> backends = {"cpu"};
+#endif
+
+  std::string cOutput    = "shadow.hdr";
+  std::string cMode      = "limb-darkening";
+  std::string cBackend   = backends.front();
+  uint32_t    cThreads   = std::max(std::thread::hardware_concurrency(), 1U);
+  bool        cBenchmark = false;
+  bool        cPrintHelp = false;
+
+  // First configure all possible command line options.
+  cs::utils::CommandLine args(
+      "Welcome to the shadow map generator! Here are the available options:");
+  args.addArgument({"-o", "--output"}, &cOutput,
+      "The image will be written to this file (default: \"" + cOutput + "\").");
+  args.addArgument({"--size"}, &settings.size,
+      "The output texture size (default: " + std::to_string(settings.size) + ").");
+  args.addArgument({"--mode"}, &cMode,
+      "This should be either 'limb-darkening', 'circles', 'linear', or 'smoothstep' (default: " +
+          cMode + ").");
+  args.addArgument({"--with-umbra"}, &settings.includeUmbra,
+      "Add the umbra region to the shadow map (default: " + std::to_string(settings.includeUmbra) +
+          ").");
+  args.addArgument({"--mapping-exponent"}, &settings.mappingExponent,
+      "Adjusts the distribution of sampling positions. A value of 1.0 will position the "
+      "umbra's end in the middle of the texture, larger values will shift this to the "
+      "right. (default: " +
+          std::to_string(settings.mappingExponent) + ").");
+#ifdef ECLIPSE_SHADOW_GENERATOR_WITH_CUDA
+  args.addArgument({"--backend"}, &cBackend,
+      "This should be either 'cuda' or 'cpu' (default: " + cBackend + ").");
+#else
+  args.addArgument({"--backend"}, &cBackend,
+      "Only 'cpu' is available, as this build does not support Cuda (default: " + cBackend +
+          ").");
+#endif
+  args.addArgument({"--threads"}, &cThreads,
+      "The number of threads used by the cpu backend (default: " + std::to_string(cThreads) +
+          ").");
+  args.addArgument({"--benchmark"}, &cBenchmark,
+      "Compute the shadow map in all modes with all available backends and print the timings "
+      "instead of writing an image (default: " +
+          std::to_string(cBenchmark) + ").");
+  args.addArgument({"-h", "--help"}, &cPrintHelp, "Show this help message.");
+
+  // Then do the actual parsing.
+  try {
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    args.parse(arguments);
+  } catch (std::runtime_error const& e) {
+    std::cerr << "Failed to parse command line arguments: " << e.what() << std::endl;
+    return 1;
+  }
+
+  // When cPrintHelp was set to true, we print a help message and exit.
+  if (cPrintHelp) {
+    args.printHelp();
+    return 0;
+  }
+
+  // Check whether a valid mode was given.
+  shadows::Mode mode{};
+  if (!parseMode(cMode, mode)) {
+    std::cerr << "Invalid value given for --mode!" << std::endl;
+
+    return 1;
+  }
+
+  // Check whether a valid backend was given.
+  if (std::find(backends.begin(), backends.end(), cBackend) == backends.end()) {
+    std::cerr << "Invalid value given for --backend!" << std::endl;
+
+    return 1;
+  }
+
+  // Initialize the limb darkening model.
+  LimbDarkening limbDarkening;
+  limbDarkening.init();
+
+  if (cBenchmark) {
+    runBenchmark(backends, settings, limbDarkening, cThreads);
+    return 0;
+  }
+
+  // Compute the shadow map based on the given mode.
+  std::vector<float> shadow(static_cast<size_t>(settings.size) * settings.size);
+  compute(cBackend, mode, settings, limbDarkening, shadow.data(), cThreads);
+
+  // Finally write the output texture!
+  stbi_write_hdr(cOutput.c_str(), static_cast<int>(settings.size),
+      static_cast<int>(settings.size), 1, shadow.data());
+
+  return 0;
+}
@@ -5,25 +5,25 @@
 // SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
 // SPDX-License-Identifier: MIT
 
-#include "math.cuh"
+#include "math.hpp"
 
 namespace math {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-double __host__ __device__ getCircleArea(double r) {
+double CS_HOST_DEVICE getCircleArea(double r) {
   return glm::pi<double>() * r * r;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-double __host__ __device__ getCapArea(double r) {
+double CS_HOST_DEVICE getCapArea(double r) {
   return 2.0 * glm::pi<double>() * (1.0 - std::cos(r));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-double __host__ __device__ getCapIntersection(double rSun, double rOcc, double d) {
+double CS_HOST_DEVICE getCapIntersection(double rSun, double rOcc, double d) {
   d = std::abs(d);
 
   if (rSun <= 0.0 || rOcc <= 0.0) {
@@ -48,7 +48,7 @@ double __host__ __device__ getCapIntersection(double rSun, double rOcc, double d
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-double __host__ __device__ getCircleIntersection(double rSun, double rOcc, double d) {
+double CS_HOST_DEVICE getCircleIntersection(double rSun, double rOcc, double d) {
   d = std::abs(d);
 
   if (rSun <= 0.0 || rOcc <= 0.0) {
@@ -72,7 +72,7 @@ double __host__ __device__ getCircleIntersection(double rSun, double rOcc, doubl
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-double __host__ __device__ sampleCircleIntersection(
+double CS_HOST_DEVICE sampleCircleIntersection(
     double rSun, double rOcc, double d, LimbDarkening const& limbDarkening) {
 
   // Sanity checks.
@@ -136,7 +136,7 @@ double __host__ __device__ sampleCircleIntersection(
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-glm::dvec2 __host__ __device__ mapPixelToAngles(
+glm::dvec2 CS_HOST_DEVICE mapPixelToAngles(
     glm::ivec2 const& pixel, uint32_t resolution, double exponent, bool includeUmbra) {
 
   double x = glm::pow((1.0 * pixel.x + 0.5) / resolution, exponent);
@@ -155,7 +155,7 @@ glm::dvec2 __host__ __device__ mapPixelToAngles(
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-glm::ivec2 __host__ __device__ mapAnglesToPixel(
+glm::ivec2 CS_HOST_DEVICE mapAnglesToPixel(
     glm::dvec2 const& angles, uint32_t resolution, double exponent, bool includeUmbra) {
 
   double phiSun   = 1.0;
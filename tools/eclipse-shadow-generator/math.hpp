@@ -15,38 +15,38 @@
 #include <glm/gtc/constants.hpp>
 #include <glm/gtx/norm.hpp>
 
-#include "LimbDarkening.cuh"
+#include "LimbDarkening.hpp"
 
 namespace math {
 
 /// Returns the surface area of a circle.
-double __host__ __device__ getCircleArea(double r);
+double CS_HOST_DEVICE getCircleArea(double r);
 
 /// Returns the surface area of a spherical cap on a unit sphere.
-double __host__ __device__ getCapArea(double r);
+double CS_HOST_DEVICE getCapArea(double r);
 
 /// Returns the intersection area of two spherical caps with radii rSun and rOcc whose center points
 /// are distance d away from each other. All values are given as angles on the unit sphere.
-double __host__ __device__ getCapIntersection(double rSun, double rOcc, double d);
+double CS_HOST_DEVICE getCapIntersection(double rSun, double rOcc, double d);
 
 /// Returns the intersection area of two circles with radii rSun and rOcc whose center points are
 /// distance d away from each other.
-double __host__ __device__ getCircleIntersection(double rSun, double rOcc, double d);
+double CS_HOST_DEVICE getCircleIntersection(double rSun, double rOcc, double d);
 
 /// Same as above, but the intersection area is computed by sampling. This is less precise but
 /// allows for incorporating limb darkening.
-double __host__ __device__ sampleCircleIntersection(
+double CS_HOST_DEVICE sampleCircleIntersection(
     double rSun, double rOcc, double d, LimbDarkening const& limbDarkening);
 
 /// Maps a pixel position in the shadow map to the three angles phiSun, phiOcc and delta. phiSun is
 /// assumed to be 1.0, phiOcc is returned as first component, delta as second component.
-glm::dvec2 __host__ __device__ mapPixelToAngles(
+glm::dvec2 CS_HOST_DEVICE mapPixelToAngles(
     glm::ivec2 const& pixel, uint32_t resolution, double exponent, bool includeUmbra);
 
 /// Maps the three angles phiSun, phiOcc and delta to a pixel position in the shadow map to. phiSun
 /// is assumed to be 1.0, phiOcc should be given as first component, delta as second component of
 /// "angled".
-glm::ivec2 __host__ __device__ mapAnglesToPixel(
+glm::ivec2 CS_HOST_DEVICE mapAnglesToPixel(
     glm::dvec2 const& angles, uint32_t resolution, double exponent, bool includeUmbra);
 } // namespace math
 
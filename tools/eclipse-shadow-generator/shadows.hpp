@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//                               This file is part of CosmoScout VR                               //
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// SPDX-FileCopyrightText: German Aerospace Center (DLR) <cosmoscout@dlr.de>
+// SPDX-License-Identifier: MIT
+
+#ifndef SHADOWS_HPP
+#define SHADOWS_HPP
+
+#include "LimbDarkening.hpp"
+#include "math.hpp"
+
+#include <cstdint>
+
+namespace shadows {
+
+/// The different ways of computing the shadow map. See the functions below for details.
+enum class Mode { eLimbDarkening, eCircles, eLinear, eSmoothstep };
+
+/// This is used to pass the command line options to the backends.
+struct ShadowSettings {
+  uint32_t size            = 512;
+  bool     includeUmbra    = false;
+  double   mappingExponent = 1.0;
+};
+
+// The functions below compute the value of a single pixel of the shadow map. They are shared by the
+// Cuda and the CPU backend so that both produce the same output.
+
+/// Computes the shadow by sampling the intersection area between circles representing the Sun and
+/// the occluder. This makes use of the given limb darkening function.
+inline CS_HOST_DEVICE float getLimbDarkeningShadow(
+    glm::dvec2 const& angles, LimbDarkening const& limbDarkening) {
+  double sunArea = math::getCircleArea(1.0);
+
+  return static_cast<float>(
+      1 - math::sampleCircleIntersection(1.0, angles.x, angles.y, limbDarkening) / sunArea);
+}
+
+/// Computes the shadow by analytically computing the intersection area between circles
+/// representing the Sun and the occluder. This does not use a limb darkening function.
+inline CS_HOST_DEVICE float getCircleIntersectionShadow(glm::dvec2 const& angles) {
+  double sunArea = math::getCircleArea(1.0);
+
+  return static_cast<float>(1.0 - math::getCircleIntersection(1.0, angles.x, angles.y) / sunArea);
+}
+
+/// Computes the shadow by assuming a linear brightness gradient from the outer edge of the penumbra
+/// to the start of the umbra / antumbra. In the antumbra, the shadow intensity decreases
+/// quadratically. This does not use a limb darkening function.
+inline CS_HOST_DEVICE float getLinearShadow(glm::dvec2 const& angles) {
+  double phiSun = 1.0;
+  double phiOcc = angles[0];
+  double delta  = angles[1];
+
+  double visiblePortion =
+      (delta - glm::abs(phiSun - phiOcc)) / (phiSun + phiOcc - glm::abs(phiSun - phiOcc));
+
+  double maxDepth = glm::min(1.0, glm::pow(phiOcc / phiSun, 2.0));
+
+  return static_cast<float>(1.0 - maxDepth * glm::clamp(1.0 - visiblePortion, 0.0, 1.0));
+}
+
+/// Computes the shadow by assuming a smoothstep-based brightness gradient from the outer edge of
+/// the penumbra to the start of the umbra / antumbra. In the antumbra, the shadow intensity
+/// decreases quadratically. This does not use a limb darkening function.
+inline CS_HOST_DEVICE float getSmoothstepShadow(glm::dvec2 const& angles) {
+  double phiSun = 1.0;
+  double phiOcc = angles[0];
+  double delta  = angles[1];
+
+  double visiblePortion =
+      (delta - glm::abs(phiSun - phiOcc)) / (phiSun + phiOcc - glm::abs(phiSun - phiOcc));
+
+  double maxDepth = glm::min(1.0, glm::pow(phiOcc / phiSun, 2.0));
+
+  return static_cast<float>(
+      1.0 - maxDepth * glm::clamp(1.0 - glm::smoothstep(0.0, 1.0, visiblePortion), 0.0, 1.0));
+}
+
+/// Computes the shadow map on the CPU. The rows of the image are distributed among the given number
+/// of threads. The shadowMap has to point to settings.size * settings.size floats.
+void computeCPU(Mode mode, ShadowSettings const& settings, LimbDarkening const& limbDarkening,
+    float* shadowMap, uint32_t threads);
+
+#ifdef ECLIPSE_SHADOW_GENERATOR_WITH_CUDA
+/// Computes the shadow map on the GPU. The shadowMap has to point to settings.size * settings.size
+/// floats in host memory.
+void computeCuda(Mode mode, ShadowSettings const& settings, LimbDarkening const& limbDarkening,
+    float* shadowMap);
+#endif
+
+} // namespace shadows
+
+#endif // SHADOWS_HPP